@@ -93,6 +93,7 @@ DEPS_LIST=(
     "$PREFIX/lib/libavcodec.so.58"
     "$PREFIX/lib/libavfilter.so.7"
     "$PREFIX/lib/libavutil.so.56"
+    "$PREFIX/lib/libswscale.so.5"
 )
 
 DEPS_SONAME=(
@@ -100,6 +101,7 @@ DEPS_SONAME=(
     "libavcodec.so.58"
     "libavfilter.so.7"
     "libavutil.so.56"
+    "libswscale.so.5"
 )
 
 PKGNAME_PATH=dali/python/nvidia/dali/
@@ -169,5 +171,6 @@ make -j install
 $PYTHON -m pip install --no-deps --ignore-installed .
 popd
 
-# Move tfrecord2idx to host env so it can be found at runtime
+# Move tfrecord2idx and idx2bin to host env so they can be found at runtime
 cp $SRC_DIR/tools/tfrecord2idx $PREFIX/bin
+cp $SRC_DIR/tools/idx2bin $PREFIX/bin
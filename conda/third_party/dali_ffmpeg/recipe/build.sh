@@ -25,8 +25,10 @@ unset SUBDIR
     --enable-avformat \
     --enable-avcodec \
     --enable-avfilter \
+    --enable-swscale \
     --enable-protocol=file \
     --enable-demuxer=mov,matroska,avi  \
+    --enable-decoder=h264,hevc,mpeg4,vp9 \
     --enable-bsf=h264_mp4toannexb,hevc_mp4toannexb,mpeg4_unpack_bframes
 make -j"$(nproc --all)"
 make install
@@ -0,0 +1,110 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "dali/pipeline/operator/arg_helper.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+DALI_SCHEMA(ArgAccessBenchOp)
+  .NumInput(0).NumOutput(0)
+  .AddOptionalArg("center_x", "per-sample argument", 0.5f, true)
+  .AddOptionalArg("center_y", "per-sample argument", 0.5f, true)
+  .AddOptionalArg("center_z", "per-sample argument", 0.5f, true);
+
+namespace {
+
+const char *kArgNames[] = {"center_x", "center_y", "center_z"};
+
+/**
+ * @brief The arguments of a per-sample operator, either constant or given as argument inputs
+ */
+struct ArgAccessSetup {
+  ArgAccessSetup(int batch_size, bool argument_input) : spec("ArgAccessBenchOp") {
+    spec.AddArg("batch_size", batch_size);
+    for (const char *name : kArgNames) {
+      if (argument_input) {
+        spec.AddArgumentInput(name, "<not_used>");
+        auto tv = std::make_shared<TensorVector<CPUBackend>>(batch_size);
+        tv->Resize(uniform_list_shape(batch_size, {1}));
+        tv->set_type(TypeInfo::Create<float>());
+        for (int i = 0; i < batch_size; i++)
+          tv->tensor_handle(i)->mutable_data<float>()[0] = 0.25f;
+        ws.AddArgumentInput(name, tv);
+      } else {
+        spec.AddArg(name, 0.25f);
+      }
+    }
+  }
+
+  OpSpec spec;
+  ArgumentWorkspace ws;
+};
+
+void ArgAccessArgs(benchmark::internal::Benchmark *b) {
+  for (int argument_input : {0, 1}) {
+    for (int batch_size : {32, 256})
+      b->Args({batch_size, argument_input});
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief Per-sample access with OpSpec::GetArgument, as done by the legacy per-sample operators
+ */
+static void ArgAccess_GetArgument(benchmark::State &st) {
+  int batch_size = st.range(0);
+  ArgAccessSetup setup(batch_size, st.range(1));
+  for (auto _ : st) {
+    float sum = 0;
+    for (int i = 0; i < batch_size; i++) {
+      for (const char *name : kArgNames)
+        sum += setup.spec.GetArgument<float>(name, &setup.ws, i);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  st.counters["samples"] = benchmark::Counter(st.iterations() * batch_size,
+                                              benchmark::Counter::kIsRate);
+}
+
+/**
+ * @brief Per-sample access with ScalarArg, resolved once and acquired once per batch
+ */
+static void ArgAccess_ScalarArg(benchmark::State &st) {
+  int batch_size = st.range(0);
+  ArgAccessSetup setup(batch_size, st.range(1));
+  ScalarArg<float> args[] = {
+    {kArgNames[0], setup.spec}, {kArgNames[1], setup.spec}, {kArgNames[2], setup.spec}
+  };
+  for (auto _ : st) {
+    for (auto &arg : args)
+      arg.Acquire(setup.ws);
+    float sum = 0;
+    for (int i = 0; i < batch_size; i++) {
+      for (auto &arg : args)
+        sum += arg[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  st.counters["samples"] = benchmark::Counter(st.iterations() * batch_size,
+                                              benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(ArgAccess_GetArgument)->Apply(ArgAccessArgs);
+BENCHMARK(ArgAccess_ScalarArg)->Apply(ArgAccessArgs);
+
+}  // namespace dali
@@ -0,0 +1,109 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_impl_cpu.h"
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+
+namespace dali {
+
+namespace {
+
+// The tile size used by the CPU ArithmeticGenericOp
+constexpr int kArithmTileSize = 4096;
+constexpr int64_t kArithmBenchSize = 1 << 20;
+
+/**
+ * Arguments: SIMD level
+ */
+void ArithmCPUArgs(benchmark::internal::Benchmark *b) {
+  for (auto simd : { ArithmSIMD::None, ArithmSIMD::AVX2, ArithmSIMD::AVX512 })
+    b->Args({static_cast<int>(simd)});
+}
+
+template <typename T>
+std::vector<T> ArithmBenchData(int64_t n) {
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> dist(1, 100);
+  std::vector<T> data(n);
+  for (auto &x : data)
+    x = dist(rng);
+  return data;
+}
+
+/**
+ * @brief Runs the tensor-tensor implementation of `op` over tiles covering
+ *        kArithmBenchSize elements; reports the throughput of the inputs and output together.
+ */
+template <ArithmeticOp op, typename Left, typename Right>
+void ArithmTensorTensorCPU(benchmark::State &st) {
+  using Result = typename arithm_meta<op, CPUBackend>::template result_t<Left, Right>;
+  auto simd = GetArithmSIMD();
+  SetArithmSIMD(static_cast<ArithmSIMD>(st.range(0)));
+  if (GetArithmSIMD() != static_cast<ArithmSIMD>(st.range(0))) {
+    SetArithmSIMD(simd);
+    st.SkipWithError("SIMD level not supported by this CPU");
+    return;
+  }
+
+  auto left = ArithmBenchData<Left>(kArithmBenchSize);
+  auto right = ArithmBenchData<Right>(kArithmBenchSize);
+  std::vector<Result> out(kArithmBenchSize);
+  std::vector<ExtendedTileDesc> tiles;
+  for (int64_t offset = 0; offset < kArithmBenchSize; offset += kArithmTileSize) {
+    TileDesc desc = {0, static_cast<int>(offset / kArithmTileSize), kArithmTileSize,
+                     kArithmTileSize};
+    tiles.emplace_back(desc, out.data() + offset,
+                       ArgPack{left.data() + offset, right.data() + offset});
+  }
+
+  ExprImplCpuTT<op, Result, Left, Right> impl;
+  ExprImplContext ctx = {0, nullptr};
+  for (auto _ : st) {
+    for (int t = 0; t < static_cast<int>(tiles.size()); t++)
+      impl.Execute(ctx, tiles, {t, t + 1});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  st.SetBytesProcessed(st.iterations() * kArithmBenchSize *
+                       (sizeof(Left) + sizeof(Right) + sizeof(Result)));
+  SetArithmSIMD(simd);
+}
+
+}  // namespace
+
+#define ARITHM_CPU_BENCHMARK(OP, Left, Right)                  \
+  BENCHMARK_TEMPLATE(ArithmTensorTensorCPU, OP, Left, Right)   \
+  ->Unit(benchmark::kMicrosecond)                              \
+  ->Apply(ArithmCPUArgs)
+
+ARITHM_CPU_BENCHMARK(ArithmeticOp::add, uint8_t, uint8_t);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::add, int16_t, int16_t);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::add, int32_t, int32_t);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::add, float, float);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::mul, int16_t, int16_t);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::mul, int32_t, int32_t);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::mul, float, float);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::fdiv, float, float);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::add, uint8_t, int16_t);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::sub, uint8_t, float);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::mul, int16_t, float);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::mul, int32_t, float);
+ARITHM_CPU_BENCHMARK(ArithmeticOp::fdiv, uint8_t, uint8_t);
+
+}  // namespace dali
@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
 
 #include "dali/benchmark/dali_bench.h"
 #include "dali/pipeline/pipeline.h"
+#include "dali/util/async_file.h"
 #include "dali/util/image.h"
 #include "dali/test/dali_test_config.h"
 
@@ -151,4 +154,60 @@ BENCHMARK_REGISTER_F(FileReaderAlexnet, CaffePipe)->Iterations(1)
 ->UseRealTime()
 ->Apply(PipeArgs);
 
+BENCHMARK_DEFINE_F(FileReaderAlexnet, ReaderOnly)(benchmark::State& st) { // NOLINT
+  static const char *io_backends[] = { "sync", "threads", "io_uring" };
+  const char *io_backend = io_backends[st.range(0)];
+  int batch_size = st.range(1);
+  int io_queue_depth = st.range(2);
+
+  if (!strcmp(io_backend, "io_uring") && !AsyncFileReader::IOUringSupported()) {
+    st.SkipWithError("io_uring is not supported");
+    return;
+  }
+
+  Pipeline pipe(batch_size, 1, 0, -1, false, 2, false);
+
+  dali::string list_root(testing::dali_extra_path() + "/db/single/jpeg/image_list.txt");
+  pipe.AddOperator(
+      OpSpec("FileReader")
+      .AddArg("device", "cpu")
+      .AddArg("file_root", list_root)
+      .AddArg("io_backend", std::string(io_backend))
+      .AddArg("io_queue_depth", io_queue_depth)
+      .AddOutput("compressed_images", "cpu")
+      .AddOutput("labels", "cpu"));
+
+  vector<std::pair<string, string>> outputs = {{"compressed_images", "cpu"}};
+  pipe.Build(outputs);
+
+  DeviceWorkspace ws;
+  pipe.RunCPU();
+  pipe.RunGPU();
+  pipe.Outputs(&ws);
+
+  while (st.KeepRunning()) {
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  }
+
+  st.counters["FPS"] = benchmark::Counter(batch_size*st.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+static void ReaderArgs(benchmark::internal::Benchmark *b) {
+  int batch_size = 128;
+  b->Args({0, batch_size, 1});
+  for (int io_backend = 1; io_backend < 3; ++io_backend) {
+    for (int queue_depth = 4; queue_depth <= 64; queue_depth *= 4) {
+      b->Args({io_backend, batch_size, queue_depth});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(FileReaderAlexnet, ReaderOnly)->Iterations(50)
+->Unit(benchmark::kMillisecond)
+->UseRealTime()
+->Apply(ReaderArgs);
+
 }  // namespace dali
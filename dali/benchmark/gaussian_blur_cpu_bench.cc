@@ -0,0 +1,78 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "dali/kernels/imgproc/convolution/separable_convolution_cpu.h"
+#include "dali/kernels/scratch.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * Arguments: image height, image width, window size
+ */
+void SeparableConvolutionCPUArgs(benchmark::internal::Benchmark *b) {
+  for (int window_size : {7, 31}) {
+    b->Args({1080, 1920, window_size});
+    b->Args({4000, 6000, window_size});
+  }
+}
+
+/**
+ * @brief Blurs an RGB image; `W` = double selects the implementation with
+ *        a full-size intermediate buffer, `W` = float - the blocked one.
+ */
+template <typename W>
+void SeparableConvolutionCPU(benchmark::State &st) {
+  int64_t H = st.range(0), Wd = st.range(1);
+  int window_size = st.range(2);
+  TensorShape<3> shape = {H, Wd, 3};
+  std::vector<uint8_t> in(volume(shape)), out(volume(shape));
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto &x : in)
+    x = dist(rng);
+  std::vector<W> window(window_size, W(1) / window_size);
+  TensorView<StorageCPU, const W, 1> window_view(window.data(), TensorShape<1>{window_size});
+
+  kernels::SeparableConvolutionCpu<uint8_t, uint8_t, W, 2, true> kernel;
+  kernels::KernelContext ctx;
+  auto req = kernel.Setup(ctx, shape, {window_size, window_size});
+  kernels::ScratchpadAllocator scratch_alloc;
+  scratch_alloc.Reserve(req.scratch_sizes);
+
+  TensorView<StorageCPU, uint8_t, 3> out_view(out.data(), shape);
+  TensorView<StorageCPU, const uint8_t, 3> in_view(in.data(), shape);
+  for (auto _ : st) {
+    auto scratchpad = scratch_alloc.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    kernel.Run(ctx, out_view, in_view, {window_view, window_view});
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  st.SetBytesProcessed(st.iterations() * volume(shape));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(SeparableConvolutionCPU, float)->Unit(benchmark::kMillisecond)
+    ->Apply(SeparableConvolutionCPUArgs);
+BENCHMARK_TEMPLATE(SeparableConvolutionCPU, double)->Unit(benchmark::kMillisecond)
+    ->Apply(SeparableConvolutionCPUArgs);
+
+}  // namespace dali
@@ -0,0 +1,128 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "dali/kernels/imgproc/resample_cpu.h"
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
+#include "dali/kernels/scratch.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * Arguments: filter type, input size, output size, SIMD level
+ */
+static void ResampleCPUArgs(benchmark::internal::Benchmark *b) {
+  for (auto filter : { kernels::ResamplingFilterType::Linear,
+                       kernels::ResamplingFilterType::Triangular,
+                       kernels::ResamplingFilterType::Cubic,
+                       kernels::ResamplingFilterType::Lanczos3 }) {
+    for (auto sizes : { std::make_pair(500, 224), std::make_pair(1024, 1536) }) {
+      for (auto simd : { kernels::ResamplingSIMD::None,
+                         kernels::ResamplingSIMD::SSE41,
+                         kernels::ResamplingSIMD::AVX2 }) {
+        b->Args({static_cast<int>(filter), sizes.first, sizes.second, static_cast<int>(simd)});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename Out>
+class ResampleCPUFixture : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State& st) override {
+    auto filter = static_cast<kernels::ResamplingFilterType>(st.range(0));
+    int in_size = st.range(1);
+    out_size_ = st.range(2);
+    simd_ = kernels::GetResamplingSIMD();
+    kernels::SetResamplingSIMD(static_cast<kernels::ResamplingSIMD>(st.range(3)));
+
+    in_shape_ = { in_size, in_size * 4 / 3, 3 };
+    in_mem_.resize(volume(in_shape_));
+    std::mt19937_64 rng(1234);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto &x : in_mem_)
+      x = dist(rng);
+
+    for (auto &p : params_) {
+      p.output_size = out_size_;
+      p.min_filter = p.mag_filter = filter;
+    }
+    params_[1].output_size = out_size_ * 4 / 3;
+
+    auto in = make_tensor_cpu<3>(in_mem_.data(), in_shape_);
+    auto req = kernel_.Setup(ctx_, in, params_);
+    scratch_alloc_.Reserve(req.scratch_sizes);
+    out_shape_ = req.output_shapes[0].template tensor_shape<3>(0);
+    out_mem_.resize(volume(out_shape_));
+  }
+
+  void TearDown(benchmark::State& st) override {
+    kernels::SetResamplingSIMD(simd_);
+    out_mem_.clear();
+    out_mem_.shrink_to_fit();
+    in_mem_.clear();
+    in_mem_.shrink_to_fit();
+  }
+
+  void RunResample(benchmark::State& st) {
+    auto in = make_tensor_cpu<3>(in_mem_.data(), in_shape_);
+    auto out = make_tensor_cpu<3>(out_mem_.data(), out_shape_);
+    for (auto _ : st) {
+      auto scratchpad = scratch_alloc_.GetScratchpad();
+      ctx_.scratchpad = &scratchpad;
+      kernel_.Run(ctx_, out, in, params_);
+      benchmark::DoNotOptimize(out_mem_.data());
+      benchmark::ClobberMemory();
+    }
+    st.counters["FPS"] = benchmark::Counter(st.iterations(), benchmark::Counter::kIsRate);
+    st.SetBytesProcessed(st.iterations() * in_mem_.size());
+  }
+
+  kernels::ResampleCPU<Out, uint8_t> kernel_;
+  kernels::KernelContext ctx_;
+  kernels::ScratchpadAllocator scratch_alloc_;
+  kernels::ResamplingParams2D params_;
+  kernels::ResamplingSIMD simd_;
+  int out_size_;
+  TensorShape<3> in_shape_, out_shape_;
+  std::vector<uint8_t> in_mem_;
+  std::vector<Out> out_mem_;
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(ResampleCPUFixture, Uint8ToUint8, uint8_t)(benchmark::State& st) {
+  RunResample(st);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ResampleCPUFixture, Uint8ToFloat, float)(benchmark::State& st) {
+  RunResample(st);
+}
+
+BENCHMARK_REGISTER_F(ResampleCPUFixture, Uint8ToUint8)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ResampleCPUArgs);
+
+BENCHMARK_REGISTER_F(ResampleCPUFixture, Uint8ToFloat)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ResampleCPUArgs);
+
+}  // namespace dali
@@ -0,0 +1,68 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "dali/kernels/signal/resampling.h"
+
+namespace dali {
+
+namespace {
+
+// 10 seconds of 48 kHz audio
+constexpr int64_t kResamplingBenchInputSize = 480000;
+
+/**
+ * Arguments: input rate, output rate, maximum number of phases (0 - windowed sinc)
+ */
+void ResamplingCPUArgs(benchmark::internal::Benchmark *b) {
+  for (int max_phases : { 1024, 0 }) {
+    b->Args({48000, 16000, max_phases});
+    b->Args({44100, 16000, max_phases});
+    b->Args({22050, 16000, max_phases});
+  }
+}
+
+/**
+ * @brief Resamples a mono signal; reports the number of output samples processed.
+ */
+void ResamplingCPU(benchmark::State &st) {
+  double in_rate = st.range(0), out_rate = st.range(1);
+  kernels::signal::resampling::Resampler R;
+  R.Initialize(16);
+  R.max_phases = st.range(2);
+
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<float> dist(-1, 1);
+  std::vector<float> in(kResamplingBenchInputSize);
+  for (auto &x : in)
+    x = dist(rng);
+  int64_t n_out = kernels::signal::resampling::resampled_length(in.size(), in_rate, out_rate);
+  std::vector<float> out(n_out);
+
+  for (auto _ : st) {
+    R.Resample(out.data(), 0, n_out, out_rate, in.data(), in.size(), in_rate);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  st.SetItemsProcessed(st.iterations() * n_out);
+}
+
+}  // namespace
+
+BENCHMARK(ResamplingCPU)->Unit(benchmark::kMicrosecond)->Apply(ResamplingCPUArgs);
+
+}  // namespace dali
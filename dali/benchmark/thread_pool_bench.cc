@@ -24,7 +24,24 @@ static void ThreadPoolArgs(benchmark::internal::Benchmark *b) {
   int work_size_min = 400;
   int work_size_max = 10000;
   int nthreads = 4;
-  b->Args({batch_size, work_size_min, work_size_max, nthreads});
+  b->Args({batch_size, work_size_min, work_size_max, nthreads,
+           static_cast<int>(ThreadPoolMode::PriorityQueue)});
+}
+
+/**
+ * @brief Short, per-sample-sized tasks on many threads - compares the contention of the single
+ *        priority queue with the per-worker deques of the work-stealing mode.
+ */
+static void ThreadPoolModeArgs(benchmark::internal::Benchmark *b) {
+  int batch_size = 256;
+  int work_size_min = 100;
+  int work_size_max = 2000;
+  for (int mode : { static_cast<int>(ThreadPoolMode::PriorityQueue),
+                    static_cast<int>(ThreadPoolMode::WorkStealing) }) {
+    for (int nthreads : {8, 32, 64}) {
+      b->Args({batch_size, work_size_min, work_size_max, nthreads, mode});
+    }
+  }
 }
 
 BENCHMARK_DEFINE_F(ThreadPoolBench, DoWorkWithID)(benchmark::State& st) {
@@ -32,8 +49,9 @@ BENCHMARK_DEFINE_F(ThreadPoolBench, DoWorkWithID)(benchmark::State& st) {
   int work_size_min = st.range(1);
   int work_size_max = st.range(2);
   int nthreads = st.range(3);
+  auto mode = static_cast<ThreadPoolMode>(st.range(4));
 
-  ThreadPool thread_pool(nthreads, 0, false);
+  ThreadPool thread_pool(nthreads, 0, false, mode);
 
   std::vector<uint8_t> data(2000, 0xFF);
   std::atomic<int64_t> total_count(0);
@@ -64,14 +82,21 @@ BENCHMARK_REGISTER_F(ThreadPoolBench, DoWorkWithID)->Iterations(1000)
 ->UseRealTime()
 ->Apply(ThreadPoolArgs);
 
+BENCHMARK_REGISTER_F(ThreadPoolBench, DoWorkWithID)
+->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ThreadPoolModeArgs);
+
 
 BENCHMARK_DEFINE_F(ThreadPoolBench, AddWork)(benchmark::State& st) {
   int batch_size = st.range(0);
   int work_size_min = st.range(1);
   int work_size_max = st.range(2);
   int nthreads = st.range(3);
+  auto mode = static_cast<ThreadPoolMode>(st.range(4));
 
-  ThreadPool thread_pool(nthreads, 0, false);
+  ThreadPool thread_pool(nthreads, 0, false, mode);
   std::vector<uint8_t> data(2000, 0xFF);
 
   std::atomic<int64_t> total_count(0);
@@ -103,4 +128,10 @@ BENCHMARK_REGISTER_F(ThreadPoolBench, AddWork)->Iterations(1000)
 ->UseRealTime()
 ->Apply(ThreadPoolArgs);
 
+BENCHMARK_REGISTER_F(ThreadPoolBench, AddWork)
+->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ThreadPoolModeArgs);
+
 }  // namespace dali
@@ -47,6 +47,9 @@ static CaseData cases[] = {
     CaseData{{7, 2, 4, 6, 10, 8, 4, 2}, {6, 4, 2, 0, 7, 5, 3, 1}},
     CaseData{{7, 2, 4, 6, 10, 8, 4, 2}, {5, 4, 2, 1, 7, 6, 3, 0}},
     CaseData{{7, 2, 4, 6, 10, 8, 4, 2}, {7, 5, 3, 2, 4, 0, 1, 6}},
+    // Fortran-order arrays
+    CaseData{{256, 256}, {1, 0}},
+    CaseData{{16, 32, 24}, {2, 1, 0}},
 };
 
 std::tuple<TensorShape<>, std::vector<int>> GetCase(int id) {
@@ -61,6 +64,12 @@ static void CustomArguments(benchmark::internal::Benchmark* b) {
   }
 }
 
+template <typename T>
+void TransposeTiledWhole(const TensorView<StorageCPU, T> &dst,
+                         const TensorView<StorageCPU, const T> &src, span<const int> perm) {
+  kernels::TransposeTiled(dst, src, perm);
+}
+
 }  // namespace
 
 template <typename T>
@@ -169,4 +178,33 @@ BENCHMARK_REGISTER_F(TransposeFixture, CompactUint16Test)->Apply(CustomArguments
 BENCHMARK_REGISTER_F(TransposeFixture, CompactIntTest)->Apply(CustomArguments);
 BENCHMARK_REGISTER_F(TransposeFixture, CompactDoubleTest)->Apply(CustomArguments);
 
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, TiledUint8Test, uint8_t)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeTiledWhole<uint8_t>>();
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, TiledUint16Test, uint16_t)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeTiledWhole<uint16_t>>();
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, TiledIntTest, int)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeTiledWhole<int>>();
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, TiledDoubleTest, double)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeTiledWhole<double>>();
+  }
+}
+
+BENCHMARK_REGISTER_F(TransposeFixture, TiledUint8Test)->Apply(CustomArguments);
+BENCHMARK_REGISTER_F(TransposeFixture, TiledUint16Test)->Apply(CustomArguments);
+BENCHMARK_REGISTER_F(TransposeFixture, TiledIntTest)->Apply(CustomArguments);
+BENCHMARK_REGISTER_F(TransposeFixture, TiledDoubleTest)->Apply(CustomArguments);
+
 }  // namespace dali
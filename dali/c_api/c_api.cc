@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include "dali/core/cuda_stream.h"
 #include "dali/core/format.h"
@@ -35,10 +36,40 @@ namespace {
 
 bool dali_initialized = false;
 
+/**
+ * @brief Creates an owner for the borrowed memory, which invokes `release` when the last
+ *        of the buffers sharing it is dropped by the pipeline
+ */
+std::shared_ptr<void> ReleaseToken(daliExternalInputReleaseCallback release, void *release_arg) {
+  return std::shared_ptr<void>(nullptr, [release, release_arg](void *) {
+    if (release)
+      release(release_arg);
+  });
+}
+
+/**
+ * @brief Wraps `ptr` in a shared pointer; if `owner` is not empty, it is kept alive as long as
+ *        the result is
+ */
+std::shared_ptr<void> BorrowedPtr(const void *ptr, const std::shared_ptr<void> &owner) {
+  // We cast away the const from data_ptr, as there is no other way of passing it to the
+  // TensorList, as we must also set the shape and type metadata.
+  // It is passed further as const TensorList, so it's data cannot be modified.
+  auto *mutable_ptr = const_cast<void *>(ptr);
+  if (owner)
+    return std::shared_ptr<void>(owner, mutable_ptr);
+  return std::shared_ptr<void>(mutable_ptr, [](void *) {});
+}
+
+/**
+ * @param owner If not empty, the data is shared with the ExternalSource instead of copied and
+ *              the reference to the owner is kept until the pipeline is done with the data
+ */
 template<typename Backend>
 void SetExternalInput(daliPipelineHandle *pipe_handle, const char *name, const void *data_ptr,
                       dali_data_type_t data_type, const int64_t *shapes, int sample_dim,
-                      const char *layout_str, cudaStream_t stream = 0, unsigned int flags = 0) {
+                      const char *layout_str, cudaStream_t stream = 0, unsigned int flags = 0,
+                      const std::shared_ptr<void> &owner = {}) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   std::vector<int64_t> shapes_tmp(shapes, shapes + sample_dim * pipeline->batch_size());
   dali::TensorListShape<> tl_shape(std::move(shapes_tmp), pipeline->batch_size(), sample_dim);
@@ -49,24 +80,28 @@ void SetExternalInput(daliPipelineHandle *pipe_handle, const char *name, const v
   dali::TensorList<Backend> data;
   const auto &type_info = dali::TypeTable::GetTypeInfo(static_cast<dali::DALIDataType>(data_type));
   auto elem_sizeof = type_info.size();
-  // We cast away the const from data_ptr, as there is no other way of passing it to the
-  // TensorList, as we must also set the shape and type metadata.
-  // It is passed further as const TensorList, so it's data cannot be modified.
   data.set_pinned(flags & DALI_ext_pinned);
-  data.ShareData(const_cast<void *>(data_ptr), tl_shape.num_elements() * elem_sizeof);
+  data.ShareData(BorrowedPtr(data_ptr, owner), tl_shape.num_elements() * elem_sizeof,
+                 dali::TensorListShape<>{}, dali::TypeInfo::Create<dali::NoType>());
   data.Resize(tl_shape, type_info);
   data.SetLayout(layout);
   pipeline->SetExternalInput(name, data, stream,
                              flags & DALI_ext_force_sync,
-                             flags & DALI_use_copy_kernel);
+                             flags & DALI_use_copy_kernel,
+                             owner != nullptr);
 }
 
 
+/**
+ * @param owner If not empty, the data is shared with the ExternalSource instead of copied and
+ *              the reference to the owner is kept until the pipeline is done with the data
+ */
 template<typename Backend>
 void SetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                              const void *const *data_ptr, dali_data_type_t data_type,
                              const int64_t *shapes, int64_t sample_dim, const char *layout_str,
-                             cudaStream_t stream = 0, unsigned int flags = 0) {
+                             cudaStream_t stream = 0, unsigned int flags = 0,
+                             const std::shared_ptr<void> &owner = {}) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   std::vector<int64_t> shapes_tmp(shapes, shapes + sample_dim * pipeline->batch_size());
   dali::TensorListShape<> tl_shape(std::move(shapes_tmp), pipeline->batch_size(), sample_dim);
@@ -78,17 +113,16 @@ void SetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
   const auto &type_info = dali::TypeTable::GetTypeInfo(static_cast<dali::DALIDataType>(data_type));
   auto elem_sizeof = type_info.size();
   for (int i = 0; i < pipeline->batch_size(); i++) {
-    // We cast away the const from data_ptr, as there is no other way of passing it to the
-    // Tensor as we must also set the shape and type metadata.
-    // The vector that we pass to pipeline is const.
     data[i].set_pinned(flags & DALI_ext_pinned);
-    data[i].ShareData(const_cast<void *>(data_ptr[i]), tl_shape[i].num_elements() * elem_sizeof);
+    data[i].ShareData(BorrowedPtr(data_ptr[i], owner), tl_shape[i].num_elements() * elem_sizeof,
+                      dali::TensorShape<>{0}, dali::TypeInfo::Create<dali::NoType>());
     data[i].Resize(tl_shape[i], type_info);
     data[i].SetLayout(layout);
   }
   pipeline->SetExternalInput(name, data, stream,
                              flags & DALI_ext_force_sync,
-                             flags & DALI_use_copy_kernel);
+                             flags & DALI_use_copy_kernel,
+                             owner != nullptr);
 }
 
 dali::kernels::AllocType GetAllocType(device_type_t device_type, bool is_pinned) {
@@ -205,6 +239,28 @@ void daliSetExternalInputAsync(daliPipelineHandle *pipe_handle, const char *name
 }
 
 
+void daliSetExternalInputNoCopy(daliPipelineHandle *pipe_handle, const char *name,
+                                device_type_t device, const void *data_ptr,
+                                dali_data_type_t data_type, const int64_t *shapes,
+                                int sample_dim, const char *layout_str, cudaStream_t stream,
+                                unsigned int flags, daliExternalInputReleaseCallback release,
+                                void *release_arg) {
+  auto owner = ReleaseToken(release, release_arg);
+  switch (device) {
+    case device_type_t::CPU:
+      SetExternalInput<dali::CPUBackend>(pipe_handle, name, data_ptr, data_type, shapes, sample_dim,
+                                         layout_str, stream, flags, owner);
+      return;
+    case device_type_t::GPU:
+      SetExternalInput<dali::GPUBackend>(pipe_handle, name, data_ptr, data_type, shapes, sample_dim,
+                                         layout_str, stream, flags, owner);
+      return;
+    default:
+      DALI_FAIL(dali::make_string("Unknown device: ", device));
+  }
+}
+
+
 void daliSetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                                  device_type_t device, const void *const *data_ptr,
                                  dali_data_type_t data_type, const int64_t *shapes,
@@ -235,6 +291,29 @@ void daliSetExternalInputTensorsAsync(daliPipelineHandle *pipe_handle, const cha
 }
 
 
+void daliSetExternalInputTensorsNoCopy(daliPipelineHandle *pipe_handle, const char *name,
+                                       device_type_t device, const void *const *data_ptr,
+                                       dali_data_type_t data_type, const int64_t *shapes,
+                                       int64_t sample_dim, const char *layout_str,
+                                       cudaStream_t stream, unsigned int flags,
+                                       daliExternalInputReleaseCallback release,
+                                       void *release_arg) {
+  auto owner = ReleaseToken(release, release_arg);
+  switch (device) {
+    case device_type_t::CPU:
+      SetExternalInputTensors<dali::CPUBackend>(pipe_handle, name, data_ptr, data_type, shapes,
+                                                sample_dim, layout_str, stream, flags, owner);
+      return;
+    case device_type_t::GPU:
+      SetExternalInputTensors<dali::GPUBackend>(pipe_handle, name, data_ptr, data_type, shapes,
+                                                sample_dim, layout_str, stream, flags, owner);
+      return;
+    default:
+      DALI_FAIL(dali::make_string("Unknown device: ", device));
+  }
+}
+
+
 void daliRun(daliPipelineHandle *pipe_handle) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   pipeline->RunCPU();
@@ -515,7 +594,7 @@ void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetada
     stat.first.copy(op_meta.operator_name, op_name_size);
     op_meta.operator_name[op_name_size] = '\0';
 
-    auto num_outputs = stat.second.size();
+    auto num_outputs = stat.second.outputs.size();
     op_meta.out_num = num_outputs;
     op_meta.real_size = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
     op_meta.max_real_size = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
@@ -523,12 +602,19 @@ void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetada
     op_meta.max_reserved = static_cast<size_t*>(malloc(sizeof(size_t) * num_outputs));
 
     for (size_t j = 0; j < num_outputs; ++j) {
-      const auto &entry = stat.second[j];
+      const auto &entry = stat.second.outputs[j];
       op_meta.real_size[j] = entry.real_size;
       op_meta.max_real_size[j] = entry.max_real_size;
       op_meta.reserved[j] = entry.reserved;
       op_meta.max_reserved[j] = entry.max_reserved;
     }
+    const auto &timing = stat.second.timing;
+    op_meta.iterations = timing.iterations;
+    op_meta.min_time = timing.min_time;
+    op_meta.mean_time = timing.mean_time;
+    op_meta.p50_time = timing.p50_time;
+    op_meta.p99_time = timing.p99_time;
+    op_meta.samples_per_sec = timing.samples_per_sec;
     ++i;
   }
 }
@@ -543,3 +629,32 @@ void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta, size_t operat
   }
   free(operator_meta);
 }
+
+void daliGetExecutorStageMetadata(daliPipelineHandle* pipe_handle, dali_executor_stage_t stage,
+                                  daliExecutorStageMetadata *stage_meta) {
+  DALI_ENFORCE(stage_meta, "Provided pointer to meta cannot be NULL.");
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  dali::OpType op_type;
+  switch (stage) {
+    case DALI_STAGE_CPU:
+      op_type = dali::OpType::CPU;
+      break;
+    case DALI_STAGE_MIXED:
+      op_type = dali::OpType::MIXED;
+      break;
+    case DALI_STAGE_GPU:
+      op_type = dali::OpType::GPU;
+      break;
+    default:
+      DALI_FAIL(dali::make_string("Unknown executor stage: ", static_cast<int>(stage)));
+  }
+  auto stats = pipeline->GetStageTimingStats(op_type);
+  stage_meta->iterations = stats.iterations;
+  stage_meta->mean_queue_wait = stats.mean_queue_wait;
+  stage_meta->max_queue_wait = stats.max_queue_wait;
+  stage_meta->mean_run_time = stats.mean_run_time;
+  stage_meta->samples_per_sec = stats.samples_per_sec;
+  stage_meta->thread_pool_utilization = stats.thread_pool_utilization;
+  stage_meta->op_overlap = stats.op_overlap;
+  stage_meta->max_concurrent_ops = stats.max_concurrent_ops;
+}
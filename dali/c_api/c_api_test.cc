@@ -469,8 +469,26 @@ TYPED_TEST(CApiTest, TestExecutorMeta) {
     for (size_t j = 0; j < meta_entry.out_num; ++j) {
       EXPECT_LE(meta_entry.real_size[j], meta_entry.reserved[j]);
     }
+    EXPECT_GE(meta_entry.iterations, 1);
+    EXPECT_LE(meta_entry.min_time, meta_entry.p50_time);
+    EXPECT_LE(meta_entry.p50_time, meta_entry.p99_time);
+    EXPECT_GT(meta_entry.samples_per_sec, 0);
   }
   daliFreeExecutorMetadata(meta, N);
+
+  for (auto stage : {DALI_STAGE_CPU, DALI_STAGE_MIXED, DALI_STAGE_GPU}) {
+    daliExecutorStageMetadata stage_meta;
+    daliGetExecutorStageMetadata(&handle, stage, &stage_meta);
+    EXPECT_GE(stage_meta.iterations, 1) << "stage " << stage;
+    EXPECT_GE(stage_meta.mean_run_time, 0);
+    EXPECT_GE(stage_meta.max_queue_wait, stage_meta.mean_queue_wait);
+    if (stage == DALI_STAGE_CPU) {
+      EXPECT_GT(stage_meta.op_overlap, 0);
+      EXPECT_EQ(stage_meta.max_concurrent_ops, 1);
+    } else {
+      EXPECT_EQ(stage_meta.max_concurrent_ops, 0);
+    }
+  }
 }
 
 TYPED_TEST(CApiTest, UseCopyKernel) {
@@ -0,0 +1,291 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include "dali/core/host_memory_pool.h"
+#include "dali/core/util.h"
+
+namespace dali {
+
+namespace {
+
+// The smallest size class; the next ones grow by 1/4 of the power of 2 below
+constexpr size_t kMinBlockSize = 256;
+constexpr int kMinBlockLog2 = 8;
+static_assert(kMinBlockSize == (size_t(1) << kMinBlockLog2), "Inconsistent constants");
+
+constexpr int SizeClassOf(size_t bytes) {
+  return bytes <= kMinBlockSize
+    ? 0
+    : 1 + (ilog2(bytes - 1) - kMinBlockLog2) * 4 +
+      static_cast<int>(((bytes - 1) - (size_t(1) << ilog2(bytes - 1))) >> (ilog2(bytes - 1) - 2));
+}
+
+constexpr size_t SizeOfClass(int size_class) {
+  return size_class == 0
+    ? kMinBlockSize
+    : (size_t(1) << (kMinBlockLog2 + (size_class - 1) / 4)) +
+      ((size_class - 1) % 4 + 1) * (size_t(1) << (kMinBlockLog2 + (size_class - 1) / 4 - 2));
+}
+
+constexpr int kNumClasses = SizeClassOf(HostMemoryPool::kMaxCachedSize) + 1;
+constexpr int kUncached = -1;
+
+static_assert(SizeOfClass(SizeClassOf(HostMemoryPool::kMaxCachedSize)) ==
+              HostMemoryPool::kMaxCachedSize, "kMaxCachedSize must be the size of a class");
+static_assert(SizeOfClass(SizeClassOf(257)) == 320, "Unexpected size class");
+static_assert(SizeOfClass(SizeClassOf(640)) == 640, "Unexpected size class");
+
+// Blocks up to this size are cached per thread, up to kThreadCacheBlocks blocks of each class
+constexpr size_t kMaxThreadCachedSize = 256 << 10;
+constexpr int kThreadCacheClasses = SizeClassOf(kMaxThreadCachedSize) + 1;
+constexpr int kThreadCacheBlocks = 16;
+
+constexpr uint32_t kBlockMagic = 0xDA11B10C;
+
+/**
+ * @brief Precedes each block returned to the user; padded to kAlignment
+ */
+struct BlockHeader {
+  uint32_t magic;
+  int32_t size_class;
+  size_t block_size;
+};
+
+static_assert(sizeof(BlockHeader) <= HostMemoryPool::kAlignment, "Block header too large");
+
+inline BlockHeader *GetHeader(void *user_ptr) {
+  return reinterpret_cast<BlockHeader *>(static_cast<char *>(user_ptr) -
+                                         HostMemoryPool::kAlignment);
+}
+
+inline void *GetUserPtr(void *block) {
+  return static_cast<char *>(block) + HostMemoryPool::kAlignment;
+}
+
+size_t GetCapacityFromEnv() {
+  size_t capacity = size_t(1) << 30;
+  if (const char *env = std::getenv("DALI_HOST_POOL_CAPACITY_MB")) {
+    try {
+      capacity = static_cast<size_t>(std::stoull(env)) << 20;
+    } catch (...) {
+      // keep the default
+    }
+  }
+  return capacity;
+}
+
+}  // namespace
+
+struct HostMemoryPool::ThreadCache {
+  struct Bin {
+    int count = 0;
+    void *blocks[kThreadCacheBlocks];
+  };
+  Bin bins[kThreadCacheClasses];
+
+  ~ThreadCache();
+};
+
+namespace {
+
+thread_local HostMemoryPool::ThreadCache tls_cache;
+// Set when tls_cache is destroyed - memory can still be freed by destructors of other
+// thread-local objects, which must not use the cache anymore
+thread_local bool tls_cache_destroyed = false;
+
+}  // namespace
+
+HostMemoryPool::ThreadCache::~ThreadCache() {
+  tls_cache_destroyed = true;
+  HostMemoryPool::instance().FlushThreadCache(*this);
+}
+
+HostMemoryPool &HostMemoryPool::instance() {
+  // never destroyed - the caches of the threads which outlive static destructors use it
+  static HostMemoryPool *pool = new HostMemoryPool();
+  return *pool;
+}
+
+HostMemoryPool::HostMemoryPool()
+: shared_(new SharedBin[kNumClasses]), capacity_(GetCapacityFromEnv()) {}
+
+size_t HostMemoryPool::BlockSize(size_t bytes) {
+  return bytes > kMaxCachedSize ? bytes : SizeOfClass(SizeClassOf(bytes));
+}
+
+void *HostMemoryPool::SystemAllocate(int size_class, size_t block_size) noexcept {
+  void *block = nullptr;
+  if (posix_memalign(&block, kAlignment, block_size + kAlignment) != 0)
+    return nullptr;
+  auto *header = static_cast<BlockHeader *>(block);
+  header->magic = kBlockMagic;
+  header->size_class = size_class;
+  header->block_size = block_size;
+  counters_.system_allocations.fetch_add(1, std::memory_order_relaxed);
+  return block;
+}
+
+void HostMemoryPool::SystemDeallocate(void *block) noexcept {
+  counters_.system_deallocations.fetch_add(1, std::memory_order_relaxed);
+  free(block);
+}
+
+bool HostMemoryPool::ReserveCache(size_t bytes) noexcept {
+  int64_t capacity = capacity_.load(std::memory_order_relaxed);
+  int64_t cached = bytes_cached_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  if (cached > capacity) {
+    bytes_cached_.fetch_sub(bytes, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void HostMemoryPool::AddInUse(int64_t bytes) noexcept {
+  int64_t in_use = counters_.bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64_t peak = counters_.peak_bytes_in_use.load(std::memory_order_relaxed);
+  while (in_use > peak &&
+         !counters_.peak_bytes_in_use.compare_exchange_weak(peak, in_use,
+                                                            std::memory_order_relaxed)) {}
+}
+
+void *HostMemoryPool::Allocate(size_t bytes) noexcept {
+  counters_.allocations.fetch_add(1, std::memory_order_relaxed);
+  if (bytes > kMaxCachedSize) {
+    void *block = SystemAllocate(kUncached, bytes);
+    if (!block)
+      return nullptr;
+    AddInUse(bytes);
+    return GetUserPtr(block);
+  }
+
+  int size_class = SizeClassOf(bytes);
+  size_t block_size = SizeOfClass(size_class);
+  void *block = nullptr;
+  if (size_class < kThreadCacheClasses && !tls_cache_destroyed) {
+    auto &bin = tls_cache.bins[size_class];
+    if (bin.count > 0) {
+      block = bin.blocks[--bin.count];
+      counters_.thread_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if (!block) {
+    auto &bin = shared_[size_class];
+    std::lock_guard<std::mutex> guard(bin.mutex);
+    if (!bin.blocks.empty()) {
+      block = bin.blocks.back();
+      bin.blocks.pop_back();
+      counters_.pool_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if (block) {
+    bytes_cached_.fetch_sub(block_size, std::memory_order_relaxed);
+  } else {
+    block = SystemAllocate(size_class, block_size);
+    if (!block)
+      return nullptr;
+  }
+  AddInUse(block_size);
+  return GetUserPtr(block);
+}
+
+void HostMemoryPool::Deallocate(void *ptr) noexcept {
+  if (!ptr)
+    return;
+  BlockHeader *header = GetHeader(ptr);
+  assert(header->magic == kBlockMagic && "The block was not allocated by HostMemoryPool");
+  int size_class = header->size_class;
+  size_t block_size = header->block_size;
+  void *block = header;
+  counters_.deallocations.fetch_add(1, std::memory_order_relaxed);
+  counters_.bytes_in_use.fetch_sub(block_size, std::memory_order_relaxed);
+
+  if (size_class == kUncached || !ReserveCache(block_size)) {
+    SystemDeallocate(block);
+    return;
+  }
+  if (size_class < kThreadCacheClasses && !tls_cache_destroyed) {
+    auto &bin = tls_cache.bins[size_class];
+    if (bin.count < kThreadCacheBlocks) {
+      bin.blocks[bin.count++] = block;
+      return;
+    }
+  }
+  PushShared(size_class, block);
+}
+
+void HostMemoryPool::PushShared(int size_class, void *block) noexcept {
+  auto &bin = shared_[size_class];
+  std::lock_guard<std::mutex> guard(bin.mutex);
+  try {
+    bin.blocks.push_back(block);
+  } catch (...) {
+    bytes_cached_.fetch_sub(SizeOfClass(size_class), std::memory_order_relaxed);
+    SystemDeallocate(block);
+  }
+}
+
+void HostMemoryPool::FlushThreadCache(ThreadCache &cache) noexcept {
+  for (int size_class = 0; size_class < kThreadCacheClasses; size_class++) {
+    auto &bin = cache.bins[size_class];
+    while (bin.count > 0)
+      PushShared(size_class, bin.blocks[--bin.count]);
+  }
+}
+
+void HostMemoryPool::TrimShared(size_t target_bytes) {
+  // free the largest blocks first
+  for (int size_class = kNumClasses - 1; size_class >= 0; size_class--) {
+    if (bytes_cached_.load(std::memory_order_relaxed) <= static_cast<int64_t>(target_bytes))
+      break;
+    size_t block_size = SizeOfClass(size_class);
+    auto &bin = shared_[size_class];
+    std::lock_guard<std::mutex> guard(bin.mutex);
+    while (!bin.blocks.empty() &&
+           bytes_cached_.load(std::memory_order_relaxed) > static_cast<int64_t>(target_bytes)) {
+      SystemDeallocate(bin.blocks.back());
+      bin.blocks.pop_back();
+      bytes_cached_.fetch_sub(block_size, std::memory_order_relaxed);
+    }
+  }
+}
+
+void HostMemoryPool::SetCapacity(size_t bytes) {
+  capacity_.store(bytes, std::memory_order_relaxed);
+  TrimShared(bytes);
+}
+
+void HostMemoryPool::ReleaseCached() {
+  if (!tls_cache_destroyed)
+    FlushThreadCache(tls_cache);
+  TrimShared(0);
+}
+
+HostMemoryPoolStats HostMemoryPool::GetStats() const {
+  HostMemoryPoolStats stats;
+  stats.allocations = counters_.allocations.load(std::memory_order_relaxed);
+  stats.deallocations = counters_.deallocations.load(std::memory_order_relaxed);
+  stats.thread_cache_hits = counters_.thread_cache_hits.load(std::memory_order_relaxed);
+  stats.pool_hits = counters_.pool_hits.load(std::memory_order_relaxed);
+  stats.system_allocations = counters_.system_allocations.load(std::memory_order_relaxed);
+  stats.system_deallocations = counters_.system_deallocations.load(std::memory_order_relaxed);
+  stats.bytes_in_use = counters_.bytes_in_use.load(std::memory_order_relaxed);
+  stats.peak_bytes_in_use = counters_.peak_bytes_in_use.load(std::memory_order_relaxed);
+  stats.bytes_cached = bytes_cached_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace dali
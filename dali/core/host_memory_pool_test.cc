@@ -0,0 +1,176 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "dali/core/host_memory_pool.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Sets the capacity of the pool for the duration of a test and releases the cache after
+ */
+class PoolCapacityGuard {
+ public:
+  explicit PoolCapacityGuard(size_t capacity)
+  : old_capacity_(HostMemoryPool::instance().Capacity()) {
+    HostMemoryPool::instance().ReleaseCached();
+    HostMemoryPool::instance().SetCapacity(capacity);
+  }
+  ~PoolCapacityGuard() {
+    HostMemoryPool::instance().ReleaseCached();
+    HostMemoryPool::instance().SetCapacity(old_capacity_);
+  }
+
+ private:
+  size_t old_capacity_;
+};
+
+}  // namespace
+
+TEST(HostMemoryPool, BlockSize) {
+  EXPECT_EQ(HostMemoryPool::BlockSize(0), 256u);
+  EXPECT_EQ(HostMemoryPool::BlockSize(1), 256u);
+  EXPECT_EQ(HostMemoryPool::BlockSize(256), 256u);
+  EXPECT_EQ(HostMemoryPool::BlockSize(257), 320u);
+  EXPECT_EQ(HostMemoryPool::BlockSize(1000), 1024u);
+  EXPECT_EQ(HostMemoryPool::BlockSize(1025), 1280u);
+  for (size_t size = 1; size < (size_t(1) << 24); size = size * 3 / 2 + 1) {
+    size_t block = HostMemoryPool::BlockSize(size);
+    EXPECT_GE(block, size);
+    EXPECT_LE(block, std::max<size_t>(256, size + size / 4 + 1)) << size;
+  }
+  size_t huge = HostMemoryPool::kMaxCachedSize + 1;
+  EXPECT_EQ(HostMemoryPool::BlockSize(huge), huge);
+}
+
+TEST(HostMemoryPool, Reuse) {
+  PoolCapacityGuard guard(64 << 20);
+  auto &pool = HostMemoryPool::instance();
+
+  // small blocks are reused by the thread cache, large ones - by the shared cache
+  for (size_t size : { size_t(100), size_t(5000), size_t(3) << 20 }) {
+    void *p = pool.Allocate(size);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % HostMemoryPool::kAlignment, 0u);
+    memset(p, 0xAB, size);
+    pool.Deallocate(p);
+
+    auto before = pool.GetStats();
+    // a request of a slightly different size, within the same size class
+    void *q = pool.Allocate(size - 1);
+    auto after = pool.GetStats();
+    EXPECT_EQ(q, p);
+    EXPECT_EQ(after.system_allocations, before.system_allocations);
+    EXPECT_EQ(after.thread_cache_hits + after.pool_hits,
+              before.thread_cache_hits + before.pool_hits + 1);
+    EXPECT_EQ(after.bytes_cached, before.bytes_cached -
+                                  static_cast<int64_t>(HostMemoryPool::BlockSize(size)));
+    pool.Deallocate(q);
+  }
+}
+
+TEST(HostMemoryPool, Capacity) {
+  PoolCapacityGuard guard(1 << 20);
+  auto &pool = HostMemoryPool::instance();
+
+  std::vector<void *> blocks;
+  for (int i = 0; i < 8; i++)
+    blocks.push_back(pool.Allocate(300 << 10));
+  auto before = pool.GetStats();
+  for (void *p : blocks)
+    pool.Deallocate(p);
+  auto after = pool.GetStats();
+  // only 3 blocks of 320 KiB fit in 1 MiB
+  EXPECT_LE(after.bytes_cached, 1 << 20);
+  EXPECT_EQ(after.system_deallocations - before.system_deallocations, 5);
+
+  pool.SetCapacity(0);
+  EXPECT_EQ(pool.GetStats().bytes_cached, 0);
+  void *p = pool.Allocate(1000);
+  pool.Deallocate(p);
+  EXPECT_EQ(pool.GetStats().bytes_cached, 0);
+}
+
+TEST(HostMemoryPool, Uncached) {
+  PoolCapacityGuard guard(64 << 20);
+  auto &pool = HostMemoryPool::instance();
+  auto before = pool.GetStats();
+  void *p = pool.Allocate(HostMemoryPool::kMaxCachedSize + 1);
+  if (!p)
+    GTEST_SKIP() << "Not enough memory";
+  EXPECT_EQ(pool.GetStats().bytes_in_use - before.bytes_in_use,
+            static_cast<int64_t>(HostMemoryPool::kMaxCachedSize + 1));
+  pool.Deallocate(p);
+  auto after = pool.GetStats();
+  EXPECT_EQ(after.bytes_cached, before.bytes_cached);
+  EXPECT_EQ(after.bytes_in_use, before.bytes_in_use);
+}
+
+TEST(HostMemoryPool, MultiThreaded) {
+  PoolCapacityGuard guard(256 << 20);
+  auto &pool = HostMemoryPool::instance();
+  auto before = pool.GetStats();
+
+  // blocks are allocated by one thread and freed by another
+  constexpr int kThreads = 4, kIters = 2000;
+  std::vector<std::vector<void *>> handoff(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(t);
+      std::uniform_int_distribution<size_t> size_dist(1, 1 << 20);
+      std::vector<std::pair<uint8_t *, size_t>> live;
+      for (int i = 0; i < kIters; i++) {
+        size_t size = size_dist(rng) >> (rng() % 12);
+        auto *p = static_cast<uint8_t *>(pool.Allocate(size));
+        ASSERT_NE(p, nullptr);
+        memset(p, t, size);
+        live.emplace_back(p, size);
+        if (live.size() > 16) {
+          size_t idx = rng() % live.size();
+          auto victim = live[idx];
+          live[idx] = live.back();
+          live.pop_back();
+          for (size_t j = 0; j < victim.second; j += 997)
+            ASSERT_EQ(victim.first[j], t);
+          pool.Deallocate(victim.first);
+        }
+      }
+      for (auto &l : live)
+        handoff[t].push_back(l.first);
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  for (auto &blocks : handoff)
+    for (void *p : blocks)
+      pool.Deallocate(p);
+
+  auto after = pool.GetStats();
+  EXPECT_EQ(after.allocations - before.allocations, kThreads * kIters);
+  EXPECT_EQ(after.deallocations - before.deallocations, kThreads * kIters);
+  EXPECT_EQ(after.bytes_in_use, before.bytes_in_use);
+  EXPECT_LT(after.system_allocations - before.system_allocations, kThreads * kIters / 2);
+}
+
+}  // namespace dali
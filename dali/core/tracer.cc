@@ -0,0 +1,261 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/core/tracer.h"
+
+namespace dali {
+namespace tracing {
+
+namespace detail {
+std::atomic<bool> tracing_enabled{false};
+}  // namespace detail
+
+namespace {
+
+/**
+ * @brief The ring buffer of a thread
+ *
+ * Only the owning thread writes the events, and only while `writing` is set. The events
+ * are read after the tracing is stopped and all the threads have cleared `writing`.
+ */
+struct ThreadTrace {
+  int tid = 0;
+  std::string name;
+  std::atomic<bool> writing{false};
+  /// the session the events belong to; the buffer is reset on the first event of a new session
+  int64_t session = -1;
+  std::vector<TraceEvent> events;
+  /// number of events recorded in the session, including the overwritten ones
+  int64_t count = 0;
+};
+
+struct Tracer {
+  /// guards the list of threads, their names and starting/stopping the tracing
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadTrace>> threads;
+  int next_tid = 0;
+  // written under the mutex before the tracing is enabled
+  int64_t session = 0;
+  int64_t events_per_thread = kDefaultEventsPerThread;
+  int64_t start_ns = 0;
+};
+
+Tracer &GetTracer() {
+  static Tracer tracer;
+  return tracer;
+}
+
+ThreadTrace &GetThreadTrace() {
+  // the tracer keeps a reference, so that the events outlive the thread
+  thread_local std::shared_ptr<ThreadTrace> trace = []() {
+    auto t = std::make_shared<ThreadTrace>();
+    auto &tracer = GetTracer();
+    std::lock_guard<std::mutex> lock(tracer.mutex);
+    t->tid = tracer.next_tid++;
+    tracer.threads.push_back(t);
+    return t;
+  }();
+  return *trace;
+}
+
+void StopTracingLocked(Tracer &tracer) {
+  detail::tracing_enabled.store(false);
+  // the threads register under the mutex, so none of the writers can be missing here
+  for (auto &thread : tracer.threads) {
+    while (thread->writing.load())
+      std::this_thread::yield();
+  }
+}
+
+void AppendEscaped(std::ostream &os, const char *s) {
+  for (; *s; s++) {
+    char c = *s;
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      os << buf;
+    } else {
+      os << c;
+    }
+  }
+}
+
+/**
+ * @brief Starts the tracing when DALI is loaded, if `DALI_TRACE_FILE` is set, and writes
+ *        the trace when the process exits.
+ */
+struct EnvTracing {
+  EnvTracing() {
+    const char *filename_env = std::getenv("DALI_TRACE_FILE");
+    if (filename_env && *filename_env) {
+      filename = filename_env;
+      StartTracing();
+    }
+  }
+
+  ~EnvTracing() {
+    if (filename.empty())
+      return;
+    try {
+      StopTracing();
+      WriteTrace(filename);
+    } catch (const std::exception &e) {
+      std::cerr << "Cannot write the trace to \"" << filename << "\": " << e.what() << std::endl;
+    }
+  }
+
+  std::string filename;
+};
+
+EnvTracing env_tracing;
+
+}  // namespace
+
+void StartTracing(int64_t events_per_thread) {
+  DALI_ENFORCE(events_per_thread > 0, "The number of events per thread must be positive.");
+  auto &tracer = GetTracer();
+  std::lock_guard<std::mutex> lock(tracer.mutex);
+  StopTracingLocked(tracer);
+  // forget the threads that have exited
+  tracer.threads.erase(std::remove_if(tracer.threads.begin(), tracer.threads.end(),
+                                      [](const std::shared_ptr<ThreadTrace> &t) {
+                                        return t.use_count() == 1;
+                                      }),
+                       tracer.threads.end());
+  tracer.session++;
+  tracer.events_per_thread = events_per_thread;
+  tracer.start_ns = Now();
+  detail::tracing_enabled.store(true);
+}
+
+void StopTracing() {
+  auto &tracer = GetTracer();
+  std::lock_guard<std::mutex> lock(tracer.mutex);
+  StopTracingLocked(tracer);
+}
+
+void RecordEvent(const char *name, const char *detail, int64_t iteration,
+                 int64_t begin, int64_t end) {
+  auto &trace = GetThreadTrace();
+  trace.writing.store(true);
+  // checked after setting `writing`, so that StopTracing either waits for this event
+  // or this event sees that the tracing is stopped
+  if (detail::tracing_enabled.load()) {
+    auto &tracer = GetTracer();
+    if (trace.session != tracer.session) {
+      trace.events.resize(tracer.events_per_thread);
+      trace.count = 0;
+      trace.session = tracer.session;
+    }
+    TraceEvent &event = trace.events[trace.count % trace.events.size()];
+    event.name = name;
+    if (detail) {
+      strncpy(event.detail, detail, kMaxDetailLength - 1);
+      event.detail[kMaxDetailLength - 1] = '\0';
+    } else {
+      event.detail[0] = '\0';
+    }
+    event.iteration = iteration;
+    event.begin_ns = begin - tracer.start_ns;
+    event.end_ns = end - tracer.start_ns;
+    trace.count++;
+  }
+  trace.writing.store(false, std::memory_order_release);
+}
+
+void SetThreadName(const std::string &name) {
+  auto &trace = GetThreadTrace();
+  std::lock_guard<std::mutex> lock(GetTracer().mutex);
+  trace.name = name;
+}
+
+std::string GetTraceJSON() {
+  auto &tracer = GetTracer();
+  std::lock_guard<std::mutex> lock(tracer.mutex);
+  DALI_ENFORCE(!IsTracingEnabled(), "The tracing must be stopped before reading the trace.");
+
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed;
+  int pid = getpid();
+  int64_t dropped = 0;
+  bool first = true;
+  auto separator = [&]() -> std::ostream & {
+    if (!first)
+      os << ",\n";
+    first = false;
+    return os;
+  };
+
+  os << "{\"traceEvents\": [\n";
+  for (auto &thread : tracer.threads) {
+    if (!thread->name.empty()) {
+      separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+                  << ", \"tid\": " << thread->tid << ", \"args\": {\"name\": \"";
+      AppendEscaped(os, thread->name.c_str());
+      os << "\"}}";
+    }
+    if (thread->session != tracer.session)
+      continue;
+    int64_t capacity = thread->events.size();
+    int64_t first_event = std::max<int64_t>(0, thread->count - capacity);
+    dropped += first_event;
+    for (int64_t i = first_event; i < thread->count; i++) {
+      const TraceEvent &event = thread->events[i % capacity];
+      separator() << "{\"name\": \"";
+      if (event.name)
+        AppendEscaped(os, event.name);
+      if (event.name && event.detail[0])
+        os << ' ';
+      AppendEscaped(os, event.detail);
+      os << "\", \"cat\": \"dali\", \"ph\": \"X\", \"pid\": " << pid
+         << ", \"tid\": " << thread->tid
+         << ", \"ts\": " << event.begin_ns * 1e-3
+         << ", \"dur\": " << (event.end_ns - event.begin_ns) * 1e-3;
+      if (event.iteration >= 0)
+        os << ", \"args\": {\"iteration\": " << event.iteration << "}";
+      os << "}";
+    }
+  }
+  os << "\n],\n\"displayTimeUnit\": \"ms\",\n"
+     << "\"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+  return os.str();
+}
+
+void WriteTrace(const std::string &filename) {
+  std::string json = GetTraceJSON();
+  std::ofstream f(filename);
+  DALI_ENFORCE(f.good(), "Cannot open \"" + filename + "\" for writing.");
+  f << json;
+  DALI_ENFORCE(f.good(), "Cannot write the trace to \"" + filename + "\".");
+}
+
+}  // namespace tracing
+}  // namespace dali
@@ -0,0 +1,123 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/tracer.h"
+
+namespace dali {
+
+namespace {
+
+int CountOccurrences(const std::string &s, const std::string &what) {
+  int n = 0;
+  for (size_t pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1))
+    n++;
+  return n;
+}
+
+}  // namespace
+
+TEST(TracerTest, TimeRange) {
+  { TimeRange tr("not traced"); }
+  tracing::StartTracing();
+  EXPECT_TRUE(tracing::IsTracingEnabled());
+  tracing::SetThreadName("test \"main\" thread");
+  {
+    TimeRange tr("op", std::string("my_op"), TimeRange::kBlue1, 42);
+  }
+  {
+    TimeRange tr(std::string("dynamic ") + "name");
+  }
+  tracing::StopTracing();
+  { TimeRange tr("not traced"); }
+  EXPECT_FALSE(tracing::IsTracingEnabled());
+
+  std::string json = tracing::GetTraceJSON();
+  EXPECT_EQ(CountOccurrences(json, "\"name\": \"op my_op\""), 1) << json;
+  EXPECT_EQ(CountOccurrences(json, "\"iteration\": 42"), 1) << json;
+  EXPECT_EQ(CountOccurrences(json, "\"name\": \"dynamic name\""), 1) << json;
+  EXPECT_EQ(CountOccurrences(json, "not traced"), 0) << json;
+  EXPECT_EQ(CountOccurrences(json, "test \\\"main\\\" thread"), 1) << json;
+}
+
+TEST(TracerTest, RingBuffer) {
+  tracing::StartTracing(10);
+  for (int i = 0; i < 25; i++)
+    TimeRange tr("event", TimeRange::kRed, i);
+  tracing::StopTracing();
+  std::string json = tracing::GetTraceJSON();
+  // only the most recent events are kept
+  EXPECT_EQ(CountOccurrences(json, "\"name\": \"event\""), 10);
+  EXPECT_EQ(CountOccurrences(json, "\"iteration\": 14}"), 0);
+  EXPECT_EQ(CountOccurrences(json, "\"iteration\": 15}"), 1);
+  EXPECT_EQ(CountOccurrences(json, "\"iteration\": 24}"), 1);
+  EXPECT_EQ(CountOccurrences(json, "\"dropped_events\": 15"), 1);
+
+  // restarting discards the previous events
+  tracing::StartTracing();
+  tracing::StopTracing();
+  EXPECT_EQ(CountOccurrences(tracing::GetTraceJSON(), "\"name\": \"event\""), 0);
+}
+
+TEST(TracerTest, MultipleThreads) {
+  const int num_threads = 4, num_events = 1000;
+  tracing::StartTracing();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([t]() {
+      tracing::SetThreadName("worker " + std::to_string(t));
+      for (int i = 0; i < num_events; i++)
+        TimeRange tr("work", TimeRange::kGreen, i);
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  // the events of the threads that have exited are kept
+  tracing::StopTracing();
+  std::string json = tracing::GetTraceJSON();
+  EXPECT_EQ(CountOccurrences(json, "\"name\": \"work\""), num_threads * num_events);
+  for (int t = 0; t < num_threads; t++)
+    EXPECT_EQ(CountOccurrences(json, "\"name\": \"worker " + std::to_string(t) + "\""), 1);
+}
+
+TEST(TracerTest, StopWhileRecording) {
+  std::atomic<bool> done{false};
+  std::thread recorder([&]() {
+    while (!done)
+      TimeRange tr("busy");
+  });
+  for (int i = 0; i < 20; i++) {
+    tracing::StartTracing(100);
+    std::this_thread::yield();
+    tracing::StopTracing();
+    EXPECT_NO_THROW(tracing::GetTraceJSON());
+  }
+  done = true;
+  recorder.join();
+  EXPECT_THROW({
+    tracing::StartTracing();
+    try {
+      tracing::GetTraceJSON();
+    } catch (...) {
+      tracing::StopTracing();
+      throw;
+    }
+  }, std::runtime_error);
+}
+
+}  // namespace dali
@@ -32,6 +32,29 @@ void Image::Decode() {
 }
 
 
+int Image::PrepareDecode(int max_tasks) {
+  DALI_ENFORCE(!decoded_, "Called decode for already decoded image");
+  DALI_ENFORCE(max_tasks > 0, "The number of decoding tasks must be positive");
+  num_tasks_ = PrepareDecodeImpl(decoded_image_, shape_, image_type_, encoded_image_, length_,
+                                 max_tasks);
+  if (num_tasks_ == 0)
+    return 1;  // the whole image is decoded by DecodeTask(0)
+  decoded_ = true;
+  return num_tasks_;
+}
+
+void Image::DecodeTask(int task_idx) {
+  if (num_tasks_ == 0) {
+    DALI_ENFORCE(task_idx == 0, make_string("Invalid decoding task: ", task_idx));
+    Decode();
+    return;
+  }
+  DALI_ENFORCE(task_idx >= 0 && task_idx < num_tasks_,
+               make_string("Invalid decoding task: ", task_idx));
+  DecodeTaskImpl(task_idx);
+}
+
+
 std::shared_ptr<uint8_t> Image::GetImage() const {
   DALI_ENFORCE(decoded_, "Image not decoded. Run Decode()");
   return decoded_image_;
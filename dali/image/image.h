@@ -40,6 +40,20 @@ class Image {
    */
   DLL_PUBLIC void Decode();
 
+  /**
+   * Prepares decoding split into tasks, which can be run concurrently with DecodeTask.
+   * The image is decoded once all the tasks are complete; images that can't be decoded
+   * in parts use a single task.
+   * @param max_tasks maximum number of tasks to split the decoding into
+   * @return number of tasks
+   */
+  DLL_PUBLIC int PrepareDecode(int max_tasks);
+
+  /**
+   * Runs one of the tasks returned by PrepareDecode
+   */
+  DLL_PUBLIC void DecodeTask(int task_idx);
+
   /**
    * Returns pointer to decoded image. Decode(...) has to be called
    * prior to calling this function
@@ -119,6 +133,24 @@ class Image {
   virtual std::pair<std::shared_ptr<uint8_t>, Shape>
   DecodeImpl(DALIImageType image_type, const uint8_t *encoded_buffer, size_t length) const = 0;
 
+  /**
+   * Template method, that splits decoding into independent tasks, run with DecodeTaskImpl.
+   * The default implementation doesn't support it.
+   * @param decoded set to the (not yet populated) decoded image
+   * @param shape set to the shape of the decoded image
+   * @return number of tasks, at most `max_tasks`, or 0 if DecodeImpl should be used instead
+   */
+  virtual int PrepareDecodeImpl(std::shared_ptr<uint8_t> &decoded, Shape &shape,
+                                DALIImageType image_type, const uint8_t *encoded_buffer,
+                                size_t length, int max_tasks) {
+    return 0;
+  }
+
+  /**
+   * Template method. Decodes a part of the image prepared by PrepareDecodeImpl
+   */
+  virtual void DecodeTaskImpl(int task_idx) {}
+
   /**
    * Template method. Reads image dimensions, without decoding the image
    * @param encoded_buffer encoded image data
@@ -142,6 +174,7 @@ class Image {
   const DALIImageType image_type_;
   bool decoded_ = false;
   bool use_fast_idct_ = false;
+  int num_tasks_ = 0;
   Shape shape_;
   CropWindowGenerator crop_window_generator_;
   std::shared_ptr<uint8_t> decoded_image_ = nullptr;
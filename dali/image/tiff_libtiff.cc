@@ -60,14 +60,18 @@
 
 #include "dali/image/tiff_libtiff.h"
 #include <tiffio.h>
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <memory>
 #include "dali/util/color_space_conversion_utils.h"
 #include "dali/core/convert.h"
+#include "dali/core/math_util.h"
 #include "dali/core/span.h"
+#include "dali/core/util.h"
 
 #define LIBTIFF_CALL_SUCCESS 1
 #define LIBTIFF_CALL(call)                                \
@@ -80,17 +84,25 @@
 
 namespace dali {
 
+namespace {
+
+// Minimum number of pixels decoded by a single task, so that splitting the decoding into tasks
+// pays off
+constexpr int64_t kMinDecodeTaskPixels = 1 << 18;
+
+}  // namespace
+
 namespace detail {
 
 // Extracted and adjusted from OpenCV's modules/imgcodecs/src/grfmt_tiff.cpp
 class BufDecoderHelper {
  private:
-  span<const uint8_t> &buf_;
-  size_t &buf_pos_;
+  span<const uint8_t> buf_;
+  size_t buf_pos_ = 0;
 
  public:
-  BufDecoderHelper(span<const uint8_t> &buf, size_t &buf_pos)
-      : buf_(buf), buf_pos_(buf_pos) {}
+  explicit BufDecoderHelper(span<const uint8_t> buf)
+      : buf_(buf) {}
 
   static tmsize_t read(thandle_t handle, void *buffer, tmsize_t n) {
     BufDecoderHelper *helper = reinterpret_cast<BufDecoderHelper *>(handle);
@@ -221,26 +233,58 @@ void ConvertLine(OutType *out_row, int64_t out_C, const InType *in_row, int64_t
   }
 }
 
+/**
+ * @brief Converts a line of 8-bit samples
+ */
+inline void DecodeLine(uint8_t *out_row, int64_t out_C, const uint8_t *in_row, int64_t in_C,
+                       int64_t roi_x, int64_t roi_w, DALIImageType out_img_type,
+                       std::vector<uint8_t> &tmp) {
+  ConvertLine(out_row, out_C, in_row, in_C, roi_x, roi_w, out_img_type);
+}
+
+/**
+ * @brief Converts a line of 16-bit samples; they're normalized to 8 bits first, as expected
+ *        by the color space conversion
+ */
+inline void DecodeLine(uint8_t *out_row, int64_t out_C, const uint16_t *in_row, int64_t in_C,
+                       int64_t roi_x, int64_t roi_w, DALIImageType out_img_type,
+                       std::vector<uint8_t> &tmp) {
+  tmp.resize(roi_w * in_C);
+  const uint16_t *in = in_row + roi_x * in_C;
+  for (int64_t i = 0; i < roi_w * in_C; i++)
+    tmp[i] = ConvertSatNorm<uint8_t>(in[i]);
+  ConvertLine(out_row, out_C, tmp.data(), in_C, 0, roi_w, out_img_type);
+}
+
 }  // namespace detail
 
-TiffImage_Libtiff::TiffImage_Libtiff(const uint8_t *encoded_buffer,
-                                     size_t length,
-                                     DALIImageType image_type)
-    : GenericImage(encoded_buffer, length, image_type),
-      buf_({encoded_buffer, static_cast<ptrdiff_t>(length)}),
-      buf_pos_(0) {
-  tif_.reset(
+TiffImage_Libtiff::TiffHandle TiffImage_Libtiff::Open() const {
+  TiffHandle tif = {
     TIFFClientOpen("", "r",
-                   reinterpret_cast<thandle_t>(
-                     new detail::BufDecoderHelper(buf_, buf_pos_)),
+                   reinterpret_cast<thandle_t>(new detail::BufDecoderHelper(buf_)),
                    &detail::BufDecoderHelper::read,
                    &detail::BufDecoderHelper::write,
                    &detail::BufDecoderHelper::seek,
                    &detail::BufDecoderHelper::close,
                    &detail::BufDecoderHelper::size,
                    &detail::BufDecoderHelper::map,
-                   /*unmap=*/0));
-  DALI_ENFORCE(tif_, "Cannot open TIFF file.");
+                   /*unmap=*/0),
+    &TIFFClose};
+  DALI_ENFORCE(tif, "Cannot open TIFF file.");
+  if (compression_ == COMPRESSION_JPEG && photometric_ == PHOTOMETRIC_YCBCR) {
+    // let libjpeg convert the data to RGB
+    LIBTIFF_CALL(
+      TIFFSetField(tif.get(), TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB));
+  }
+  return tif;
+}
+
+TiffImage_Libtiff::TiffImage_Libtiff(const uint8_t *encoded_buffer,
+                                     size_t length,
+                                     DALIImageType image_type)
+    : GenericImage(encoded_buffer, length, image_type),
+      buf_({encoded_buffer, static_cast<ptrdiff_t>(length)}) {
+  tif_ = Open();
 
   LIBTIFF_CALL(
     TIFFGetField(tif_.get(), TIFFTAG_IMAGELENGTH, &shape_[0]));
@@ -260,6 +304,28 @@ TiffImage_Libtiff::TiffImage_Libtiff(const uint8_t *encoded_buffer,
     TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_ROWSPERSTRIP, &rows_per_strip_));
   LIBTIFF_CALL(
     TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_COMPRESSION, &compression_));
+  LIBTIFF_CALL(
+    TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_PLANARCONFIG, &planar_config_));
+  LIBTIFF_CALL(
+    TIFFGetFieldDefaulted(tif_.get(), TIFFTAG_SAMPLEFORMAT, &sample_format_));
+  // no default value; keep PHOTOMETRIC_MINISBLACK if not present
+  TIFFGetField(tif_.get(), TIFFTAG_PHOTOMETRIC, &photometric_);
+
+  if (is_tiled_) {
+    LIBTIFF_CALL(
+      TIFFGetField(tif_.get(), TIFFTAG_TILEWIDTH, &chunk_w_));
+    LIBTIFF_CALL(
+      TIFFGetField(tif_.get(), TIFFTAG_TILELENGTH, &chunk_h_));
+    DALI_ENFORCE(chunk_w_ > 0 && chunk_h_ > 0, "Invalid TIFF tile size");
+  } else {
+    chunk_w_ = shape_[1];
+    chunk_h_ = std::min<int64_t>(rows_per_strip_, shape_[0]);
+  }
+
+  if (compression_ == COMPRESSION_JPEG && photometric_ == PHOTOMETRIC_YCBCR) {
+    LIBTIFF_CALL(
+      TIFFSetField(tif_.get(), TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB));
+  }
 }
 
 Image::Shape TiffImage_Libtiff::PeekShapeImpl(const uint8_t *encoded_buffer,
@@ -270,104 +336,193 @@ Image::Shape TiffImage_Libtiff::PeekShapeImpl(const uint8_t *encoded_buffer,
 }
 
 std::pair<std::shared_ptr<uint8_t>, Image::Shape>
-TiffImage_Libtiff::DecodeImpl(DALIImageType image_type,
-                              const uint8 *encoded_buffer,
-                              size_t length) const {
-  // This decoder only handles bitdepth=8, non-tiled and top-left orientation
-  // Other cases go to OpenCV's based decoder
-  if (!CanDecode(image_type)) {
-    return GenericImage::DecodeImpl(image_type, encoded_buffer, length);
-  }
-
+TiffImage_Libtiff::SetupDecodeRegion(DecodeRegion &region, DALIImageType image_type) const {
   const int64_t H = shape_[0], W = shape_[1], C = shape_[2];
 
   auto roi_generator = GetCropWindowGenerator();
 
-  int64_t roi_x = 0, roi_y = 0;
-  int64_t roi_h = H, roi_w = W;
+  region.y = 0;
+  region.x = 0;
+  region.h = H;
+  region.w = W;
   if (roi_generator) {
     auto roi = roi_generator({H, W}, "HW");
-    roi_y = roi.anchor[0];
-    roi_x = roi.anchor[1];
-    roi_h = roi.shape[0];
-    roi_w = roi.shape[1];
-    DALI_ENFORCE(roi_w > 0 && roi_w <= W);
-    DALI_ENFORCE(roi_h > 0 && roi_h <= H);
+    region.y = roi.anchor[0];
+    region.x = roi.anchor[1];
+    region.h = roi.shape[0];
+    region.w = roi.shape[1];
+    DALI_ENFORCE(region.w > 0 && region.w <= W);
+    DALI_ENFORCE(region.h > 0 && region.h <= H);
   }
 
-  int64_t out_C = C;
   switch (image_type) {
     case DALI_GRAY:
-      out_C = 1;
+      region.out_C = 1;
       break;
     case DALI_RGB:
     case DALI_BGR:
     case DALI_YCbCr:
-      out_C = 3;
+      region.out_C = 3;
       break;
     case DALI_ANY_DATA:
     default:
-      out_C = C;
+      region.out_C = C;
   }
+  region.image_type = image_type;
 
-  TensorShape<3> decoded_shape = {roi_h, roi_w, out_C};
+  TensorShape<3> decoded_shape = {region.h, region.w, region.out_C};
   const size_t decoded_size = volume(decoded_shape);
   std::shared_ptr<uint8_t> decoded_img_ptr{
     new uint8_t[decoded_size],
     [](uint8_t* ptr){ delete [] ptr; }
   };
+  region.out = decoded_img_ptr.get();
+
+  region.chunks.clear();
+  if (IsChunked()) {
+    const int64_t chunks_across = div_ceil(W, static_cast<uint64_t>(chunk_w_));
+    for (int64_t cy = region.y / chunk_h_; cy * chunk_h_ < region.y + region.h; cy++) {
+      for (int64_t cx = region.x / chunk_w_; cx * chunk_w_ < region.x + region.w; cx++)
+        region.chunks.push_back(cy * chunks_across + cx);
+    }
+  }
 
-  // TODO(janton): support different types in ImageDecoder
-  using InType = uint8_t;
-  using OutType = uint8_t;
-
-  // allocate memory for reading tif image
-  auto row_nbytes = TIFFScanlineSize(tif_.get());
-  DALI_ENFORCE(row_nbytes > 0);
+  return {decoded_img_ptr, decoded_shape};
+}
 
-  std::unique_ptr<InType, void(*)(void*)> row_buf{
-    static_cast<InType *>(_TIFFmalloc(row_nbytes)), _TIFFfree};
-  DALI_ENFORCE(row_buf.get() != nullptr, "Could not allocate memory");
-  memset(row_buf.get(), 0, row_nbytes);
+std::pair<std::shared_ptr<uint8_t>, Image::Shape>
+TiffImage_Libtiff::DecodeImpl(DALIImageType image_type,
+                              const uint8 *encoded_buffer,
+                              size_t length) const {
+  // Unsupported formats go to OpenCV's based decoder
+  if (!CanDecode(image_type)) {
+    return GenericImage::DecodeImpl(image_type, encoded_buffer, length);
+  }
 
+  DecodeRegion region;
+  auto decoded = SetupDecodeRegion(region, image_type);
+  if (IsChunked()) {
+    DecodeChunks(tif_.get(), region, 0, region.chunks.size());
+  } else {
+    DecodeScanlines(tif_.get(), region);
+  }
+  return decoded;
+}
 
-  const int64_t out_row_stride = roi_w * out_C;
-  InType * const row_in  = row_buf.get();
-  OutType * const img_out = decoded_img_ptr.get();
+int TiffImage_Libtiff::PrepareDecodeImpl(std::shared_ptr<uint8_t> &decoded, Image::Shape &shape,
+                                         DALIImageType image_type, const uint8_t *encoded_buffer,
+                                         size_t length, int max_tasks) {
+  if (!CanDecode(image_type) || !IsChunked())
+    return 0;
+  std::tie(decoded, shape) = SetupDecodeRegion(region_, image_type);
+  int64_t num_chunks = region_.chunks.size();
+  int64_t num_pixels = num_chunks * chunk_w_ * chunk_h_;
+  num_tasks_ = clamp<int64_t>(num_pixels / kMinDecodeTaskPixels, 1,
+                              std::min<int64_t>(max_tasks, num_chunks));
+  return num_tasks_;
+}
 
-  // Need to read sequentially since not all the images support random access
+void TiffImage_Libtiff::DecodeTaskImpl(int task_idx) {
+  int64_t num_chunks = region_.chunks.size();
+  int64_t begin = num_chunks * task_idx / num_tasks_;
+  int64_t end = num_chunks * (task_idx + 1) / num_tasks_;
+  if (task_idx == 0) {
+    DecodeChunks(tif_.get(), region_, begin, end);
+  } else {
+    // libtiff handles can't be used concurrently
+    auto tif = Open();
+    DecodeChunks(tif.get(), region_, begin, end);
+  }
+}
 
-  // From: http://www.libtiff.org/man/TIFFReadScanline.3t.html
-  // Compression algorithm does not support random access. Data was requested in a non-sequential
-  // order from a file that uses a compression algorithm and that has RowsPerStrip greater than one.
-  // That is, data in the image is stored in a compressed form, and with multiple rows packed into a
-  // strip. In this case, the library does not support random access to the data. The data should
-  // either be accessed sequentially, or the file should be converted so that each strip is made up
-  // of one row of data.
-  const bool allow_random_row_access =
-    (compression_ == COMPRESSION_NONE || rows_per_strip_ == 1);
+void TiffImage_Libtiff::DecodeChunks(TIFF *tif, const DecodeRegion &region,
+                                     int64_t begin, int64_t end) const {
+  if (bit_depth_ == 16) {
+    DecodeChunksImpl<uint16_t>(tif, region, begin, end);
+  } else {
+    DecodeChunksImpl<uint8_t>(tif, region, begin, end);
+  }
+}
 
-  // If random access is not allowed, need to read sequentially all previous rows
-  if (!allow_random_row_access) {
-    for (int64_t y = 0; y < roi_y; y++) {
-      LIBTIFF_CALL(
-        TIFFReadScanline(tif_.get(), row_in, y, 0));
+template <typename InType>
+void TiffImage_Libtiff::DecodeChunksImpl(TIFF *tif, const DecodeRegion &region,
+                                         int64_t begin, int64_t end) const {
+  const int64_t W = shape_[1], C = shape_[2];
+  const int64_t chunks_across = div_ceil(W, static_cast<uint64_t>(chunk_w_));
+
+  // allocate memory for reading a tile (or strip)
+  auto chunk_nbytes = is_tiled_ ? TIFFTileSize(tif) : TIFFStripSize(tif);
+  auto row_nbytes = is_tiled_ ? TIFFTileRowSize(tif) : TIFFScanlineSize(tif);
+  DALI_ENFORCE(chunk_nbytes > 0 && row_nbytes > 0);
+
+  std::unique_ptr<uint8_t, void(*)(void*)> chunk_buf{
+    static_cast<uint8_t *>(_TIFFmalloc(chunk_nbytes)), _TIFFfree};
+  DALI_ENFORCE(chunk_buf.get() != nullptr, "Could not allocate memory");
+  std::vector<uint8_t> tmp;
+
+  const int64_t out_row_stride = region.w * region.out_C;
+  for (int64_t i = begin; i < end; i++) {
+    uint32_t chunk = region.chunks[i];
+    auto nbytes = is_tiled_
+        ? TIFFReadEncodedTile(tif, chunk, chunk_buf.get(), chunk_nbytes)
+        : TIFFReadEncodedStrip(tif, chunk, chunk_buf.get(), chunk_nbytes);
+    DALI_ENFORCE(nbytes >= 0, make_string("Cannot decode TIFF ", is_tiled_ ? "tile " : "strip ",
+                                          chunk));
+
+    // the part of the tile (or strip) within the region of interest
+    const int64_t chunk_y = chunk / chunks_across * chunk_h_;
+    const int64_t chunk_x = chunk % chunks_across * chunk_w_;
+    const int64_t y0 = std::max(chunk_y, region.y);
+    const int64_t y1 = std::min(chunk_y + chunk_h_, region.y + region.h);
+    const int64_t x0 = std::max(chunk_x, region.x);
+    const int64_t x1 = std::min(chunk_x + chunk_w_, region.x + region.w);
+    for (int64_t y = y0; y < y1; y++) {
+      const InType *row_in =
+          reinterpret_cast<const InType *>(chunk_buf.get() + (y - chunk_y) * row_nbytes);
+      uint8_t *row_out =
+          region.out + (y - region.y) * out_row_stride + (x0 - region.x) * region.out_C;
+      detail::DecodeLine(row_out, region.out_C, row_in, C, x0 - chunk_x, x1 - x0,
+                         region.image_type, tmp);
     }
   }
+}
+
+void TiffImage_Libtiff::DecodeScanlines(TIFF *tif, const DecodeRegion &region) const {
+  const int64_t C = shape_[2];
+
+  // allocate memory for reading tif image
+  auto row_nbytes = TIFFScanlineSize(tif);
+  DALI_ENFORCE(row_nbytes > 0);
+
+  std::unique_ptr<uint8_t, void(*)(void*)> row_buf{
+    static_cast<uint8_t *>(_TIFFmalloc(row_nbytes)), _TIFFfree};
+  DALI_ENFORCE(row_buf.get() != nullptr, "Could not allocate memory");
+  memset(row_buf.get(), 0, row_nbytes);
+  std::vector<uint8_t> tmp;
 
-  for (int64_t y = 0; y < roi_h; y++) {
+  const int64_t out_row_stride = region.w * region.out_C;
+
+  // The uncompressed images and the ones with single-row strips allow random row access.
+  // The other ones are decoded by strips (see IsChunked).
+  for (int64_t y = 0; y < region.h; y++) {
     LIBTIFF_CALL(
-      TIFFReadScanline(tif_.get(), row_in, roi_y + y, 0));
-    OutType * const row_out = img_out + (y * out_row_stride);
-    detail::ConvertLine(row_out, out_C, row_in, C, roi_x, roi_w, image_type);
+      TIFFReadScanline(tif, row_buf.get(), region.y + y, 0));
+    uint8_t * const row_out = region.out + (y * out_row_stride);
+    if (bit_depth_ == 16) {
+      detail::DecodeLine(row_out, region.out_C, reinterpret_cast<const uint16_t *>(row_buf.get()),
+                         C, region.x, region.w, region.image_type, tmp);
+    } else {
+      detail::DecodeLine(row_out, region.out_C, row_buf.get(), C, region.x, region.w,
+                         region.image_type, tmp);
+    }
   }
-
-  return {decoded_img_ptr, decoded_shape};
 }
 
 bool TiffImage_Libtiff::CanDecode(DALIImageType image_type) const {
-  return !is_tiled_
-      && bit_depth_ == 8
+  return (bit_depth_ == 8 || bit_depth_ == 16)
+      && sample_format_ == SAMPLEFORMAT_UINT
+      && planar_config_ == PLANARCONFIG_CONTIG
+      && (photometric_ != PHOTOMETRIC_YCBCR || compression_ == COMPRESSION_JPEG)
       && orientation_ == ORIENTATION_TOPLEFT;
 }
 
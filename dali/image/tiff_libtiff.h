@@ -18,6 +18,7 @@
 #include <tiffio.h>
 #include <utility>
 #include <memory>
+#include <vector>
 #include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/image/generic_image.h"
@@ -33,12 +34,53 @@ class TiffImage_Libtiff : public GenericImage {
   std::pair<std::shared_ptr<uint8_t>, Image::Shape>
   DecodeImpl(DALIImageType image_type, const uint8_t *encoded_buffer, size_t length) const override;
 
+  int PrepareDecodeImpl(std::shared_ptr<uint8_t> &decoded, Image::Shape &shape,
+                        DALIImageType image_type, const uint8_t *encoded_buffer, size_t length,
+                        int max_tasks) override;
+
+  void DecodeTaskImpl(int task_idx) override;
+
   Image::Shape PeekShapeImpl(const uint8_t *encoded_buffer, size_t length) const override;
 
  private:
+  using TiffHandle = std::unique_ptr<TIFF, void (*)(TIFF *)>;
+
+  /**
+   * @brief The region of interest and the output it's decoded to
+   */
+  struct DecodeRegion {
+    int64_t y = 0, x = 0, h = 0, w = 0;
+    int64_t out_C = 0;
+    DALIImageType image_type = DALI_RGB;
+    uint8_t *out = nullptr;
+    /// indices of the tiles (or strips) that intersect the region of interest
+    std::vector<uint32_t> chunks;
+  };
+
+  TiffHandle Open() const;
+
+  /**
+   * @brief Whether the image is decoded by tiles (or strips) rather than by scanlines
+   *
+   * Tiles and compressed multi-row strips can be decoded independently, so only the ones
+   * that intersect the region of interest are read.
+   */
+  bool IsChunked() const {
+    return is_tiled_ || (compression_ != COMPRESSION_NONE && rows_per_strip_ > 1);
+  }
+
+  std::pair<std::shared_ptr<uint8_t>, Image::Shape>
+  SetupDecodeRegion(DecodeRegion &region, DALIImageType image_type) const;
+
+  void DecodeScanlines(TIFF *tif, const DecodeRegion &region) const;
+
+  void DecodeChunks(TIFF *tif, const DecodeRegion &region, int64_t begin, int64_t end) const;
+
+  template <typename InType>
+  void DecodeChunksImpl(TIFF *tif, const DecodeRegion &region, int64_t begin, int64_t end) const;
+
   span<const uint8_t> buf_;
-  size_t buf_pos_;
-  std::unique_ptr<TIFF, void (*)(TIFF *)> tif_ = {nullptr, &TIFFClose};
+  TiffHandle tif_ = {nullptr, &TIFFClose};
 
   TensorShape<3> shape_ = {0, 0, 0};
   bool is_tiled_ = false;
@@ -46,6 +88,15 @@ class TiffImage_Libtiff : public GenericImage {
   uint16_t orientation_ = ORIENTATION_TOPLEFT;
   uint32_t rows_per_strip_ = 0xFFFFFFFF;
   uint16_t compression_ = COMPRESSION_NONE;
+  uint16_t photometric_ = PHOTOMETRIC_MINISBLACK;
+  uint16_t planar_config_ = PLANARCONFIG_CONTIG;
+  uint16_t sample_format_ = SAMPLEFORMAT_UINT;
+  /// tile (or strip) size; strips span the whole width of the image
+  uint32_t chunk_w_ = 0, chunk_h_ = 0;
+
+  /// the decoding split into tasks by PrepareDecodeImpl
+  DecodeRegion region_;
+  int num_tasks_ = 0;
 };
 
 }  // namespace dali
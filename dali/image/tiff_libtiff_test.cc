@@ -0,0 +1,214 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <tiffio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "dali/image/tiff_libtiff.h"
+
+namespace dali {
+
+namespace {
+
+struct TiffTestImage {
+  int64_t H, W, C;
+  int bit_depth;
+  uint16_t compression;
+  uint32_t tile_w = 0, tile_h = 0;  // 0 - stripped image
+  uint32_t rows_per_strip = 0;
+};
+
+/**
+ * @brief The test pattern; 16-bit samples are scaled, so that they normalize to the same
+ *        8-bit values
+ */
+uint8_t TestPixel(int64_t y, int64_t x, int64_t c) {
+  return (y * 7 + x * 3 + c * 50) & 255;
+}
+
+template <typename T>
+void FillChunk(T *out, const TiffTestImage &img, int64_t y0, int64_t x0, int64_t h, int64_t w) {
+  const int scale = sizeof(T) == 2 ? 257 : 1;
+  for (int64_t y = y0; y < y0 + h; y++) {
+    for (int64_t x = x0; x < x0 + w; x++) {
+      for (int64_t c = 0; c < img.C; c++) {
+        // the tiles are padded beyond the edges of the image
+        *out++ = y < img.H && x < img.W ? TestPixel(y, x, c) * scale : 0;
+      }
+    }
+  }
+}
+
+template <typename T>
+void WriteTiffData(TIFF *tif, const TiffTestImage &img) {
+  if (img.tile_w) {
+    std::vector<T> tile(img.tile_w * img.tile_h * img.C);
+    uint32_t tile_idx = 0;
+    for (int64_t y = 0; y < img.H; y += img.tile_h) {
+      for (int64_t x = 0; x < img.W; x += img.tile_w) {
+        FillChunk(tile.data(), img, y, x, img.tile_h, img.tile_w);
+        ASSERT_GE(TIFFWriteEncodedTile(tif, tile_idx++, tile.data(), tile.size() * sizeof(T)), 0);
+      }
+    }
+  } else {
+    std::vector<T> strip(img.rows_per_strip * img.W * img.C);
+    uint32_t strip_idx = 0;
+    for (int64_t y = 0; y < img.H; y += img.rows_per_strip) {
+      int64_t h = std::min<int64_t>(img.rows_per_strip, img.H - y);
+      FillChunk(strip.data(), img, y, 0, h, img.W);
+      int64_t nbytes = h * img.W * img.C * sizeof(T);
+      ASSERT_GE(TIFFWriteEncodedStrip(tif, strip_idx++, strip.data(), nbytes), 0);
+    }
+  }
+}
+
+std::vector<uint8_t> EncodeTiff(const TiffTestImage &img) {
+  char name[] = "/tmp/dali_tiff_XXXXXX";
+  int fd = mkstemp(name);
+  EXPECT_GE(fd, 0);
+  close(fd);
+
+  TIFF *tif = TIFFOpen(name, "w");
+  EXPECT_NE(tif, nullptr);
+  TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, static_cast<uint32_t>(img.W));
+  TIFFSetField(tif, TIFFTAG_IMAGELENGTH, static_cast<uint32_t>(img.H));
+  TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, static_cast<uint16_t>(img.C));
+  TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, static_cast<uint16_t>(img.bit_depth));
+  TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, img.C == 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK);
+  TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+  TIFFSetField(tif, TIFFTAG_COMPRESSION, img.compression);
+  if (img.tile_w) {
+    TIFFSetField(tif, TIFFTAG_TILEWIDTH, img.tile_w);
+    TIFFSetField(tif, TIFFTAG_TILELENGTH, img.tile_h);
+  } else {
+    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, img.rows_per_strip);
+  }
+  if (img.bit_depth == 16)
+    WriteTiffData<uint16_t>(tif, img);
+  else
+    WriteTiffData<uint8_t>(tif, img);
+  TIFFClose(tif);
+
+  std::ifstream f(name, std::ios::binary);
+  std::vector<uint8_t> encoded{std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+  unlink(name);
+  return encoded;
+}
+
+CropWindow MakeCropWindow(int64_t y, int64_t x, int64_t h, int64_t w) {
+  CropWindow crop;
+  crop.SetAnchor({y, x});
+  crop.SetShape({h, w});
+  return crop;
+}
+
+/**
+ * @brief Decodes the crop window of the image, either at once or split into tasks,
+ *        and compares it with the test pattern
+ */
+void CheckTiffDecoding(const std::vector<uint8_t> &encoded, const TiffTestImage &desc,
+                       const CropWindow &crop, int max_tasks) {
+  TiffImage_Libtiff img(encoded.data(), encoded.size(), DALI_ANY_DATA);
+  ASSERT_TRUE(img.CanDecode(DALI_ANY_DATA));
+  img.SetCropWindow(crop);
+  if (max_tasks == 0) {
+    img.Decode();
+  } else {
+    int num_tasks = img.PrepareDecode(max_tasks);
+    ASSERT_GE(num_tasks, 1);
+    ASSERT_LE(num_tasks, max_tasks);
+    // any order
+    for (int t = num_tasks - 1; t >= 0; t--)
+      img.DecodeTask(t);
+  }
+
+  auto shape = img.GetShape();
+  ASSERT_EQ(shape, (TensorShape<3>{crop.shape[0], crop.shape[1], desc.C}));
+  const uint8_t *decoded = img.GetImage().get();
+  for (int64_t y = 0; y < shape[0]; y++) {
+    for (int64_t x = 0; x < shape[1]; x++) {
+      for (int64_t c = 0; c < shape[2]; c++) {
+        ASSERT_EQ(*decoded++, TestPixel(crop.anchor[0] + y, crop.anchor[1] + x, c))
+            << "at (" << y << ", " << x << ", " << c << "), tasks: " << max_tasks;
+      }
+    }
+  }
+}
+
+void CheckTiffDecoding(const TiffTestImage &desc) {
+  auto encoded = EncodeTiff(desc);
+  CropWindow crops[] = {
+    MakeCropWindow(0, 0, desc.H, desc.W),
+    MakeCropWindow(desc.H / 3, desc.W / 5, desc.H / 2, desc.W / 3),
+    MakeCropWindow(desc.H - 17, desc.W - 33, 17, 33),
+    MakeCropWindow(5, 7, 1, 1)
+  };
+  for (auto &crop : crops) {
+    for (int max_tasks : {0, 1, 5})
+      CheckTiffDecoding(encoded, desc, crop, max_tasks);
+  }
+}
+
+}  // namespace
+
+TEST(TiffLibtiffTest, Tiled) {
+  CheckTiffDecoding({700, 1100, 3, 8, COMPRESSION_LZW, 128, 64});
+  CheckTiffDecoding({250, 300, 1, 8, COMPRESSION_NONE, 64, 32});
+}
+
+TEST(TiffLibtiffTest, Tiled16Bit) {
+  CheckTiffDecoding({600, 900, 3, 16, COMPRESSION_LZW, 256, 256});
+}
+
+TEST(TiffLibtiffTest, Strips) {
+  CheckTiffDecoding({1000, 700, 3, 8, COMPRESSION_LZW, 0, 0, 16});
+  CheckTiffDecoding({301, 257, 3, 16, COMPRESSION_LZW, 0, 0, 7});
+  CheckTiffDecoding({301, 257, 1, 16, COMPRESSION_NONE, 0, 0, 10});
+}
+
+TEST(TiffLibtiffTest, SplitIntoTasks) {
+  TiffTestImage desc = {2048, 2048, 3, 8, COMPRESSION_LZW, 256, 256};
+  auto encoded = EncodeTiff(desc);
+  {
+    TiffImage_Libtiff img(encoded.data(), encoded.size(), DALI_RGB);
+    ASSERT_EQ(img.PrepareDecode(4), 4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+      threads.emplace_back([&img, t]() { img.DecodeTask(t); });
+    for (auto &thread : threads)
+      thread.join();
+    const uint8_t *decoded = img.GetImage().get();
+    for (int64_t y = 0; y < desc.H; y++) {
+      for (int64_t x = 0; x < desc.W; x++) {
+        for (int64_t c = 0; c < desc.C; c++)
+          ASSERT_EQ(*decoded++, TestPixel(y, x, c)) << "at (" << y << ", " << x << ", " << c << ")";
+      }
+    }
+  }
+  {
+    // small regions of interest are not split
+    TiffImage_Libtiff img(encoded.data(), encoded.size(), DALI_RGB);
+    img.SetCropWindow(MakeCropWindow(1000, 1000, 100, 100));
+    EXPECT_EQ(img.PrepareDecode(4), 1);
+  }
+}
+
+}  // namespace dali
@@ -18,6 +18,7 @@
 #include "dali/kernels/alloc.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/host_memory_pool.h"
 
 namespace dali {
 namespace kernels {
@@ -29,10 +30,13 @@ struct Allocator;
 template <>
 struct Allocator<AllocType::Host> {
   static void Deallocate(void *ptr, int device) noexcept {
-    free(ptr);
+    (void) device;
+    HostMemoryPool::instance().Deallocate(ptr);
   }
 
-  static void *Allocate(size_t bytes) noexcept { return malloc(bytes); }
+  static void *Allocate(size_t bytes) noexcept {
+    return HostMemoryPool::instance().Allocate(bytes);
+  }
 };
 
 template <>
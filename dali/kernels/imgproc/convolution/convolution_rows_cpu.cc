@@ -0,0 +1,98 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/convolution/convolution_rows_cpu.h"
+#include <algorithm>
+#include <cmath>
+#include "dali/core/cpu_features.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+void ConvolveRowsGeneric(float *out, const float *const *rows, const float *window,
+                         int window_size, int64_t length) {
+  // the accumulators of a block of outputs stay in registers/L1 across the whole window
+  constexpr int kBlock = 64;
+  float acc[kBlock];
+  for (int64_t j0 = 0; j0 < length; j0 += kBlock) {
+    int n = std::min<int64_t>(kBlock, length - j0);
+    for (int j = 0; j < n; j++)
+      acc[j] = 0;
+    for (int k = 0; k < window_size; k++) {
+      const float *row = rows[k] + j0;
+      float w = window[k];
+      for (int j = 0; j < n; j++)
+        acc[j] += w * row[j];
+    }
+    for (int j = 0; j < n; j++)
+      out[j0 + j] = acc[j];
+  }
+}
+
+#if DALI_CPU_X86
+
+DALI_TARGET_AVX2_FMA
+void ConvolveRowsAVX2(float *out, const float *const *rows, const float *window,
+                      int window_size, int64_t length) {
+  int64_t j = 0;
+  for (; j + 32 <= length; j += 32) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    for (int k = 0; k < window_size; k++) {
+      const float *row = rows[k] + j;
+      __m256 w = _mm256_set1_ps(window[k]);
+      acc0 = _mm256_fmadd_ps(w, _mm256_loadu_ps(row), acc0);
+      acc1 = _mm256_fmadd_ps(w, _mm256_loadu_ps(row + 8), acc1);
+      acc2 = _mm256_fmadd_ps(w, _mm256_loadu_ps(row + 16), acc2);
+      acc3 = _mm256_fmadd_ps(w, _mm256_loadu_ps(row + 24), acc3);
+    }
+    _mm256_storeu_ps(out + j, acc0);
+    _mm256_storeu_ps(out + j + 8, acc1);
+    _mm256_storeu_ps(out + j + 16, acc2);
+    _mm256_storeu_ps(out + j + 24, acc3);
+  }
+  for (; j + 8 <= length; j += 8) {
+    __m256 acc = _mm256_setzero_ps();
+    for (int k = 0; k < window_size; k++)
+      acc = _mm256_fmadd_ps(_mm256_set1_ps(window[k]), _mm256_loadu_ps(rows[k] + j), acc);
+    _mm256_storeu_ps(out + j, acc);
+  }
+  for (; j < length; j++) {
+    float acc = 0;
+    for (int k = 0; k < window_size; k++)
+      acc = std::fma(window[k], rows[k][j], acc);
+    out[j] = acc;
+  }
+}
+
+#endif
+
+}  // namespace
+
+void ConvolveRows(float *out, const float *const *rows, const float *window,
+                  int window_size, int64_t length) {
+#if DALI_CPU_X86
+  const auto &cpu = GetCPUFeatures();
+  if (cpu.avx2 && cpu.fma) {
+    ConvolveRowsAVX2(out, rows, window, window_size, length);
+    return;
+  }
+#endif
+  ConvolveRowsGeneric(out, rows, window, window_size, length);
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,38 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_ROWS_CPU_H_
+#define DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_ROWS_CPU_H_
+
+#include <cstdint>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Calculates a weighted sum of rows: `out[j] = sum(window[k] * rows[k][j])`
+ *        for `j` in `[0, length)`, accumulating from `k = 0`.
+ *
+ * Convolution along any axis reduces to it - for the innermost axis the rows are the same
+ * (padded) input row shifted by consecutive pixels.
+ * Vectorized across `j` with AVX2/FMA, if supported by the CPU.
+ */
+DLL_PUBLIC void ConvolveRows(float *out, const float *const *rows, const float *window,
+                             int window_size, int64_t length);
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_CONVOLUTION_CONVOLUTION_ROWS_CPU_H_
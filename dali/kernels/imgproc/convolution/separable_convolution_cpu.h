@@ -15,11 +15,16 @@
 #ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_SEPARABLE_CONVOLUTION_CPU_H_
 #define DALI_KERNELS_IMGPROC_CONVOLUTION_SEPARABLE_CONVOLUTION_CPU_H_
 
+#include <algorithm>
+#include <type_traits>
+#include "dali/core/boundary.h"
 #include "dali/core/convert.h"
 #include "dali/core/format.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/tensor_view.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/imgproc/convolution/convolution_cpu.h"
+#include "dali/kernels/imgproc/convolution/convolution_rows_cpu.h"
 #include "dali/kernels/kernel.h"
 #include "dali/pipeline/util/operator_impl_utils.h"
 
@@ -73,26 +78,55 @@ struct SeparableConvolutionCpu<Out, In, W, 1, has_channels> {
   ConvolutionCpu<Out, In, W, ndim, 0, has_channels> conv_;
 };
 
+/**
+ * @brief 2D separable convolution
+ *
+ * With float intermediate values (the usual case), the image is processed in bands of columns,
+ * row by row: the rows convolved along the innermost axis are kept in a ring buffer
+ * of `window_sizes[0]` rows, sized to fit in L2 cache, and the outer axis convolution is
+ * calculated from them, so no full-size intermediate is needed. Both passes are vectorized
+ * across the row (see ConvolveRows). Ranges of output rows can be calculated independently,
+ * which allows splitting a large image across threads.
+ * The input and output must not overlap.
+ *
+ * Otherwise, the axes are processed one after another, with a full-size intermediate buffer.
+ */
 template <typename Out, typename In, typename W, bool has_channels>
 struct SeparableConvolutionCpu<Out, In, W, 2, has_channels> {
   static constexpr int axes = 2;
   static constexpr int ndim = has_channels ? 3 : 2;
   using Intermediate = decltype(std::declval<W>() * std::declval<In>());
+  static constexpr bool kBlocked =
+      std::is_same<W, float>::value && std::is_same<Intermediate, float>::value;
+  /// Size of the ring buffer of intermediate rows
+  static constexpr int64_t kRingBytes = 256 << 10;
+  /// Minimum width of a band of columns, so that the horizontal borders are amortized
+  static constexpr int64_t kMinBandWidth = 32;
 
   KernelRequirements Setup(KernelContext& ctx, const TensorShape<ndim>& in_shape,
                            const std::array<int, axes>& window_sizes) {
     KernelRequirements req;
 
     ScratchpadEstimator se;
-    se.add<Intermediate>(AllocType::Host, volume(in_shape));
+    if (kBlocked) {
+      int64_t num_channels = has_channels ? in_shape[2] : 1;
+      int64_t band_w = GetBandWidth(in_shape, window_sizes[0]);
+      se.add<float>(AllocType::Host, window_sizes[0] * band_w * num_channels);  // ring
+      se.add<float>(AllocType::Host, (band_w + window_sizes[1] - 1) * num_channels);  // padded
+      se.add<float>(AllocType::Host, band_w * num_channels);  // output row
+    } else {
+      se.add<Intermediate>(AllocType::Host, volume(in_shape));
+    }
     req.scratch_sizes = se.sizes;
     req.output_shapes.push_back(uniform_list_shape<ndim>(1, in_shape));
 
-    auto req_inner = conv_innermost_.Setup(ctx, in_shape, window_sizes[1]);
-    auto req_outer = conv_outermost_.Setup(ctx, in_shape, window_sizes[0]);
+    if (!kBlocked) {
+      auto req_inner = conv_innermost_.Setup(ctx, in_shape, window_sizes[1]);
+      auto req_outer = conv_outermost_.Setup(ctx, in_shape, window_sizes[0]);
 
-    req.AddInputSet(req_inner, false);
-    req.AddInputSet(req_outer, false);
+      req.AddInputSet(req_inner, false);
+      req.AddInputSet(req_outer, false);
+    }
 
     return req;
   }
@@ -101,6 +135,39 @@ struct SeparableConvolutionCpu<Out, In, W, 2, has_channels> {
            const TensorView<StorageCPU, const In, ndim>& in,
            const std::array<TensorView<StorageCPU, const W, 1>, axes>& windows,
            W scale = 1) {
+    Run(ctx, out, in, windows, scale, 0, in.shape[0]);
+  }
+
+  /**
+   * @brief Calculates the output rows `[row_begin, row_end)`
+   *
+   * Only the whole image can be processed if the intermediate type is not float.
+   */
+  void Run(KernelContext& ctx, const TensorView<StorageCPU, Out, ndim> out,
+           const TensorView<StorageCPU, const In, ndim>& in,
+           const std::array<TensorView<StorageCPU, const W, 1>, axes>& windows,
+           W scale, int64_t row_begin, int64_t row_end) {
+    DALI_ENFORCE(0 <= row_begin && row_begin <= row_end && row_end <= in.shape[0],
+                 make_string("Invalid range of rows: [", row_begin, ", ", row_end, ")."));
+    RunImpl(std::integral_constant<bool, kBlocked>(), ctx, out, in, windows, scale, row_begin,
+            row_end);
+  }
+
+ private:
+  static int64_t GetBandWidth(const TensorShape<ndim>& in_shape, int outer_window_size) {
+    int64_t num_channels = has_channels ? in_shape[2] : 1;
+    int64_t band_w = kRingBytes / (sizeof(float) * outer_window_size * num_channels);
+    if (band_w < kMinBandWidth)
+      band_w = kMinBandWidth;
+    return std::max<int64_t>(1, std::min(in_shape[1], band_w));
+  }
+
+  void RunImpl(std::false_type, KernelContext& ctx, const TensorView<StorageCPU, Out, ndim> out,
+               const TensorView<StorageCPU, const In, ndim>& in,
+               const std::array<TensorView<StorageCPU, const W, 1>, axes>& windows,
+               W scale, int64_t row_begin, int64_t row_end) {
+    DALI_ENFORCE(row_begin == 0 && row_end == in.shape[0],
+                 "Ranges of rows are supported only with float intermediate type.");
     auto *tmp = ctx.scratchpad->Allocate<Intermediate>(AllocType::Host, volume(in.shape));
     auto intermediate = TensorView<StorageCPU, Intermediate, ndim>(tmp, in.shape);
 
@@ -108,6 +175,81 @@ struct SeparableConvolutionCpu<Out, In, W, 2, has_channels> {
     conv_outermost_.Run(ctx, out, intermediate, windows[0], scale);
   }
 
+  void RunImpl(std::true_type, KernelContext& ctx, const TensorView<StorageCPU, Out, ndim> out,
+               const TensorView<StorageCPU, const In, ndim>& in,
+               const std::array<TensorView<StorageCPU, const W, 1>, axes>& windows,
+               W scale, int64_t row_begin, int64_t row_end) {
+    DALI_ENFORCE(static_cast<const void*>(out.data) != static_cast<const void*>(in.data),
+                 "The 2D separable convolution cannot be calculated in-place.");
+    const int64_t height = in.shape[0], width = in.shape[1];
+    const int64_t num_channels = has_channels ? in.shape[2] : 1;
+    const int outer_size = windows[0].num_elements(), inner_size = windows[1].num_elements();
+    const int outer_radius = outer_size / 2;
+    const int64_t band_w = GetBandWidth(in.shape, outer_size);
+    const int64_t ring_stride = band_w * num_channels;
+
+    auto* ring = ctx.scratchpad->Allocate<float>(AllocType::Host, outer_size * ring_stride);
+    auto* padded = ctx.scratchpad->Allocate<float>(AllocType::Host,
+                                                   (band_w + inner_size - 1) * num_channels);
+    auto* out_row_buf = ctx.scratchpad->Allocate<float>(AllocType::Host, ring_stride);
+    SmallVector<const float*, 32> rows;
+    rows.resize(std::max(outer_size, inner_size));
+    // intermediate row `y` (possibly outside of the image) is stored in slot `y mod outer_size`
+    auto ring_row = [&](int64_t y) {
+      int64_t slot = y % outer_size;
+      return ring + (slot < 0 ? slot + outer_size : slot) * ring_stride;
+    };
+
+    for (int64_t x0 = 0; x0 < width; x0 += band_w) {
+      int64_t x1 = std::min(x0 + band_w, width);
+      int64_t length = (x1 - x0) * num_channels;
+      int64_t next_row = row_begin - outer_radius;
+      for (int64_t y = row_begin; y < row_end; y++) {
+        for (; next_row <= y + outer_radius; next_row++) {
+          int64_t in_y = boundary::idx_reflect_101(next_row, height);
+          ConvolveInnerBand(ring_row(next_row), in.data + in_y * width * num_channels,
+                            x0, x1, width, num_channels, windows[1].data, inner_size, padded,
+                            rows.data());
+        }
+        for (int k = 0; k < outer_size; k++)
+          rows[k] = ring_row(y - outer_radius + k);
+        Out* out_row = out.data + (y * width + x0) * num_channels;
+        float* acc = std::is_same<Out, float>::value ? reinterpret_cast<float*>(out_row)
+                                                     : out_row_buf;
+        ConvolveRows(acc, rows.data(), windows[0].data, outer_size, length);
+        if (!std::is_same<Out, float>::value || scale != 1) {
+          for (int64_t j = 0; j < length; j++)
+            out_row[j] = ConvertSat<Out>(acc[j] * scale);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Convolves the columns `[x0, x1)` of an input row along the innermost axis
+   */
+  static void ConvolveInnerBand(float* out, const In* in_row, int64_t x0, int64_t x1,
+                                int64_t width, int64_t num_channels, const float* window,
+                                int window_size, float* padded, const float** rows) {
+    const int radius = window_size / 2;
+    const float* src;
+    if (std::is_same<In, float>::value && x0 - radius >= 0 && x1 + radius <= width) {
+      // no border handling nor conversion needed
+      src = reinterpret_cast<const float*>(in_row) + (x0 - radius) * num_channels;
+    } else {
+      float* p = padded;
+      for (int64_t x = x0 - radius; x < x1 + radius; x++) {
+        const In* pixel = in_row + boundary::idx_reflect_101(x, width) * num_channels;
+        for (int64_t c = 0; c < num_channels; c++)
+          *p++ = pixel[c];
+      }
+      src = padded;
+    }
+    for (int k = 0; k < window_size; k++)
+      rows[k] = src + k * num_channels;
+    ConvolveRows(out, rows, window, window_size, (x1 - x0) * num_channels);
+  }
+
   ConvolutionCpu<Intermediate, In, W, ndim, 1, has_channels> conv_innermost_;
   ConvolutionCpu<Out, Intermediate, W, ndim, 0, has_channels> conv_outermost_;
 };
@@ -155,6 +297,17 @@ struct SeparableConvolutionCpu<Out, In, W, 3, has_channels> {
   ConvolutionCpu<Out, Intermediate, W, ndim, 0, has_channels> conv_outermost_;
 };
 
+/**
+ * @brief Whether the separable convolution can calculate ranges of the output rows independently
+ */
+template <typename Kernel>
+struct supports_row_ranges : std::false_type {};
+
+template <typename Out, typename In, typename W, bool has_channels>
+struct supports_row_ranges<SeparableConvolutionCpu<Out, In, W, 2, has_channels>>
+    : std::integral_constant<bool,
+                             SeparableConvolutionCpu<Out, In, W, 2, has_channels>::kBlocked> {};
+
 }  // namespace kernels
 }  // namespace dali
 
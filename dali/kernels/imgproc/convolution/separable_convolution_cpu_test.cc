@@ -216,6 +216,74 @@ TEST(SeparableConvolutionTest, Axes2NoChannels) {
   Check(out_v, compare_v);
 }
 
+namespace {
+
+/**
+ * @brief Runs the 2D convolution of an image wide enough to be processed in several bands
+ *        of columns, optionally split into ranges of rows, and compares it with the baseline
+ */
+template <typename Out>
+void CheckBlockedConvolution2D(int num_ranges, float scale) {
+  std::array<int, 2> window_dims = {21, 9};
+  TestTensorList<float, 1> kernel_window_0, kernel_window_1;
+  TestTensorList<uint8_t, 3> input;
+  TestTensorList<float, 3> intermediate, baseline_output;
+  TestTensorList<Out, 3> output;
+
+  TensorListShape<3> data_shape = uniform_list_shape<3>(1, {45, 2500, 3});
+
+  kernel_window_0.reshape(uniform_list_shape<1>(1, {window_dims[0]}));
+  kernel_window_1.reshape(uniform_list_shape<1>(1, {window_dims[1]}));
+  input.reshape(data_shape);
+  intermediate.reshape(data_shape);
+  output.reshape(data_shape);
+  baseline_output.reshape(data_shape);
+
+  auto kernel_window_0_v = kernel_window_0.cpu()[0];
+  auto kernel_window_1_v = kernel_window_1.cpu()[0];
+  auto in_v = input.cpu()[0];
+  auto interm_v = intermediate.cpu()[0];
+  auto out_v = output.cpu()[0];
+  auto baseline_out_v = baseline_output.cpu()[0];
+
+  std::mt19937 rng;
+  UniformRandomFill(in_v, rng, 0, 255);
+  InitTriangleWindow(kernel_window_0_v);
+  InitTriangleWindow(kernel_window_1_v);
+
+  SeparableConvolutionCpu<Out, uint8_t, float, 2, true> kernel;
+  KernelContext ctx;
+
+  auto req = kernel.Setup(ctx, data_shape[0], window_dims);
+
+  ScratchpadAllocator scratch_alloc;
+  scratch_alloc.Reserve(req.scratch_sizes);
+
+  int64_t H = data_shape[0][0];
+  for (int r = 0; r < num_ranges; r++) {
+    auto scratchpad = scratch_alloc.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    kernel.Run(ctx, out_v, in_v, {kernel_window_0_v, kernel_window_1_v}, scale,
+               H * r / num_ranges, H * (r + 1) / num_ranges);
+  }
+  testing::BaselineConvolve(interm_v, in_v, kernel_window_1_v, 1, window_dims[1] / 2);
+  testing::BaselineConvolve(baseline_out_v, interm_v, kernel_window_0_v, 0, window_dims[0] / 2);
+  // the sums of integers are exact in float, regardless of the order of the operations
+  for (int64_t i = 0; i < baseline_out_v.num_elements(); i++)
+    baseline_out_v.data[i] = ConvertSat<Out>(baseline_out_v.data[i] * scale);
+  Check(out_v, baseline_out_v);
+}
+
+}  // namespace
+
+TEST(SeparableConvolutionTest, Axes2Blocked) {
+  for (int num_ranges : {1, 4}) {
+    CheckBlockedConvolution2D<float>(num_ranges, 1.0f);
+    // normalize the triangle windows, so that the output fits uint8
+    CheckBlockedConvolution2D<uint8_t>(num_ranges, 1.0f / (121 * 25));
+  }
+}
+
 TEST(SeparableConvolutionTest, Axes3WithChannels) {
   std::array<int, 3> window_dims = {5, 7, 3};
   TestTensorList<uint16_t, 1> kernel_window_0, kernel_window_1, kernel_window_2;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cmath>
+#include "dali/core/convert.h"
 #include "dali/kernels/imgproc/resample/resampling_filters.cuh"
 #include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
 
@@ -46,5 +47,29 @@ void InitializeResamplingFilter(
   }
 }
 
+void ConvertResamplingFilterToFixedPoint(int16_t *out_coeffs, const float *coeffs,
+                                         int out_size, int support) {
+  const float scale = 1 << kResamplingCoeffBits;
+  for (int x = 0; x < out_size; x++) {
+    const float *in = coeffs + x * support;
+    int16_t *out = out_coeffs + x * support;
+    int sum = 0;
+    int max_k = 0;
+    float max_abs = 0;
+    for (int k = 0; k < support; k++) {
+      out[k] = clamp<int16_t>(std::roundf(in[k] * scale));
+      sum += out[k];
+      if (std::abs(in[k]) > max_abs) {
+        max_abs = std::abs(in[k]);
+        max_k = k;
+      }
+    }
+    // Distribute the rounding error so that the coefficients sum up exactly to one;
+    // all-zero filters are left as they are.
+    if (sum && max_abs)
+      out[max_k] = clamp<int16_t>(out[max_k] + (1 << kResamplingCoeffBits) - sum);
+  }
+}
+
 }  // namespace kernels
 }  // namespace dali
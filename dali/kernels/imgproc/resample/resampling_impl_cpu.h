@@ -32,6 +32,113 @@ DLL_PUBLIC
 void InitializeResamplingFilter(int32_t *out_indices, float *out_coeffs, int out_size,
                                 float srcx0, float scale, const ResamplingFilter &filter);
 
+/**
+ * @brief Number of fractional bits in fixed-point resampling coefficients
+ */
+constexpr int kResamplingCoeffBits = 14;
+
+/**
+ * @brief Number of fractional bits in int16 intermediate data in fixed-point resampling
+ *
+ * The intermediate values are uint8 values scaled by 2^kResamplingIntermediateBits; there is
+ * enough headroom for the overshoot of filters with negative lobes (cubic, Lanczos).
+ */
+constexpr int kResamplingIntermediateBits = 6;
+
+/**
+ * @brief Converts normalized floating point coefficients to fixed point.
+ *
+ * The coefficients for each output pixel are rounded so that their sum is exactly
+ * 1 << kResamplingCoeffBits, which preserves flat areas of the image.
+ */
+DLL_PUBLIC
+void ConvertResamplingFilterToFixedPoint(int16_t *out_coeffs, const float *coeffs,
+                                         int out_size, int support);
+
+/**
+ * @brief Instruction set used by vectorized resampling; the best one is detected at run time
+ */
+enum class ResamplingSIMD {
+  None = 0,
+  SSE41,
+  AVX2
+};
+
+DLL_PUBLIC ResamplingSIMD GetResamplingSIMD();
+
+/**
+ * @brief Limits the instruction set used by the resampling functions; for testing and benchmarks
+ *
+ * The level is clamped to what is supported by the CPU.
+ */
+DLL_PUBLIC void SetResamplingSIMD(ResamplingSIMD simd);
+
+/**
+ * @brief Fixed-point vertical resampling pass
+ *
+ * uint8 -> int16 is a first pass, int16 -> uint8 is a second pass; int16 -> int16 is
+ * a middle pass of volumetric resampling. See kResamplingIntermediateBits.
+ */
+DLL_PUBLIC void ResampleVertFixed(Surface2D<int16_t> out, Surface2D<const uint8_t> in,
+                                  const int32_t *in_rows, const int16_t *row_coeffs, int support);
+DLL_PUBLIC void ResampleVertFixed(Surface2D<uint8_t> out, Surface2D<const int16_t> in,
+                                  const int32_t *in_rows, const int16_t *row_coeffs, int support);
+DLL_PUBLIC void ResampleVertFixed(Surface2D<int16_t> out, Surface2D<const int16_t> in,
+                                  const int32_t *in_rows, const int16_t *row_coeffs, int support);
+
+/**
+ * @brief Fixed-point horizontal resampling pass
+ *
+ * @see ResampleVertFixed
+ */
+DLL_PUBLIC void ResampleHorzFixed(Surface2D<int16_t> out, Surface2D<const uint8_t> in,
+                                  const int32_t *in_columns, const int16_t *col_coeffs,
+                                  int support);
+DLL_PUBLIC void ResampleHorzFixed(Surface2D<uint8_t> out, Surface2D<const int16_t> in,
+                                  const int32_t *in_columns, const int16_t *col_coeffs,
+                                  int support);
+DLL_PUBLIC void ResampleHorzFixed(Surface2D<int16_t> out, Surface2D<const int16_t> in,
+                                  const int32_t *in_columns, const int16_t *col_coeffs,
+                                  int support);
+
+/**
+ * @brief Vectorized floating point vertical resampling pass
+ *
+ * The results are identical to those of the generic implementation.
+ *
+ * @return false, if the vectorized implementation is not available
+ */
+DLL_PUBLIC bool ResampleVertSIMD(Surface2D<float> out, Surface2D<const float> in,
+                                 const int32_t *in_rows, const float *row_coeffs, int support);
+DLL_PUBLIC bool ResampleVertSIMD(Surface2D<float> out, Surface2D<const uint8_t> in,
+                                 const int32_t *in_rows, const float *row_coeffs, int support);
+
+template <typename Out, typename In>
+inline bool ResampleVertSIMD(Surface2D<Out> out, Surface2D<In> in,
+                             const int32_t *in_rows, const float *row_coeffs, int support) {
+  return false;
+}
+
+/**
+ * @brief Vectorized floating point horizontal resampling pass (up to 4 channels)
+ *
+ * The results are identical to those of the generic implementation.
+ *
+ * @return false, if the vectorized implementation is not available
+ */
+DLL_PUBLIC bool ResampleHorzSIMD(Surface2D<float> out, Surface2D<const float> in,
+                                 const int32_t *in_columns, const float *col_coeffs,
+                                 int support);
+DLL_PUBLIC bool ResampleHorzSIMD(Surface2D<float> out, Surface2D<const uint8_t> in,
+                                 const int32_t *in_columns, const float *col_coeffs,
+                                 int support);
+
+template <typename Out, typename In>
+inline bool ResampleHorzSIMD(Surface2D<Out> out, Surface2D<In> in,
+                             const int32_t *in_columns, const float *col_coeffs, int support) {
+  return false;
+}
+
 template <int static_channels, bool clamp_left, bool clamp_right, typename Out, typename In>
 void ResampleCol(Out *out, const In *in, int x, int w, const int32_t *in_columns,
                  const float *coeffs, int support, int dynamic_channels) {
@@ -79,11 +186,16 @@ void ResampleHorz_Channels(
     const float *coeffs, int support) {
   const int channels = static_channels < 0 ? out.channels : static_channels;
 
+  // The column indices are monotonic, but may be decreasing (flipped ROI) - hence, the
+  // columns which need clamping may lie on either side of the regular range.
+  auto is_regular = [&](int x) {
+    return in_columns[x] >= 0 && in_columns[x] + support <= in.size.x;
+  };
   int first_regular_col = 0;
   int last_regular_col = out.size.x - 1;
-  while (first_regular_col < out.size.x && in_columns[first_regular_col] < 0)
+  while (first_regular_col < out.size.x && !is_regular(first_regular_col))
     first_regular_col++;
-  while (last_regular_col >= 0 && in_columns[last_regular_col] + support > in.size.x)
+  while (last_regular_col >= first_regular_col && !is_regular(last_regular_col))
     last_regular_col--;
 
   for (int y = 0; y < out.size.y; y++) {
@@ -92,10 +204,6 @@ void ResampleHorz_Channels(
 
     int x = 0;
 
-    for (; x < first_regular_col && x <= last_regular_col; x++) {
-      ResampleCol<static_channels, true, false>(
-        out_row, in_row, x, in.size.x, in_columns, coeffs, support, channels);
-    }
     for (; x < first_regular_col; x++) {
       ResampleCol<static_channels, true, true>(
         out_row, in_row, x, in.size.x, in_columns, coeffs, support, channels);
@@ -105,7 +213,7 @@ void ResampleHorz_Channels(
         out_row, in_row, x, in.size.x, in_columns, coeffs, support, channels);
     }
     for (; x < out.size.x; x++) {
-      ResampleCol<static_channels, false, true>(
+      ResampleCol<static_channels, true, true>(
         out_row, in_row, x, in.size.x, in_columns, coeffs, support, channels);
     }
   }
@@ -122,6 +230,10 @@ void ResampleVert(
   int flat_w = out.size.x * out.channels;
 
   assert(support > 0);
+  const Surface2D<const std::remove_const_t<In>> &const_in = in;
+  if (ResampleVertSIMD(out, const_in, in_rows, row_coeffs, support))
+    return;
+
   const In **in_row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
 
   for (int y = 0; y < out.size.y; y++) {
@@ -157,6 +269,9 @@ void ResampleVert(
 template <typename Out, typename In>
 inline void ResampleHorz(Surface2D<Out> out, Surface2D<In> in,
                          const int *in_columns, const float *col_coeffs, int support) {
+  const Surface2D<const std::remove_const_t<In>> &const_in = in;
+  if (ResampleHorzSIMD(out, const_in, in_columns, col_coeffs, support))
+    return;
   VALUE_SWITCH(out.channels, static_channels, (1, 2, 3, 4), (
     ResampleHorz_Channels<static_channels>(out, in, in_columns, col_coeffs, support);
   ), (  // NOLINT
@@ -175,6 +290,62 @@ inline void ResampleAxis(Surface2D<Out> out, Surface2D<In> in,
     assert(!"Invalid axis index");
 }
 
+/**
+ * @brief Fixed-point variant of ResampleAxis
+ */
+template <typename Out, typename In>
+inline void ResampleAxis(Surface2D<Out> out, Surface2D<In> in,
+                         const int *in_indices, const int16_t *coeffs, int support, int axis) {
+  const Surface2D<const std::remove_const_t<In>> &const_in = in;
+  if (axis == 1)
+    ResampleVertFixed(out, const_in, in_indices, coeffs, support);
+  else if (axis == 0)
+    ResampleHorzFixed(out, const_in, in_indices, coeffs, support);
+  else
+    assert(!"Invalid axis index");
+}
+
+/**
+ * @brief Resamples a volume along one axis
+ *
+ * For the inner axes, the volume is processed slice by slice. The outermost axis is
+ * resampled like the vertical axis of an image, the rows of which are the slices.
+ */
+template <int n, typename Out, typename In, typename Coeff>
+std::enable_if_t<(n > 2)> ResampleAxis(Surface<n, Out> out, Surface<n, In> in,
+                                       const int *in_indices, const Coeff *coeffs, int support,
+                                       int axis) {
+  static_assert(n == 3, "Only 2D and 3D resampling is supported");
+  if (axis < n - 1) {
+    assert(out.size[n - 1] == in.size[n - 1]);
+    for (int i = 0; i < out.size[n - 1]; i++)
+      ResampleAxis(out.slice(i), in.slice(i), in_indices, coeffs, support, axis);
+    return;
+  }
+  assert(axis == n - 1);
+  auto contiguous_slices = [](auto &s) {
+    return s.strides.x == s.channels && s.strides.y == s.size.x * s.strides.x;
+  };
+  if (contiguous_slices(out) && contiguous_slices(in)) {
+    // whole slices are the rows
+    Surface2D<Out> out_rows(out.data, out.size.x * out.size.y, out.size.z, out.channels,
+                            out.strides.x, out.strides.z, out.channel_stride);
+    Surface2D<In> in_rows(in.data, in.size.x * in.size.y, in.size.z, in.channels,
+                          in.strides.x, in.strides.z, in.channel_stride);
+    ResampleAxis(out_rows, in_rows, in_indices, coeffs, support, 1);
+  } else {
+    // one row of each slice
+    assert(out.size.y == in.size.y);
+    for (int y = 0; y < out.size.y; y++) {
+      Surface2D<Out> out_rows(&out(0, y, 0), out.size.x, out.size.z, out.channels,
+                              out.strides.x, out.strides.z, out.channel_stride);
+      Surface2D<In> in_rows(&in(0, y, 0), in.size.x, in.size.z, in.channels,
+                            in.strides.x, in.strides.z, in.channel_stride);
+      ResampleAxis(out_rows, in_rows, in_indices, coeffs, support, 1);
+    }
+  }
+}
+
 /**
  * @brief Resamples `in` using Nearest Neighbor interpolation and stores result in `out`
  * @param out - output surface
@@ -288,6 +459,8 @@ void ResampleNN(Surface<n, Out> out, Surface<n, const In> in,
   float src = origin[n-1] + 0.5f * step;
   for (int i = 0; i < out.size[n-1]; i++, src += step) {
     int isrc = std::floor(src);
+    if (isrc < 0) isrc = 0;
+    else if (isrc > in.size[n-1] - 1) isrc = in.size[n-1] - 1;
     ResampleNN(out.slice(i), in.slice(isrc), sub<n-1>(origin), sub<n-1>(scale));
   }
 }
@@ -0,0 +1,674 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include "dali/core/convert.h"
+#include "dali/core/cpu_features.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+ResamplingSIMD DetectResamplingSIMD() {
+  const auto &cpu = GetCPUFeatures();
+  if (cpu.avx2)
+    return ResamplingSIMD::AVX2;
+  if (cpu.sse41)
+    return ResamplingSIMD::SSE41;
+  return ResamplingSIMD::None;
+}
+
+ResamplingSIMD SupportedResamplingSIMD() {
+  static const ResamplingSIMD supported = DetectResamplingSIMD();
+  return supported;
+}
+
+std::atomic<ResamplingSIMD> &CurrentResamplingSIMD() {
+  static std::atomic<ResamplingSIMD> current(SupportedResamplingSIMD());
+  return current;
+}
+
+/**
+ * @brief Number of bits by which the fixed-point sum is shifted right to get the output
+ */
+template <typename Out, typename In>
+constexpr int FixedPointShift() {
+  return kResamplingCoeffBits
+      + (std::is_same<In, int16_t>::value ? kResamplingIntermediateBits : 0)
+      - (std::is_same<Out, int16_t>::value ? kResamplingIntermediateBits : 0);
+}
+
+template <typename Out, typename In>
+constexpr int32_t FixedPointBias() {
+  return 1 << (FixedPointShift<Out, In>() - 1);
+}
+
+template <typename Out>
+inline Out FixedPointToOut(int32_t sum, int shift) {
+  return clamp<Out>(sum >> shift);
+}
+
+/**
+ * @brief Gets pointers to the input rows (with clamping) contributing to output row y
+ */
+template <typename In>
+inline void GetRowPointers(const In **row_ptrs, const Surface2D<const In> &in,
+                           const int32_t *in_rows, int y, int support) {
+  for (int k = 0; k < support; k++) {
+    int sy = in_rows[y] + k;
+    if (sy < 0) sy = 0;
+    else if (sy > in.size.y - 1) sy = in.size.y - 1;
+    row_ptrs[k] = &in(0, sy);
+  }
+}
+
+// Scalar implementations - these define the results; the vectorized variants must produce
+// bit-exact results.
+
+template <typename Out, typename In>
+void ResampleVertFixedRow(Out *out_row, const In *const *in_rows, const int16_t *coeffs,
+                          int support, int x0, int x1) {
+  constexpr int shift = FixedPointShift<Out, In>();
+  constexpr int32_t bias = FixedPointBias<Out, In>();
+  for (int x = x0; x < x1; x++) {
+    int32_t sum = bias;
+    for (int k = 0; k < support; k++)
+      sum += coeffs[k] * in_rows[k][x];
+    out_row[x] = FixedPointToOut<Out>(sum, shift);
+  }
+}
+
+template <typename Out, typename In>
+void ResampleVertFixedScalar(Surface2D<Out> out, Surface2D<const In> in,
+                             const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  int flat_w = out.size.x * out.channels;
+  const In **row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
+  for (int y = 0; y < out.size.y; y++) {
+    GetRowPointers(row_ptrs, in, in_rows, y, support);
+    ResampleVertFixedRow(&out(0, y), row_ptrs, row_coeffs + y * support, support, 0, flat_w);
+  }
+}
+
+template <int static_channels, bool clamp_x, typename Out, typename In>
+inline void ResampleColFixed(Out *out, const In *in, int x, int w, const int32_t *in_columns,
+                             const int16_t *coeffs, int support, int dynamic_channels) {
+  constexpr int shift = FixedPointShift<Out, In>();
+  constexpr int32_t bias = FixedPointBias<Out, In>();
+  const int channels = static_channels < 0 ? dynamic_channels : static_channels;
+  int x0 = in_columns[x];
+  const int16_t *c = coeffs + x * support;
+  for (int ch = 0; ch < channels; ch++) {
+    int32_t sum = bias;
+    for (int k = 0; k < support; k++) {
+      int srcx = clamp_x ? clamp(x0 + k, 0, w - 1) : x0 + k;
+      sum += c[k] * in[srcx * channels + ch];
+    }
+    out[x * channels + ch] = FixedPointToOut<Out>(sum, shift);
+  }
+}
+
+/**
+ * @brief Finds the range of output columns which don't need clamping of input coordinates
+ *
+ * The column indices are monotonic (but may be decreasing), so the regular columns
+ * form a contiguous range [first, last]; the range is empty if first > last.
+ */
+inline void GetRegularColumns(int &first, int &last, const int32_t *in_columns,
+                              int out_w, int in_w, int support) {
+  auto is_regular = [&](int x) {
+    return in_columns[x] >= 0 && in_columns[x] + support <= in_w;
+  };
+  first = 0;
+  last = out_w - 1;
+  while (first < out_w && !is_regular(first))
+    first++;
+  while (last >= first && !is_regular(last))
+    last--;
+}
+
+/**
+ * @brief Finds the range of regular columns which don't use the last input pixel in a row
+ *
+ * In these columns, 3-channel pixels can be loaded with 4-element loads without accessing
+ * the memory past the end of the row.
+ */
+inline void GetOverreadColumns(int &first, int &last, int first_regular, int last_regular,
+                               const int32_t *in_columns, int in_w, int support) {
+  last = last_regular;
+  while (last >= first_regular && in_columns[last] + support >= in_w)
+    last--;
+  first = first_regular;
+  while (first <= last && in_columns[first] + support >= in_w)
+    first++;
+}
+
+template <int static_channels, typename Out, typename In>
+void ResampleHorzFixedScalar(Surface2D<Out> out, Surface2D<const In> in,
+                             const int32_t *in_columns, const int16_t *col_coeffs, int support) {
+  int first_regular_col, last_regular_col;
+  GetRegularColumns(first_regular_col, last_regular_col, in_columns,
+                    out.size.x, in.size.x, support);
+  for (int y = 0; y < out.size.y; y++) {
+    Out *out_row = &out(0, y);
+    const In *in_row = &in(0, y);
+    int x = 0;
+    for (; x < first_regular_col; x++)
+      ResampleColFixed<static_channels, true>(out_row, in_row, x, in.size.x, in_columns,
+                                              col_coeffs, support, out.channels);
+    for (; x <= last_regular_col; x++)
+      ResampleColFixed<static_channels, false>(out_row, in_row, x, in.size.x, in_columns,
+                                               col_coeffs, support, out.channels);
+    for (; x < out.size.x; x++)
+      ResampleColFixed<static_channels, true>(out_row, in_row, x, in.size.x, in_columns,
+                                              col_coeffs, support, out.channels);
+  }
+}
+
+#if DALI_CPU_X86
+
+// The vectorized fixed-point implementations process pairs of taps with _mm*_madd_epi16:
+// the inputs from two rows (or columns) are interleaved and multiplied by a pair of
+// coefficients, producing 32-bit sums.
+
+inline int32_t CoeffPair(const int16_t *coeffs, int k, int support) {
+  uint16_t c0 = coeffs[k];
+  uint16_t c1 = k + 1 < support ? coeffs[k + 1] : 0;
+  return static_cast<int32_t>(c0 | (static_cast<uint32_t>(c1) << 16));
+}
+
+DALI_TARGET_SSE41 inline __m128i Load8xI16(const uint8_t *in) {
+  return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)));
+}
+
+DALI_TARGET_SSE41 inline __m128i Load8xI16(const int16_t *in) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+}
+
+DALI_TARGET_SSE41 inline void Store8(int16_t *out, __m128i v16) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), v16);
+}
+
+DALI_TARGET_SSE41 inline void Store8(uint8_t *out, __m128i v16) {
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(v16, v16));
+}
+
+template <typename Out, typename In>
+DALI_TARGET_SSE41
+void ResampleVertFixedSSE41(Surface2D<Out> out, Surface2D<const In> in,
+                            const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  constexpr int shift = FixedPointShift<Out, In>();
+  const __m128i bias = _mm_set1_epi32(FixedPointBias<Out, In>());
+  int flat_w = out.size.x * out.channels;
+  const In **row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
+  for (int y = 0; y < out.size.y; y++) {
+    GetRowPointers(row_ptrs, in, in_rows, y, support);
+    const int16_t *coeffs = row_coeffs + y * support;
+    Out *out_row = &out(0, y);
+    int x = 0;
+    for (; x + 8 <= flat_w; x += 8) {
+      __m128i lo = bias, hi = bias;
+      for (int k = 0; k < support; k += 2) {
+        __m128i a = Load8xI16(row_ptrs[k] + x);
+        __m128i b = k + 1 < support ? Load8xI16(row_ptrs[k + 1] + x) : _mm_setzero_si128();
+        __m128i c = _mm_set1_epi32(CoeffPair(coeffs, k, support));
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), c));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), c));
+      }
+      lo = _mm_srai_epi32(lo, shift);
+      hi = _mm_srai_epi32(hi, shift);
+      Store8(out_row + x, _mm_packs_epi32(lo, hi));
+    }
+    ResampleVertFixedRow(out_row, row_ptrs, coeffs, support, x, flat_w);
+  }
+}
+
+DALI_TARGET_AVX2 inline __m256i Load16xI16(const uint8_t *in) {
+  return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+}
+
+DALI_TARGET_AVX2 inline __m256i Load16xI16(const int16_t *in) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+}
+
+DALI_TARGET_AVX2 inline void Store16(int16_t *out, __m256i v16) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), v16);
+}
+
+DALI_TARGET_AVX2 inline void Store16(uint8_t *out, __m256i v16) {
+  // packus works within 128-bit lanes - gather the low halves of the lanes
+  __m256i v8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(v16, v16), 0x08);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(v8));
+}
+
+template <typename Out, typename In>
+DALI_TARGET_AVX2
+void ResampleVertFixedAVX2(Surface2D<Out> out, Surface2D<const In> in,
+                           const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  constexpr int shift = FixedPointShift<Out, In>();
+  const __m256i bias = _mm256_set1_epi32(FixedPointBias<Out, In>());
+  int flat_w = out.size.x * out.channels;
+  const In **row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
+  for (int y = 0; y < out.size.y; y++) {
+    GetRowPointers(row_ptrs, in, in_rows, y, support);
+    const int16_t *coeffs = row_coeffs + y * support;
+    Out *out_row = &out(0, y);
+    int x = 0;
+    for (; x + 16 <= flat_w; x += 16) {
+      __m256i lo = bias, hi = bias;
+      for (int k = 0; k < support; k += 2) {
+        __m256i a = Load16xI16(row_ptrs[k] + x);
+        __m256i b = k + 1 < support ? Load16xI16(row_ptrs[k + 1] + x) : _mm256_setzero_si256();
+        __m256i c = _mm256_set1_epi32(CoeffPair(coeffs, k, support));
+        // unpack and pack both work within 128-bit lanes, so the order is restored by packs
+        lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), c));
+        hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), c));
+      }
+      lo = _mm256_srai_epi32(lo, shift);
+      hi = _mm256_srai_epi32(hi, shift);
+      Store16(out_row + x, _mm256_packs_epi32(lo, hi));
+    }
+    ResampleVertFixedRow(out_row, row_ptrs, coeffs, support, x, flat_w);
+  }
+}
+
+/**
+ * @brief Loads one pixel, converted to int16, to the low 64 bits of the register
+ *
+ * If `overread` is true, a 3-channel pixel is loaded with one 4-element load, which accesses
+ * one element past the pixel - the caller must make sure that it's not the last pixel in a row.
+ */
+template <int channels, bool overread>
+DALI_TARGET_SSE41 inline __m128i LoadPixelI16(const uint8_t *in) {
+  int32_t v;
+  if (channels == 4 || (overread && channels == 3)) {
+    std::memcpy(&v, in, 4);
+  } else if (channels == 2) {
+    uint16_t v2;
+    std::memcpy(&v2, in, 2);
+    v = v2;
+  } else if (channels == 1) {
+    v = *in;
+  } else {
+    uint16_t v2;
+    std::memcpy(&v2, in, 2);
+    v = v2 | (in[2] << 16);
+  }
+  return _mm_cvtepu8_epi16(_mm_cvtsi32_si128(v));
+}
+
+template <int channels, bool overread>
+DALI_TARGET_SSE41 inline __m128i LoadPixelI16(const int16_t *in) {
+  if (channels == 4 || (overread && channels == 3))
+    return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in));
+  __m128i v = _mm_cvtsi32_si128(static_cast<uint16_t>(in[0]));
+  if (channels > 1) v = _mm_insert_epi16(v, in[1], 1);
+  if (channels > 2) v = _mm_insert_epi16(v, in[2], 2);
+  return v;
+}
+
+template <int channels, typename Out>
+DALI_TARGET_SSE41 inline void StorePixel(Out *out, __m128i sum) {
+  // saturate to int16 and then (if needed) to uint8 - like clamp<Out>
+  __m128i v16 = _mm_packs_epi32(sum, sum);
+  if (std::is_same<Out, uint8_t>::value) {
+    uint32_t v = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+    for (int ch = 0; ch < channels; ch++)
+      out[ch] = static_cast<uint8_t>(v >> (8 * ch));
+  } else {
+    // _mm_cvtsi128_si64 is not available in 32-bit builds
+    uint64_t v;
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(&v), v16);
+    for (int ch = 0; ch < channels; ch++)
+      out[ch] = static_cast<int16_t>(v >> (16 * ch));
+  }
+}
+
+/**
+ * @brief Calculates one output pixel (up to 4 channels) with fixed-point arithmetic
+ *
+ * The taps are processed in pairs: the pixels are interleaved
+ * (a0, b0, a1, b1, a2, b2, a3, b3) and multiplied by (ca, cb) pairs with a single madd.
+ */
+template <int channels, bool clamp_x, bool overread, typename Out, typename In>
+DALI_TARGET_SSE41 inline void ResampleColFixedSSE41(
+      Out *out, const In *in, int x, int w, const int32_t *in_columns,
+      const int16_t *coeffs, int support) {
+  constexpr int shift = FixedPointShift<Out, In>();
+  int x0 = in_columns[x];
+  const int16_t *c = coeffs + x * support;
+  __m128i sum = _mm_set1_epi32(FixedPointBias<Out, In>());
+  auto src = [&](int k) {
+    int sx = x0 + k;
+    return in + (clamp_x ? clamp(sx, 0, w - 1) : sx) * channels;
+  };
+  int k = 0;
+  for (; k + 2 <= support; k += 2) {
+    __m128i a = LoadPixelI16<channels, overread>(src(k));
+    __m128i b = LoadPixelI16<channels, overread>(src(k + 1));
+    int32_t cpair;
+    std::memcpy(&cpair, c + k, sizeof(cpair));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), _mm_set1_epi32(cpair)));
+  }
+  if (k < support) {
+    __m128i a = LoadPixelI16<channels, overread>(src(k));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(a, _mm_setzero_si128()),
+                                            _mm_set1_epi32(static_cast<uint16_t>(c[k]))));
+  }
+  StorePixel<channels>(out + x * channels, _mm_srai_epi32(sum, shift));
+}
+
+template <int channels, typename Out, typename In>
+DALI_TARGET_SSE41
+void ResampleHorzFixedSSE41(Surface2D<Out> out, Surface2D<const In> in,
+                            const int32_t *in_columns, const int16_t *col_coeffs, int support) {
+  static_assert(channels >= 1 && channels <= 4, "Up to 4 channels are supported");
+  int first_regular_col, last_regular_col;
+  GetRegularColumns(first_regular_col, last_regular_col, in_columns,
+                    out.size.x, in.size.x, support);
+  int first_overread_col, last_overread_col;
+  GetOverreadColumns(first_overread_col, last_overread_col, first_regular_col, last_regular_col,
+                     in_columns, in.size.x, support);
+
+  for (int y = 0; y < out.size.y; y++) {
+    Out *out_row = &out(0, y);
+    const In *in_row = &in(0, y);
+    int x = 0;
+    for (; x < first_regular_col; x++)
+      ResampleColFixedSSE41<channels, true, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                   col_coeffs, support);
+    for (; x < first_overread_col; x++)
+      ResampleColFixedSSE41<channels, false, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                    col_coeffs, support);
+    for (; x <= last_overread_col; x++)
+      ResampleColFixedSSE41<channels, false, true>(out_row, in_row, x, in.size.x, in_columns,
+                                                   col_coeffs, support);
+    for (; x <= last_regular_col; x++)
+      ResampleColFixedSSE41<channels, false, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                    col_coeffs, support);
+    for (; x < out.size.x; x++)
+      ResampleColFixedSSE41<channels, true, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                   col_coeffs, support);
+  }
+}
+
+template <int channels, bool overread>
+DALI_TARGET_SSE41 inline __m128 LoadPixelF32(const float *in) {
+  if (channels == 4 || (overread && channels == 3))
+    return _mm_loadu_ps(in);
+  if (channels == 1)
+    return _mm_load_ss(in);
+  __m128 v = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)));
+  if (channels == 3)
+    v = _mm_movelh_ps(v, _mm_load_ss(in + 2));
+  return v;
+}
+
+template <int channels, bool overread>
+DALI_TARGET_SSE41 inline __m128 LoadPixelF32(const uint8_t *in) {
+  return _mm_cvtepi32_ps(_mm_cvtepi16_epi32(LoadPixelI16<channels, overread>(in)));
+}
+
+/**
+ * @brief Calculates one floating point output pixel (up to 4 channels)
+ *
+ * The operations are the same as in the generic ResampleCol, so are the results.
+ */
+template <int channels, bool clamp_x, bool overread, typename In>
+DALI_TARGET_SSE41 inline void ResampleColFloatSSE41(
+      float *out, const In *in, int x, int w, const int32_t *in_columns,
+      const float *coeffs, int support) {
+  int x0 = in_columns[x];
+  const float *c = coeffs + x * support;
+  __m128 sum = _mm_setzero_ps();
+  for (int k = 0; k < support; k++) {
+    int sx = x0 + k;
+    if (clamp_x)
+      sx = clamp(sx, 0, w - 1);
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(c[k]),
+                                     LoadPixelF32<channels, overread>(in + sx * channels)));
+  }
+  alignas(16) float tmp[4];
+  _mm_store_ps(tmp, sum);
+  for (int ch = 0; ch < channels; ch++)
+    out[x * channels + ch] = tmp[ch];
+}
+
+template <int channels, typename In>
+DALI_TARGET_SSE41
+void ResampleHorzFloatSSE41(Surface2D<float> out, Surface2D<const In> in,
+                            const int32_t *in_columns, const float *col_coeffs, int support) {
+  static_assert(channels >= 1 && channels <= 4, "Up to 4 channels are supported");
+  int first_regular_col, last_regular_col, first_overread_col, last_overread_col;
+  GetRegularColumns(first_regular_col, last_regular_col, in_columns,
+                    out.size.x, in.size.x, support);
+  GetOverreadColumns(first_overread_col, last_overread_col, first_regular_col, last_regular_col,
+                     in_columns, in.size.x, support);
+
+  for (int y = 0; y < out.size.y; y++) {
+    float *out_row = &out(0, y);
+    const In *in_row = &in(0, y);
+    int x = 0;
+    for (; x < first_regular_col; x++)
+      ResampleColFloatSSE41<channels, true, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                   col_coeffs, support);
+    for (; x < first_overread_col; x++)
+      ResampleColFloatSSE41<channels, false, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                    col_coeffs, support);
+    for (; x <= last_overread_col; x++)
+      ResampleColFloatSSE41<channels, false, true>(out_row, in_row, x, in.size.x, in_columns,
+                                                   col_coeffs, support);
+    for (; x <= last_regular_col; x++)
+      ResampleColFloatSSE41<channels, false, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                    col_coeffs, support);
+    for (; x < out.size.x; x++)
+      ResampleColFloatSSE41<channels, true, false>(out_row, in_row, x, in.size.x, in_columns,
+                                                   col_coeffs, support);
+  }
+}
+
+template <typename In>
+DALI_TARGET_AVX2 inline __m256 Load8xF32(const In *in);
+
+template <>
+DALI_TARGET_AVX2 inline __m256 Load8xF32(const float *in) {
+  return _mm256_loadu_ps(in);
+}
+
+template <>
+DALI_TARGET_AVX2 inline __m256 Load8xF32(const uint8_t *in) {
+  __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in));
+  return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v));
+}
+
+template <typename In>
+DALI_TARGET_AVX2
+void ResampleVertFloatAVX2(Surface2D<float> out, Surface2D<const In> in,
+                           const int32_t *in_rows, const float *row_coeffs, int support) {
+  int flat_w = out.size.x * out.channels;
+  const In **row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
+  for (int y = 0; y < out.size.y; y++) {
+    GetRowPointers(row_ptrs, in, in_rows, y, support);
+    const float *c = row_coeffs + y * support;
+    float *out_row = &out(0, y);
+    int x = 0;
+    for (; x + 32 <= flat_w; x += 32) {
+      __m256 s0 = _mm256_setzero_ps(), s1 = s0, s2 = s0, s3 = s0;
+      for (int k = 0; k < support; k++) {
+        // separate multiply and add (no FMA) - to match the results of the scalar code
+        __m256 flt = _mm256_set1_ps(c[k]);
+        const In *row = row_ptrs[k] + x;
+        s0 = _mm256_add_ps(s0, _mm256_mul_ps(flt, Load8xF32(row)));
+        s1 = _mm256_add_ps(s1, _mm256_mul_ps(flt, Load8xF32(row + 8)));
+        s2 = _mm256_add_ps(s2, _mm256_mul_ps(flt, Load8xF32(row + 16)));
+        s3 = _mm256_add_ps(s3, _mm256_mul_ps(flt, Load8xF32(row + 24)));
+      }
+      _mm256_storeu_ps(out_row + x, s0);
+      _mm256_storeu_ps(out_row + x + 8, s1);
+      _mm256_storeu_ps(out_row + x + 16, s2);
+      _mm256_storeu_ps(out_row + x + 24, s3);
+    }
+    for (; x + 8 <= flat_w; x += 8) {
+      __m256 s = _mm256_setzero_ps();
+      for (int k = 0; k < support; k++)
+        s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_set1_ps(c[k]), Load8xF32(row_ptrs[k] + x)));
+      _mm256_storeu_ps(out_row + x, s);
+    }
+    for (; x < flat_w; x++) {
+      float sum = 0;
+      for (int k = 0; k < support; k++)
+        sum += c[k] * row_ptrs[k][x];
+      out_row[x] = sum;
+    }
+  }
+}
+
+#endif  // DALI_CPU_X86
+
+template <typename Out, typename In>
+void ResampleVertFixedImpl(Surface2D<Out> out, Surface2D<const In> in,
+                           const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  assert(support > 0);
+  assert(out.channel_stride == 1 && out.strides.x == out.channels);
+#if DALI_CPU_X86
+  switch (GetResamplingSIMD()) {
+    case ResamplingSIMD::AVX2:
+      ResampleVertFixedAVX2(out, in, in_rows, row_coeffs, support);
+      return;
+    case ResamplingSIMD::SSE41:
+      ResampleVertFixedSSE41(out, in, in_rows, row_coeffs, support);
+      return;
+    default:
+      break;
+  }
+#endif
+  ResampleVertFixedScalar(out, in, in_rows, row_coeffs, support);
+}
+
+template <typename Out, typename In>
+void ResampleHorzFixedImpl(Surface2D<Out> out, Surface2D<const In> in,
+                           const int32_t *in_columns, const int16_t *col_coeffs, int support) {
+  assert(support > 0);
+#if DALI_CPU_X86
+  // There's no separate AVX2 variant - one pixel (up to 4 channels) fits in an SSE register
+  if (GetResamplingSIMD() != ResamplingSIMD::None && out.channels <= 4) {
+    VALUE_SWITCH(out.channels, static_channels, (1, 2, 3, 4), (
+      ResampleHorzFixedSSE41<static_channels>(out, in, in_columns, col_coeffs, support);
+    ), (assert(!"Unreachable code")));  // NOLINT
+    return;
+  }
+#endif
+  VALUE_SWITCH(out.channels, static_channels, (1, 2, 3, 4), (
+    ResampleHorzFixedScalar<static_channels>(out, in, in_columns, col_coeffs, support);
+  ), (  // NOLINT
+    ResampleHorzFixedScalar<-1>(out, in, in_columns, col_coeffs, support);
+  ));   // NOLINT
+}
+
+template <typename In>
+bool ResampleHorzFloatImpl(Surface2D<float> out, Surface2D<const In> in,
+                           const int32_t *in_columns, const float *col_coeffs, int support) {
+#if DALI_CPU_X86
+  if (GetResamplingSIMD() != ResamplingSIMD::None && out.channels <= 4 &&
+      out.channel_stride == 1 && in.channel_stride == 1) {
+    VALUE_SWITCH(out.channels, static_channels, (1, 2, 3, 4), (
+      ResampleHorzFloatSSE41<static_channels>(out, in, in_columns, col_coeffs, support);
+    ), (assert(!"Unreachable code")));  // NOLINT
+    return true;
+  }
+#endif
+  return false;
+}
+
+}  // namespace
+
+ResamplingSIMD GetResamplingSIMD() {
+  return CurrentResamplingSIMD().load(std::memory_order_relaxed);
+}
+
+void SetResamplingSIMD(ResamplingSIMD simd) {
+  if (simd > SupportedResamplingSIMD())
+    simd = SupportedResamplingSIMD();
+  CurrentResamplingSIMD() = simd;
+}
+
+void ResampleVertFixed(Surface2D<int16_t> out, Surface2D<const uint8_t> in,
+                       const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  ResampleVertFixedImpl(out, in, in_rows, row_coeffs, support);
+}
+
+void ResampleVertFixed(Surface2D<uint8_t> out, Surface2D<const int16_t> in,
+                       const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  ResampleVertFixedImpl(out, in, in_rows, row_coeffs, support);
+}
+
+void ResampleVertFixed(Surface2D<int16_t> out, Surface2D<const int16_t> in,
+                       const int32_t *in_rows, const int16_t *row_coeffs, int support) {
+  ResampleVertFixedImpl(out, in, in_rows, row_coeffs, support);
+}
+
+void ResampleHorzFixed(Surface2D<int16_t> out, Surface2D<const uint8_t> in,
+                       const int32_t *in_columns, const int16_t *col_coeffs, int support) {
+  ResampleHorzFixedImpl(out, in, in_columns, col_coeffs, support);
+}
+
+void ResampleHorzFixed(Surface2D<uint8_t> out, Surface2D<const int16_t> in,
+                       const int32_t *in_columns, const int16_t *col_coeffs, int support) {
+  ResampleHorzFixedImpl(out, in, in_columns, col_coeffs, support);
+}
+
+void ResampleHorzFixed(Surface2D<int16_t> out, Surface2D<const int16_t> in,
+                       const int32_t *in_columns, const int16_t *col_coeffs, int support) {
+  ResampleHorzFixedImpl(out, in, in_columns, col_coeffs, support);
+}
+
+bool ResampleHorzSIMD(Surface2D<float> out, Surface2D<const float> in,
+                      const int32_t *in_columns, const float *col_coeffs, int support) {
+  return ResampleHorzFloatImpl(out, in, in_columns, col_coeffs, support);
+}
+
+bool ResampleHorzSIMD(Surface2D<float> out, Surface2D<const uint8_t> in,
+                      const int32_t *in_columns, const float *col_coeffs, int support) {
+  return ResampleHorzFloatImpl(out, in, in_columns, col_coeffs, support);
+}
+
+bool ResampleVertSIMD(Surface2D<float> out, Surface2D<const float> in,
+                      const int32_t *in_rows, const float *row_coeffs, int support) {
+#if DALI_CPU_X86
+  if (GetResamplingSIMD() == ResamplingSIMD::AVX2) {
+    ResampleVertFloatAVX2(out, in, in_rows, row_coeffs, support);
+    return true;
+  }
+#endif
+  return false;
+}
+
+bool ResampleVertSIMD(Surface2D<float> out, Surface2D<const uint8_t> in,
+                      const int32_t *in_rows, const float *row_coeffs, int support) {
+#if DALI_CPU_X86
+  if (GetResamplingSIMD() == ResamplingSIMD::AVX2) {
+    ResampleVertFloatAVX2(out, in, in_rows, row_coeffs, support);
+    return true;
+  }
+#endif
+  return false;
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cuda_runtime.h>
+#include <algorithm>
+#include <limits>
 #include "dali/kernels/imgproc/resample/resampling_setup.h"
 #include "dali/kernels/common/block_setup.h"
 
@@ -167,6 +169,77 @@ void SeparableResamplingSetup<2>::SetupSample(
   }
 }
 
+template <>
+void SeparableResamplingSetup<3>::SetupSample(
+    SampleDesc &desc,
+    const TensorShape<tensor_ndim> &in_shape,
+    const ResamplingParams3D &params) {
+  int C = in_shape[3];
+  ivec3 out_size;
+  for (int dim = 0; dim < 3; dim++) {
+    int axis = 2 - dim;
+    desc.in_shape()[axis] = in_shape[dim];
+    int out_extent = params[dim].output_size;
+    out_size[axis] = out_extent == KeepOriginalSize ? in_shape[dim] : out_extent;
+  }
+  desc.out_shape() = out_size;
+  SetFilters(desc, params);
+  ROI roi = ComputeScaleAndROI(desc, params);
+
+  ivec3 filter_support;
+  for (int axis = 0; axis < 3; axis++)
+    filter_support[axis] = std::max(1, desc.filter[axis].support());
+
+  // Try all orders of axes. Each pass costs proportionally to its output size multiplied by
+  // the filter support; the sizes of intermediate buffers are weighted as in the 2D case.
+  const float size_weight = 3;
+  int axes[3] = { 0, 1, 2 };
+  float best_cost = std::numeric_limits<float>::max();
+  do {
+    ivec3 shape = roi.extent();
+    float cost = 0;
+    for (int stage = 0; stage < 3; stage++) {
+      int axis = axes[stage];
+      shape[axis] = out_size[axis];
+      float size = volume(shape);
+      cost += size * filter_support[axis];
+      if (stage < 2)
+        cost += size_weight * size;
+    }
+    if (cost < best_cost) {
+      best_cost = cost;
+      desc.order = { axes[0], axes[1], axes[2] };
+    }
+  } while (std::next_permutation(axes, axes + 3));
+
+  ivec3 tmp_shape = roi.extent();
+  for (int stage = 0; stage < 2; stage++) {
+    int axis = desc.order[stage];
+    tmp_shape[axis] = out_size[axis];
+    desc.tmp_shape(stage) = tmp_shape;
+  }
+
+  for (int stage = 0; stage < 4; stage++) {
+    desc.strides[stage][0] = desc.shapes[stage].x * C;
+    desc.strides[stage][1] = desc.strides[stage][0] * desc.shapes[stage].y;
+    desc.offsets[stage] = 0;
+  }
+  desc.channels = C;
+  // Volumetric resampling is not implemented on the GPU - there are no blocks
+  for (int stage = 0; stage < 3; stage++)
+    desc.block_count[stage] = 0;
+
+  // The first pass reads whole input along the resized axis; other axes are cropped to ROI.
+  for (int axis = 0; axis < 3; axis++) {
+    if (axis == desc.order[0])
+      continue;
+    ptrdiff_t stride = axis == 0 ? desc.channels : desc.strides[0][axis - 1];
+    desc.origin[axis] -= roi.lo[axis];
+    desc.in_offset() += roi.lo[axis] * stride;
+    desc.in_shape()[axis] = roi.extent()[axis];
+  }
+}
+
 template <>
 void BatchResamplingSetup<2>::SetupBatch(
     const TensorListShape<3> &in, const Params &params) {
@@ -15,6 +15,10 @@
 #ifndef DALI_KERNELS_IMGPROC_RESAMPLE_SEPARABLE_CPU_H_
 #define DALI_KERNELS_IMGPROC_RESAMPLE_SEPARABLE_CPU_H_
 
+#include <array>
+#include <cassert>
+#include <type_traits>
+#include "dali/core/math_util.h"
 #include "dali/kernels/imgproc/resample/params.h"
 #include "dali/kernels/imgproc/resample/resampling_filters.cuh"
 #include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
@@ -134,9 +138,16 @@ struct SeparableResampleCPU  {
   using Input =  InTensorCPU<InputElement, tensor_ndim>;
   using Output = OutTensorCPU<OutputElement, tensor_ndim>;
 
+  /**
+   * @brief uint8 -> uint8 resampling uses fixed-point arithmetic with int16 intermediate data
+   */
+  static constexpr bool kFixedPointTypes =
+      std::is_same<OutputElement, uint8_t>::value && std::is_same<InputElement, uint8_t>::value;
+  using FixedPointIntermediate = std::conditional_t<kFixedPointTypes, int16_t, float>;
+
   KernelRequirements Setup(KernelContext &context,
                            const Input &input,
-                           const ResamplingParams2D &params) {
+                           const ResamplingParamsND<spatial_ndim> &params) {
     setup.Setup(input.shape, params);
 
     TensorShape<tensor_ndim> out_shape =
@@ -146,6 +157,15 @@ struct SeparableResampleCPU  {
     se.add<float>(AllocType::Host, setup.memory.tmp_size);
     se.add<float>(AllocType::Host, setup.memory.coeffs_size);
     se.add<int32_t>(AllocType::Host, setup.memory.indices_size);
+    if (CanUseFixedPoint())
+      se.add<int16_t>(AllocType::Host, setup.memory.coeffs_size);
+    if (CanRunInBands()) {
+      // RunBand keeps the filters for both axes at the same time
+      se.add<float>(AllocType::Host, setup.memory.coeffs_size);
+      se.add<int32_t>(AllocType::Host, setup.memory.indices_size);
+      if (CanUseFixedPoint())
+        se.add<int16_t>(AllocType::Host, setup.memory.coeffs_size);
+    }
 
     TensorListShape<> out_tls({ out_shape });
 
@@ -162,7 +182,8 @@ struct SeparableResampleCPU  {
            const ResamplingParamsND<spatial_ndim> &params) {
     auto &desc = setup.desc;
 
-    desc.set_base_pointers(input.data, static_cast<char*>(nullptr), output.data);
+    std::array<char *, num_tmp_buffers> tmp_ptrs = {};  // intermediate buffers are in scratchpad
+    desc.set_base_pointers(input.data, tmp_ptrs, output.data);
 
     auto in_ROI = as_surface_channel_last(input);
     in_ROI.size = desc.in_shape();
@@ -174,55 +195,237 @@ struct SeparableResampleCPU  {
 
     if (setup.IsPureNN(desc)) {
       ResampleNN(out_ROI, in_ROI, desc.origin, desc.scale);
+    } else if (UseFixedPoint()) {
+      RunPasses<FixedPointIntermediate>(context, out_ROI, in_ROI);
     } else {
-      TensorShape<tensor_ndim> tmp_shapes[num_tmp_buffers];
-      for (int i = 0; i < num_tmp_buffers; i++) {
-        tmp_shapes[i] = shape_cat(vec2shape(desc.tmp_shape(i)), desc.channels);
-      }
+      RunPasses<float>(context, out_ROI, in_ROI);
+    }
+  }
 
-      float *tmp_buf = context.scratchpad->Allocate<float>(AllocType::Host, setup.memory.tmp_size);
-      void *filter_mem = context.scratchpad->Allocate<int32_t>(AllocType::Host,
-          setup.memory.coeffs_size + setup.memory.indices_size);
+  /**
+   * @brief Tells whether any of the axes uses Nearest Neighbor filter
+   */
+  bool HasNNPass() const {
+    for (auto flt_type : setup.desc.filter_type)
+      if (flt_type == ResamplingFilterType::Nearest)
+        return true;
+    return false;
+  }
 
-      Surface<spatial_ndim, float> tmp_surf = {}, tmp_prev = {};
+  /**
+   * @brief Tells whether the resampling is done in fixed point
+   *
+   * Fixed point is used for uint8 -> uint8 resampling, unless there's a Nearest Neighbor pass.
+   * Without vectorized kernels, the fixed point arithmetic has no advantage over floats.
+   */
+  bool UseFixedPoint() const {
+    return CanUseFixedPoint() && GetResamplingSIMD() != ResamplingSIMD::None;
+  }
 
-      for (int stage = 0; stage < spatial_ndim; stage++) {
-        if (stage < spatial_ndim - 1) {
-          tmp_surf.data = tmp_buf + (stage & 1 ? setup.memory.tmp_odd_offset : 0);
-          tmp_surf.size = setup.desc.tmp_shape(stage);
-          tmp_surf.channels = setup.desc.channels;
+  /**
+   * @brief Tells whether the output can be processed in independent bands with RunBand
+   *
+   * Bands are supported for 2D resampling with non-NN filters on both axes.
+   */
+  bool CanRunInBands() const {
+    return spatial_ndim == 2 && !HasNNPass();
+  }
+
+  /**
+   * @brief Calculates output rows [row_begin, row_end) (outermost spatial dimension)
+   *
+   * Bands of the same sample don't depend on each other and can be processed concurrently,
+   * provided that each call gets a separate scratchpad. The first pass only processes the
+   * part of the input (or intermediate) data that contributes to the band, so the overhead
+   * of splitting is limited to filter support at the band edges.
+   *
+   * The result is identical to that of a single call to Run.
+   * Only valid if CanRunInBands() returns true.
+   */
+  void RunBand(KernelContext &context,
+               const Output &output,
+               const Input &input,
+               const ResamplingParamsND<spatial_ndim> &params,
+               int row_begin, int row_end) {
+    if (UseFixedPoint())
+      RunBandImpl<FixedPointIntermediate>(context, output, input, row_begin, row_end);
+    else
+      RunBandImpl<float>(context, output, input, row_begin, row_end);
+  }
 
-          tmp_surf.channel_stride = 1;
-          tmp_surf.strides.x = tmp_surf.channels;
-          for (int i = 1; i < spatial_ndim; i++) {
-            tmp_surf.strides[i] = tmp_surf.strides[i-1] * tmp_surf.size[i-1];
-          }
+ private:
+  bool CanUseFixedPoint() const {
+    return kFixedPointTypes && !HasNNPass();
+  }
+
+  template <typename Intermediate>
+  void RunPasses(KernelContext &context,
+                 const Surface<spatial_ndim, OutputElement> &out_ROI,
+                 const Surface<spatial_ndim, const InputElement> &in_ROI) {
+    auto &desc = setup.desc;
+    auto *tmp_buf = reinterpret_cast<Intermediate *>(
+        context.scratchpad->Allocate<float>(AllocType::Host, setup.memory.tmp_size));
+    void *filter_mem = context.scratchpad->Allocate<int32_t>(AllocType::Host,
+        setup.memory.coeffs_size + setup.memory.indices_size);
+    int16_t *fixed_coeffs = std::is_same<Intermediate, int16_t>::value
+        ? context.scratchpad->Allocate<int16_t>(AllocType::Host, setup.memory.coeffs_size)
+        : nullptr;
+
+    Surface<spatial_ndim, Intermediate> tmp_surf = {}, tmp_prev = {};
+
+    for (int stage = 0; stage < spatial_ndim; stage++) {
+      if (stage < spatial_ndim - 1) {
+        tmp_surf.data = tmp_buf + (stage & 1 ? setup.memory.tmp_odd_offset : 0);
+        tmp_surf.size = desc.tmp_shape(stage);
+        tmp_surf.channels = desc.channels;
+
+        tmp_surf.channel_stride = 1;
+        tmp_surf.strides.x = tmp_surf.channels;
+        for (int i = 1; i < spatial_ndim; i++) {
+          tmp_surf.strides[i] = tmp_surf.strides[i-1] * tmp_surf.size[i-1];
         }
+      }
+
+      if (stage == 0)  // in -> tmp(0)
+        ResamplePass<Intermediate, InputElement>(
+            tmp_surf, in_ROI, filter_mem, fixed_coeffs, desc.order[stage]);
+      else if (stage < spatial_ndim - 1)  // tmp(i) -> tmp(i+1)
+        ResamplePass<Intermediate, Intermediate>(
+            tmp_surf, tmp_prev, filter_mem, fixed_coeffs, desc.order[stage]);
+      else  // tmp(spatial_ndim-1) -> out
+        ResamplePass<OutputElement, Intermediate>(
+            out_ROI, tmp_surf, filter_mem, fixed_coeffs, desc.order[stage]);
+
+      tmp_prev = tmp_surf;
+    }
+  }
 
-        if (stage == 0)  // in -> tmp(0)
-          ResamplePass<float, InputElement>(tmp_surf, in_ROI, filter_mem, desc.order[stage]);
-        else if (stage < spatial_ndim - 1)  // tmp(i) -> tmp(i+1)
-          ResamplePass<float, float>(tmp_surf, tmp_prev, filter_mem, desc.order[stage]);
-        else  // tmp(spatial_ndim-1) -> out
-          ResamplePass<OutputElement, float>(out_ROI, tmp_surf, filter_mem, desc.order[stage]);
+  template <typename Intermediate, int D = spatial_ndim>
+  std::enable_if_t<D != 2> RunBandImpl(KernelContext &, const Output &, const Input &,
+                                       int, int) {
+    assert(!"Banded processing is only implemented for 2D resampling");
+  }
 
-        tmp_prev = tmp_surf;
+  template <typename Intermediate, int D = spatial_ndim>
+  std::enable_if_t<D == 2> RunBandImpl(KernelContext &context,
+                                       const Output &output,
+                                       const Input &input,
+                                       int row_begin, int row_end) {
+    assert(CanRunInBands());
+    // local copy - other bands of the same sample may be processed concurrently
+    auto desc = setup.desc;
+
+    desc.set_base_pointers(input.data, static_cast<char*>(nullptr), output.data);
+
+    auto in_ROI = as_surface_channel_last(input);
+    in_ROI.size = desc.in_shape();
+    in_ROI.data = desc.template in_ptr<InputElement>();
+
+    auto out_ROI = as_surface_channel_last(output);
+    out_ROI.size = desc.out_shape();
+    out_ROI.data = desc.template out_ptr<OutputElement>();
+
+    assert(row_begin >= 0 && row_begin < row_end && row_end <= out_ROI.size.y);
+    auto out_band = out_ROI;
+    out_band.data = &out_ROI(0, row_begin);
+    out_band.size.y = row_end - row_begin;
+
+    auto *tmp_buf = reinterpret_cast<Intermediate *>(
+        context.scratchpad->Allocate<float>(AllocType::Host, setup.memory.tmp_size));
+    size_t filter_mem_size = setup.memory.coeffs_size + setup.memory.indices_size;
+    int32_t *vert_mem = context.scratchpad->Allocate<int32_t>(AllocType::Host, filter_mem_size);
+    int32_t *horz_mem = context.scratchpad->Allocate<int32_t>(AllocType::Host, filter_mem_size);
+
+    int out_h = desc.out_shape()[1];
+    int out_w = desc.out_shape()[0];
+    int32_t *in_rows = vert_mem;
+    float *row_coeffs = reinterpret_cast<float*>(vert_mem + out_h);
+    int vert_support = desc.filter[1].support();
+    InitializeResamplingFilter(in_rows, row_coeffs, out_h, desc.origin[1], desc.scale[1],
+                               desc.filter[1]);
+
+    int32_t *in_columns = horz_mem;
+    float *col_coeffs = reinterpret_cast<float*>(horz_mem + out_w);
+    int horz_support = desc.filter[0].support();
+    InitializeResamplingFilter(in_columns, col_coeffs, out_w, desc.origin[0], desc.scale[0],
+                               desc.filter[0]);
+
+    // float or fixed point coefficients, depending on the intermediate type
+    using Coeff = std::conditional_t<std::is_same<Intermediate, int16_t>::value, int16_t, float>;
+    const Coeff *vert_coeffs, *horz_coeffs;
+    GetCoeffs(vert_coeffs, context, row_coeffs, out_h, vert_support);
+    GetCoeffs(horz_coeffs, context, col_coeffs, out_w, horz_support);
+
+    Surface2D<Intermediate> tmp_surf = {};
+    tmp_surf.data = tmp_buf;
+    tmp_surf.channels = desc.channels;
+    tmp_surf.channel_stride = 1;
+    tmp_surf.strides.x = tmp_surf.channels;
+
+    const int32_t *band_rows = in_rows + row_begin;
+    const Coeff *band_row_coeffs = vert_coeffs + row_begin * vert_support;
+
+    if (desc.order[0] == 1) {
+      // vertical pass first - the intermediate band has the same rows as the output band
+      tmp_surf.size = { desc.tmp_shape(0)[0], out_band.size.y };
+      tmp_surf.strides.y = tmp_surf.strides.x * tmp_surf.size.x;
+      ResampleAxis(tmp_surf, in_ROI, band_rows, band_row_coeffs, vert_support, 1);
+      ResampleAxis(out_band, tmp_surf, in_columns, horz_coeffs, horz_support, 0);
+    } else {
+      // horizontal pass first - only the input rows used by the band are processed
+      int in_h = in_ROI.size.y;
+      int lo = band_rows[0], hi = band_rows[0];
+      for (int y = 1; y < out_band.size.y; y++) {
+        if (band_rows[y] < lo) lo = band_rows[y];
+        if (band_rows[y] > hi) hi = band_rows[y];
       }
+      hi += vert_support;
+      int r0 = clamp(lo, 0, in_h - 1);
+      int r1 = clamp(hi, r0 + 1, in_h);
+
+      auto in_band = in_ROI;
+      in_band.data = &in_ROI(0, r0);
+      in_band.size.y = r1 - r0;
+
+      tmp_surf.size = { desc.tmp_shape(0)[0], r1 - r0 };
+      tmp_surf.strides.y = tmp_surf.strides.x * tmp_surf.size.x;
+      ResampleAxis(tmp_surf, in_band, in_columns, horz_coeffs, horz_support, 0);
+
+      // Make the row indices relative to the intermediate band. Clamping within the band
+      // gives the same result as clamping within the whole input - see r0, r1 above.
+      for (int y = row_begin; y < row_end; y++)
+        in_rows[y] -= r0;
+      ResampleAxis(out_band, tmp_surf, band_rows, band_row_coeffs, vert_support, 1);
     }
   }
 
+  void GetCoeffs(const float *&out, KernelContext &, const float *coeffs, int, int) {
+    out = coeffs;
+  }
+
+  void GetCoeffs(const int16_t *&out, KernelContext &context, const float *coeffs,
+                 int out_size, int support) {
+    int16_t *fixed = context.scratchpad->Allocate<int16_t>(AllocType::Host,
+                                                           setup.memory.coeffs_size);
+    ConvertResamplingFilterToFixedPoint(fixed, coeffs, out_size, support);
+    out = fixed;
+  }
+
   template <typename PassOutput, typename PassInput>
-  void ResamplePass(const Surface2D<PassOutput> &out,
-                    const Surface2D<const PassInput> &in,
+  void ResamplePass(const Surface<spatial_ndim, PassOutput> &out,
+                    const Surface<spatial_ndim, const PassInput> &in,
                     void *mem,
+                    int16_t *fixed_coeffs,
                     int axis) {
     auto &desc = setup.desc;
 
     if (desc.filter_type[axis] == ResamplingFilterType::Nearest) {
       // use specialized NN resampling pass - should be faster
-      ResampleNN(out, in,
-        desc.origin,
-        { (axis == 0 ? desc.scale.x : 1.0f), (axis == 1 ? desc.scale.y : 1.0f) });
+      // other axes are not resampled in this pass - hence, no offset and unit scale
+      vec<spatial_ndim> origin = 0.0f, scale = 1.0f;
+      origin[axis] = desc.origin[axis];
+      scale[axis] = desc.scale[axis];
+      ResampleNN(out, in, origin, scale);
     } else {
       int32_t *indices = static_cast<int32_t*>(mem);
       int out_size = desc.out_shape()[axis];
@@ -233,10 +436,34 @@ struct SeparableResampleCPU  {
                                  desc.origin[axis], desc.scale[axis],
                                  desc.filter[axis]);
 
-      ResampleAxis(out, in, indices, coeffs, support, axis);
+      // int16 is also a valid input/output type - only uint8 resampling has fixed-point passes
+      using is_fixed = std::integral_constant<bool, kFixedPointTypes &&
+          (std::is_same<PassOutput, int16_t>::value || std::is_same<PassInput, int16_t>::value)>;
+      ResampleFiltered(is_fixed(), out, in, indices, coeffs, fixed_coeffs, support, axis);
     }
   }
 
+  template <typename PassOutput, typename PassInput>
+  void ResampleFiltered(std::false_type,
+                        const Surface<spatial_ndim, PassOutput> &out,
+                        const Surface<spatial_ndim, const PassInput> &in,
+                        const int32_t *indices, const float *coeffs, int16_t *,
+                        int support, int axis) {
+    ResampleAxis(out, in, indices, coeffs, support, axis);
+  }
+
+  template <typename PassOutput, typename PassInput>
+  void ResampleFiltered(std::true_type,
+                        const Surface<spatial_ndim, PassOutput> &out,
+                        const Surface<spatial_ndim, const PassInput> &in,
+                        const int32_t *indices, const float *coeffs, int16_t *fixed_coeffs,
+                        int support, int axis) {
+    assert(fixed_coeffs);
+    ConvertResamplingFilterToFixedPoint(fixed_coeffs, coeffs, out.size[axis], support);
+    ResampleAxis(out, in, indices, fixed_coeffs, support, axis);
+  }
+
+ public:
   using ResamplingSetup = ResamplingSetupSingleImage<spatial_ndim>;
   ResamplingSetup setup;
   static constexpr int num_tmp_buffers = ResamplingSetup::num_tmp_buffers;
@@ -0,0 +1,114 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/signal/resampling.h"
+#include "dali/core/cpu_features.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+namespace resampling {
+
+namespace {
+
+/**
+ * @brief Position of the output sample in the input: the first input sample used by it
+ *        and the phase of the filter
+ */
+struct PolyphasePosition {
+  PolyphasePosition(int64_t out_idx, const PolyphaseFilter &filter)
+  : base_step(filter.in_step / filter.out_step), phase_step(filter.in_step % filter.out_step),
+    out_step(filter.out_step) {
+    int64_t pos = out_idx * filter.in_step;
+    first = pos / filter.out_step - filter.lobes;
+    phase = pos % filter.out_step;
+  }
+
+  inline void next() {
+    first += base_step;
+    phase += phase_step;
+    if (phase >= out_step) {
+      phase -= out_step;
+      first++;
+    }
+  }
+
+  int64_t first, phase;
+  int64_t base_step, phase_step, out_step;
+};
+
+void ResamplePolyphaseInteriorGeneric(float *out, int64_t out_begin, int64_t out_end,
+                                      const float *in, const PolyphaseFilter &filter) {
+  const int taps = filter.taps;
+  PolyphasePosition pos(out_begin, filter);
+  for (int64_t j = out_begin; j < out_end; j++, pos.next()) {
+    const float *x = in + pos.first;
+    const float *coeffs = filter.phase(pos.phase);
+    // independent partial sums - the number of taps is a multiple of 8
+    float acc[8] = {};
+    for (int t = 0; t < taps; t += 8) {
+      for (int k = 0; k < 8; k++)
+        acc[k] += x[t + k] * coeffs[t + k];
+    }
+    out[j - out_begin] =
+        ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+  }
+}
+
+#if DALI_CPU_X86
+
+DALI_TARGET_AVX2_FMA
+void ResamplePolyphaseInteriorAVX2(float *out, int64_t out_begin, int64_t out_end,
+                                   const float *in, const PolyphaseFilter &filter) {
+  const int taps = filter.taps;
+  PolyphasePosition pos(out_begin, filter);
+  for (int64_t j = out_begin; j < out_end; j++, pos.next()) {
+    const float *x = in + pos.first;
+    const float *coeffs = filter.phase(pos.phase);
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    int t = 0;
+    for (; t + 16 <= taps; t += 16) {
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + t), _mm256_loadu_ps(coeffs + t), acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + t + 8), _mm256_loadu_ps(coeffs + t + 8), acc1);
+    }
+    if (t < taps)
+      acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + t), _mm256_loadu_ps(coeffs + t), acc0);
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    out[j - out_begin] = _mm_cvtss_f32(sum);
+  }
+}
+
+#endif
+
+}  // namespace
+
+void ResamplePolyphaseInterior(float *out, int64_t out_begin, int64_t out_end,
+                               const float *in, const PolyphaseFilter &filter) {
+#if DALI_CPU_X86
+  const auto &cpu = GetCPUFeatures();
+  if (cpu.avx2 && cpu.fma) {
+    ResamplePolyphaseInteriorAVX2(out, out_begin, out_end, in, filter);
+    return;
+  }
+#endif
+  ResamplePolyphaseInteriorGeneric(out, out_begin, out_end, in, filter);
+}
+
+}  // namespace resampling
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
@@ -17,9 +17,15 @@
 
 #include <cmath>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include "dali/core/api_helper.h"
 #include "dali/core/math_util.h"
+#include "dali/core/util.h"
 #include "dali/core/small_vector.h"
 #include "dali/core/convert.h"
 #include "dali/core/static_switch.h"
@@ -55,7 +61,7 @@ struct ResamplingWindow {
   std::vector<float> lookup;
 };
 
-void windowed_sinc(ResamplingWindow &window,
+inline void windowed_sinc(ResamplingWindow &window,
     int coeffs, int lobes, std::function<double(double)> envelope = Hann) {
   assert(coeffs > 1 && lobes > 0 && "Degenerate parameters specified.");
   float scale = 2.0f * lobes / (coeffs - 1);
@@ -79,11 +85,107 @@ inline int64_t resampled_length(int64_t in_length, double in_rate, double out_ra
   return std::ceil(in_length * out_rate / in_rate);
 }
 
+inline int64_t gcd(int64_t a, int64_t b) {
+  while (b) {
+    int64_t r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+/**
+ * @brief Filter taps for resampling with a rational ratio `in_rate / out_rate = in_step / out_step`
+ *
+ * Output sample `j` corresponds to the input position `x = j * in_step / out_step`;
+ * the fractional part of `x` takes one of `out_step` values (phases).
+ * Each phase has `taps` coefficients, applied to the input samples starting at
+ * `floor(x) - lobes`. The number of taps is padded with zeros to a multiple of 8.
+ */
+struct PolyphaseFilter {
+  int64_t in_step = 1, out_step = 1;
+  int lobes = 0, taps = 0;
+  std::vector<float> coeffs;
+
+  const float *phase(int64_t p) const {
+    return coeffs.data() + p * taps;
+  }
+
+  void Initialize(const ResamplingWindow &window, int64_t in_step, int64_t out_step) {
+    this->in_step = in_step;
+    this->out_step = out_step;
+    lobes = window.lobes;
+    taps = align_up(2 * lobes + 1, 8);
+    coeffs.resize(out_step * taps);
+    for (int64_t p = 0; p < out_step; p++) {
+      double frac = static_cast<double>(p) / out_step;
+      float *phase_coeffs = coeffs.data() + p * taps;
+      for (int t = 0; t < taps; t++) {
+        float x = (t - lobes) - frac;
+        phase_coeffs[t] = std::abs(x) <= lobes ? window(x) : 0.0f;
+      }
+    }
+  }
+
+  /**
+   * @brief Range of outputs, for which all taps fall within the input of length `n_in`
+   */
+  std::pair<int64_t, int64_t> interior(int64_t n_in) const {
+    // floor(j * in_step / out_step) >= lobes
+    int64_t begin = (lobes * out_step + in_step - 1) / in_step;
+    // floor(j * in_step / out_step) - lobes + taps <= n_in
+    int64_t last_base = n_in - taps + lobes;
+    int64_t end = last_base < 0 ? 0 : ((last_base + 1) * out_step + in_step - 1) / in_step;
+    return { begin, std::max(begin, end) };
+  }
+};
+
+/**
+ * @brief Computes single-channel output samples `[out_begin, out_end)` with a vectorized dot
+ *        product; all taps for these outputs must fall within the input.
+ *
+ * `out` points to the output sample `out_begin`; `in` points to the beginning of the signal.
+ */
+DLL_PUBLIC void ResamplePolyphaseInterior(float *out, int64_t out_begin, int64_t out_end,
+                                          const float *in, const PolyphaseFilter &filter);
+
 struct Resampler {
   ResamplingWindow window;
 
+  /**
+   * @brief Maximum number of phases for which the polyphase filter is used; the ratios
+   *        which would require more phases (or are not rational) use the windowed sinc
+   *        evaluated for each tap. 0 disables the polyphase filter.
+   */
+  int max_phases = 1024;
+
   void Initialize(int lobes = 16, int lookup_size = 2048) {
     windowed_sinc(window, lookup_size, lobes);
+    std::lock_guard<std::mutex> guard(polyphase_mutex_);
+    polyphase_filters_.clear();
+  }
+
+  /**
+   * @brief Returns the polyphase filter for given rates, computing it on first use,
+   *        or nullptr if the ratio is not rational with at most `max_phases` phases
+   */
+  const PolyphaseFilter *GetPolyphaseFilter(double in_rate, double out_rate) const {
+    if (max_phases <= 0 || in_rate != std::round(in_rate) || out_rate != std::round(out_rate) ||
+        in_rate > (1 << 30) || out_rate > (1 << 30))
+      return nullptr;
+    int64_t in_step = in_rate, out_step = out_rate;
+    int64_t g = gcd(in_step, out_step);
+    in_step /= g;
+    out_step /= g;
+    if (out_step > max_phases)
+      return nullptr;
+    std::lock_guard<std::mutex> guard(polyphase_mutex_);
+    auto &filter = polyphase_filters_[{in_step, out_step}];
+    if (!filter) {
+      filter = std::make_unique<PolyphaseFilter>();
+      filter->Initialize(window, in_step, out_step);
+    }
+    return filter.get();
   }
 
   /**
@@ -98,6 +200,10 @@ struct Resampler {
         Out *__restrict__ out, int64_t out_begin, int64_t out_end, double out_rate,
         const float *__restrict__ in, int64_t n_in, double in_rate) const {
     assert(out_rate > 0 && in_rate > 0 && "Sampling rate must be positive");
+    if (auto *filter = GetPolyphaseFilter(in_rate, out_rate)) {
+      ResamplePolyphase(out, out_begin, out_end, in, n_in, *filter);
+      return;
+    }
     int64_t in_pos = 0;
     int64_t block = 1 << 10;  // still leaves 13 significant bits for fractional part
     double scale = in_rate / out_rate;
@@ -156,6 +262,12 @@ struct Resampler {
     const int num_channels = static_channels < 0 ? dynamic_num_channels : static_channels;
     assert(num_channels > 0);
 
+    if (auto *filter = GetPolyphaseFilter(in_rate, out_rate)) {
+      ResamplePolyphase<static_channels>(out, out_begin, out_end, in, n_in, *filter,
+                                         num_channels);
+      return;
+    }
+
     int64_t in_pos = 0;
     int64_t block = 1 << 10;  // still leaves 13 significant bits for fractional part
     double scale = in_rate / out_rate;
@@ -216,6 +328,82 @@ struct Resampler {
       (Resample<-1, Out>(out, out_begin, out_end, out_rate,
         in, n_in, in_rate, num_channels)));
   }
+
+ private:
+  /**
+   * @brief Computes single-channel output samples with the polyphase filter
+   *
+   * The samples whose taps fall within the input are computed in blocks with a vectorized
+   * dot product; the remaining ones, near the ends of the input, skip the missing taps.
+   */
+  template <typename Out>
+  static void ResamplePolyphase(Out *__restrict__ out, int64_t out_begin, int64_t out_end,
+                                const float *__restrict__ in, int64_t n_in,
+                                const PolyphaseFilter &filter) {
+    auto interior = filter.interior(n_in);
+    int64_t interior_begin = clamp(interior.first, out_begin, out_end);
+    int64_t interior_end = clamp(interior.second, interior_begin, out_end);
+    ResamplePolyphase<1>(out, out_begin, interior_begin, in, n_in, filter, 1);
+    constexpr int64_t kBlock = 256;
+    float tmp[kBlock];
+    for (int64_t block = interior_begin; block < interior_end; block += kBlock) {
+      int64_t block_end = std::min(block + kBlock, interior_end);
+      if (std::is_same<Out, float>::value) {
+        ResamplePolyphaseInterior(reinterpret_cast<float *>(out + block), block, block_end,
+                                  in, filter);
+      } else {
+        ResamplePolyphaseInterior(tmp, block, block_end, in, filter);
+        for (int64_t j = block; j < block_end; j++)
+          out[j] = ConvertSatNorm<Out>(tmp[j - block]);
+      }
+    }
+    ResamplePolyphase<1>(out, interior_end, out_end, in, n_in, filter, 1);
+  }
+
+  /**
+   * @brief Computes multi-channel output samples with the polyphase filter, skipping
+   *        the taps which fall outside of the input
+   */
+  template <int static_channels, typename Out>
+  static void ResamplePolyphase(Out *__restrict__ out, int64_t out_begin, int64_t out_end,
+                                const float *__restrict__ in, int64_t n_in,
+                                const PolyphaseFilter &filter, int dynamic_num_channels) {
+    const int num_channels = static_channels < 0 ? dynamic_num_channels : static_channels;
+    SmallVector<float, (static_channels < 0 ? 16 : static_channels)> tmp;
+    tmp.resize(num_channels);
+    int64_t pos = out_begin * filter.in_step;
+    int64_t base = pos / filter.out_step;
+    int64_t phase = pos % filter.out_step;
+    int64_t base_step = filter.in_step / filter.out_step;
+    int64_t phase_step = filter.in_step % filter.out_step;
+    for (int64_t j = out_begin; j < out_end; j++) {
+      const float *coeffs = filter.phase(phase);
+      int64_t first = base - filter.lobes;
+      int t0 = std::max<int64_t>(-first, 0);
+      int t1 = std::min<int64_t>(n_in - first, filter.taps);
+      for (int c = 0; c < num_channels; c++)
+        tmp[c] = 0;
+      for (int t = t0; t < t1; t++) {
+        float w = coeffs[t];
+        const float *in_sample = in + (first + t) * num_channels;
+        for (int c = 0; c < num_channels; c++)
+          tmp[c] += in_sample[c] * w;
+      }
+      for (int c = 0; c < num_channels; c++)
+        out[j * num_channels + c] = ConvertSatNorm<Out>(tmp[c]);
+
+      base += base_step;
+      phase += phase_step;
+      if (phase >= filter.out_step) {
+        phase -= filter.out_step;
+        base++;
+      }
+    }
+  }
+
+  mutable std::mutex polyphase_mutex_;
+  mutable std::map<std::pair<int64_t, int64_t>, std::unique_ptr<PolyphaseFilter>>
+      polyphase_filters_;
 };
 
 }  // namespace resampling
@@ -13,8 +13,9 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
-#include <vector>
 #include <numeric>
+#include <utility>
+#include <vector>
 #include "dali/kernels/signal/resampling.h"
 
 namespace dali {
@@ -103,6 +104,73 @@ TEST(ResampleSinc, MultiChannel) {
     "\n  RMS error: " << err << std::endl;
 }
 
+TEST(ResampleSinc, PolyphaseVsWindowedSinc) {
+  std::pair<double, double> rates[] = {
+    { 48000, 16000 }, { 44100, 16000 }, { 22050, 16000 }, { 16000, 22050 }, { 8000, 44100 }
+  };
+  for (auto rate : rates) {
+    for (int ch : { 1, 2, 5 }) {
+      int n_in = 3000;
+      int64_t n_out = resampled_length(n_in, rate.first, rate.second);
+      std::vector<float> in(n_in * ch);
+      for (int c = 0; c < ch; c++)
+        TestWave(in.data() + c, n_in, ch, 0.1f * (1 + c * 0.012345));
+      std::vector<float> sinc(n_out * ch), out(n_out * ch);
+      std::vector<int16_t> out_int(n_out * ch);
+
+      Resampler R;
+      R.Initialize(16);
+      R.max_phases = 0;
+      ASSERT_EQ(R.GetPolyphaseFilter(rate.first, rate.second), nullptr);
+      R.Resample(sinc.data(), 0, n_out, rate.second, in.data(), n_in, rate.first, ch);
+
+      R.max_phases = 1024;
+      ASSERT_NE(R.GetPolyphaseFilter(rate.first, rate.second), nullptr);
+      // in parts, to check that the outputs can be computed in any range
+      int64_t split = n_out / 3;
+      R.Resample(out.data(), 0, split, rate.second, in.data(), n_in, rate.first, ch);
+      R.Resample(out.data(), split, n_out, rate.second, in.data(), n_in, rate.first, ch);
+      R.Resample(out_int.data(), 0, n_out, rate.second, in.data(), n_in, rate.first, ch);
+
+      for (int64_t j = 0; j < n_out; j++) {
+        // the same filter, evaluated at the exact input position
+        double x = j * rate.first / rate.second;
+        for (int c = 0; c < ch; c++) {
+          double ref = 0;
+          for (int64_t i = std::ceil(x) - 16; i <= std::floor(x) + 16; i++) {
+            if (i >= 0 && i < n_in)
+              ref += in[i * ch + c] * R.window(i - x);
+          }
+          int64_t idx = j * ch + c;
+          ASSERT_NEAR(out[idx], ref, 1e-5) << "@" << idx << ", " << rate.first << " -> "
+                                           << rate.second << " Hz, " << ch << " channels";
+          // the windowed sinc accumulates the position in single precision
+          ASSERT_NEAR(sinc[idx], ref, 2e-3) << "@" << idx;
+          ASSERT_NEAR(out_int[idx], ConvertSatNorm<int16_t>(out[idx]), 1) << "@" << idx;
+        }
+      }
+    }
+  }
+}
+
+TEST(ResampleSinc, PolyphaseFilterSelection) {
+  Resampler R;
+  R.Initialize(16);
+  auto *f = R.GetPolyphaseFilter(48000, 16000);
+  ASSERT_NE(f, nullptr);
+  EXPECT_EQ(f->in_step, 3);
+  EXPECT_EQ(f->out_step, 1);
+  EXPECT_EQ(f->taps % 8, 0);
+  EXPECT_EQ(R.GetPolyphaseFilter(48000, 16000), f);  // computed once per rate pair
+  f = R.GetPolyphaseFilter(44100, 16000);
+  ASSERT_NE(f, nullptr);
+  EXPECT_EQ(f->in_step, 441);
+  EXPECT_EQ(f->out_step, 160);
+  // non-integer rates and too many phases use the windowed sinc
+  EXPECT_EQ(R.GetPolyphaseFilter(44100, 16000.5), nullptr);
+  EXPECT_EQ(R.GetPolyphaseFilter(22050, 22053), nullptr);
+}
+
 }  // namespace resampling
 }  // namespace signal
 }  // namespace kernels
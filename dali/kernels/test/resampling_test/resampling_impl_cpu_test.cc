@@ -14,10 +14,13 @@
 
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
+#include <random>
+#include <vector>
 #include "dali/kernels/test/test_data.h"
 #include "dali/test/tensor_test_utils.h"
 #include "dali/kernels/imgproc/resample/resampling_filters.cuh"
 #include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
+#include "dali/kernels/imgproc/resample/params.h"
 #include "dali/test/mat2tensor.h"
 #include "dali/core/tensor_shape_print.h"
 
@@ -238,5 +241,154 @@ TEST(ResampleCPU, Linear) {
 }
 
 
+TEST(ResampleCPU, FixedPointCoeffs) {
+  int w = 77;
+  int in_w = 300;
+  float scale = static_cast<float>(in_w) / w;
+  for (auto filter : { GetResamplingFiltersCPU()->Triangular(scale),
+                       GetResamplingFiltersCPU()->Cubic(),
+                       GetResamplingFiltersCPU()->Lanczos3(scale) }) {
+    int support = filter.support();
+    std::vector<float> coeffs(w * support);
+    std::vector<int16_t> fixed(w * support);
+    std::vector<int> idx(w);
+    InitializeResamplingFilter(idx.data(), coeffs.data(), w, 0, scale, filter);
+    ConvertResamplingFilterToFixedPoint(fixed.data(), coeffs.data(), w, support);
+    for (int i = 0; i < w; i++) {
+      int sum = 0;
+      for (int k = 0; k < support; k++) {
+        sum += fixed[i*support + k];
+        // the rounding error of the whole filter is accumulated in one of the coefficients
+        EXPECT_NEAR(fixed[i*support + k], coeffs[i*support + k] * (1 << kResamplingCoeffBits),
+                    0.5f * support + 1) << "at " << i << ", " << k;
+      }
+      EXPECT_EQ(sum, 1 << kResamplingCoeffBits) << "Fixed point coefficients must sum to 1";
+    }
+  }
+}
+
+namespace {
+
+struct ResamplingSIMDGuard {
+  ResamplingSIMDGuard() : level(GetResamplingSIMD()) {}
+  ~ResamplingSIMDGuard() { SetResamplingSIMD(level); }
+  ResamplingSIMD level;
+};
+
+template <typename T>
+Surface2D<T> MakeSurfaceHWC(std::vector<std::remove_const_t<T>> &data,
+                            int w, int h, int c) {
+  data.resize(w * h * c);
+  return { data.data(), w, h, c, c, w * c, 1 };
+}
+
+inline void ConvertFilter(std::vector<float> &out, const std::vector<float> &coeffs, int, int) {
+  out = coeffs;
+}
+
+inline void ConvertFilter(std::vector<int16_t> &out, const std::vector<float> &coeffs,
+                          int out_size, int support) {
+  ConvertResamplingFilterToFixedPoint(out.data(), coeffs.data(), out_size, support);
+}
+
+/**
+ * @brief Runs a resampling pass at all SIMD levels and checks that the results are identical
+ */
+template <typename Out, typename In, typename Coeff, typename Pass>
+void TestSIMDLevels(int axis, int out_len, int in_len, int channels, ResamplingFilterType type,
+                    Pass &&pass) {
+  ResamplingSIMDGuard guard;
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  int in_w = axis == 0 ? in_len : 53, in_h = axis == 1 ? in_len : 11;
+  int out_w = axis == 0 ? out_len : in_w, out_h = axis == 1 ? out_len : in_h;
+
+  std::vector<In> in_data;
+  auto in = MakeSurfaceHWC<const In>(in_data, in_w, in_h, channels);
+  for (auto &x : in_data)
+    x = std::is_same<In, int16_t>::value ? dist(rng) << kResamplingIntermediateBits : dist(rng);
+
+  float scale = static_cast<float>(in_len) / out_len;
+  auto filters = GetResamplingFiltersCPU();
+  ResamplingFilter filter;
+  switch (type) {
+    case ResamplingFilterType::Cubic:
+      filter = filters->Cubic();
+      break;
+    case ResamplingFilterType::Lanczos3:
+      filter = filters->Lanczos3(std::max(scale * 3, 3.0f));
+      break;
+    case ResamplingFilterType::Triangular:
+      filter = filters->Triangular(std::max(scale, 1.0f));
+      break;
+    default:
+      filter = filters->Triangular(1);
+      break;
+  }
+  int support = filter.support();
+  std::vector<float> coeffs(out_len * support);
+  std::vector<int> idx(out_len);
+  InitializeResamplingFilter(idx.data(), coeffs.data(), out_len, 0, scale, filter);
+  std::vector<Coeff> pass_coeffs(coeffs.size());
+  ConvertFilter(pass_coeffs, coeffs, out_len, support);
+
+  std::vector<Out> ref_data, out_data;
+  auto ref = MakeSurfaceHWC<Out>(ref_data, out_w, out_h, channels);
+  auto out = MakeSurfaceHWC<Out>(out_data, out_w, out_h, channels);
+  SetResamplingSIMD(ResamplingSIMD::None);
+  pass(ref, in, idx.data(), pass_coeffs.data(), support);
+  for (auto level : { ResamplingSIMD::SSE41, ResamplingSIMD::AVX2 }) {
+    SetResamplingSIMD(level);
+    std::fill(out_data.begin(), out_data.end(), 0);
+    pass(out, in, idx.data(), pass_coeffs.data(), support);
+    ASSERT_EQ(out_data, ref_data) << "Result differs from scalar code at SIMD level "
+                                  << static_cast<int>(GetResamplingSIMD());
+  }
+}
+
+}  // namespace
+
+TEST(ResampleCPU, SIMDFixedPoint) {
+  auto vert = [](auto out, auto in, const int *idx, const int16_t *coeffs, int support) {
+    ResampleVertFixed(out, in, idx, coeffs, support);
+  };
+  auto horz = [](auto out, auto in, const int *idx, const int16_t *coeffs, int support) {
+    ResampleHorzFixed(out, in, idx, coeffs, support);
+  };
+  for (int channels : { 1, 3, 4, 5 }) {
+    for (auto type : { ResamplingFilterType::Linear, ResamplingFilterType::Cubic,
+                       ResamplingFilterType::Lanczos3, ResamplingFilterType::Triangular }) {
+      for (auto lens : { std::make_pair(41, 200), std::make_pair(333, 77) }) {
+        int out_len = lens.first, in_len = lens.second;
+        TestSIMDLevels<int16_t, uint8_t, int16_t>(1, out_len, in_len, channels, type, vert);
+        TestSIMDLevels<uint8_t, int16_t, int16_t>(1, out_len, in_len, channels, type, vert);
+        TestSIMDLevels<int16_t, int16_t, int16_t>(1, out_len, in_len, channels, type, vert);
+        TestSIMDLevels<int16_t, uint8_t, int16_t>(0, out_len, in_len, channels, type, horz);
+        TestSIMDLevels<uint8_t, int16_t, int16_t>(0, out_len, in_len, channels, type, horz);
+        TestSIMDLevels<int16_t, int16_t, int16_t>(0, out_len, in_len, channels, type, horz);
+      }
+    }
+  }
+}
+
+TEST(ResampleCPU, SIMDFloat) {
+  auto vert = [](auto out, auto in, const int *idx, const float *coeffs, int support) {
+    ResampleVert(out, in, idx, coeffs, support);
+  };
+  auto horz = [](auto out, auto in, const int *idx, const float *coeffs, int support) {
+    ResampleHorz(out, in, idx, coeffs, support);
+  };
+  for (int channels : { 1, 3, 4 }) {
+    for (auto type : { ResamplingFilterType::Linear, ResamplingFilterType::Cubic,
+                       ResamplingFilterType::Lanczos3 }) {
+      TestSIMDLevels<float, uint8_t, float>(1, 41, 200, channels, type, vert);
+      TestSIMDLevels<float, float, float>(1, 333, 77, channels, type, vert);
+      TestSIMDLevels<float, uint8_t, float>(0, 41, 200, channels, type, horz);
+      TestSIMDLevels<float, float, float>(0, 333, 77, channels, type, horz);
+    }
+  }
+}
+
+
 }  // namespace kernels
 }  // namespace dali
@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
+#include <random>
+#include <vector>
 #include "dali/kernels/test/test_data.h"
 #include "dali/test/tensor_test_utils.h"
 #include "dali/kernels/test/resampling_test/resampling_test_params.h"
@@ -100,6 +102,46 @@ TEST_P(ResamplingTestCPU, KernelAPI) {
   }
 }
 
+TEST_P(ResamplingTestCPU, Bands) {
+  const ResamplingTestEntry &param = GetParam();
+  auto img = testing::data::image(param.input.c_str());
+  auto in_tensor = view_as_tensor<const uint8_t, 3>(img);
+
+  using Kernel = ResampleCPU<uint8_t, uint8_t>;
+  Kernel kernel;
+  KernelContext context;
+  ScratchpadAllocator scratch_alloc;
+
+  auto req = kernel.Setup(context, in_tensor, param.params);
+  if (!kernel.CanRunInBands())
+    return;
+  scratch_alloc.Reserve(req.scratch_sizes);
+
+  auto ref_mat = MatWithShape<uint8_t>(req.output_shapes[0].tensor_shape<3>(0));
+  auto ref_tensor = view_as_tensor<uint8_t, 3>(ref_mat);
+  auto scratchpad = scratch_alloc.GetScratchpad();
+  context.scratchpad = &scratchpad;
+  kernel.Run(context, ref_tensor, in_tensor, param.params);
+
+  auto out_mat = MatWithShape<uint8_t>(req.output_shapes[0].tensor_shape<3>(0));
+  auto out_tensor = view_as_tensor<uint8_t, 3>(out_mat);
+  int rows = out_tensor.shape[0];
+  for (int num_bands : { 2, 7 }) {
+    memset(out_tensor.data, 0, volume(out_tensor.shape));
+    for (int b = 0; b < num_bands; b++) {
+      int row_begin = rows * b / num_bands;
+      int row_end = rows * (b + 1) / num_bands;
+      if (row_begin == row_end)
+        continue;
+      auto band_scratchpad = scratch_alloc.GetScratchpad();
+      context.scratchpad = &band_scratchpad;
+      kernel.RunBand(context, out_tensor, in_tensor, param.params, row_begin, row_end);
+    }
+    // banded processing must give exactly the same result
+    Check(out_tensor, ref_tensor);
+  }
+}
+
 static std::vector<ResamplingTestEntry> ResampleTests = {
   {
     "imgproc/blobs.png", "imgproc/dots.png",
@@ -107,7 +149,7 @@ static std::vector<ResamplingTestEntry> ResampleTests = {
   },
   {
     "imgproc/dots.png", "imgproc/blobs.png",
-    { 300, 300 }, lin(), 0
+    { 300, 300 }, lin(), 1
   },
   {
     "imgproc/alley.png", "imgproc/ref/resampling/alley_tri_300x300.png",
@@ -153,6 +195,153 @@ static std::vector<ResamplingTestEntry> CropResampleTests = {
 INSTANTIATE_TEST_SUITE_P(Basic, ResamplingTestCPU, ::testing::ValuesIn(ResampleTests));
 INSTANTIATE_TEST_SUITE_P(Crop , ResamplingTestCPU, ::testing::ValuesIn(CropResampleTests));
 
+namespace {
+
+/**
+ * @brief Calculates reference 3D linear resampling directly from the definition
+ */
+template <typename Out, typename In>
+void Resample3DLinearRef(const OutTensorCPU<Out, 4> &out, const InTensorCPU<In, 4> &in,
+                         const ResamplingParamsND<3> &params) {
+  auto filter = GetResamplingFiltersCPU()->Triangular(1);
+  int support = filter.support();
+  std::vector<int> idx[3];
+  std::vector<float> coeffs[3];
+  for (int d = 0; d < 3; d++) {
+    int out_size = out.shape[d];
+    idx[d].resize(out_size);
+    coeffs[d].resize(out_size * support);
+    float start = 0, end = in.shape[d];
+    if (params[d].roi.use_roi) {
+      start = params[d].roi.start;
+      end = params[d].roi.end;
+    }
+    InitializeResamplingFilter(idx[d].data(), coeffs[d].data(), out_size, start,
+                               (end - start) / out_size, filter);
+  }
+  int C = in.shape[3];
+  auto src = [&](int d, int i, int k) {
+    return clamp(idx[d][i] + k, 0, static_cast<int>(in.shape[d] - 1));
+  };
+  for (int z = 0; z < out.shape[0]; z++)
+    for (int y = 0; y < out.shape[1]; y++)
+      for (int x = 0; x < out.shape[2]; x++)
+        for (int c = 0; c < C; c++) {
+          float sum = 0;
+          for (int kz = 0; kz < support; kz++)
+            for (int ky = 0; ky < support; ky++)
+              for (int kx = 0; kx < support; kx++) {
+                float w = coeffs[0][z * support + kz] * coeffs[1][y * support + ky] *
+                          coeffs[2][x * support + kx];
+                sum += w * *in(src(0, z, kz), src(1, y, ky), src(2, x, kx), c);
+              }
+          *out(z, y, x, c) = ConvertSat<Out>(sum);
+        }
+}
+
+template <typename Out>
+void TestResample3D(TensorShape<4> in_shape, TensorShape<3> out_size, double eps,
+                    const ResamplingParams::ROI *roi = nullptr) {
+  std::vector<uint8_t> in_data(volume(in_shape));
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto &x : in_data)
+    x = dist(rng);
+  auto in = make_tensor_cpu<4>(static_cast<const uint8_t *>(in_data.data()), in_shape);
+
+  ResamplingParamsND<3> params;
+  for (int d = 0; d < 3; d++) {
+    params[d].output_size = out_size[d];
+    params[d].min_filter = params[d].mag_filter = ResamplingFilterType::Linear;
+    if (roi)
+      params[d].roi = roi[d];
+  }
+
+  ResampleCPU<Out, uint8_t, 3> kernel;
+  KernelContext context;
+  ScratchpadAllocator scratch_alloc;
+  auto req = kernel.Setup(context, in, params);
+  scratch_alloc.Reserve(req.scratch_sizes);
+  auto scratchpad = scratch_alloc.GetScratchpad();
+  context.scratchpad = &scratchpad;
+
+  auto out_shape = req.output_shapes[0].template tensor_shape<4>(0);
+  ASSERT_EQ(out_shape, shape_cat(out_size, in_shape[3]));
+  std::vector<Out> out_data(volume(out_shape)), ref_data(volume(out_shape));
+  auto out = make_tensor_cpu<4>(out_data.data(), out_shape);
+  auto ref = make_tensor_cpu<4>(ref_data.data(), out_shape);
+  kernel.Run(context, out, in, params);
+  Resample3DLinearRef(ref, in, params);
+  Check(out, ref, EqualEps(eps));
+}
+
+}  // namespace
+
+TEST(ResampleCPU3D, Linear) {
+  // the shapes are selected so that different orders of passes are chosen
+  TensorShape<4> in_shapes[] = {
+    { 20, 30, 40, 3 },
+    { 7, 50, 13, 1 },
+    { 33, 8, 21, 2 },
+  };
+  TensorShape<3> out_sizes[] = {
+    { 10, 45, 41 },
+    { 31, 9, 13 },
+    { 5, 6, 60 },
+  };
+  for (auto &in_shape : in_shapes) {
+    for (auto &out_size : out_sizes) {
+      TestResample3D<float>(in_shape, out_size, 1e-3);
+      TestResample3D<uint8_t>(in_shape, out_size, 1);
+    }
+  }
+}
+
+TEST(ResampleCPU3D, LinearROI) {
+  TensorShape<4> in_shape = { 24, 31, 17, 3 };
+  TensorShape<3> out_size = { 15, 10, 23 };
+  // depth and width are flipped
+  ResamplingParams::ROI roi[3] = { { 20.5f, 3.0f }, { 5.0f, 25.5f }, { 16.0f, 2.0f } };
+  TestResample3D<float>(in_shape, out_size, 1e-3, roi);
+  TestResample3D<uint8_t>(in_shape, out_size, 1, roi);
+}
+
+TEST(ResampleCPU3D, NN) {
+  TensorShape<4> in_shape = { 9, 10, 11, 2 };
+  std::vector<uint8_t> in_data(volume(in_shape));
+  for (size_t i = 0; i < in_data.size(); i++)
+    in_data[i] = i;
+  auto in = make_tensor_cpu<4>(static_cast<const uint8_t *>(in_data.data()), in_shape);
+
+  ResamplingParamsND<3> params;
+  TensorShape<3> out_size = { 18, 5, 11 };
+  for (int d = 0; d < 3; d++) {
+    params[d].output_size = out_size[d];
+    params[d].min_filter = params[d].mag_filter = ResamplingFilterType::Nearest;
+  }
+
+  ResampleCPU<uint8_t, uint8_t, 3> kernel;
+  KernelContext context;
+  ScratchpadAllocator scratch_alloc;
+  auto req = kernel.Setup(context, in, params);
+  scratch_alloc.Reserve(req.scratch_sizes);
+  auto scratchpad = scratch_alloc.GetScratchpad();
+  context.scratchpad = &scratchpad;
+  auto out_shape = req.output_shapes[0].tensor_shape<4>(0);
+  std::vector<uint8_t> out_data(volume(out_shape));
+  auto out = make_tensor_cpu<4>(out_data.data(), out_shape);
+  kernel.Run(context, out, in, params);
+
+  for (int z = 0; z < out_size[0]; z++)
+    for (int y = 0; y < out_size[1]; y++)
+      for (int x = 0; x < out_size[2]; x++)
+        for (int c = 0; c < 2; c++) {
+          int sz = z / 2, sy = y * 2 + 1, sx = x;
+          ASSERT_EQ(*out(z, y, x, c), *in(sz, sy, sx, c))
+              << "at " << z << ", " << y << ", " << x << ", " << c;
+        }
+}
+
 }  // namespace resample_test
 }  // namespace kernels
 }  // namespace dali
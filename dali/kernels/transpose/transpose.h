@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 #define DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -111,6 +112,121 @@ void TransposeImpl(T *dst, const T *src, int level, int max_levels, span<const i
   }
 }
 
+/**
+ * @brief Drops the unit dimensions and merges the adjacent dimensions, which are contiguous
+ *        both in the source and the destination.
+ *
+ * All the arguments are in the destination order.
+ */
+template <size_t static_size>
+inline void SimplifyStrided(TensorShape<> &size, SmallVector<int64_t, static_size> &dst_stride,
+                            SmallVector<int64_t, static_size> &src_stride) {
+  TensorShape<> out_size;
+  SmallVector<int64_t, static_size> out_dst_stride, out_src_stride;
+  for (int d = 0; d < size.size(); d++) {
+    if (size[d] == 1)
+      continue;
+    int last = out_size.size() - 1;
+    if (last >= 0 &&
+        out_dst_stride[last] == dst_stride[d] * size[d] &&
+        out_src_stride[last] == src_stride[d] * size[d]) {
+      out_size[last] *= size[d];
+      out_dst_stride[last] = dst_stride[d];
+      out_src_stride[last] = src_stride[d];
+    } else {
+      out_size.shape.push_back(size[d]);
+      out_dst_stride.push_back(dst_stride[d]);
+      out_src_stride.push_back(src_stride[d]);
+    }
+  }
+  size = std::move(out_size);
+  dst_stride = std::move(out_dst_stride);
+  src_stride = std::move(out_src_stride);
+}
+
+/**
+ * @brief Cache-blocked transposition of a dense destination
+ *
+ * The innermost destination dimension and the dimension which is innermost in the source are
+ * processed in square blocks, so that both the reads and the writes use whole cache lines.
+ * The remaining dimensions are iterated over in the outer loop.
+ *
+ * @param size dst-ordered shape, without unit dimensions
+ * @param dst_stride destination strides; the innermost one is 1
+ * @param src_stride source strides, in the destination order
+ */
+template <typename T, size_t static_size>
+void TransposeTiledImpl(T *dst, const T *src, const TensorShape<> &size,
+                        const SmallVector<int64_t, static_size> &dst_stride,
+                        const SmallVector<int64_t, static_size> &src_stride) {
+  int ndim = size.size();
+  if (ndim == 0) {
+    *dst = *src;
+    return;
+  }
+  int inner = ndim - 1;
+  // the dimension which is contiguous (or nearly so) in the source
+  int src_inner = inner;
+  for (int d = 0; d < ndim; d++) {
+    if (src_stride[d] < src_stride[src_inner])
+      src_inner = d;
+  }
+
+  SmallVector<int, static_size> outer_dims;
+  int64_t outer_volume = 1;
+  for (int d = 0; d < inner; d++) {
+    if (d != src_inner) {
+      outer_dims.push_back(d);
+      outer_volume *= size[d];
+    }
+  }
+
+  // 64x64 bytes for 1-byte types, otherwise 32x32 elements - that's at most 8 kB
+  constexpr int64_t kBlock = sizeof(T) == 1 ? 64 : 32;
+  const int64_t n_inner = size[inner];
+  const int64_t dst_inner_stride = dst_stride[inner];
+  const int64_t src_inner_stride = src_stride[inner];
+
+  SmallVector<int64_t, static_size> idx;
+  idx.resize(outer_dims.size(), 0);
+  for (int64_t o = 0; o < outer_volume; o++) {
+    T *dst_base = dst;
+    const T *src_base = src;
+    for (int i = 0; i < static_cast<int>(outer_dims.size()); i++) {
+      dst_base += idx[i] * dst_stride[outer_dims[i]];
+      src_base += idx[i] * src_stride[outer_dims[i]];
+    }
+
+    if (src_inner == inner) {
+      // the innermost dimension is not permuted - copy whole rows
+      for (int64_t i = 0; i < n_inner; i++)
+        dst_base[i * dst_inner_stride] = src_base[i * src_inner_stride];
+    } else {
+      const int64_t n_outer = size[src_inner];
+      const int64_t dst_outer_stride = dst_stride[src_inner];
+      const int64_t src_outer_stride = src_stride[src_inner];
+      for (int64_t jb = 0; jb < n_outer; jb += kBlock) {
+        int64_t jend = std::min(jb + kBlock, n_outer);
+        for (int64_t ib = 0; ib < n_inner; ib += kBlock) {
+          int64_t iend = std::min(ib + kBlock, n_inner);
+          for (int64_t j = jb; j < jend; j++) {
+            T *d = dst_base + j * dst_outer_stride;
+            const T *s = src_base + j * src_outer_stride;
+            for (int64_t i = ib; i < iend; i++)
+              d[i * dst_inner_stride] = s[i * src_inner_stride];
+          }
+        }
+      }
+    }
+
+    for (int i = static_cast<int>(outer_dims.size()) - 1; i >= 0; i--) {
+      if (++idx[i] < size[outer_dims[i]])
+        break;
+      idx[i] = 0;
+    }
+  }
+}
+
 }  // namespace transpose_impl
 
 /**
@@ -163,6 +279,46 @@ void TransposeGrouped(const TensorView<StorageCPU, T> &dst,
             make_cspan(collapsed_perm));
 }
 
+/**
+ * @brief Transpose `src` Tensor to `dst` wrt to permutation `perm`, using cache blocking
+ *
+ * Only the range [begin, end) of the outermost destination dimension is computed, so that
+ * the transposition of a large tensor can be split between threads; negative `end` means
+ * the whole extent.
+ *
+ * Source dimension `perm[i]` goes to destination dimension `i`.
+ */
+template <typename T>
+void TransposeTiled(const TensorView<StorageCPU, T> &dst,
+                    const TensorView<StorageCPU, const T> &src, span<const int> perm,
+                    int64_t begin = 0, int64_t end = -1) {
+  int N = src.shape.sample_dim();
+  if (N == 0) {  // it's a scalar - just copy it
+    *dst.data = *src.data;
+    return;
+  }
+  assert(dst.shape.sample_dim() == N);
+  assert(volume(src.shape) == volume(dst.shape));
+  if (end < 0)
+    end = dst.shape[0];
+  if (begin >= end)
+    return;
+
+  auto dst_strides = GetStrides(dst.shape);
+  auto src_strides = GetStrides(src.shape);
+  TensorShape<> size = dst.shape;
+  SmallVector<int64_t, DynamicTensorShapeContainer::static_size> dst_stride, src_stride;
+  for (int d = 0; d < N; d++) {
+    dst_stride.push_back(dst_strides[d]);
+    src_stride.push_back(src_strides[perm[d]]);
+  }
+  size[0] = end - begin;
+  transpose_impl::SimplifyStrided(size, dst_stride, src_stride);
+  transpose_impl::TransposeTiledImpl(dst.data + begin * dst_strides[0],
+                                     src.data + begin * src_strides[perm[0]],
+                                     size, dst_stride, src_stride);
+}
+
 }  // namespace kernels
 }  // namespace dali
 
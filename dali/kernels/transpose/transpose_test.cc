@@ -0,0 +1,86 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+#include "dali/core/tensor_shape_print.h"
+#include "dali/kernels/transpose/transpose.h"
+#include "dali/kernels/transpose/transpose_test.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+template <typename T>
+void CheckTransposeTiled(const TensorShape<> &in_shape, span<const int> perm, int num_ranges) {
+  int ndim = in_shape.size();
+  auto out_shape = permute(in_shape, perm);
+  int64_t n = volume(in_shape);
+  std::vector<T> in(n), out(n, 0), ref(n);
+  std::iota(in.begin(), in.end(), 0);
+  testing::RefTranspose(ref.data(), in.data(), in_shape.data(), perm.data(), ndim);
+
+  TensorView<StorageCPU, T> out_view(out.data(), out_shape);
+  TensorView<StorageCPU, const T> in_view(in.data(), in_shape);
+  if (num_ranges == 1) {
+    TransposeTiled(out_view, in_view, perm);
+  } else {
+    int64_t extent = out_shape[0];
+    for (int r = 0; r < num_ranges; r++)
+      TransposeTiled(out_view, in_view, perm, extent * r / num_ranges,
+                     extent * (r + 1) / num_ranges);
+  }
+  for (int64_t i = 0; i < n; i++)
+    ASSERT_EQ(out[i], ref[i]) << "at " << i << ", shape " << in_shape << ", ranges " << num_ranges;
+}
+
+}  // namespace
+
+TEST(TransposeTiledTest, AllPermutations4D) {
+  TensorShape<> shape = {5, 1, 70, 37};
+  for (auto &perm : testing::Permutations4) {
+    for (int num_ranges : {1, 3}) {
+      CheckTransposeTiled<int>(shape, make_cspan(perm), num_ranges);
+      CheckTransposeTiled<uint8_t>(shape, make_cspan(perm), num_ranges);
+      CheckTransposeTiled<double>(shape, make_cspan(perm), num_ranges);
+    }
+  }
+}
+
+TEST(TransposeTiledTest, Reversed) {
+  // the permutation used for Fortran-order arrays
+  for (TensorShape<> shape : {TensorShape<>{130, 67}, TensorShape<>{9, 40, 33},
+                              TensorShape<>{3, 4, 5, 6, 7}, TensorShape<>{1000}}) {
+    std::vector<int> perm(shape.size());
+    for (int i = 0; i < shape.size(); i++)
+      perm[i] = shape.size() - 1 - i;
+    for (int num_ranges : {1, 2, 7}) {
+      CheckTransposeTiled<int16_t>(shape, make_cspan(perm), num_ranges);
+      CheckTransposeTiled<float>(shape, make_cspan(perm), num_ranges);
+    }
+  }
+}
+
+TEST(TransposeTiledTest, Scalar) {
+  int in = 42, out = 0;
+  TransposeTiled(TensorView<StorageCPU, int>(&out, TensorShape<>{}),
+                 TensorView<StorageCPU, const int>(&in, TensorShape<>{}), span<const int>{});
+  EXPECT_EQ(out, 42);
+}
+
+}  // namespace kernels
+}  // namespace dali
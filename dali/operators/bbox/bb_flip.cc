@@ -45,10 +45,9 @@ False for for width-height representation.)code",
 
 BbFlip<CPUBackend>::BbFlip(const dali::OpSpec &spec)
     : Operator<CPUBackend>(spec),
-      ltrb_(spec.GetArgument<bool>(kCoordinatesTypeArgName)) {
-  vflip_is_tensor_ = spec.HasTensorArgument(kVerticalArgName);
-  hflip_is_tensor_ = spec.HasTensorArgument(kHorizontalArgName);
-}
+      ltrb_(spec.GetArgument<bool>(kCoordinatesTypeArgName)),
+      horizontal_(kHorizontalArgName, spec),
+      vertical_(kVerticalArgName, spec) {}
 
 void BbFlip<CPUBackend>::RunImpl(dali::SampleWorkspace &ws) {
   const auto &input = ws.Input<CPUBackend>(0);
@@ -56,15 +55,8 @@ void BbFlip<CPUBackend>::RunImpl(dali::SampleWorkspace &ws) {
 
   DALI_ENFORCE(input.type().id() == DALI_FLOAT, "Bounding box in wrong format");
 
-  const auto vertical =
-      vflip_is_tensor_
-          ? spec_.GetArgument<int>(kVerticalArgName, &ws, ws.data_idx())
-          : spec_.GetArgument<int>(kVerticalArgName);
-
-  const auto horizontal =
-      hflip_is_tensor_
-          ? spec_.GetArgument<int>(kHorizontalArgName, &ws, ws.data_idx())
-          : spec_.GetArgument<int>(kHorizontalArgName);
+  const auto vertical = vertical_[ws.data_idx()];
+  const auto horizontal = horizontal_[ws.data_idx()];
 
   auto &output = ws.Output<CPUBackend>(0);
   // XXX: Setting type of output (i.e. Buffer -> buffer.h)
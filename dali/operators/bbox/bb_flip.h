@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -36,6 +37,8 @@ class BbFlip<CPUBackend> : public Operator<CPUBackend> {
 
  protected:
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    horizontal_.Acquire(ws);
+    vertical_.Acquire(ws);
     return false;
   }
 
@@ -84,10 +87,9 @@ class BbFlip<CPUBackend> : public Operator<CPUBackend> {
   Tensor<CPUBackend> flip_type_horizontal_;
 
   /**
-   * XXX: This is workaround for architectural mishap, that there are 2 access
-   * points for operator arguments: Workspace and OpSpec
+   * Flip arguments, either constant or given per sample as argument inputs
    */
-  bool vflip_is_tensor_, hflip_is_tensor_;
+  ScalarArg<int> horizontal_, vertical_;
 };
 
 }  // namespace dali
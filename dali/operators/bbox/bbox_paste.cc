@@ -69,9 +69,9 @@ void BBoxPaste<CPUBackend>::RunImpl(Workspace<CPUBackend> &ws) {
 
   const auto data_idx = ws.data_idx();
   // pasting onto a larger canvas scales bounding boxes down by scale ratio
-  float ratio = spec_.GetArgument<float>("ratio", &ws, data_idx);
-  float px = spec_.GetArgument<float>("paste_x", &ws, data_idx);
-  float py = spec_.GetArgument<float>("paste_y", &ws, data_idx);
+  float ratio = ratio_[data_idx];
+  float px = paste_x_[data_idx];
+  float py = paste_y_[data_idx];
   float scale = 1 / ratio;
 
   // offsets are scaled so that (0,0) pastes the image aligned to the top-left
@@ -19,6 +19,7 @@
 
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -28,14 +29,19 @@ template <typename Backend>
 class BBoxPaste : public Operator<Backend> {
  public:
   explicit inline BBoxPaste(const OpSpec &spec) :
-    Operator<Backend>(spec) {
+    Operator<Backend>(spec), ratio_("ratio", spec), paste_x_("paste_x", spec),
+    paste_y_("paste_y", spec) {
     use_ltrb_ = spec.GetArgument<bool>("ltrb");
   }
 
  protected:
   bool use_ltrb_ = false;
+  ScalarArg<float> ratio_, paste_x_, paste_y_;
 
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    ratio_.Acquire(ws);
+    paste_x_.Acquire(ws);
+    paste_y_.Acquire(ws);
     return false;
   }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/operators/coord/coord_flip.h"
+#include "dali/pipeline/operator/arg_helper.h"
 
 namespace dali {
 
@@ -44,7 +45,9 @@ Note: If left empty, ``"x"``, ``"xy"`` or ``"xyz"`` will be assumed, depending o
 class CoordFlipCPU : public CoordFlip<CPUBackend> {
  public:
   explicit CoordFlipCPU(const OpSpec &spec)
-      : CoordFlip<CPUBackend>(spec) {}
+      : CoordFlip<CPUBackend>(spec)
+      , flip_x_("flip_x", spec), flip_y_("flip_y", spec), flip_z_("flip_z", spec)
+      , center_x_("center_x", spec), center_y_("center_y", spec), center_z_("center_z", spec) {}
 
   ~CoordFlipCPU() override = default;
   DISABLE_COPY_MOVE_ASSIGN(CoordFlipCPU);
@@ -54,6 +57,10 @@ class CoordFlipCPU : public CoordFlip<CPUBackend> {
   USE_OPERATOR_MEMBERS();
   using Operator<CPUBackend>::RunImpl;
   using CoordFlip<CPUBackend>::layout_;
+
+ private:
+  ScalarArg<int> flip_x_, flip_y_, flip_z_;
+  ScalarArg<float> center_x_, center_y_, center_z_;
 };
 
 void CoordFlipCPU::RunImpl(workspace_t<CPUBackend> &ws) {
@@ -61,16 +68,21 @@ void CoordFlipCPU::RunImpl(workspace_t<CPUBackend> &ws) {
   auto &output = ws.OutputRef<CPUBackend>(0);
   auto &thread_pool = ws.GetThreadPool();
 
+  for (auto *arg : {&flip_x_, &flip_y_, &flip_z_})
+    arg->Acquire(ws);
+  for (auto *arg : {&center_x_, &center_y_, &center_z_})
+    arg->Acquire(ws);
+
   for (int sample_id = 0; sample_id < batch_size_; sample_id++) {
     std::array<bool, 3> flip_dim = {false, false, false};
-    flip_dim[x_dim_] = spec_.GetArgument<int>("flip_x", &ws, sample_id);
-    flip_dim[y_dim_] = spec_.GetArgument<int>("flip_y", &ws, sample_id);
-    flip_dim[z_dim_] = spec_.GetArgument<int>("flip_z", &ws, sample_id);
+    flip_dim[x_dim_] = flip_x_[sample_id];
+    flip_dim[y_dim_] = flip_y_[sample_id];
+    flip_dim[z_dim_] = flip_z_[sample_id];
 
     std::array<float, 3> mirrored_origin = {1.0f, 1.0f, 1.0f};
-    mirrored_origin[x_dim_] = 2.0f * spec_.GetArgument<float>("center_x", &ws, sample_id);
-    mirrored_origin[y_dim_] = 2.0f * spec_.GetArgument<float>("center_y", &ws, sample_id);
-    mirrored_origin[z_dim_] = 2.0f * spec_.GetArgument<float>("center_z", &ws, sample_id);
+    mirrored_origin[x_dim_] = 2.0f * center_x_[sample_id];
+    mirrored_origin[y_dim_] = 2.0f * center_y_[sample_id];
+    mirrored_origin[z_dim_] = 2.0f * center_z_[sample_id];
 
     auto in_size = volume(input[sample_id].shape());
     thread_pool.AddWork(
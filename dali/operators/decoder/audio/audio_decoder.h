@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_H_
 #define DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_H_
 
+#include <cstdio>
 #include <memory>
 #include "dali/core/span.h"
 
@@ -42,6 +43,17 @@ class AudioDecoderBase {
   }
 
 
+  /**
+   * @brief Moves the read position, in (multi-channel) samples, so that the following call
+   *        to Decode starts there
+   * @param whence SEEK_SET, SEEK_CUR or SEEK_END
+   * @return The new read position, counted from the beginning of the recording
+   */
+  int64_t SeekFrames(int64_t frame_offset, int whence = SEEK_SET) {
+    return SeekFramesImpl(frame_offset, whence);
+  }
+
+
   /**
    * @brief Decode audio data and store it in the supplied buffer
    * @return Number of (multi-channel) samples actually read
@@ -54,6 +66,8 @@ class AudioDecoderBase {
   virtual AudioMetadata OpenImpl(span<const char> encoded) = 0;
 
   virtual void CloseImpl() = 0;
+
+  virtual int64_t SeekFramesImpl(int64_t frame_offset, int whence) = 0;
 };
 
 template<typename SampleType>
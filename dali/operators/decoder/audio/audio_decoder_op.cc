@@ -42,7 +42,18 @@ This operator produces two outputs:
           "If True, downmix all input channels to mono. "
           "If downmixing is turned on, decoder will produce always 1-D output", false)
   .AddOptionalArg("dtype",
-          "Type of the output data. Supports types: `INT16`, `INT32`, `FLOAT`", DALI_FLOAT);
+          "Type of the output data. Supports types: `INT16`, `INT32`, `FLOAT`", DALI_FLOAT)
+  .AddOptionalArg("offset",
+          "Beginning of the decoded window, relative to the beginning of the recording.\n"
+          "Only the requested window is decoded and resampled; the window is clamped to the "
+          "length of the recording.", 0.0, true)
+  .AddOptionalArg("duration",
+          "Length of the decoded window. If negative, the recording is decoded until the end.",
+          -1.0, true)
+  .AddOptionalArg("window_unit",
+          "Unit of `offset` and `duration`: \"seconds\" or \"samples\". The samples are "
+          "counted at the sampling rate of the input, before resampling.",
+          std::string("seconds"));
 
 DALI_REGISTER_OPERATOR(AudioDecoder, AudioDecoderCpu, CPU);
 
@@ -50,6 +61,8 @@ DALI_REGISTER_OPERATOR(AudioDecoder, AudioDecoderCpu, CPU);
 bool
 AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) {
   GetPerSampleArgument<float>(target_sample_rates_, "sample_rate", ws);
+  GetPerSampleArgument<double>(offsets_, "offset", ws);
+  GetPerSampleArgument<double>(durations_, "duration", ws);
   auto &input = ws.template InputRef<Backend>(0);
   const auto batch_size = input.shape().num_samples();
 
@@ -61,6 +74,7 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
   intermediate_buffers_.resize(batch_size);
   sample_meta_.resize(batch_size);
   files_names_.resize(batch_size);
+  windows_.resize(batch_size);
 
   decode_type_ = use_resampling_ || downmix_ ? DALI_FLOAT : output_type_;
   TYPE_SWITCH(decode_type_, type2id, OutputType, (int16_t, int32_t, float), (
@@ -80,7 +94,8 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
     auto meta = decoders_[i]->Open({reinterpret_cast<const char *>(input[i].raw_mutable_data()),
                                     input[i].shape().num_elements()});
     sample_meta_[i] = meta;
-    int64_t out_length = OutputLength(meta.length, meta.sample_rate, i);
+    windows_[i] = GetDecodeWindow(meta, i);
+    int64_t out_length = OutputLength(windows_[i], meta.sample_rate, i);
     TensorShape<> data_sample_shape;
     if (downmix_) {
       data_sample_shape = {out_length};
@@ -99,6 +114,22 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
 }
 
 
+AudioDecoderCpu::DecodeWindow
+AudioDecoderCpu::GetDecodeWindow(const AudioMetadata &meta, int sample_idx) const {
+  double unit = window_in_samples_ ? 1.0 : meta.sample_rate;
+  double offset = offsets_[sample_idx] * unit;
+  double duration = durations_[sample_idx] * unit;
+  DALI_ENFORCE(offset >= 0, make_string("The offset must not be negative; got ",
+                                        offsets_[sample_idx]));
+  DecodeWindow window;
+  window.begin = std::min<int64_t>(std::llround(offset), meta.length);
+  window.end = duration < 0
+      ? meta.length
+      : std::min<int64_t>(window.begin + std::llround(duration), meta.length);
+  return window;
+}
+
+
 template <typename T>
 span<char> as_raw_span(T *buffer, ptrdiff_t length) {
   return make_span(reinterpret_cast<char*>(buffer), length*sizeof(T));
@@ -110,6 +141,8 @@ void
 AudioDecoderCpu::DecodeSample(const TensorView<StorageCPU, OutputType, DynamicDimensions> &audio,
                               int thread_idx, int sample_idx) {
   const AudioMetadata &meta = sample_meta_[sample_idx];
+  const DecodeWindow &window = windows_[sample_idx];
+  auto &decoder = *decoders_[sample_idx];
 
   auto &tmp_buf = intermediate_buffers_[thread_idx];
   double output_rate = meta.sample_rate;
@@ -121,40 +154,56 @@ AudioDecoderCpu::DecodeSample(const TensorView<StorageCPU, OutputType, DynamicDi
   }
   bool should_resample = meta.sample_rate != output_rate;
   bool should_downmix = meta.channels > 1 && downmix_;
+
+  // The resampling filter needs the input samples around the edges of the window
+  int64_t pad = should_resample ? resampler_.window.lobes + 1 : 0;
+  int64_t in_begin = std::max<int64_t>(window.begin - pad, 0);
+  int64_t in_end = std::min<int64_t>(window.end + pad, meta.length);
+  int64_t in_length = in_end - in_begin;
+  if (in_length <= 0 || volume(audio.shape) == 0)
+    return;
+  if (in_begin > 0)
+    decoder.SeekFrames(in_begin);
+
   if (should_resample || should_downmix || output_type_ != decode_type_) {
     assert(decode_type_ == DALI_FLOAT);
     int64_t tmp_size = should_downmix && should_resample
-      ? meta.length * (meta.channels + 1)   // downmix to intermediate buffer, then resample
-      : meta.length * meta.channels;        // decode to intermediate, then resample or downmix
-                                            // directly to the output
+      ? in_length * (meta.channels + 1)   // downmix to intermediate buffer, then resample
+      : in_length * meta.channels;        // decode to intermediate, then resample or downmix
+                                          // directly to the output
 
     tmp_buf.resize(tmp_size);
-    size_t num_samples = meta.length * meta.channels;
-    size_t ret = decoders_[sample_idx]->Decode(as_raw_span(tmp_buf.data(), num_samples));
+    size_t num_samples = in_length * meta.channels;
+    size_t ret = decoder.Decode(as_raw_span(tmp_buf.data(), num_samples));
     DALI_ENFORCE(ret == num_samples,
                  make_string("Error decoding audio file: ", files_names_[sample_idx]));
 
+    // The resampler works with positions in the whole recording - the pointers are adjusted,
+    // so that the window and the decoded input are placed at their positions in the recording
+    int64_t out_begin = OutputPosition(window.begin, meta.sample_rate, sample_idx);
+    int64_t out_end = out_begin + audio.shape[0];
     if (should_downmix) {
       if (should_resample) {
         // downmix and resample
-        float *downmixed = tmp_buf.data() + meta.length * meta.channels;
-        assert(downmixed + meta.length <= tmp_buf.data() + tmp_buf.size());
-        kernels::signal::Downmix(downmixed, tmp_buf.data(), meta.length, meta.channels);
-        resampler_.Resample(audio.data, 0, audio.shape[0], output_rate,
-                            downmixed, meta.length, meta.sample_rate);
+        float *downmixed = tmp_buf.data() + in_length * meta.channels;
+        assert(downmixed + in_length <= tmp_buf.data() + tmp_buf.size());
+        kernels::signal::Downmix(downmixed, tmp_buf.data(), in_length, meta.channels);
+        resampler_.Resample(audio.data - out_begin, out_begin, out_end, output_rate,
+                            downmixed - in_begin, in_end, meta.sample_rate);
       } else {
         // downmix only
-        kernels::signal::Downmix(audio.data, tmp_buf.data(), meta.length, meta.channels);
+        kernels::signal::Downmix(audio.data, tmp_buf.data(), in_length, meta.channels);
       }
     } else if (should_resample) {
       // multi-channel resample
-      resampler_.Resample(audio.data, 0, audio.shape[0], output_rate,
-                          tmp_buf.data(), meta.length, meta.sample_rate, meta.channels);
+      resampler_.Resample(audio.data - out_begin * meta.channels, out_begin, out_end, output_rate,
+                          tmp_buf.data() - in_begin * meta.channels, in_end, meta.sample_rate,
+                          meta.channels);
 
     } else {
       // convert or copy only - this will only happen if resampling is specified, but this
       // recording's sampling rate and number of channels coincides with the target
-      int64_t len = std::min<int64_t>(volume(audio.shape), meta.length*meta.channels);
+      int64_t len = std::min<int64_t>(volume(audio.shape), in_length * meta.channels);
       for (int64_t ofs = 0; ofs < len; ofs++) {
         audio.data[ofs] = ConvertSatNorm<OutputType>(tmp_buf[ofs]);
       }
@@ -162,7 +211,7 @@ AudioDecoderCpu::DecodeSample(const TensorView<StorageCPU, OutputType, DynamicDi
   } else {
     assert(!should_downmix && !should_resample);
     size_t num_samples = volume(audio.shape);
-    size_t ret = decoders_[sample_idx]->Decode(as_raw_span(audio.data, num_samples));
+    size_t ret = decoder.Decode(as_raw_span(audio.data, num_samples));
     DALI_ENFORCE(ret == num_samples,
                  make_string("Error decoding audio file: ", files_names_[sample_idx]));
   }
@@ -188,7 +237,7 @@ void AudioDecoderCpu::DecodeBatch(workspace_t<Backend> &ws) {
         DALI_FAIL(make_string("Error decoding file.\nError: ", e.what(), "\nFile: ",
                               files_names_[i], "\n"));
       }
-    }, sample_meta_[i].length * sample_meta_[i].channels);
+    }, (windows_[i].end - windows_[i].begin) * sample_meta_[i].channels);
   }
 
   tp.RunAll();
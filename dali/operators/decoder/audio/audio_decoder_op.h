@@ -42,6 +42,11 @@ class AudioDecoderCpu : public Operator<CPUBackend> {
           downmix_(spec.GetArgument<bool>("downmix")),
           use_resampling_(spec.HasArgument("sample_rate") || spec.HasTensorArgument("sample_rate")),
           quality_(spec.GetArgument<float>("quality")) {
+    auto window_unit = spec.GetArgument<std::string>("window_unit");
+    DALI_ENFORCE(window_unit == "seconds" || window_unit == "samples",
+                 make_string("`window_unit` must be either \"seconds\" or \"samples\"; got \"",
+                             window_unit, "\""));
+    window_in_samples_ = window_unit == "samples";
     if (use_resampling_) {
       double q = quality_;
       DALI_ENFORCE(q >= 0 && q <= 100, "Resampling quality must be in [0..100] range");
@@ -73,16 +78,40 @@ class AudioDecoderCpu : public Operator<CPUBackend> {
   template <typename OutputType>
   void DecodeBatch(workspace_t<Backend> &ws);
 
-  int64_t OutputLength(int64_t in_length, double in_rate, int sample_idx) const {
+  /**
+   * @brief The range of the input (multi-channel) samples to decode
+   */
+  struct DecodeWindow {
+    int64_t begin = 0, end = 0;
+  };
+
+  DecodeWindow GetDecodeWindow(const AudioMetadata &meta, int sample_idx) const;
+
+  /**
+   * @brief Index of the first output sample of the window, counted from the beginning of
+   *        the (resampled) recording
+   *
+   * The window is resampled as a part of the whole recording, so decoding the recording
+   * in windows produces the same samples as decoding it in one go.
+   */
+  int64_t OutputPosition(int64_t in_pos, double in_rate, int sample_idx) const {
     if (use_resampling_) {
       return kernels::signal::resampling::resampled_length(
-          in_length, in_rate, target_sample_rates_[sample_idx]);
+          in_pos, in_rate, target_sample_rates_[sample_idx]);
     } else {
-      return in_length;
+      return in_pos;
     }
   }
 
+  int64_t OutputLength(const DecodeWindow &window, double in_rate, int sample_idx) const {
+    return OutputPosition(window.end, in_rate, sample_idx) -
+           OutputPosition(window.begin, in_rate, sample_idx);
+  }
+
   std::vector<float> target_sample_rates_;
+  std::vector<double> offsets_, durations_;
+  std::vector<DecodeWindow> windows_;
+  bool window_in_samples_ = false;
   kernels::signal::resampling::Resampler resampler_;
   DALIDataType output_type_ = DALI_NO_TYPE, decode_type_ = DALI_NO_TYPE;
   const bool downmix_ = false, use_resampling_ = false;
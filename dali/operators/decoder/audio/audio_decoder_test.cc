@@ -89,4 +89,38 @@ TEST(AudioDecoderTest, WavDecoderTest) {
   EXPECT_PRED3(CheckBuffers<DataType>, output.data(), vec.data(), vec.size());
 }
 
+
+TEST(AudioDecoderTest, WavDecoderSeekTest) {
+  using DataType = short;  // NOLINT
+  GenericAudioDecoder<DataType> decoder;
+
+  std::string wav_path = make_string(audio_data_root, "dziendobry.wav");
+  std::string decoded_path = make_string(audio_data_root, "dziendobry.txt");
+
+  std::vector<DataType> vec;
+  std::vector<char> bytes;
+  try {
+    vec = ReadTxt<DataType>(decoded_path);
+    bytes = ReadBytes(wav_path);
+  } catch (const std::bad_alloc &e) {
+    FAIL() << "Test data hasn't been provided: Expected `" << wav_path << "` and `" << decoded_path
+           << "` to exist";
+  }
+
+  auto meta = decoder.Open(make_cspan(bytes));
+  int64_t offset = meta.length / 3;
+  int64_t length = meta.length / 5;
+  ASSERT_EQ(decoder.SeekFrames(offset), offset);
+  std::vector<DataType> output(length * meta.channels);
+  EXPECT_EQ(decoder.DecodeTyped(make_span(output)), static_cast<ptrdiff_t>(output.size()));
+  EXPECT_PRED3(CheckBuffers<DataType>, output.data(), vec.data() + offset * meta.channels,
+               output.size());
+
+  // relative seek - skip the same number of frames again
+  EXPECT_EQ(decoder.SeekFrames(length, SEEK_CUR), offset + 2 * length);
+  EXPECT_EQ(decoder.DecodeTyped(make_span(output)), static_cast<ptrdiff_t>(output.size()));
+  EXPECT_PRED3(CheckBuffers<DataType>, output.data(),
+               vec.data() + (offset + 2 * length) * meta.channels, output.size());
+}
+
 }  // namespace dali
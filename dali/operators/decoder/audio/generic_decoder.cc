@@ -160,6 +160,12 @@ void GenericAudioDecoder<SampleType>::CloseImpl() {
 }
 
 
+template<typename SampleType>
+int64_t GenericAudioDecoder<SampleType>::SeekFramesImpl(int64_t frame_offset, int whence) {
+  return impl_->SeekFramesImpl(frame_offset, whence);
+}
+
+
 template<typename SampleType>
 GenericAudioDecoder<SampleType>::~GenericAudioDecoder() = default;
 
@@ -203,6 +209,14 @@ struct GenericAudioDecoder<SampleType>::Impl {
   }
 
 
+  int64_t SeekFramesImpl(int64_t frame_offset, int whence) {
+    sf_count_t pos = sf_seek(sound_, frame_offset, whence);
+    DALI_ENFORCE(pos >= 0, make_string("Failed to seek to frame ", frame_offset, ": ",
+                                       sf_strerror(sound_)));
+    return pos;
+  }
+
+
   void CloseImpl() {
     if (sound_) {
       auto err = sf_close(sound_);
@@ -44,6 +44,8 @@ class DLL_PUBLIC GenericAudioDecoder : public TypedAudioDecoderBase<SampleType>
 
   void CloseImpl() override;
 
+  int64_t SeekFramesImpl(int64_t frame_offset, int whence) override;
+
   struct Impl;
   std::unique_ptr<Impl> impl_;
 };
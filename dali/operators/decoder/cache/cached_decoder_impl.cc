@@ -93,25 +93,29 @@ void CachedDecoderImpl::CacheStore(const std::string& file_name, const uint8_t *
 DALI_SCHEMA(CachedDecoderAttr)
   .DocStr(R"code(Attributes for cached decoder.)code")
   .AddOptionalArg("cache_size",
-      R"code(**`mixed` backend only** Total size of the decoder cache in megabytes. When provided, decoded
-images bigger than `cache_threshold` will be cached in GPU memory.)code",
+      R"code(Total size of the decoder cache in megabytes. When provided, decoded
+images bigger than `cache_threshold` will be cached in GPU memory (`mixed` backend) or
+in host memory (`cpu` backend).)code",
       0)
   .AddOptionalArg("cache_threshold",
-      R"code(**`mixed` backend only** Size threshold (in bytes) for images (after decoding) to be cached.)code",
+      R"code(Size threshold (in bytes) for images (after decoding) to be cached.)code",
       0)
   .AddOptionalArg("cache_debug",
-      R"code(**`mixed` backend only** Print debug information about decoder cache.)code",
+      R"code(Print debug information about decoder cache.)code",
       false)
   .AddOptionalArg("cache_batch_copy",
       R"code(**`mixed` backend only** If true, multiple images from cache are copied with a single batched copy kernel call;
 otherwise, each image is copied using cudaMemcpy unless order in the batch is the same as in the cache)code",
       true)
   .AddOptionalArg("cache_type",
-      R"code(**`mixed` backend only** Choose cache type:
+      R"code(Choose cache type:
 `threshold`: Caches every image with size bigger than `cache_threshold` until cache is full.
 Warm up time for `threshold` policy is 1 epoch.
 `largest`: Store largest images that can fit the cache.
 Warm up time for `largest` policy is 2 epochs
+`lru`: **`cpu` backend only** Caches every image with size bigger than `cache_threshold`; when
+the cache is full, the least recently read images are evicted. It can't be used with
+`skip_cached_images` option of the readers.
 To take advantage of caching, it is recommended to use the option `stick_to_shard=True` with
 the reader operators, to limit the amount of unique images seen by the decoder in a multi node environment)code",
       std::string());
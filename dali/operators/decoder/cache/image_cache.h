@@ -16,6 +16,7 @@
 #define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_H_
 
 #include <cuda_runtime.h>
+#include <functional>
 #include <string>
 #include "dali/core/api_helper.h"
 #include "dali/core/tensor_shape.h"
@@ -40,8 +41,9 @@ class DLL_PUBLIC ImageCache {
   /**
    * @brief Get image dimensions
    * @param image_key key representing the image in cache
+   * @remarks Returned by value - the entry can be evicted by another thread right after the call
    */
-  DLL_PUBLIC virtual const ImageShape& GetShape(const ImageKey& image_key) const = 0;
+  DLL_PUBLIC virtual ImageShape GetShape(const ImageKey& image_key) const = 0;
 
     /**
      * @brief Try to read from cache
@@ -54,6 +56,22 @@ class DLL_PUBLIC ImageCache {
                                  void* destination_data,
                                  cudaStream_t stream) const = 0;
 
+  /**
+   * @brief Try to read an image whose shape is not known in advance
+   * @param image_key key representing the image in cache
+   * @param get_destination called with the shape of the image, returns the destination buffer
+   * @param stream cuda stream
+   * @return true if successful cache read, false otherwise
+   * @remarks Unlike a GetShape and Read pair, the image cannot be evicted in between
+   */
+  DLL_PUBLIC virtual bool Read(const ImageKey& image_key,
+                               const std::function<void*(const ImageShape&)> &get_destination,
+                               cudaStream_t stream) const {
+    if (!IsCached(image_key))
+      return false;
+    return Read(image_key, get_destination(GetShape(image_key)), stream);
+  }
+
   /**
    * @brief Try to add entry to cache.
    * @remarks Whether the entry is registered or not depends on the particular implementation
@@ -84,6 +102,14 @@ class DLL_PUBLIC ImageCache {
    *          Read/Add calls are already synchronized and don't require using this API
    */
   DLL_PUBLIC virtual void SyncToRead(cudaStream_t stream) const = 0;
+
+  /**
+   * @brief Whether the images, once cached, can be removed from the cache to make room for others
+   * @remarks The readers can't skip loading the cached images (`skip_cached_images`) when so
+   */
+  DLL_PUBLIC virtual bool EvictsImages() const {
+    return false;
+  }
 };
 
 }  // namespace dali
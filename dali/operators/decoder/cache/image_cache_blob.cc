@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/operators/decoder/cache/image_cache_blob.h"
+#include <cstring>
 #include <fstream>
 #include <mutex>
 #include <unordered_map>
@@ -25,18 +26,24 @@ namespace dali {
 
 ImageCacheBlob::ImageCacheBlob(std::size_t cache_size,
                                std::size_t image_size_threshold,
-                               bool stats_enabled)
+                               bool stats_enabled,
+                               kernels::AllocType alloc_type)
     : cache_size_(cache_size)
     , image_size_threshold_(image_size_threshold)
-    , stats_enabled_(stats_enabled) {
+    , stats_enabled_(stats_enabled)
+    , alloc_type_(alloc_type) {
   DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+  DALI_ENFORCE(alloc_type == kernels::AllocType::GPU || alloc_type == kernels::AllocType::Host,
+               "The cache can only be allocated in GPU or host memory");
 
-  buffer_ = kernels::memory::alloc_unique<uint8_t>(kernels::AllocType::GPU, cache_size_);
+  buffer_ = kernels::memory::alloc_unique<uint8_t>(alloc_type_, cache_size_);
   DALI_ENFORCE(buffer_ != nullptr);
   tail_ = buffer_.get();
   buffer_end_ = buffer_.get() + cache_size_;
   LOG_LINE << "cache size is " << cache_size_ / (1024 * 1024) << " MB" << std::endl;
 
+  if (is_host())
+    return;
   CUDA_CALL(cudaStreamCreateWithPriority(&cache_stream_, cudaStreamNonBlocking, 0));
   CUDA_CALL(cudaEventCreate(&cache_read_event_));
   CUDA_CALL(cudaEventCreate(&cache_write_event_));
@@ -44,10 +51,12 @@ ImageCacheBlob::ImageCacheBlob(std::size_t cache_size,
 
 ImageCacheBlob::~ImageCacheBlob() {
   try {
-    CUDA_CALL(cudaStreamSynchronize(cache_stream_));
-    CUDA_CALL(cudaEventDestroy(cache_read_event_));
-    CUDA_CALL(cudaEventDestroy(cache_write_event_));
-    CUDA_CALL(cudaStreamDestroy(cache_stream_));
+    if (!is_host()) {
+      CUDA_CALL(cudaStreamSynchronize(cache_stream_));
+      CUDA_CALL(cudaEventDestroy(cache_read_event_));
+      CUDA_CALL(cudaEventDestroy(cache_write_event_));
+      CUDA_CALL(cudaStreamDestroy(cache_stream_));
+    }
 
     if (stats_enabled_ && images_seen() > 0) print_stats();
   } catch (...) {
@@ -60,7 +69,7 @@ bool ImageCacheBlob::IsCached(const ImageKey& image_key) const {
   return cache_.find(image_key) != cache_.end();
 }
 
-const ImageCache::ImageShape& ImageCacheBlob::GetShape(const ImageKey& image_key) const {
+ImageCache::ImageShape ImageCacheBlob::GetShape(const ImageKey& image_key) const {
   std::lock_guard<std::mutex> lock(mutex_);
   const auto it = cache_.find(image_key);
   DALI_ENFORCE(it != cache_.end(), "cache entry [" + image_key + "] not found");
@@ -83,7 +92,7 @@ bool ImageCacheBlob::Read(const ImageKey& image_key,
   DALI_ENFORCE(data.data + n <= tail_);
 
   SyncToRead(stream);
-  MemCopy(destination_buffer, data.data, n, stream);
+  Copy(destination_buffer, data.data, n, stream);
 
   if (stats_enabled_) stats_[image_key].reads++;
   return true;
@@ -119,7 +128,7 @@ void ImageCacheBlob::Add(const ImageKey& image_key, const uint8_t* data,
     return;
   }
 
-  MemCopy(tail_, data, data_size, stream);
+  Copy(tail_, data, data_size, stream);
   SyncAfterWrite(stream);
 
   cache_[image_key] = {tail_, data_shape};
@@ -128,13 +137,25 @@ void ImageCacheBlob::Add(const ImageKey& image_key, const uint8_t* data,
   if (stats_enabled_) stats_[image_key].is_cached = true;
 }
 
+void ImageCacheBlob::Copy(void *dst, const void *src, std::size_t bytes,
+                          cudaStream_t stream) const {
+  if (is_host())
+    std::memcpy(dst, src, bytes);
+  else
+    MemCopy(dst, src, bytes, stream);
+}
+
 void ImageCacheBlob::SyncToRead(cudaStream_t stream) const {
+  if (is_host())
+    return;
   // synchronizing with cache instance stream with provided stream
   CUDA_CALL(cudaEventRecord(cache_read_event_, cache_stream_));
   CUDA_CALL(cudaStreamWaitEvent(stream, cache_read_event_, 0));
 }
 
 void ImageCacheBlob::SyncAfterWrite(cudaStream_t stream) const {
+  if (is_host())
+    return;
   // synchronizing with cache instance stream with provided stream
   CUDA_CALL(cudaEventRecord(cache_write_event_, stream));
   CUDA_CALL(cudaStreamWaitEvent(cache_stream_, cache_write_event_, 0));
@@ -25,11 +25,18 @@
 
 namespace dali {
 
+/**
+ * @brief Caches the images in a single buffer, allocated upfront, until it is full
+ *
+ * The buffer is allocated in GPU memory or, with `alloc_type` = Host, in host memory, in which
+ * case the streams passed to the reads and writes are ignored.
+ */
 class DLL_PUBLIC ImageCacheBlob : public ImageCache {
  public:
     DLL_PUBLIC ImageCacheBlob(std::size_t cache_size,
                               std::size_t image_size_threshold,
-                              bool stats_enabled = false);
+                              bool stats_enabled = false,
+                              kernels::AllocType alloc_type = kernels::AllocType::GPU);
 
     ~ImageCacheBlob() override;
 
@@ -37,11 +44,13 @@ class DLL_PUBLIC ImageCacheBlob : public ImageCache {
 
     bool IsCached(const ImageKey& image_key) const override;
 
+    using ImageCache::Read;
+
     bool Read(const ImageKey& image_key,
               void* destination_data,
               cudaStream_t stream) const override;
 
-    const ImageShape& GetShape(const ImageKey& image_key) const override;
+    ImageShape GetShape(const ImageKey& image_key) const override;
 
     void Add(const ImageKey& image_key,
              const uint8_t *data,
@@ -57,6 +66,13 @@ class DLL_PUBLIC ImageCacheBlob : public ImageCache {
 
     void print_stats() const;
 
+    /// copies to or from the buffer
+    void Copy(void *dst, const void *src, std::size_t bytes, cudaStream_t stream) const;
+
+    inline bool is_host() const {
+        return alloc_type_ == kernels::AllocType::Host;
+    }
+
     inline std::size_t images_seen() const {
         return (total_seen_images_ == 0) ?
             stats_.size() : total_seen_images_;
@@ -70,6 +86,7 @@ class DLL_PUBLIC ImageCacheBlob : public ImageCache {
     std::size_t cache_size_ = 0;
     std::size_t image_size_threshold_ = 0;
     bool stats_enabled_ = false;
+    kernels::AllocType alloc_type_ = kernels::AllocType::GPU;
     kernels::memory::KernelUniquePtr<uint8_t> buffer_;
     uint8_t* buffer_end_ = nullptr;
     uint8_t* tail_ = nullptr;
@@ -86,9 +103,10 @@ class DLL_PUBLIC ImageCacheBlob : public ImageCache {
     bool is_full = false;
     std::size_t total_seen_images_ = 0;
 
-    cudaStream_t cache_stream_;
-    cudaEvent_t cache_read_event_;
-    cudaEvent_t cache_write_event_;
+    // not used with host memory
+    cudaStream_t cache_stream_ = nullptr;
+    cudaEvent_t cache_read_event_ = nullptr;
+    cudaEvent_t cache_write_event_ = nullptr;
 };
 
 }  // namespace dali
@@ -67,6 +67,24 @@ TEST_F(ImageCacheBlobTest, ErrorTooSmallCacheSize) {
   EXPECT_FALSE(cache_->IsCached(kKey1));
 }
 
+TEST_F(ImageCacheBlobTest, HostMemory) {
+  cache_.reset(new ImageCacheBlob(1 << 9, 0, false, kernels::AllocType::Host));
+  cache_->Add(kKey1, &kValue1[0], kShape1, 0);
+  EXPECT_TRUE(cache_->IsCached(kKey1));
+  std::vector<uint8_t> cachedData(kValue1.size());
+  EXPECT_TRUE(cache_->Read(kKey1, &cachedData[0], 0));
+  EXPECT_EQ(kValue1, cachedData);
+
+  std::vector<uint8_t> cachedData2;
+  EXPECT_TRUE(cache_->Read(kKey1, [&](const ImageCache::ImageShape &shape) {
+    EXPECT_EQ(kShape1, shape);
+    cachedData2.resize(volume(shape));
+    return cachedData2.data();
+  }, 0));
+  EXPECT_EQ(kValue1, cachedData2);
+  EXPECT_FALSE(cache_->EvictsImages());
+}
+
 TEST_F(ImageCacheBlobTest, AllocateMoreThan2000MB) {
   std::size_t one_mb = 1024 * 1024;
   std::size_t size = 3l * 1024 * one_mb;
@@ -16,6 +16,7 @@
 #include <memory>
 #include "dali/operators/decoder/cache/image_cache_blob.h"
 #include "dali/operators/decoder/cache/image_cache_largest.h"
+#include "dali/operators/decoder/cache/image_cache_lru.h"
 
 namespace dali {
 
@@ -23,16 +24,21 @@ std::shared_ptr<ImageCache> ImageCacheFactory::Get(int device_id,
                                                    const std::string& cache_policy,
                                                    std::size_t cache_size,
                                                    bool cache_debug,
-                                                   std::size_t cache_threshold) {
+                                                   std::size_t cache_threshold,
+                                                   kernels::AllocType alloc_type) {
   std::lock_guard<std::mutex> lock(mutex_);
-  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold};
+  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold, alloc_type};
   auto &instance = caches_[device_id];
   auto cache = instance.cache.lock();
   if (!cache) {
     if (cache_policy == "threshold") {
-      cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
+      cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug, alloc_type));
     } else if (cache_policy == "largest") {
-      cache.reset(new ImageCacheLargest(cache_size, cache_debug));
+      cache.reset(new ImageCacheLargest(cache_size, cache_debug, alloc_type));
+    } else if (cache_policy == "lru") {
+      DALI_ENFORCE(alloc_type == kernels::AllocType::Host,
+                   "`lru` cache policy is only available for the CPU decoder");
+      cache.reset(new ImageCacheLRU(cache_size, cache_threshold, cache_debug));
     } else {
       DALI_FAIL("unexpected cache policy `" + cache_policy + "`");
     }
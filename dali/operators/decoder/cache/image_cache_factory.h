@@ -19,6 +19,7 @@
 #include <string>
 #include <map>
 #include <mutex>
+#include "dali/kernels/alloc_type.h"
 #include "dali/operators/decoder/cache/image_cache.h"
 
 namespace dali {
@@ -36,13 +37,17 @@ class DLL_PUBLIC ImageCacheFactory {
    * are the same.
    * Will fail if the cache was already allocated but with different
    * parameters
+   * @param alloc_type GPU or Host; the `lru` policy is available only in host memory
+   * @remarks There is one cache per device id, so a cache in host memory (used by the CPU
+   *          decoder) and a cache in GPU memory can't be used with the same device id
    */
   DLL_PUBLIC std::shared_ptr<ImageCache> Get(
     int device_id,
     const std::string& cache_policy,
     std::size_t cache_size,
     bool cache_debug = false,
-    std::size_t cache_threshold = 0);
+    std::size_t cache_threshold = 0,
+    kernels::AllocType alloc_type = kernels::AllocType::GPU);
 
   /**
    * @brief Get the already allocated cache
@@ -65,12 +70,14 @@ class DLL_PUBLIC ImageCacheFactory {
     std::size_t cache_size;
     bool cache_debug;
     std::size_t cache_threshold;
+    kernels::AllocType alloc_type;
 
     inline bool operator==(const CacheParams& oth) const {
       return cache_policy == oth.cache_policy
           && cache_size == oth.cache_size
           && cache_debug == oth.cache_debug
-          && cache_threshold == oth.cache_threshold;
+          && cache_threshold == oth.cache_threshold
+          && alloc_type == oth.alloc_type;
     }
   };
 
@@ -45,6 +45,26 @@ TEST_F(ImageCacheFactoryTest, TwoDifferentDevices) {
   EXPECT_TRUE(factory.IsInitialized(1));
 }
 
+TEST_F(ImageCacheFactoryTest, HostMemory) {
+  auto &factory = ImageCacheFactory::Instance();
+  ASSERT_FALSE(factory.IsInitialized(CPU_ONLY_DEVICE_ID));
+  EXPECT_THROW(factory.Get(CPU_ONLY_DEVICE_ID, "lru", 1*1024*1024, true, 0),
+               std::runtime_error);
+  auto cache = factory.Get(CPU_ONLY_DEVICE_ID, "lru", 1*1024*1024, true, 0,
+                           kernels::AllocType::Host);
+  EXPECT_NE(nullptr, cache);
+  EXPECT_TRUE(cache->EvictsImages());
+  // a cache in GPU memory has different parameters
+  EXPECT_THROW(factory.Get(CPU_ONLY_DEVICE_ID, "lru", 1*1024*1024, true, 0),
+               std::runtime_error);
+  cache.reset();
+  cache = factory.Get(CPU_ONLY_DEVICE_ID, "largest", 1*1024*1024, true, 0,
+                      kernels::AllocType::Host);
+  EXPECT_FALSE(cache->EvictsImages());
+  cache.reset();
+  EXPECT_FALSE(factory.IsInitialized(CPU_ONLY_DEVICE_ID));
+}
+
 TEST_F(ImageCacheFactoryTest, Lifetime) {
   auto &factory = ImageCacheFactory::Instance();
   ASSERT_FALSE(factory.IsInitialized(0));
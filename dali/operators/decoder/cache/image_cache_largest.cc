@@ -19,8 +19,9 @@
 
 namespace dali {
 
-ImageCacheLargest::ImageCacheLargest(std::size_t cache_size, bool stats_enabled)
-    : ImageCacheBlob(cache_size, 0, stats_enabled) {}
+ImageCacheLargest::ImageCacheLargest(std::size_t cache_size, bool stats_enabled,
+                                     kernels::AllocType alloc_type)
+    : ImageCacheBlob(cache_size, 0, stats_enabled, alloc_type) {}
 
 void ImageCacheLargest::Add(const ImageKey& image_key,
                                   const uint8_t *data,
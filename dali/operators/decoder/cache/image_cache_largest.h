@@ -27,7 +27,8 @@ namespace dali {
 
 class DLL_PUBLIC ImageCacheLargest : public ImageCacheBlob {
  public:
-  DLL_PUBLIC ImageCacheLargest(std::size_t cache_size, bool stats_enabled = false);
+  DLL_PUBLIC ImageCacheLargest(std::size_t cache_size, bool stats_enabled = false,
+                               kernels::AllocType alloc_type = kernels::AllocType::GPU);
 
   DISABLE_COPY_MOVE_ASSIGN(ImageCacheLargest);
 
@@ -0,0 +1,135 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_lru.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+ImageCacheLRU::ImageCacheLRU(std::size_t cache_size,
+                             std::size_t image_size_threshold,
+                             bool stats_enabled)
+    : cache_size_(cache_size)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled) {
+  DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+}
+
+ImageCacheLRU::~ImageCacheLRU() {
+  if (stats_enabled_)
+    print_stats();
+}
+
+bool ImageCacheLRU::IsCached(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.find(image_key) != index_.end();
+}
+
+ImageCache::ImageShape ImageCacheLRU::GetShape(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(image_key);
+  DALI_ENFORCE(it != index_.end(), "cache entry [" + image_key + "] not found");
+  return it->second->shape;
+}
+
+bool ImageCacheLRU::Read(const ImageKey& image_key,
+                         void* destination_buffer,
+                         cudaStream_t stream) const {
+  DALI_ENFORCE(destination_buffer != nullptr);
+  return Read(image_key, [destination_buffer](const ImageShape &) {
+    return destination_buffer;
+  }, stream);
+}
+
+bool ImageCacheLRU::Read(const ImageKey& image_key,
+                         const std::function<void*(const ImageShape&)> &get_destination,
+                         cudaStream_t) const {
+  DALI_ENFORCE(!image_key.empty());
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(image_key);
+  if (it == index_.end())
+    return false;
+  const auto &entry = *it->second;
+  void *destination_buffer = get_destination(entry.shape);
+  DALI_ENFORCE(destination_buffer != nullptr);
+  std::memcpy(destination_buffer, entry.data.get(), volume(entry.shape));
+  Touch(it->second);
+  reads_++;
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheLRU::Get(const ImageKey&) const {
+  DALI_FAIL("The LRU cache can evict an image while its buffer is still in use - "
+            "use Read instead of Get");
+}
+
+void ImageCacheLRU::Add(const ImageKey& image_key, const uint8_t* data,
+                        const ImageShape& data_shape, cudaStream_t) {
+  const std::size_t data_size = volume(data_shape);
+  if (data_size < image_size_threshold_ || data_size > cache_size_)
+    return;
+  DALI_ENFORCE(!image_key.empty());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index_.find(image_key) != index_.end())
+    return;
+
+  while (bytes_used_ + data_size > cache_size_) {
+    auto &lru = entries_.back();
+    bytes_used_ -= volume(lru.shape);
+    index_.erase(lru.key);
+    entries_.pop_back();
+    evictions_++;
+  }
+
+  Entry entry{image_key, data_shape, std::unique_ptr<uint8_t[]>(new uint8_t[data_size])};
+  std::memcpy(entry.data.get(), data, data_size);
+  entries_.push_front(std::move(entry));
+  index_[image_key] = entries_.begin();
+  bytes_used_ += data_size;
+  adds_++;
+}
+
+std::size_t ImageCacheLRU::bytes_used() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_used_;
+}
+
+void ImageCacheLRU::Touch(EntryList::iterator it) const {
+  entries_.splice(entries_.begin(), entries_, it);
+}
+
+void ImageCacheLRU::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_size: " << cache_size_ << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "bytes_used: " << bytes_used_ << std::endl;
+  out << "images_cached: " << entries_.size() << std::endl;
+  out << "images_added: " << adds_ << std::endl;
+  out << "images_evicted: " << evictions_ << std::endl;
+  out << "reads: " << reads_ << std::endl;
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
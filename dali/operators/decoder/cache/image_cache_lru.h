@@ -0,0 +1,110 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_LRU_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_LRU_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "dali/core/common.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief Caches the images in host memory and, when a new image doesn't fit, evicts the least
+ *        recently read ones
+ *
+ * Unlike the `threshold` and `largest` policies, it keeps adapting when the decoded dataset
+ * doesn't fit in the cache. Since the images can be evicted, the readers can't skip loading them.
+ * The streams passed to the reads and writes are ignored.
+ */
+class DLL_PUBLIC ImageCacheLRU : public ImageCache {
+ public:
+  DLL_PUBLIC ImageCacheLRU(std::size_t cache_size,
+                           std::size_t image_size_threshold = 0,
+                           bool stats_enabled = false);
+
+  ~ImageCacheLRU() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheLRU);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  /**
+   * @remarks The reference is valid until the image is evicted; use Read with `get_destination`
+   *          to read an image of unknown shape
+   */
+  ImageShape GetShape(const ImageKey& image_key) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  bool Read(const ImageKey& image_key,
+            const std::function<void*(const ImageShape&)> &get_destination,
+            cudaStream_t stream) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  /**
+   * @brief Not supported - another thread could evict the image while its buffer is in use
+   */
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override {}
+
+  bool EvictsImages() const override {
+    return true;
+  }
+
+  /// The total size of the cached images, in bytes
+  std::size_t bytes_used() const;
+
+ private:
+  struct Entry {
+    ImageKey key;
+    ImageShape shape;
+    std::unique_ptr<uint8_t[]> data;
+  };
+  using EntryList = std::list<Entry>;
+
+  /// Marks the entry as the most recently read one
+  void Touch(EntryList::iterator it) const;
+
+  void print_stats() const;
+
+  std::size_t cache_size_ = 0;
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+
+  std::size_t bytes_used_ = 0;
+  /// the most recently read images first
+  mutable EntryList entries_;
+  std::unordered_map<ImageKey, EntryList::iterator> index_;
+  mutable std::mutex mutex_;
+
+  mutable std::size_t reads_ = 0;
+  std::size_t adds_ = 0, evictions_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_LRU_H_
@@ -0,0 +1,128 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/operators/decoder/cache/image_cache_lru.h"
+
+namespace dali {
+namespace testing {
+
+struct ImageCacheLRUTest : public ::testing::Test {
+  void SetUp() override { SetUpImpl(30); }
+
+  void SetUpImpl(std::size_t cache_size, std::size_t image_size_threshold = 0) {
+    cache_.reset(new ImageCacheLRU(cache_size, image_size_threshold, false));
+    data_.clear();
+    for (std::size_t i = 0; i <= 20; i++) {
+      data_.push_back({std::to_string(i), std::vector<uint8_t>(i, i % 256)});
+    }
+  }
+
+  void AddImage(std::size_t i) {
+    cache_->Add(data_[i].first, data_[i].second.data(),
+                {static_cast<int64_t>(data_[i].second.size()), 1, 1}, 0);
+  }
+
+  bool ReadImage(std::size_t i) {
+    std::vector<uint8_t> out(data_[i].second.size(), 0xFF);
+    if (!cache_->Read(data_[i].first, out.data(), 0))
+      return false;
+    EXPECT_EQ(data_[i].second, out);
+    return true;
+  }
+
+  bool IsCached(std::size_t i) { return cache_->IsCached(data_[i].first); }
+
+  std::unique_ptr<ImageCacheLRU> cache_;
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> data_;
+};
+
+TEST_F(ImageCacheLRUTest, AddAndRead) {
+  EXPECT_FALSE(ReadImage(5));
+  AddImage(5);
+  AddImage(7);
+  EXPECT_TRUE(IsCached(5));
+  EXPECT_TRUE(IsCached(7));
+  EXPECT_EQ(cache_->bytes_used(), 12u);
+  EXPECT_TRUE(ReadImage(5));
+  EXPECT_TRUE(ReadImage(7));
+  EXPECT_EQ(cache_->GetShape("7"), ImageCache::ImageShape(7, 1, 1));
+  EXPECT_TRUE(cache_->EvictsImages());
+}
+
+TEST_F(ImageCacheLRUTest, EvictsLeastRecentlyRead) {
+  AddImage(10);
+  AddImage(11);
+  AddImage(8);
+  // 10 is read, so 11 is the least recently used one
+  EXPECT_TRUE(ReadImage(10));
+  AddImage(9);
+  EXPECT_TRUE(IsCached(10));
+  EXPECT_FALSE(IsCached(11));
+  EXPECT_TRUE(IsCached(8));
+  EXPECT_TRUE(IsCached(9));
+  EXPECT_EQ(cache_->bytes_used(), 27u);
+
+  // evicts as many images as needed
+  AddImage(20);
+  EXPECT_TRUE(IsCached(20));
+  EXPECT_FALSE(IsCached(8));
+  EXPECT_FALSE(IsCached(10));
+  EXPECT_TRUE(IsCached(9));
+  EXPECT_TRUE(ReadImage(20));
+}
+
+TEST_F(ImageCacheLRUTest, ShapeOutlivesEviction) {
+  AddImage(10);
+  AddImage(11);
+  auto shape = cache_->GetShape("10");
+  AddImage(20);
+  EXPECT_FALSE(IsCached(10));
+  EXPECT_EQ(shape, ImageCache::ImageShape(10, 1, 1));
+}
+
+TEST_F(ImageCacheLRUTest, GetNotSupported) {
+  AddImage(5);
+  EXPECT_THROW(cache_->Get("5"), std::runtime_error);
+  EXPECT_TRUE(ReadImage(5));
+}
+
+TEST_F(ImageCacheLRUTest, TooBigOrTooSmall) {
+  SetUpImpl(10, 5);
+  AddImage(4);
+  AddImage(11);
+  AddImage(5);
+  EXPECT_FALSE(IsCached(4));
+  EXPECT_FALSE(IsCached(11));
+  EXPECT_TRUE(IsCached(5));
+}
+
+TEST_F(ImageCacheLRUTest, ReadUnknownShape) {
+  AddImage(6);
+  std::vector<uint8_t> out;
+  auto get_destination = [&out](const ImageCache::ImageShape &shape) {
+    out.resize(volume(shape));
+    return out.data();
+  };
+  EXPECT_TRUE(static_cast<ImageCache&>(*cache_).Read("6", get_destination, 0));
+  EXPECT_EQ(data_[6].second, out);
+  EXPECT_FALSE(static_cast<ImageCache&>(*cache_).Read("7", get_destination, 0));
+}
+
+}  // namespace testing
+}  // namespace dali
@@ -29,6 +29,10 @@ class HostDecoderCrop : public HostDecoder, protected CropAttr {
   inline ~HostDecoderCrop() override = default;
   DISABLE_COPY_MOVE_ASSIGN(HostDecoderCrop);
 
+  void inline SetupSharedSampleParams(HostWorkspace &ws) override {
+    CropAttr::AcquireArguments(ws);
+  }
+
   void inline SetupSharedSampleParams(SampleWorkspace &ws) override {
     CropAttr::ProcessArguments(ws);
   }
@@ -15,11 +15,84 @@
 #include <opencv2/opencv.hpp>
 #include <tuple>
 #include <memory>
+#include <utility>
 #include "dali/image/image_factory.h"
+#include "dali/operators/decoder/cache/image_cache_factory.h"
 #include "dali/operators/decoder/host/host_decoder.h"
 
 namespace dali {
 
+void HostDecoder::InitCache(const OpSpec &spec) {
+  if (!spec.HasArgument("cache_size"))
+    return;
+  const std::size_t cache_size_mb =
+    static_cast<std::size_t>(spec.GetArgument<int>("cache_size"));
+  const std::size_t cache_size = cache_size_mb * 1024 * 1024;
+  const std::size_t cache_threshold =
+      static_cast<std::size_t>(spec.GetArgument<int>("cache_threshold"));
+  if (cache_size > 0 && cache_size >= cache_threshold) {
+    const std::string cache_type = spec.GetArgument<std::string>("cache_type");
+    const bool cache_debug = spec.GetArgument<bool>("cache_debug");
+    cache_ = ImageCacheFactory::Instance().Get(
+      spec.GetArgument<int>("device_id"), cache_type, cache_size, cache_debug, cache_threshold,
+      kernels::AllocType::Host);
+  }
+}
+
+bool HostDecoder::CacheLoad(const std::string &file_name, Tensor<CPUBackend> &output) {
+  if (!cache_ || file_name.empty())
+    return false;
+  return cache_->Read(file_name, [&output](const ImageCache::ImageShape &shape) {
+    output.Resize(shape);
+    return output.mutable_data<uint8_t>();
+  }, 0);
+}
+
+void HostDecoder::CacheStore(const std::string &file_name, const Tensor<CPUBackend> &output) {
+  if (!cache_ || file_name.empty() || cache_->IsCached(file_name))
+    return;
+  cache_->Add(file_name, output.data<uint8_t>(), output.shape().to_static<3>(), 0);
+}
+
+void HostDecoder::RunImpl(HostWorkspace &ws) {
+  deferred_.clear();
+  deferred_.resize(batch_size_);
+  Operator<CPUBackend>::RunImpl(ws);
+
+  // Large images (e.g. tiled TIFFs) are decoded in parts, in parallel
+  auto &thread_pool = ws.GetThreadPool();
+  bool any_deferred = false;
+  for (int data_idx = 0; data_idx < batch_size_; data_idx++) {
+    auto &sample = deferred_[data_idx];
+    for (int task_idx = 0; task_idx < sample.num_tasks; task_idx++) {
+      thread_pool.AddWork([&sample, task_idx](int tid) {
+        try {
+          sample.img->DecodeTask(task_idx);
+        } catch (std::exception &e) {
+          DALI_FAIL(e.what() + ". File: " + sample.file_name);
+        }
+      }, -data_idx);
+      any_deferred = true;
+    }
+  }
+  if (!any_deferred)
+    return;
+  thread_pool.RunAll();
+
+  for (int data_idx = 0; data_idx < batch_size_; data_idx++) {
+    auto &sample = deferred_[data_idx];
+    if (sample.num_tasks == 0)
+      continue;
+    thread_pool.AddWork([this, &sample](int tid) {
+      std::memcpy(sample.output->mutable_data<unsigned char>(), sample.img->GetImage().get(),
+                  volume(sample.img->GetShape()));
+      sample.img.reset();
+      CacheStore(sample.file_name, *sample.output);
+    }, -data_idx);
+  }
+  thread_pool.RunAll();
+}
+
 void HostDecoder::RunImpl(SampleWorkspace &ws) {
   const auto &input = ws.Input<CPUBackend>(0);
   auto &output = ws.Output<CPUBackend>(0);
@@ -31,21 +104,40 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
   DALI_ENFORCE(IsType<uint8>(input.type()),
                 "Input must be stored as uint8 data.");
 
+  if (CacheLoad(file_name, output)) {
+    output.SetLayout("HWC");
+    return;
+  }
+
+  // the decoding can be split into tasks only when run for the whole batch
+  bool can_defer = ws.data_idx() < static_cast<int>(deferred_.size());
   std::unique_ptr<Image> img;
+  int num_tasks = 1;
   try {
     img = ImageFactory::CreateImage(input.data<uint8>(), input.size(), output_type_);
     img->SetCropWindowGenerator(GetCropWindowGenerator(ws.data_idx()));
     img->SetUseFastIdct(use_fast_idct_);
-    img->Decode();
+    num_tasks = img->PrepareDecode(can_defer ? num_threads_ : 1);
+    if (num_tasks == 1)
+      img->DecodeTask(0);
   } catch (std::exception &e) {
     DALI_FAIL(e.what() + ". File: " + file_name);
   }
-  const auto decoded = img->GetImage();
   const auto shape = img->GetShape();
   output.Resize(shape);
   output.SetLayout("HWC");
+  if (num_tasks > 1) {
+    auto &sample = deferred_[ws.data_idx()];
+    sample.img = std::move(img);
+    sample.num_tasks = num_tasks;
+    sample.output = &output;
+    sample.file_name = file_name;
+    return;
+  }
+  const auto decoded = img->GetImage();
   unsigned char *out_data = output.mutable_data<unsigned char>();
   std::memcpy(out_data, decoded.get(), volume(shape));
+  CacheStore(file_name, output);
 }
 
 DALI_REGISTER_OPERATOR(ImageDecoder, HostDecoder, CPU);
@@ -15,10 +15,14 @@
 #ifndef DALI_OPERATORS_DECODER_HOST_HOST_DECODER_H_
 #define DALI_OPERATORS_DECODER_HOST_HOST_DECODER_H_
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/image/image.h"
+#include "dali/operators/decoder/cache/image_cache.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/util/crop_window.h"
 
@@ -30,8 +34,9 @@ class HostDecoder : public Operator<CPUBackend> {
       Operator<CPUBackend>(spec),
       output_type_(spec.GetArgument<DALIImageType>("output_type")),
       c_(IsColor(output_type_) ? 3 : 1),
-      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct"))
-  {}
+      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")) {
+    InitCache(spec);
+  }
 
   inline ~HostDecoder() override = default;
   DISABLE_COPY_MOVE_ASSIGN(HostDecoder);
@@ -41,6 +46,8 @@ class HostDecoder : public Operator<CPUBackend> {
     return false;
   }
 
+  void RunImpl(HostWorkspace &ws) override;
+
   void RunImpl(SampleWorkspace &ws) override;
 
   virtual CropWindowGenerator GetCropWindowGenerator(int data_idx) const {
@@ -50,6 +57,35 @@ class HostDecoder : public Operator<CPUBackend> {
   DALIImageType output_type_;
   int c_;
   bool use_fast_idct_ = false;
+
+ private:
+  /**
+   * @brief Creates the decoded image cache, in host memory, if requested in the spec
+   *
+   * Fused operators don't have cache options.
+   */
+  void InitCache(const OpSpec &spec);
+
+  /**
+   * @brief Reads the decoded image from the cache, resizing the output, if it is there
+   */
+  bool CacheLoad(const std::string &file_name, Tensor<CPUBackend> &output);
+
+  void CacheStore(const std::string &file_name, const Tensor<CPUBackend> &output);
+
+  std::shared_ptr<ImageCache> cache_;
+
+  /**
+   * @brief A sample whose decoding is split into tasks, run across the thread pool
+   *        once all the samples are processed
+   */
+  struct DeferredDecode {
+    std::unique_ptr<Image> img;
+    int num_tasks = 0;
+    Tensor<CPUBackend> *output = nullptr;
+    std::string file_name;
+  };
+  std::vector<DeferredDecode> deferred_;
 };
 
 }  // namespace dali
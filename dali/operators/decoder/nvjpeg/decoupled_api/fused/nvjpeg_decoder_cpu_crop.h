@@ -35,6 +35,10 @@ class nvJPEGDecoderCPUStageCrop : public nvJPEGDecoderCPUStage, protected CropAt
     return CropAttr::GetCropWindowGenerator(data_idx);
   }
 
+  void SetupSharedSampleParams(HostWorkspace &ws) override {
+    CropAttr::AcquireArguments(ws);
+  }
+
   void SetupSharedSampleParams(SampleWorkspace &ws) override {
     CropAttr::ProcessArguments(ws);
   }
@@ -36,7 +36,10 @@ DALI_SCHEMA(Flip)
 
 template <>
 Flip<CPUBackend>::Flip(const OpSpec &spec)
-    : Operator<CPUBackend>(spec) {}
+    : Operator<CPUBackend>(spec)
+    , horizontal_("horizontal", spec)
+    , vertical_("vertical", spec)
+    , depthwise_("depthwise", spec) {}
 
 void RunFlip(Tensor<CPUBackend> &output, const Tensor<CPUBackend> &input,
              const TensorLayout &layout,
@@ -64,9 +67,9 @@ void Flip<CPUBackend>::RunImpl(Workspace<CPUBackend> &ws) {
   output.SetLayout(layout);
   output.set_type(input.type());
   output.ResizeLike(input);
-  auto _horizontal = GetHorizontal(ws, ws.data_idx());
-  auto _vertical = GetVertical(ws, ws.data_idx());
-  auto _depthwise = GetDepthwise(ws, ws.data_idx());
+  auto _horizontal = horizontal_[ws.data_idx()];
+  auto _vertical = vertical_[ws.data_idx()];
+  auto _depthwise = depthwise_[ws.data_idx()];
   if (!_horizontal && !_vertical && !_depthwise) {
     output.Copy(input, nullptr);
   } else {
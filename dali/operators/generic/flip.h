@@ -19,6 +19,7 @@
 #include <string>
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/operator.h"
 
 namespace dali {
@@ -37,6 +38,9 @@ class Flip: public Operator<Backend> {
     auto &input = ws.template InputRef<Backend>(0);
     output_desc[0].type =  input.type();
     output_desc[0].shape = input.shape();
+    horizontal_.Acquire(ws);
+    vertical_.Acquire(ws);
+    depthwise_.Acquire(ws);
     return true;
   }
 
@@ -46,18 +50,6 @@ class Flip: public Operator<Backend> {
 
   void RunImpl(Workspace<Backend> &ws) override;
 
-  int GetHorizontal(const ArgumentWorkspace &ws, int idx) {
-    return this->spec_.template GetArgument<int>("horizontal", &ws, idx);
-  }
-
-  int GetVertical(const ArgumentWorkspace &ws, int idx) {
-    return this->spec_.template GetArgument<int>("vertical", &ws, idx);
-  }
-
-  int GetDepthwise(const ArgumentWorkspace &ws, int idx) {
-    return this->spec_.template GetArgument<int>("depthwise", &ws, idx);
-  }
-
   std::vector<int> GetHorizontal(const ArgumentWorkspace &ws) {
     std::vector<int> result;
     OperatorBase::GetPerSampleArgument(result, "horizontal", ws);
@@ -75,6 +67,9 @@ class Flip: public Operator<Backend> {
     OperatorBase::GetPerSampleArgument(result, "depthwise", ws);
     return result;
   }
+
+  // Per-sample access, used by the CPU operator
+  ScalarArg<int> horizontal_, vertical_, depthwise_;
 };
 
 }  // namespace dali
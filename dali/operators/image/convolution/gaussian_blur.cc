@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -229,26 +231,71 @@ class GaussianBlurOpCpu : public OpImplBase<CPUBackend> {
         seq_elements = volume(shape.begin(), shape.begin() + dim_desc_.usable_axes_start);
         stride = elem_volume;
       }
+      auto elem_shape = shape.template last<ndim>();
+      int num_parts = GetNumParts(elem_shape, params_[sample_idx], thread_pool.size());
       for (int elem_idx = 0; elem_idx < seq_elements; elem_idx++) {
-        thread_pool.AddWork(
-            [this, &input, &output, sample_idx, elem_idx, stride](int thread_id) {
-              auto gaussian_windows = windows_[sample_idx].GetWindows();
-              auto elem_shape = input[sample_idx].shape().template last<ndim>();
-              auto in_view = TensorView<StorageCPU, const In, ndim>{
-                  input[sample_idx].template data<In>() + stride * elem_idx, elem_shape};
-              auto out_view = TensorView<StorageCPU, Out, ndim>{
-                  output[sample_idx].template mutable_data<Out>() + stride * elem_idx, elem_shape};
-              // I need a context for that particular run (or rather matching the thread &
-              // scratchpad)
-              auto ctx = ctx_;
-              kmgr_.Run<Kernel>(thread_id, sample_idx, ctx, out_view, in_view, gaussian_windows);
-            }, elem_volume);
+        for (int part = 0; part < num_parts; part++) {
+          int64_t row_begin = elem_shape[0] * part / num_parts;
+          int64_t row_end = elem_shape[0] * (part + 1) / num_parts;
+          thread_pool.AddWork(
+              [this, &input, &output, sample_idx, elem_idx, stride, row_begin,
+               row_end](int thread_id) {
+                auto gaussian_windows = windows_[sample_idx].GetWindows();
+                auto elem_shape = input[sample_idx].shape().template last<ndim>();
+                auto in_view = TensorView<StorageCPU, const In, ndim>{
+                    input[sample_idx].template data<In>() + stride * elem_idx, elem_shape};
+                auto out_view = TensorView<StorageCPU, Out, ndim>{
+                    output[sample_idx].template mutable_data<Out>() + stride * elem_idx,
+                    elem_shape};
+                // I need a context for that particular run (or rather matching the thread &
+                // scratchpad)
+                auto ctx = ctx_;
+                RunKernel(kernels::supports_row_ranges<Kernel>(), thread_id, sample_idx, ctx,
+                          out_view, in_view, gaussian_windows, row_begin, row_end);
+              }, elem_volume / num_parts);
+        }
       }
     }
     thread_pool.RunAll();
   }
 
  private:
+  // Minimum number of elements processed by a single task, when splitting an image
+  static constexpr int64_t kMinPartVolume = 1 << 18;
+
+  /**
+   * @brief Number of ranges of rows that a 2D image is split into, to be processed in parallel
+   *
+   * Each part recalculates `window_size - 1` rows of the intermediate result at its borders,
+   * so the parts are at least 4 times higher than the outer window.
+   */
+  int GetNumParts(const TensorShape<ndim>& elem_shape, const GaussianBlurParams<axes>& params,
+                  int num_threads) const {
+    if (!kernels::supports_row_ranges<Kernel>::value)
+      return 1;
+    int64_t max_parts_by_rows = elem_shape[0] / (4 * params.window_sizes[0]);
+    int64_t max_parts_by_volume = volume(elem_shape) / kMinPartVolume;
+    return std::max<int64_t>(1, std::min<int64_t>({num_threads, max_parts_by_rows,
+                                                   max_parts_by_volume}));
+  }
+
+  template <typename Windows>
+  void RunKernel(std::true_type, int thread_id, int sample_idx, kernels::KernelContext& ctx,
+                 const TensorView<StorageCPU, Out, ndim>& out_view,
+                 const TensorView<StorageCPU, const In, ndim>& in_view, const Windows& windows,
+                 int64_t row_begin, int64_t row_end) {
+    kmgr_.Run<Kernel>(thread_id, sample_idx, ctx, out_view, in_view, windows, 1.f, row_begin,
+                      row_end);
+  }
+
+  template <typename Windows>
+  void RunKernel(std::false_type, int thread_id, int sample_idx, kernels::KernelContext& ctx,
+                 const TensorView<StorageCPU, Out, ndim>& out_view,
+                 const TensorView<StorageCPU, const In, ndim>& in_view, const Windows& windows,
+                 int64_t row_begin, int64_t row_end) {
+    kmgr_.Run<Kernel>(thread_id, sample_idx, ctx, out_view, in_view, windows);
+  }
+
   OpSpec spec_;
   int batch_size_ = 0;
   DimDesc dim_desc_;
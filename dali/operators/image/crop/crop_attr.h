@@ -20,6 +20,7 @@
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/util/crop_window.h"
@@ -36,12 +37,21 @@ class CropAttr {
   static constexpr int kNoCrop = -1;
   explicit inline CropAttr(const OpSpec &spec)
     : spec__(spec)
-    , batch_size__(spec__.GetArgument<int>("batch_size")) {
+    , batch_size__(spec__.GetArgument<int>("batch_size"))
+    , crop_pos_x_("crop_pos_x", spec)
+    , crop_pos_y_("crop_pos_y", spec)
+    , crop_pos_z_("crop_pos_z", spec)
+    , crop_w_arg_("crop_w", spec)
+    , crop_h_arg_("crop_h", spec)
+    , crop_d_arg_("crop_d", spec) {
     int crop_h = kNoCrop, crop_w = kNoCrop, crop_d = kNoCrop;
     bool has_crop_arg = spec__.HasArgument("crop");
     bool has_crop_w_arg = spec__.ArgumentDefined("crop_w");
     bool has_crop_h_arg = spec__.ArgumentDefined("crop_h");
     bool has_crop_d_arg = spec__.ArgumentDefined("crop_d");
+    has_crop_w_arg_ = has_crop_w_arg;
+    has_crop_h_arg_ = has_crop_h_arg;
+    has_crop_d_arg_ = has_crop_d_arg;
     is_whole_image_ = !has_crop_arg && !has_crop_w_arg && !has_crop_h_arg && !has_crop_d_arg;
 
     DALI_ENFORCE(has_crop_w_arg == has_crop_h_arg,
@@ -82,23 +92,34 @@ class CropAttr {
     crop_window_generators_.resize(batch_size__, {});
   }
 
-  void ProcessArguments(const ArgumentWorkspace *ws, std::size_t data_idx) {
-    crop_x_norm_[data_idx] = spec__.GetArgument<float>("crop_pos_x", ws, data_idx);
-    crop_y_norm_[data_idx] = spec__.GetArgument<float>("crop_pos_y", ws, data_idx);
+  /**
+   * @brief Gets the argument inputs of the current iteration; must be called before
+   *        the arguments of the samples are processed
+   */
+  void AcquireArguments(const ArgumentWorkspace &ws) {
+    crop_pos_x_.Acquire(ws);
+    crop_pos_y_.Acquire(ws);
     if (has_crop_d_)
-      crop_z_norm_[data_idx] = spec__.GetArgument<float>("crop_pos_z", ws, data_idx);
-    if (spec__.ArgumentDefined("crop_w")) {
-      crop_width_[data_idx] = static_cast<int>(
-        spec__.GetArgument<float>("crop_w", ws, data_idx));
-    }
-    if (spec__.ArgumentDefined("crop_h")) {
-      crop_height_[data_idx] = static_cast<int>(
-        spec__.GetArgument<float>("crop_h", ws, data_idx));
-    }
-    if (spec__.ArgumentDefined("crop_d")) {
-      crop_depth_[data_idx] = static_cast<int>(
-        spec__.GetArgument<float>("crop_d", ws, data_idx));
-    }
+      crop_pos_z_.Acquire(ws);
+    if (has_crop_w_arg_)
+      crop_w_arg_.Acquire(ws);
+    if (has_crop_h_arg_)
+      crop_h_arg_.Acquire(ws);
+    if (has_crop_d_arg_)
+      crop_d_arg_.Acquire(ws);
+  }
+
+  void ProcessArguments(std::size_t data_idx) {
+    crop_x_norm_[data_idx] = crop_pos_x_[data_idx];
+    crop_y_norm_[data_idx] = crop_pos_y_[data_idx];
+    if (has_crop_d_)
+      crop_z_norm_[data_idx] = crop_pos_z_[data_idx];
+    if (has_crop_w_arg_)
+      crop_width_[data_idx] = static_cast<int>(crop_w_arg_[data_idx]);
+    if (has_crop_h_arg_)
+      crop_height_[data_idx] = static_cast<int>(crop_h_arg_[data_idx]);
+    if (has_crop_d_arg_)
+      crop_depth_[data_idx] = static_cast<int>(crop_d_arg_[data_idx]);
 
     crop_window_generators_[data_idx] =
       [this, data_idx](const TensorShape<>& input_shape,
@@ -167,13 +188,18 @@ class CropAttr {
   }
 
   void ProcessArguments(const ArgumentWorkspace &ws) {
+    AcquireArguments(ws);
     for (std::size_t data_idx = 0; data_idx < batch_size__; data_idx++) {
-      ProcessArguments(&ws, data_idx);
+      ProcessArguments(data_idx);
     }
   }
 
+  /**
+   * @brief Processes the arguments of one sample; AcquireArguments must be called
+   *        for the batch first
+   */
   void ProcessArguments(const SampleWorkspace &ws) {
-    ProcessArguments(&ws, ws.data_idx());
+    ProcessArguments(ws.data_idx());
   }
 
   const CropWindowGenerator& GetCropWindowGenerator(std::size_t data_idx) const {
@@ -198,6 +224,13 @@ class CropAttr {
  private:
   OpSpec spec__;
   std::size_t batch_size__;
+
+ protected:
+  ScalarArg<float> crop_pos_x_, crop_pos_y_, crop_pos_z_;
+
+ private:
+  ScalarArg<float> crop_w_arg_, crop_h_arg_, crop_d_arg_;
+  bool has_crop_w_arg_ = false, has_crop_h_arg_ = false, has_crop_d_arg_ = false;
 };
 
 }  // namespace dali
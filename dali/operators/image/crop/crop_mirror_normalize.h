@@ -29,6 +29,7 @@
 #include "dali/kernels/slice/slice_flip_normalize_permute_pad_common.h"
 #include "dali/operators/generic/slice/out_of_bounds_policy.h"
 #include "dali/operators/image/crop/crop_attr.h"
+#include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -101,7 +102,8 @@ class CropMirrorNormalize : public Operator<Backend> {
         output_type_(spec.GetArgument<DALIDataType>("dtype")),
         output_layout_(spec.GetArgument<TensorLayout>("output_layout")),
         pad_output_(spec.GetArgument<bool>("pad_output")),
-        out_of_bounds_policy_(GetOutOfBoundsPolicy(spec)) {
+        out_of_bounds_policy_(GetOutOfBoundsPolicy(spec)),
+        mirror_("mirror", spec) {
     if (!spec.TryGetRepeatedArgument(mean_vec_, "mean")) {
       mean_vec_ = { spec.GetArgument<float>("mean") };
     }
@@ -189,6 +191,7 @@ class CropMirrorNormalize : public Operator<Backend> {
       "This operator expects an explicit channel dimension, even for monochrome images");
 
     crop_attr_.ProcessArguments(ws);
+    mirror_.Acquire(ws);
 
     VALUE_SWITCH(ndim, Dims, CMN_NDIMS,
     (
@@ -204,7 +207,7 @@ class CropMirrorNormalize : public Operator<Backend> {
         auto crop_win_gen = crop_attr_.GetCropWindowGenerator(data_idx);
         assert(crop_win_gen);
         CropWindow crop_window = crop_win_gen(in_shape[data_idx], input_layout_);
-        bool horizontal_flip = this->spec_.template GetArgument<int>("mirror", &ws, data_idx);
+        bool horizontal_flip = mirror_[data_idx];
         ApplySliceBoundsPolicy(out_of_bounds_policy_, in_shape[data_idx], crop_window.anchor,
                                crop_window.shape);
         kernel_sample_args.emplace_back(
@@ -232,6 +235,8 @@ class CropMirrorNormalize : public Operator<Backend> {
   std::vector<float> fill_values_;
   OutOfBoundsPolicy out_of_bounds_policy_ = OutOfBoundsPolicy::Error;
 
+  ScalarArg<int> mirror_;
+
   kernels::KernelManager kmgr_;
   any kernel_sample_args_;
 
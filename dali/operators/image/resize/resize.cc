@@ -19,13 +19,15 @@
 namespace dali {
 
 DALI_SCHEMA(Resize)
-  .DocStr(R"code(Resize images.)code")
+  .DocStr(R"code(Resize images.
+
+Volumetric data (``DHWC`` and ``FDHWC`` layouts) is supported by the CPU operator only.)code")
   .NumInput(1)
   .NumOutput(1)
   .AdditionalOutputsFn([](const OpSpec& spec) {
     return static_cast<int>(spec.GetArgument<bool>("save_attrs"));
   })
-  .InputLayout(0, {"HWC", "FHWC", "CHW", "FCHW", "CFHW" /*, "DHWC", "FDHWC" */ })
+  .InputLayout(0, {"HWC", "FHWC", "CHW", "FCHW", "CFHW", "DHWC", "FDHWC"})
   .AddOptionalArg("save_attrs",
       R"code(Save reshape attributes for testing.)code", false)
   .DeprecateArg("image_type", true)  // deprecated since 0.25dev
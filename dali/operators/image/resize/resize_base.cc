@@ -54,15 +54,30 @@ void ResizeBase<Backend>::SetupResize(TensorListShape<> &out_shape,
   }
 }
 
-template <typename Backend>
+template <>
 template <typename OutputType, typename InputType>
-void ResizeBase<Backend>::SetupResizeTyped(
+void ResizeBase<GPUBackend>::SetupResizeTyped(
       TensorListShape<> &out_shape,
       const TensorListShape<> &in_shape,
       span<const kernels::ResamplingParams> params,
       int spatial_ndim,
       int first_spatial_dim) {
   VALUE_SWITCH(spatial_ndim, static_spatial_ndim, (2),
+  (SetupResizeStatic<OutputType, InputType, static_spatial_ndim>(
+      out_shape, in_shape, params, first_spatial_dim)),
+  (DALI_FAIL(make_string("Unsupported number of resized dimensions: ", spatial_ndim,
+    ". GPU resize supports only 2D images."))));
+}
+
+template <>
+template <typename OutputType, typename InputType>
+void ResizeBase<CPUBackend>::SetupResizeTyped(
+      TensorListShape<> &out_shape,
+      const TensorListShape<> &in_shape,
+      span<const kernels::ResamplingParams> params,
+      int spatial_ndim,
+      int first_spatial_dim) {
+  VALUE_SWITCH(spatial_ndim, static_spatial_ndim, (2, 3),
   (SetupResizeStatic<OutputType, InputType, static_spatial_ndim>(
       out_shape, in_shape, params, first_spatial_dim)),
   (DALI_FAIL(make_string("Unsupported number of resized dimensions: ", spatial_ndim))));
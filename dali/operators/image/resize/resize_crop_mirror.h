@@ -49,7 +49,12 @@ struct TransformMeta {
 class ResizeCropMirrorAttr : protected CropAttr {
  protected:
   explicit inline ResizeCropMirrorAttr(const OpSpec &spec) : CropAttr(spec),
-    interp_type_(spec.GetArgument<DALIInterpType>("interp_type")) {
+    interp_type_(spec.GetArgument<DALIInterpType>("interp_type")),
+    resize_shorter_arg_("resize_shorter", spec),
+    resize_longer_arg_("resize_longer", spec),
+    resize_x_arg_("resize_x", spec),
+    resize_y_arg_("resize_y", spec),
+    mirror_("mirror", spec) {
     resize_shorter_ = spec.ArgumentDefined("resize_shorter");
     resize_longer_ = spec.ArgumentDefined("resize_longer");
     resize_x_ = spec.ArgumentDefined("resize_x");
@@ -70,9 +75,29 @@ class ResizeCropMirrorAttr : protected CropAttr {
   }
 
  protected:
-  inline const TransformMeta GetTransformMeta(const OpSpec &spec,
-                                              const TensorShape<> &input_shape,
-                                              const ArgumentWorkspace *ws, const Index index,
+  /**
+   * @brief Gets the argument inputs of the current iteration; must be called before
+   *        GetTransformMeta is called for the samples
+   */
+  void AcquireArguments(const ArgumentWorkspace &ws) {
+    if (resize_shorter_)
+      resize_shorter_arg_.Acquire(ws);
+    if (resize_longer_)
+      resize_longer_arg_.Acquire(ws);
+    if (resize_x_)
+      resize_x_arg_.Acquire(ws);
+    if (resize_y_)
+      resize_y_arg_.Acquire(ws);
+    if (ResizeInfoNeeded() & t_crop) {
+      crop_pos_x_.Acquire(ws);
+      crop_pos_y_.Acquire(ws);
+    }
+    if (ResizeInfoNeeded() & t_mirrorHor)
+      mirror_.Acquire(ws);
+  }
+
+  inline const TransformMeta GetTransformMeta(const TensorShape<> &input_shape,
+                                              const Index index,
                                               const uint32_t flag = 0) {
     TransformMeta meta = {};
     meta.H = input_shape[0];
@@ -81,7 +106,7 @@ class ResizeCropMirrorAttr : protected CropAttr {
 
     if (resize_shorter_) {
       // resize_shorter set
-      const int shorter_side_size = spec.GetArgument<float>("resize_shorter", ws, index);
+      const int shorter_side_size = resize_shorter_arg_[index];
 
       if (meta.H < meta.W) {
         const float scale = shorter_side_size / static_cast<float>(meta.H);
@@ -108,7 +133,7 @@ class ResizeCropMirrorAttr : protected CropAttr {
       }
     } else if (resize_longer_) {
         // resize_longer set
-        const int longer_side_size = spec.GetArgument<float>("resize_longer", ws, index);
+        const int longer_side_size = resize_longer_arg_[index];
 
         if (meta.H > meta.W) {
           const float scale = longer_side_size / static_cast<float>(meta.H);
@@ -121,10 +146,10 @@ class ResizeCropMirrorAttr : protected CropAttr {
       }
     } else {
       if (resize_x_) {
-        meta.rsz_w = spec.GetArgument<float>("resize_x", ws, index);
+        meta.rsz_w = resize_x_arg_[index];
         if (resize_y_) {
           // resize_x and resize_y set
-          meta.rsz_h = spec.GetArgument<float>("resize_y", ws, index);
+          meta.rsz_h = resize_y_arg_[index];
         } else {
           // resize_x set only
           const float scale = static_cast<float>(meta.rsz_w) / meta.W;
@@ -132,7 +157,7 @@ class ResizeCropMirrorAttr : protected CropAttr {
         }
       } else {
         // resize_y set only
-        meta.rsz_h = spec.GetArgument<float>("resize_y", ws, index);
+        meta.rsz_h = resize_y_arg_[index];
         const float scale = static_cast<float>(meta.rsz_h) / meta.H;
         meta.rsz_w = static_cast<int>(std::round(scale * meta.W));
       }
@@ -140,8 +165,8 @@ class ResizeCropMirrorAttr : protected CropAttr {
 
     if (flag & t_crop) {
       float crop_anchor_norm[2];
-      crop_anchor_norm[0] = spec.GetArgument<float>("crop_pos_y", ws, index);
-      crop_anchor_norm[1] = spec.GetArgument<float>("crop_pos_x", ws, index);
+      crop_anchor_norm[0] = crop_pos_y_[index];
+      crop_anchor_norm[1] = crop_pos_x_[index];
 
       auto anchor_abs = CalculateAnchor(make_span(crop_anchor_norm),
                                         {crop_height_[index], crop_width_[index]},
@@ -151,7 +176,7 @@ class ResizeCropMirrorAttr : protected CropAttr {
 
     if (flag & t_mirrorHor) {
       // Set mirror parameters
-      meta.mirror = spec.GetArgument<int>("mirror", ws, index);
+      meta.mirror = mirror_[index];
     }
 
     return meta;
@@ -175,9 +200,9 @@ class ResizeCropMirrorAttr : protected CropAttr {
     return std::vector<Index>{input.shape().begin(), input.shape().end()};
   }
 
-  inline const TransformMeta GetTransfomMeta(const SampleWorkspace *ws, const OpSpec &spec) {
+  inline const TransformMeta GetTransfomMeta(const SampleWorkspace *ws) {
     const auto input_shape = CheckShapes(ws);
-    return GetTransformMeta(spec, input_shape, ws, ws->data_idx(), ResizeInfoNeeded());
+    return GetTransformMeta(input_shape, ws->data_idx(), ResizeInfoNeeded());
   }
 
   DALIInterpType getInterpType() const        { return interp_type_; }
@@ -193,6 +218,9 @@ class ResizeCropMirrorAttr : protected CropAttr {
   bool max_size_enforced_;
   // Contains (H, W) max sizes
   std::vector<float> max_size_;
+
+  ScalarArg<float> resize_shorter_arg_, resize_longer_arg_, resize_x_arg_, resize_y_arg_;
+  ScalarArg<int> mirror_;
 };
 
 typedef DALIError_t (*resizeCropMirroHost)(const uint8 *img, int H, int W, int C,
@@ -221,8 +249,12 @@ class ResizeCropMirror : public Operator<CPUBackend>, protected ResizeCropMirror
     return false;
   }
 
+  inline void SetupSharedSampleParams(HostWorkspace &ws) override {
+    AcquireArguments(ws);
+  }
+
   inline void SetupSharedSampleParams(SampleWorkspace &ws) override {
-    per_thread_meta_[ws.thread_idx()] = GetTransfomMeta(&ws, spec_);
+    per_thread_meta_[ws.thread_idx()] = GetTransfomMeta(&ws);
   }
 
   inline void RunImpl(SampleWorkspace &ws) override {
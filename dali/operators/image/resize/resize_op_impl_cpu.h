@@ -20,6 +20,7 @@
 #endif
 
 #include <cassert>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include "dali/operators/image/resize/resize_op_impl.h"
@@ -34,7 +35,8 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
     kmgr_.Resize(num_threads, 0);
   }
 
-  static_assert(spatial_ndim == 2, "NOT IMPLEMENTED. Only 2D resize is supported");
+  static_assert(spatial_ndim == 2 || spatial_ndim == 3,
+                "NOT IMPLEMENTED. Only 2D and 3D resize is supported");
 
   using Kernel = kernels::ResampleCPU<Out, In, spatial_ndim>;
 
@@ -84,14 +86,10 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
 
     ThreadPool &tp = ws.GetThreadPool();
 
-    for (int i = 0; i < GetNumFrames(); i++) {
-      auto work = [&, i](int tid) {
-        kernels::KernelContext ctx;
-        auto out_frame = out_frames_view[i];
-        auto in_frame = in_frames_view[i];
-        kmgr_.Run<Kernel>(tid, i, ctx, out_frame, in_frame, params_[i]);
-      };
-
+    int N = GetNumFrames();
+    costs_.resize(N);
+    double total_cost = 0;
+    for (int i = 0; i < N; i++) {
       double out_size = volume(out_frames_view.shape.tensor_shape_span(i));
       double in_size = volume(in_frames_view.shape.tensor_shape_span(i));
       double cost = 0;
@@ -105,7 +103,48 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
         // NOTE: This does not account for cost of antialiasing!
         cost += std::pow(std::pow(out_size, spatial_ndim - i) * pow(in_size, i), root);
       }
-      tp.AddWork(work, std::llround(cost));
+      costs_[i] = cost;
+      total_cost += cost;
+    }
+
+    // Frames which would take more than their fair share of the thread pool are split into
+    // bands of output rows, so that a few large images don't leave most threads idle.
+    double max_task_cost = total_cost / tp.size();
+
+    for (int i = 0; i < N; i++) {
+      auto &kernel = kmgr_.Get<Kernel>(i);
+      int out_rows = out_frames_view.shape.tensor_shape_span(i)[0];
+      int num_bands = 1;
+      if (costs_[i] > max_task_cost && kernel.CanRunInBands()) {
+        num_bands = std::ceil(costs_[i] / max_task_cost);
+        num_bands = std::min(num_bands, out_rows / kMinBandRows);
+        num_bands = std::max(num_bands, 1);
+      }
+
+      if (num_bands == 1) {
+        auto work = [&, i](int tid) {
+          kernels::KernelContext ctx;
+          auto out_frame = out_frames_view[i];
+          auto in_frame = in_frames_view[i];
+          kmgr_.Run<Kernel>(tid, i, ctx, out_frame, in_frame, params_[i]);
+        };
+        tp.AddWork(work, std::llround(costs_[i]));
+      } else {
+        for (int b = 0; b < num_bands; b++) {
+          int row_begin = static_cast<int64_t>(out_rows) * b / num_bands;
+          int row_end = static_cast<int64_t>(out_rows) * (b + 1) / num_bands;
+          auto work = [&, i, row_begin, row_end](int tid) {
+            kernels::KernelContext ctx;
+            auto out_frame = out_frames_view[i];
+            auto in_frame = in_frames_view[i];
+            auto scratchpad = kmgr_.ReserveScratchpad(tid, kmgr_.GetRequirements(i).scratch_sizes);
+            ctx.scratchpad = &scratchpad;
+            kmgr_.Get<Kernel>(i).RunBand(ctx, out_frame, in_frame, params_[i],
+                                         row_begin, row_end);
+          };
+          tp.AddWork(work, std::llround(costs_[i] / num_bands));
+        }
+      }
     }
     tp.RunAll();
   }
@@ -122,6 +161,11 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
 
   kernels::KernelManager &kmgr_;
 
+  /// Frames are not split into bands with fewer output rows than this
+  static constexpr int kMinBandRows = 16;
+
+  std::vector<double> costs_;
+
   TensorListShape<frame_ndim> in_shape_, out_shape_;
   std::vector<ResamplingParamsND<spatial_ndim>> params_;
 };
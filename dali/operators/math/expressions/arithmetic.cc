@@ -22,18 +22,62 @@ namespace dali {
 template <>
 void ArithmeticGenericOp<CPUBackend>::RunImpl(HostWorkspace &ws) {
   PrepareTilesForTasks<CPUBackend>(tiles_per_task_, exec_order_, tile_cover_, ws, constant_storage_,
-                                   spec_);
+                                   spec_, result_shape_);
   auto &pool = ws.GetThreadPool();
   ws.OutputRef<CPUBackend>(0).SetLayout(result_layout_);
+  if (tile_buffer_size_ > 0) {
+    thread_scratch_.resize(pool.size());
+    for (auto &scratch : thread_scratch_) {
+      scratch.storage.resize(tile_buffer_size_ + kTileBufferAlignment);
+      scratch.tile_buffer = reinterpret_cast<uint8_t *>(align_up(
+          reinterpret_cast<uintptr_t>(scratch.storage.data()), kTileBufferAlignment));
+      scratch.tile.resize(1);
+    }
+  }
+  // The broadcast inputs are read through the strides of their BroadcastDesc,
+  // from the beginning of the sample
+  for (size_t i = 0; i < exec_order_.size(); i++) {
+    const auto &links = intermediate_links_[i];
+    for (size_t j = 0; j < links.broadcast.size(); j++) {
+      if (links.broadcast[j] < 0)
+        continue;
+      const auto &input = broadcast_inputs_[links.broadcast[j]];
+      for (auto &tile : tiles_per_task_[i]) {
+        if (tile.args[j])
+          continue;  // this sample has the result shape
+        tile.args[j] = GetInputSamplePointer(ws, input.input_idx, tile.desc.sample_idx);
+        tile.broadcast[j] = &input.samples[tile.desc.sample_idx];
+      }
+    }
+  }
   for (size_t task_idx = 0; task_idx < tile_range_.size(); task_idx++) {
     pool.AddWork([this, task_idx](int thread_idx) {
       auto range = tile_range_[task_idx];
+      if (tile_buffer_size_ == 0) {
+        // Go over "tiles"
+        for (int extent_idx = range.begin; extent_idx < range.end; extent_idx++) {
+          exec_order_[0].impl->Execute(exec_order_[0].ctx, tiles_per_task_[0],
+                                       {extent_idx, extent_idx + 1});
+        }
+        return;
+      }
+
+      auto *tile_buffer = thread_scratch_[thread_idx].tile_buffer;
+      auto &tile = thread_scratch_[thread_idx].tile;
       // Go over "tiles"
       for (int extent_idx = range.begin; extent_idx < range.end; extent_idx++) {
-        // Go over expression tree in some provided order
+        // Go over expression tree in post-order, the intermediate results of this tile
+        // go to the buffer of this thread
         for (size_t i = 0; i < exec_order_.size(); i++) {
-          exec_order_[i].impl->Execute(exec_order_[i].ctx, tiles_per_task_[i],
-                                       {extent_idx, extent_idx + 1});
+          const auto &links = intermediate_links_[i];
+          tile[0] = tiles_per_task_[i][extent_idx];
+          if (links.output >= 0)
+            tile[0].output = tile_buffer + links.output;
+          for (size_t j = 0; j < links.args.size(); j++) {
+            if (links.args[j] >= 0)
+              tile[0].args[j] = tile_buffer + links.args[j];
+          }
+          exec_order_[i].impl->Execute(exec_order_[i].ctx, tile, {0, 1});
         }
       }
     }, -task_idx);  // FIFO order, since the work is already divided to similarly sized chunks
@@ -16,9 +16,11 @@
 #define DALI_OPERATORS_MATH_EXPRESSIONS_ARITHMETIC_H_
 
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "dali/core/format.h"
@@ -26,8 +28,10 @@
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/core/tensor_shape_print.h"
+#include "dali/core/util.h"
 #include "dali/kernels/type_tag.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_broadcast.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -66,7 +70,11 @@ inline TileCover GetTiledCover(const TensorListShape<> &shape, int tile_size,
 }
 
 /**
- * @brief Recurse over expression tree and return the only matching layout
+ * @brief Recurse over expression tree and return the layout of the result
+ *
+ * The inputs without a layout are skipped. As the shapes are broadcast starting from
+ * the innermost dimension, a layout with fewer dimensions must match the innermost dimensions
+ * of the other one, e.g. "C" and "HWC" result in "HWC".
  */
 template <typename Backend>
 DLL_PUBLIC TensorLayout GetCommonLayout(ExprNode &expr, const workspace_t<Backend> &ws) {
@@ -84,18 +92,16 @@ DLL_PUBLIC TensorLayout GetCommonLayout(ExprNode &expr, const workspace_t<Backen
   auto result_layout = GetCommonLayout<Backend>(func[0], ws);
   for (int i = 1; i < expr.GetSubexpressionCount(); i++) {
     auto next_layout = GetCommonLayout<Backend>(func[i], ws);
-    if (result_layout.empty()) {
-      result_layout = next_layout;
-      continue;
-    }
+    if (next_layout.ndim() > result_layout.ndim())
+      std::swap(result_layout, next_layout);
     if (next_layout.empty()) {
       continue;
     }
     DALI_ENFORCE(
-        result_layout == next_layout,
+        result_layout.last(next_layout.ndim()) == next_layout,
         make_string("Layouts of subexpressions ", i - 1, " and ", i, " for atihmetic operation",
-                    func.GetFuncName(), " do not match. Expected ", result_layout, " got ",
-                    next_layout, "."));
+                    func.GetFuncName(), " do not match. Expected ", result_layout,
+                    " or its innermost dimensions, got ", next_layout, "."));
   }
   return result_layout;
 }
@@ -155,19 +161,37 @@ inline std::vector<ExprImplTask> CreateExecutionTasks(const ExprNode &expr, Expr
   return result;
 }
 
+/**
+ * @brief Calculate the shape of the result of `op` applied to inputs of given `shapes`.
+ *
+ * Scalar-like inputs are skipped. The remaining shapes must be equal or, if `broadcasting`
+ * is allowed, their samples must be compatible according to the NumPy broadcasting rules.
+ */
 inline TensorListShape<> ShapePromotion(std::string op, span<const TensorListShape<> *> shapes,
-                                        int batch_size) {
+                                        int batch_size, bool broadcasting = false) {
   const TensorListShape<> *out_shape = nullptr;
+  TensorListShape<> broadcast_shape;
   for (int i = 0; i < shapes.size(); i++) {
     if (IsScalarLike(*shapes[i]))
       continue;
     if (!out_shape) {
       out_shape = shapes[i];
-    } else {
-      DALI_ENFORCE(*out_shape == *shapes[i],
+    } else if (*out_shape != *shapes[i]) {
+      DALI_ENFORCE(broadcasting && out_shape->num_samples() == shapes[i]->num_samples(),
                    make_string("Input shapes of elemenetwise arithemtic operator \"", op,
                               "\" do not match. Expected equal shapes, got: ", op, "(",
                               *out_shape, ", ", *shapes[i], ")."));
+      std::vector<TensorShape<>> samples(out_shape->num_samples());
+      for (int sample_idx = 0; sample_idx < out_shape->num_samples(); sample_idx++) {
+        DALI_ENFORCE(BroadcastShape(samples[sample_idx], (*out_shape)[sample_idx],
+                                    (*shapes[i])[sample_idx]),
+                     make_string("Input shapes of elemenetwise arithemtic operator \"", op,
+                                 "\" cannot be broadcast. Got: ", op, "(",
+                                 (*out_shape)[sample_idx], ", ", (*shapes[i])[sample_idx],
+                                 ") for sample ", sample_idx, "."));
+      }
+      broadcast_shape = samples;
+      out_shape = &broadcast_shape;
     }
   }
   return out_shape ? *out_shape : uniform_list_shape(batch_size, {1});
@@ -201,7 +225,9 @@ DLL_PUBLIC inline const TensorListShape<> &PropagateShapes(ExprNode &expr,
   for (int i = 0; i < subexpression_count; i++) {
     shapes[i] = &PropagateShapes<Backend>(func[i], ws, batch_size);
   }
-  func.SetShape(ShapePromotion(func.GetFuncName(), make_span(shapes), batch_size));
+  // Broadcasting is supported only by the CPU tile executor
+  func.SetShape(ShapePromotion(func.GetFuncName(), make_span(shapes), batch_size,
+                               std::is_same<Backend, CPUBackend>::value));
   return func.GetShape();
 }
 
@@ -284,7 +310,14 @@ inline void CheckAllowedOperations(ExprNode &expr) {
  * @brief Arithmetic operator capable of executing expression tree of element-wise
  *        arithmetic operations.
  *
- * Only expressions consisting of one function node with tensor inputs are now supported.
+ * On the CPU, expression trees of any depth are evaluated tile by tile: all the nodes are
+ * computed for a tile before moving to the next one, with the intermediate results kept in small
+ * per-thread tile buffers, so the data goes through the memory once and no batch-sized
+ * temporaries are allocated. The GPU supports only expressions consisting of one function node.
+ *
+ * The CPU backend also supports NumPy-style broadcasting of the tensor inputs: an input with
+ * extent 1 (or missing outer dimensions) is read in place, through strides that are 0 in the
+ * broadcast dimensions, so it's never copied nor expanded.
  *
  * There are 3 levels for unit of work.
  * - Thread (CPUBackend) or CUDA kernel invokation (GPUBackend)
@@ -322,8 +355,8 @@ class ArithmeticGenericOp : public Operator<Backend> {
     }
 
     result_shape_ = PropagateShapes<Backend>(*expr_, ws, batch_size_);
-    AllocateIntermediateNodes();
     exec_order_ = CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    AllocateIntermediateNodes();
 
     output_desc[0] = {result_shape_, TypeTable::GetTypeInfo(result_type_id_)};
     std::tie(tile_cover_, tile_range_) = GetTiledCover(result_shape_, kTileSize, kTaskSize);
@@ -334,22 +367,89 @@ class ArithmeticGenericOp : public Operator<Backend> {
   void RunImpl(workspace_t<Backend> &ws) override;
 
  private:
+  /**
+   * @brief Assign the places for the results of the intermediate nodes in the tile buffers
+   *        and find the inputs that need broadcasting to the result shape
+   *
+   * Every intermediate node gets its own slot, large enough to hold one tile of its type.
+   */
   void AllocateIntermediateNodes() {
     auto &expr = *expr_;
-    bool is_simple_expression = expr.GetNodeType() == NodeType::Function &&
-                                expr.GetSubexpressionCount() > 0 &&
-                                expr.GetSubexpressionCount() <= 2;
-    auto &func = dynamic_cast<ExprFunc &>(expr);
-    for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-      is_simple_expression = is_simple_expression && func[i].GetNodeType() != NodeType::Function;
+    DALI_ENFORCE(expr.GetNodeType() == NodeType::Function && expr.GetSubexpressionCount() > 0 &&
+                 expr.GetSubexpressionCount() <= 2,
+                 "The expression must be a function node with one or two inputs.");
+    if (!std::is_same<Backend, CPUBackend>::value) {
+      DALI_ENFORCE(exec_order_.size() == 1,
+                   "Complex expression trees are not yet supported on the GPU. Only expressions "
+                   "containing one function node with one or two inputs are supported.");
+      return;
+    }
+
+    std::map<const ExprNode *, int64_t> offsets;
+    int64_t buffer_size = 0;
+    intermediate_links_.resize(exec_order_.size());
+    broadcast_inputs_.clear();
+    for (size_t i = 0; i < exec_order_.size(); i++) {
+      const auto &func = dynamic_cast<const ExprFunc &>(*exec_order_[i].ctx.node);
+      auto &links = intermediate_links_[i];
+      links.args.clear();
+      links.broadcast.clear();
+      for (int j = 0; j < func.GetSubexpressionCount(); j++) {
+        auto it = offsets.find(&func[j]);
+        links.args.push_back(it != offsets.end() ? it->second : -1);
+        links.broadcast.push_back(-1);
+        if (func[j].GetNodeType() == NodeType::Tensor && !IsScalarLike(func[j]) &&
+            func[j].GetShape() != result_shape_) {
+          links.broadcast[j] = broadcast_inputs_.size();
+          broadcast_inputs_.push_back(GetBroadcastInput(func[j]));
+        }
+      }
+      // the root, which goes last, writes directly to the output
+      links.output = -1;
+      if (i + 1 < exec_order_.size()) {
+        links.output = buffer_size;
+        offsets[&func] = buffer_size;
+        buffer_size += align_up(kTileSize * TypeTable::GetTypeInfo(func.GetTypeId()).size(),
+                                kTileBufferAlignment);
+      }
     }
+    tile_buffer_size_ = buffer_size;
+  }
 
-    DALI_ENFORCE(is_simple_expression,
-                 "Complex expression trees are not yet supported. Only expressions containing one "
-                 "function node with one or two inputs are supported.");
-    // TODO(klecki): allocate memory for intermediate results and point the threads to them
+  /**
+   * @brief An input which is broadcast to the result shape; the kernels read it through
+   *        the strides of its BroadcastDesc
+   */
+  struct BroadcastInput {
+    int input_idx;
+    std::vector<BroadcastDesc> samples;    // for the samples that need broadcasting
+  };
+
+  BroadcastInput GetBroadcastInput(const ExprNode &node) const {
+    const auto &tensor = dynamic_cast<const ExprTensor &>(node);
+    BroadcastInput input;
+    input.input_idx = tensor.GetInputIndex();
+    const auto &shape = tensor.GetShape();
+    input.samples.resize(shape.num_samples());
+    for (int sample_idx = 0; sample_idx < shape.num_samples(); sample_idx++) {
+      if (shape.tensor_size(sample_idx) != result_shape_.tensor_size(sample_idx))
+        input.samples[sample_idx] = GetBroadcastDesc(result_shape_[sample_idx], shape[sample_idx]);
+    }
+    return input;
   }
 
+  /**
+   * @brief Places of the inputs and the output of an expression node in the tile buffer;
+   *        -1 for those which are not intermediate results.
+   *
+   * `broadcast` indexes the broadcast_inputs_; -1 for the inputs that are not broadcast.
+   */
+  struct IntermediateLinks {
+    int64_t output = -1;
+    SmallVector<int64_t, kMaxArity> args;
+    SmallVector<int, kMaxArity> broadcast;
+  };
+
   std::unique_ptr<ExprNode> expr_;
   TensorListShape<> result_shape_;
   bool types_layout_inferred_ = false;
@@ -361,6 +461,23 @@ class ArithmeticGenericOp : public Operator<Backend> {
   std::vector<std::vector<ExtendedTileDesc>> tiles_per_task_;
   ConstantStorage<Backend> constant_storage_;
   ExprImplCache cache_;
+  // CPU only: per exec_order_ node, and the size of per-thread buffers for intermediate tiles
+  std::vector<IntermediateLinks> intermediate_links_;
+  std::vector<BroadcastInput> broadcast_inputs_;
+  int64_t tile_buffer_size_ = 0;
+
+  /**
+   * @brief Space used by a thread to evaluate the expression tree tile by tile
+   */
+  struct ThreadScratch {
+    std::vector<uint8_t> storage;
+    /// the intermediate tiles, tile_buffer_size_ bytes within `storage`
+    uint8_t *tile_buffer = nullptr;
+    /// the tile of the node being evaluated
+    std::vector<ExtendedTileDesc> tile;
+  };
+  std::vector<ThreadScratch> thread_scratch_;
+  static constexpr int kTileBufferAlignment = 64;
   // For CPU we limit the tile size to limit the sizes of intermediate buffers
   // For GPU it's better to execute more at one time.
   static constexpr int kTileSize =
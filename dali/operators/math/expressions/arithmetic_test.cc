@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -94,8 +95,8 @@ TEST(ArithmeticOpsTest, TreePropagationError) {
   }
   in[0]->SetLayout(TensorLayout());
   in[1]->SetLayout(TensorLayout("HW"));
-  in[2]->SetLayout(TensorLayout("DHW"));
-  in[2]->Resize({{10}, {2}});
+  in[2]->SetLayout(TensorLayout("HWC"));
+  in[2]->Resize({{10}, {3}});
   ws.AddInput(in[0]);
   ws.AddInput(in[1]);
   ws.AddInput(in[2]);
@@ -104,6 +105,123 @@ TEST(ArithmeticOpsTest, TreePropagationError) {
   ASSERT_THROW(GetCommonLayout<CPUBackend>(expr_ref, ws), std::runtime_error);
 }
 
+TEST(ArithmeticOpsTest, BroadcastLayouts) {
+  auto expr = ParseExpressionString("add(&0 mul(&1 &2))");
+  HostWorkspace ws;
+  std::shared_ptr<TensorVector<CPUBackend>> in[3];
+  for (auto &ptr : in) {
+    ptr = std::make_shared<TensorVector<CPUBackend>>();
+    ptr->Resize({{1}, {1}});
+    ws.AddInput(ptr);
+  }
+  auto layout = [&](TensorLayout l0, TensorLayout l1, TensorLayout l2) {
+    in[0]->SetLayout(l0);
+    in[1]->SetLayout(l1);
+    in[2]->SetLayout(l2);
+    return GetCommonLayout<CPUBackend>(*expr, ws);
+  };
+  EXPECT_EQ(layout("HWC", "", "HWC"), "HWC");
+  EXPECT_EQ(layout("C", "HWC", ""), "HWC");
+  EXPECT_EQ(layout("HWC", "C", "WC"), "HWC");
+  EXPECT_EQ(layout("C", "", "C"), "C");
+  EXPECT_EQ(layout("", "", ""), "");
+  EXPECT_THROW(layout("H", "HWC", ""), std::runtime_error);
+  EXPECT_THROW(layout("HWC", "C", "HW"), std::runtime_error);
+}
+
+TEST(ArithmeticOpsTest, PropagateBroadcastShapes) {
+  std::string expr_str = "mul(sub(&0 &1) &2)";
+  auto expr = ParseExpressionString(expr_str);
+  auto &expr_ref = *expr;
+  HostWorkspace ws;
+  std::shared_ptr<TensorVector<CPUBackend>> in[3];
+  for (auto &ptr : in) {
+    ptr = std::make_shared<TensorVector<CPUBackend>>();
+  }
+  in[0]->Resize({{4, 5, 3}, {2, 2, 3}});
+  in[1]->Resize({{1, 1, 3}, {1, 1, 3}});
+  in[2]->Resize({{4, 1, 1}, {2, 1, 1}});
+  for (auto &ptr : in) {
+    ws.AddInput(ptr);
+  }
+
+  auto result_shape = PropagateShapes<CPUBackend>(expr_ref, ws, 2);
+  auto expected_shape = TensorListShape<>{{4, 5, 3}, {2, 2, 3}};
+  EXPECT_EQ(result_shape, expected_shape);
+
+  // Without broadcasting (GPU), the shapes must match
+  TensorListShape<> shape0 = {{4, 5, 3}, {2, 2, 3}}, shape1 = {{1, 1, 3}, {1, 1, 3}};
+  const TensorListShape<> *shapes[] = {&shape0, &shape1};
+  EXPECT_THROW(ShapePromotion("sub", make_span(shapes), 2), std::runtime_error);
+  EXPECT_EQ(ShapePromotion("sub", make_span(shapes), 2, true), shape0);
+
+  // Missing outer dimensions are treated as 1, both inputs can be broadcast
+  TensorListShape<> shape2 = {{5, 1}, {2, 1}}, shape3 = {{4}, {3}};
+  shapes[0] = &shape2;
+  shapes[1] = &shape3;
+  TensorListShape<> expected_shape23 = {{5, 4}, {2, 3}};
+  EXPECT_EQ(ShapePromotion("add", make_span(shapes), 2, true), expected_shape23);
+
+  TensorListShape<> shape4 = {{5, 2}, {2, 3}};
+  shapes[1] = &shape4;
+  shapes[0] = &shape3;
+  EXPECT_THROW(ShapePromotion("add", make_span(shapes), 2, true), std::runtime_error);
+}
+
+TEST(ArithmeticOpsTest, BroadcastCursor) {
+  TensorShape<> out_shape = {2, 3, 1, 4, 5};
+  for (TensorShape<> in_shape : {TensorShape<>{1, 3, 1, 1, 1}, TensorShape<>{4, 5},
+                                 TensorShape<>{2, 1, 1, 4, 1}, TensorShape<>{1},
+                                 TensorShape<>{3, 1, 4, 5}}) {
+    std::vector<int> in(volume(in_shape));
+    for (size_t i = 0; i < in.size(); i++)
+      in[i] = i;
+    auto desc = GetBroadcastDesc(out_shape, in_shape);
+
+    // reference
+    std::vector<int> ref(volume(out_shape));
+    int offset = out_shape.size() - in_shape.size();
+    for (int64_t flat = 0; flat < volume(out_shape); flat++) {
+      int64_t rem = flat, in_idx = 0, in_stride = 1;
+      for (int d = out_shape.size() - 1; d >= 0; d--) {
+        int64_t idx = rem % out_shape[d];
+        rem /= out_shape[d];
+        if (d >= offset) {
+          int64_t in_extent = in_shape[d - offset];
+          in_idx += (in_extent == 1 ? 0 : idx) * in_stride;
+          in_stride *= in_extent;
+        }
+      }
+      ref[flat] = in[in_idx];
+    }
+
+    for (int64_t start : {0, 7, 20, 59}) {
+      for (int64_t extent : {1, 13, 61}) {
+        extent = std::min(extent, volume(out_shape) - start);
+        std::vector<int> out(extent, -1);
+        BroadcastCursor<int> cursor(in.data(), &desc, start);
+        for (int64_t done = 0; done < extent;) {
+          int64_t n = std::min(extent - done, cursor.run_length());
+          ASSERT_GT(n, 0);
+          for (int64_t i = 0; i < n; i++)
+            out[done + i] = cursor.repeats() ? *cursor.data() : cursor.data()[i];
+          cursor.advance(n);
+          done += n;
+        }
+        for (int64_t i = 0; i < extent; i++)
+          ASSERT_EQ(out[i], ref[start + i]) << "input shape: " << in_shape << ", start: " << start
+                                            << ", element: " << i;
+      }
+    }
+  }
+
+  auto desc = GetBroadcastDesc({6, 7, 3}, {1, 1, 3});
+  EXPECT_EQ(desc.shape.size(), 2);
+  EXPECT_EQ(desc.shape[0], 42);
+  EXPECT_EQ(desc.strides[0], 0);
+  EXPECT_EQ(desc.shape[1], 3);
+  EXPECT_EQ(desc.strides[1], 1);
+}
 
 // namespace {
 
@@ -442,6 +560,265 @@ TEST(ArithmeticOpsTest, ConstantsPipeline) {
   }
 }
 
+TEST(ArithmeticOpsTest, NestedExpressionPipeline) {
+  constexpr int batch_size = 4;
+  constexpr int num_threads = 4;
+  constexpr int magic_int = 3;
+  constexpr float magic_float = 0.5f;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("data0");
+  pipe.AddExternalInput("data1");
+
+  // (data0 - 3) * 0.5 + data1, evaluated in one pass
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc", "add(mul(sub(&0 $0:int32) $0:float32) &1)")
+                       .AddArg("integer_constants", std::vector<int>{magic_int})
+                       .AddArg("real_constants", std::vector<float>{magic_float})
+                       .AddInput("data0", "cpu")
+                       .AddInput("data1", "cpu")
+                       .AddOutput("result0", "cpu"),
+                   "arithm_cpu_nested");
+
+  // data0 * (data1 + 3) - the inner node is scalar-like when data1 is a batch of scalars
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc", "mul(&0 add(&1 $0:int32))")
+                       .AddArg("integer_constants", std::vector<int>{magic_int})
+                       .AddInput("data0", "cpu")
+                       .AddInput("data1", "cpu")
+                       .AddOutput("result1", "cpu"),
+                   "arithm_cpu_nested_scalar");
+
+  vector<std::pair<string, string>> outputs = {{"result0", "cpu"}, {"result1", "cpu"}};
+
+  pipe.Build(outputs);
+
+  // the samples span several tiles, with partial tiles at the end
+  TensorListShape<> shape = {{5000}, {10000}, {17}, {4096}};
+  for (bool scalar_data1 : {false, true}) {
+    TensorList<CPUBackend> batch[2];
+    FillBatch<int>(batch[0], shape);
+    FillBatch<int>(batch[1], scalar_data1 ? uniform_list_shape(batch_size, {1}) : shape);
+
+    pipe.SetExternalInput("data0", batch[0]);
+    pipe.SetExternalInput("data1", batch[1]);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    DeviceWorkspace ws;
+    pipe.Outputs(&ws);
+
+    auto &result0 = ws.OutputRef<CPUBackend>(0);
+    auto &result1 = ws.OutputRef<CPUBackend>(1);
+    ASSERT_EQ(result0.type(), TypeInfo::Create<float>());
+    ASSERT_EQ(result1.type(), TypeInfo::Create<int>());
+    ASSERT_EQ(result0.shape(), shape);
+    ASSERT_EQ(result1.shape(), shape);
+    for (int i = 0; i < batch_size; i++) {
+      const auto *in0 = batch[0].tensor<int>(i);
+      const auto *in1 = batch[1].tensor<int>(i);
+      const auto *out0 = result0.tensor<float>(i);
+      const auto *out1 = result1.tensor<int>(i);
+      for (int j = 0; j < shape[i].num_elements(); j++) {
+        int b = in1[scalar_data1 ? 0 : j];
+        ASSERT_EQ(out0[j], (in0[j] - magic_int) * magic_float + b)
+            << " difference at sample: " << i << ", element: " << j;
+        ASSERT_EQ(out1[j], in0[j] * (b + magic_int))
+            << " difference at sample: " << i << ", element: " << j;
+      }
+    }
+  }
+}
+
+TEST(ArithmeticOpsTest, NestedExpressionGPU) {
+  Pipeline pipe(1, 1, 0);
+  pipe.AddExternalInput("data0");
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "gpu")
+                       .AddArg("expression_desc", "minus(add(&0 &0))")
+                       .AddInput("data0", "gpu")
+                       .AddOutput("result0", "gpu"),
+                   "arithm_gpu_nested");
+  pipe.Build({{"result0", "gpu"}});
+  TensorList<CPUBackend> batch;
+  FillBatch<int>(batch, uniform_list_shape(1, {16}));
+  pipe.SetExternalInput("data0", batch);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  EXPECT_THROW(pipe.Outputs(&ws), std::runtime_error);
+}
+
+TEST(ArithmeticOpsTest, BroadcastPipeline) {
+  constexpr int batch_size = 3;
+  constexpr int num_threads = 4;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("image");
+  pipe.AddExternalInput("mean");
+  pipe.AddExternalInput("scale");
+  pipe.AddExternalInput("row");
+
+  // per-channel normalization
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc", "mul(sub(&0 &1) &2)")
+                       .AddInput("image", "cpu")
+                       .AddInput("mean", "cpu")
+                       .AddInput("scale", "cpu")
+                       .AddOutput("normalized", "cpu"),
+                   "arithm_cpu_per_channel");
+
+  // per-row scaling, the broadcast input goes first
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc", "mul(&1 &0)")
+                       .AddInput("image", "cpu")
+                       .AddInput("row", "cpu")
+                       .AddOutput("scaled", "cpu"),
+                   "arithm_cpu_per_row");
+
+  pipe.Build({{"normalized", "cpu"}, {"scaled", "cpu"}});
+
+  // the images span several tiles
+  TensorListShape<> image_shape = {{40, 50, 3}, {7, 9, 3}, {100, 31, 3}};
+  TensorListShape<> row_shape = {{40, 1, 1}, {7, 1, 1}, {100, 1, 1}};
+  TensorList<CPUBackend> image, mean, scale, row;
+  FillBatch<int>(image, image_shape);
+  FillBatch<float>(mean, uniform_list_shape(batch_size, {1, 1, 3}));
+  FillBatch<float>(scale, uniform_list_shape(batch_size, {1, 1, 3}));
+  FillBatch<int>(row, row_shape);
+
+  pipe.SetExternalInput("image", image);
+  pipe.SetExternalInput("mean", mean);
+  pipe.SetExternalInput("scale", scale);
+  pipe.SetExternalInput("row", row);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  pipe.Outputs(&ws);
+
+  auto &normalized = ws.OutputRef<CPUBackend>(0);
+  auto &scaled = ws.OutputRef<CPUBackend>(1);
+  ASSERT_EQ(normalized.type(), TypeInfo::Create<float>());
+  ASSERT_EQ(scaled.type(), TypeInfo::Create<int>());
+  ASSERT_EQ(normalized.shape(), image_shape);
+  ASSERT_EQ(scaled.shape(), image_shape);
+  for (int i = 0; i < batch_size; i++) {
+    const auto *in = image.tensor<int>(i);
+    const auto *m = mean.tensor<float>(i);
+    const auto *s = scale.tensor<float>(i);
+    const auto *r = row.tensor<int>(i);
+    const auto *out0 = normalized.tensor<float>(i);
+    const auto *out1 = scaled.tensor<int>(i);
+    int64_t width = image_shape[i][1];
+    for (int j = 0; j < image_shape[i].num_elements(); j++) {
+      int c = j % 3;
+      int y = j / (3 * width);
+      ASSERT_EQ(out0[j], (in[j] - m[c]) * s[c])
+          << " difference at sample: " << i << ", element: " << j;
+      ASSERT_EQ(out1[j], r[y] * in[j])
+          << " difference at sample: " << i << ", element: " << j;
+    }
+  }
+}
+
+TEST(ArithmeticOpsTest, MixedRankBroadcastPipeline) {
+  constexpr int batch_size = 3;
+  constexpr int num_threads = 4;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("image");
+  pipe.AddExternalInput("mean");
+  pipe.AddExternalInput("column");
+
+  // "HWC" image and "C" per-channel values
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc", "sub(&0 &1)")
+                       .AddInput("image", "cpu")
+                       .AddInput("mean", "cpu")
+                       .AddOutput("centered", "cpu"),
+                   "arithm_cpu_mixed_rank");
+
+  // both inputs of `add` and the input of `minus` are broadcast
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc", "mul(add(&0 &1) minus(&0))")
+                       .AddInput("column", "cpu")
+                       .AddInput("mean", "cpu")
+                       .AddOutput("outer", "cpu"),
+                   "arithm_cpu_outer");
+
+  pipe.Build({{"centered", "cpu"}, {"outer", "cpu"}});
+
+  TensorListShape<> image_shape = {{40, 50, 3}, {7, 9, 3}, {100, 31, 3}};
+  TensorListShape<> column_shape = {{1500, 1, 1}, {7, 1, 1}, {2, 1, 1}};
+  TensorList<CPUBackend> image, mean, column;
+  FillBatch<int>(image, image_shape);
+  FillBatch<int>(mean, uniform_list_shape(batch_size, {3}));
+  FillBatch<int>(column, column_shape);
+  image.SetLayout("HWC");
+  mean.SetLayout("C");
+  column.SetLayout("HWC");
+
+  pipe.SetExternalInput("image", image);
+  pipe.SetExternalInput("mean", mean);
+  pipe.SetExternalInput("column", column);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  pipe.Outputs(&ws);
+
+  auto &centered = ws.OutputRef<CPUBackend>(0);
+  auto &outer = ws.OutputRef<CPUBackend>(1);
+  EXPECT_EQ(centered.GetLayout(), "HWC");
+  EXPECT_EQ(outer.GetLayout(), "HWC");
+  ASSERT_EQ(centered.shape(), image_shape);
+  TensorListShape<> outer_shape = {{1500, 1, 3}, {7, 1, 3}, {2, 1, 3}};
+  ASSERT_EQ(outer.shape(), outer_shape);
+  for (int i = 0; i < batch_size; i++) {
+    const auto *in = image.tensor<int>(i);
+    const auto *m = mean.tensor<int>(i);
+    const auto *col = column.tensor<int>(i);
+    const auto *out0 = centered.tensor<int>(i);
+    const auto *out1 = outer.tensor<int>(i);
+    for (int j = 0; j < image_shape[i].num_elements(); j++) {
+      ASSERT_EQ(out0[j], in[j] - m[j % 3])
+          << " difference at sample: " << i << ", element: " << j;
+    }
+    for (int j = 0; j < outer_shape[i].num_elements(); j++) {
+      int y = j / 3, c = j % 3;
+      ASSERT_EQ(out1[j], (col[y] + m[c]) * -col[y])
+          << " difference at sample: " << i << ", element: " << j;
+    }
+  }
+}
+
+TEST(ArithmeticOpsTest, BroadcastGPU) {
+  Pipeline pipe(1, 1, 0);
+  pipe.AddExternalInput("data0");
+  pipe.AddExternalInput("data1");
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "gpu")
+                       .AddArg("expression_desc", "add(&0 &1)")
+                       .AddInput("data0", "gpu")
+                       .AddInput("data1", "gpu")
+                       .AddOutput("result0", "gpu"),
+                   "arithm_gpu_broadcast");
+  pipe.Build({{"result0", "gpu"}});
+  TensorList<CPUBackend> batch[2];
+  FillBatch<int>(batch[0], uniform_list_shape(1, {4, 3}));
+  FillBatch<int>(batch[1], uniform_list_shape(1, {1, 3}));
+  pipe.SetExternalInput("data0", batch[0]);
+  pipe.SetExternalInput("data1", batch[1]);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  EXPECT_THROW(pipe.Outputs(&ws), std::runtime_error);
+}
+
 using shape_sequence = std::vector<std::array<TensorListShape<>, 3>>;
 
 int GetBatchSize(const shape_sequence &seq) {
@@ -0,0 +1,181 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_BROADCAST_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_BROADCAST_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/core/tensor_shape_print.h"
+
+namespace dali {
+
+/**
+ * @brief Shape resulting from broadcasting `a` and `b` according to the NumPy rules
+ *
+ * The shapes are aligned to the innermost dimension; the extents must be equal or one of them
+ * must be 1. The missing outer dimensions are treated as 1.
+ *
+ * @return false, if the shapes can't be broadcast
+ */
+inline bool BroadcastShape(TensorShape<> &result, const TensorShape<> &a,
+                           const TensorShape<> &b) {
+  int ndim = std::max(a.size(), b.size());
+  result.resize(ndim);
+  for (int d = 0; d < ndim; d++) {
+    int da = d - (ndim - a.size());
+    int db = d - (ndim - b.size());
+    int64_t ea = da >= 0 ? a[da] : 1;
+    int64_t eb = db >= 0 ? b[db] : 1;
+    if (ea != eb && ea != 1 && eb != 1)
+      return false;
+    result[d] = ea == 1 ? eb : ea;
+  }
+  return true;
+}
+
+/**
+ * @brief Describes how to read a broadcast input in the order of the elements of the output
+ *
+ * The dimensions are simplified: the extent 1 dimensions are dropped and the adjacent
+ * dimensions that are both broadcast or both contiguous in the input are merged.
+ * Empty `shape` describes a single element.
+ */
+struct BroadcastDesc {
+  SmallVector<int64_t, 6> shape;    // extents of the output
+  SmallVector<int64_t, 6> strides;  // strides of the input, in elements; 0 in broadcast dims
+};
+
+inline BroadcastDesc GetBroadcastDesc(const TensorShape<> &out_shape,
+                                      const TensorShape<> &in_shape) {
+  int ndim = out_shape.size();
+  int offset = ndim - in_shape.size();
+  DALI_ENFORCE(offset >= 0, make_string("Cannot broadcast shape ", in_shape, " to ", out_shape));
+  SmallVector<int64_t, 6> strides;
+  strides.resize(ndim);
+  int64_t stride = 1;
+  for (int d = ndim - 1; d >= 0; d--) {
+    int64_t in_extent = d >= offset ? in_shape[d - offset] : 1;
+    DALI_ENFORCE(in_extent == out_shape[d] || in_extent == 1,
+                 make_string("Cannot broadcast shape ", in_shape, " to ", out_shape));
+    strides[d] = in_extent == 1 ? 0 : stride;
+    stride *= in_extent;
+  }
+
+  BroadcastDesc desc;
+  for (int d = 0; d < ndim; d++) {
+    if (out_shape[d] == 1)
+      continue;
+    int last = desc.shape.size() - 1;
+    if (last >= 0 && desc.strides[last] == strides[d] * out_shape[d]) {
+      desc.shape[last] *= out_shape[d];
+      desc.strides[last] = strides[d];
+    } else {
+      desc.shape.push_back(out_shape[d]);
+      desc.strides.push_back(strides[d]);
+    }
+  }
+  return desc;
+}
+
+/**
+ * @brief Reads an input in the order of the elements of the output, in runs in which
+ *        the input is either contiguous or repeats a single element
+ *
+ * In the simplified BroadcastDesc the innermost dimension is either broadcast or contiguous
+ * in the input, so a run ends at the end of the innermost dimension.
+ * Without a BroadcastDesc, the input is read as is: `data` points to the element corresponding
+ * to the starting element of the output and the whole input is a single contiguous run.
+ */
+template <typename T>
+class BroadcastCursor {
+ public:
+  /**
+   * @param start flat index of the starting element of the output
+   */
+  BroadcastCursor(const T *data, const BroadcastDesc *desc, int64_t start)
+      : data_(data), desc_(desc) {
+    if (!desc_)
+      return;
+    int ndim = desc_->shape.size();
+    assert(ndim == 0 || desc_->strides[ndim - 1] <= 1);
+    idx_.resize(ndim);
+    for (int d = ndim - 1; d >= 0; d--) {
+      idx_[d] = start % desc_->shape[d];
+      start /= desc_->shape[d];
+      offset_ += idx_[d] * desc_->strides[d];
+    }
+  }
+
+  /**
+   * @brief The input element corresponding to the current element of the output
+   */
+  const T *data() const {
+    return data_ + offset_;
+  }
+
+  /**
+   * @brief Whether the current run repeats a single element of the input
+   */
+  bool repeats() const {
+    return desc_ && (desc_->shape.empty() || desc_->strides[desc_->shape.size() - 1] == 0);
+  }
+
+  /**
+   * @brief Number of elements of the output left in the current run
+   */
+  int64_t run_length() const {
+    if (!desc_ || desc_->shape.empty())
+      return std::numeric_limits<int64_t>::max();
+    return desc_->shape[desc_->shape.size() - 1] - idx_[idx_.size() - 1];
+  }
+
+  /**
+   * @brief Moves `n` elements of the output forward; `n` must not exceed `run_length()`
+   */
+  void advance(int64_t n) {
+    if (!desc_) {
+      offset_ += n;
+      return;
+    }
+    int inner = static_cast<int>(desc_->shape.size()) - 1;
+    if (inner < 0)
+      return;
+    idx_[inner] += n;
+    offset_ += n * desc_->strides[inner];
+    for (int d = inner; d > 0 && idx_[d] == desc_->shape[d]; d--) {
+      offset_ += desc_->strides[d - 1] - idx_[d] * desc_->strides[d];
+      idx_[d] = 0;
+      idx_[d - 1]++;
+    }
+  }
+
+ private:
+  const T *data_;
+  const BroadcastDesc *desc_;
+  int64_t offset_ = 0;
+  SmallVector<int64_t, 6> idx_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_BROADCAST_H_
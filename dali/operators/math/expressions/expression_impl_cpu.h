@@ -15,10 +15,13 @@
 #ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_H_
 #define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_H_
 
+#include <algorithm>
 #include <vector>
 
 #include "dali/pipeline/data/types.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_broadcast.h"
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
 #include "dali/operators/math/expressions/expression_tree.h"
 #include "dali/pipeline/operator/op_spec.h"
@@ -27,6 +30,72 @@
 
 namespace dali {
 
+namespace detail {
+
+inline int64_t TileStart(const TileDesc &desc) {
+  return desc.tile_size * desc.extent_idx;
+}
+
+template <ArithmeticOp op, typename Result, typename Left, typename Right>
+void ExecuteBinOp(Result *result, const Left *l, const Right *r, int64_t extent) {
+  using meta = arithm_meta<op, CPUBackend>;
+  if (dali::TryExecuteArithmSIMD<op>(result, l, r, extent))
+    return;
+  for (int64_t i = 0; i < extent; i++) {
+    result[i] = meta::impl(l[i], r[i]);
+  }
+}
+
+template <ArithmeticOp op, typename Result, typename Left, typename Right>
+void ExecuteBinOp(Result *result, Left l, const Right *r, int64_t extent) {
+  using meta = arithm_meta<op, CPUBackend>;
+  if (dali::TryExecuteArithmSIMD<op>(result, l, r, extent))
+    return;
+  for (int64_t i = 0; i < extent; i++) {
+    result[i] = meta::impl(l, r[i]);
+  }
+}
+
+template <ArithmeticOp op, typename Result, typename Left, typename Right>
+void ExecuteBinOp(Result *result, const Left *l, Right r, int64_t extent) {
+  using meta = arithm_meta<op, CPUBackend>;
+  if (dali::TryExecuteArithmSIMD<op>(result, l, r, extent))
+    return;
+  for (int64_t i = 0; i < extent; i++) {
+    result[i] = meta::impl(l[i], r);
+  }
+}
+
+/**
+ * @brief Binary operation over a tile with broadcast arguments
+ *
+ * The tile is split into the runs in which each argument is either contiguous or repeats
+ * one element, and each run goes to the tensor-tensor, constant-tensor or tensor-constant
+ * implementation.
+ */
+template <ArithmeticOp op, typename Result, typename Left, typename Right>
+void ExecuteBinOp(Result *result, BroadcastCursor<Left> l, BroadcastCursor<Right> r,
+                  int64_t extent) {
+  using meta = arithm_meta<op, CPUBackend>;
+  for (int64_t done = 0; done < extent;) {
+    int64_t n = std::min({extent - done, l.run_length(), r.run_length()});
+    if (l.repeats() && r.repeats()) {
+      std::fill(result + done, result + done + n, meta::impl(*l.data(), *r.data()));
+    } else if (l.repeats()) {
+      ExecuteBinOp<op, Result, Left, Right>(result + done, *l.data(), r.data(), n);
+    } else if (r.repeats()) {
+      ExecuteBinOp<op, Result, Left, Right>(result + done, l.data(), *r.data(), n);
+    } else {
+      ExecuteBinOp<op, Result, Left, Right>(result + done, l.data(), r.data(), n);
+    }
+    l.advance(n);
+    r.advance(n);
+    done += n;
+  }
+}
+
+}  // namespace detail
+
 template <ArithmeticOp op, typename Result, typename Input>
 class ExprImplCpuT : public ExprImplBase {
  public:
@@ -37,7 +106,21 @@ class ExprImplCpuT : public ExprImplBase {
     const auto &tile = tiles[range.begin];
     auto output = static_cast<Result *>(tile.output);
     auto input = static_cast<const Input *>(tile.args[0]);
-    Execute(output, input, tile.desc.extent_size);
+    auto extent = tile.desc.extent_size;
+    if (!tile.broadcast[0]) {
+      Execute(output, input, extent);
+      return;
+    }
+    BroadcastCursor<Input> in(input, tile.broadcast[0], detail::TileStart(tile.desc));
+    for (int64_t done = 0; done < extent;) {
+      int64_t n = std::min(extent - done, in.run_length());
+      if (in.repeats())
+        std::fill(output + done, output + done + n, meta::impl(*in.data()));
+      else
+        Execute(output + done, in.data(), n);
+      in.advance(n);
+      done += n;
+    }
   }
 
  private:
@@ -61,16 +144,14 @@ class ExprImplCpuTT : public ExprImplBase {
     auto output = static_cast<Result *>(tile.output);
     auto left = static_cast<const Left *>(tile.args[0]);
     auto right = static_cast<const Right *>(tile.args[1]);
-    Execute(output, left, right, tile.desc.extent_size);
-  }
-
- private:
-  using meta = arithm_meta<op, CPUBackend>;
-
-  static void Execute(Result *result, const Left *l, const Right *r, int64_t extent) {
-    for (int64_t i = 0; i < extent; i++) {
-      result[i] = meta::impl(l[i], r[i]);
+    if (!tile.broadcast[0] && !tile.broadcast[1]) {
+      detail::ExecuteBinOp<op, Result, Left, Right>(output, left, right, tile.desc.extent_size);
+      return;
     }
+    auto start = detail::TileStart(tile.desc);
+    detail::ExecuteBinOp<op, Result, Left, Right>(
+        output, BroadcastCursor<Left>(left, tile.broadcast[0], start),
+        BroadcastCursor<Right>(right, tile.broadcast[1], start), tile.desc.extent_size);
   }
 };
 
@@ -85,17 +166,25 @@ class ExprImplCpuCT : public ExprImplBase {
     auto output = static_cast<Result *>(tile.output);
     auto left = static_cast<const Left *>(tile.args[0]);
     auto right = static_cast<const Right *>(tile.args[1]);
-    Execute(output, *left, right, tile.desc.extent_size);
+    auto extent = tile.desc.extent_size;
+    if (!tile.broadcast[1]) {
+      detail::ExecuteBinOp<op, Result, Left, Right>(output, *left, right, extent);
+      return;
+    }
+    BroadcastCursor<Right> r(right, tile.broadcast[1], detail::TileStart(tile.desc));
+    for (int64_t done = 0; done < extent;) {
+      int64_t n = std::min(extent - done, r.run_length());
+      if (r.repeats())
+        std::fill(output + done, output + done + n, meta::impl(*left, *r.data()));
+      else
+        detail::ExecuteBinOp<op, Result, Left, Right>(output + done, *left, r.data(), n);
+      r.advance(n);
+      done += n;
+    }
   }
 
  private:
   using meta = arithm_meta<op, CPUBackend>;
-
-  static void Execute(Result *result, Left l, const Right *r, int64_t extent) {
-    for (int64_t i = 0; i < extent; i++) {
-      result[i] = meta::impl(l, r[i]);
-    }
-  }
 };
 
 template <ArithmeticOp op, typename Result, typename Left, typename Right>
@@ -109,17 +198,25 @@ class ExprImplCpuTC : public ExprImplBase {
     auto output = static_cast<Result *>(tile.output);
     auto left = static_cast<const Left *>(tile.args[0]);
     auto right = static_cast<const Right *>(tile.args[1]);
-    Execute(output, left, *right, tile.desc.extent_size);
+    auto extent = tile.desc.extent_size;
+    if (!tile.broadcast[0]) {
+      detail::ExecuteBinOp<op, Result, Left, Right>(output, left, *right, extent);
+      return;
+    }
+    BroadcastCursor<Left> l(left, tile.broadcast[0], detail::TileStart(tile.desc));
+    for (int64_t done = 0; done < extent;) {
+      int64_t n = std::min(extent - done, l.run_length());
+      if (l.repeats())
+        std::fill(output + done, output + done + n, meta::impl(*l.data(), *right));
+      else
+        detail::ExecuteBinOp<op, Result, Left, Right>(output + done, l.data(), *right, n);
+      l.advance(n);
+      done += n;
+    }
   }
 
  private:
   using meta = arithm_meta<op, CPUBackend>;
-
-  static void Execute(Result *result, const Left *l, Right r, int64_t extent) {
-    for (int64_t i = 0; i < extent; i++) {
-      result[i] = meta::impl(l[i], r);
-    }
-  }
 };
 
 }  // namespace dali
@@ -0,0 +1,503 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <type_traits>
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+#include "dali/core/cpu_features.h"
+
+namespace dali {
+
+namespace {
+
+ArithmSIMD DetectArithmSIMD() {
+  const auto &cpu = GetCPUFeatures();
+  if (cpu.avx512f && cpu.avx512bw)
+    return ArithmSIMD::AVX512;
+  if (cpu.avx2)
+    return ArithmSIMD::AVX2;
+  return ArithmSIMD::None;
+}
+
+ArithmSIMD SupportedArithmSIMD() {
+  static const ArithmSIMD supported = DetectArithmSIMD();
+  return supported;
+}
+
+std::atomic<ArithmSIMD> &CurrentArithmSIMD() {
+  static std::atomic<ArithmSIMD> current(SupportedArithmSIMD());
+  return current;
+}
+
+template <ArithmeticOp op>
+using arithm_op_tag = std::integral_constant<ArithmeticOp, op>;
+
+// Operands are either pointers to tensor data or constants
+
+template <typename T>
+inline T Elem(const T *data, int64_t i) {
+  return data[i];
+}
+
+template <typename T>
+inline T Elem(T value, int64_t) {
+  return value;
+}
+
+/**
+ * @brief Scalar loop over [begin, end) - the reference for the vectorized variants,
+ *        which use it for the remainder of the tile.
+ */
+template <ArithmeticOp op, typename Result, typename L, typename R>
+inline void ExecuteScalar(Result *result, L l, R r, int64_t begin, int64_t end) {
+  using meta = arithm_meta<op, CPUBackend>;
+  for (int64_t i = begin; i < end; i++) {
+    result[i] = meta::impl(Elem(l, i), Elem(r, i));
+  }
+}
+
+#if DALI_CPU_X86
+
+// Vector types for the result type Result. The inputs of other types are converted
+// to Result when loaded. `Load(ptr, i)` loads `lanes` elements starting at `ptr[i]`,
+// `Load(value, i)` broadcasts a constant.
+
+template <typename Result>
+struct VecAVX2;
+
+template <>
+struct VecAVX2<float> {
+  using type = __m256;
+  static constexpr int lanes = 8;
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(const T *data, int64_t i) {
+    return LoadN(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(T value, int64_t) {
+    return _mm256_set1_ps(static_cast<float>(value));
+  }
+
+  DALI_TARGET_AVX2 static inline void Store(float *out, type v) {
+    _mm256_storeu_ps(out, v);
+  }
+
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm256_add_ps(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm256_sub_ps(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::mul>, type a, type b) {
+    return _mm256_mul_ps(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::div>, type a, type b) {
+    return _mm256_div_ps(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::fdiv>, type a, type b) {
+    return _mm256_div_ps(a, b);
+  }
+
+ private:
+  DALI_TARGET_AVX2 static inline type LoadN(const float *in) {
+    return _mm256_loadu_ps(in);
+  }
+  DALI_TARGET_AVX2 static inline type LoadN(const int32_t *in) {
+    return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in)));
+  }
+  DALI_TARGET_AVX2 static inline type LoadN(const int16_t *in) {
+    return _mm256_cvtepi32_ps(
+        _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))));
+  }
+  DALI_TARGET_AVX2 static inline type LoadN(const uint8_t *in) {
+    return _mm256_cvtepi32_ps(
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in))));
+  }
+};
+
+template <>
+struct VecAVX2<int32_t> {
+  using type = __m256i;
+  static constexpr int lanes = 8;
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(const T *data, int64_t i) {
+    return LoadN(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(T value, int64_t) {
+    return _mm256_set1_epi32(static_cast<int32_t>(value));
+  }
+
+  DALI_TARGET_AVX2 static inline void Store(int32_t *out, type v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), v);
+  }
+
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm256_add_epi32(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm256_sub_epi32(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::mul>, type a, type b) {
+    return _mm256_mullo_epi32(a, b);
+  }
+
+ private:
+  DALI_TARGET_AVX2 static inline type LoadN(const int32_t *in) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+  }
+  DALI_TARGET_AVX2 static inline type LoadN(const int16_t *in) {
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+  }
+  DALI_TARGET_AVX2 static inline type LoadN(const uint8_t *in) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in)));
+  }
+};
+
+template <>
+struct VecAVX2<int16_t> {
+  using type = __m256i;
+  static constexpr int lanes = 16;
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(const T *data, int64_t i) {
+    return LoadN(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(T value, int64_t) {
+    return _mm256_set1_epi16(static_cast<int16_t>(value));
+  }
+
+  DALI_TARGET_AVX2 static inline void Store(int16_t *out, type v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), v);
+  }
+
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm256_add_epi16(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm256_sub_epi16(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::mul>, type a, type b) {
+    return _mm256_mullo_epi16(a, b);
+  }
+
+ private:
+  DALI_TARGET_AVX2 static inline type LoadN(const int16_t *in) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+  }
+  DALI_TARGET_AVX2 static inline type LoadN(const uint8_t *in) {
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+  }
+};
+
+template <>
+struct VecAVX2<uint8_t> {
+  using type = __m256i;
+  static constexpr int lanes = 32;
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(const T *data, int64_t i) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX2 static inline type Load(T value, int64_t) {
+    return _mm256_set1_epi8(static_cast<char>(value));
+  }
+
+  DALI_TARGET_AVX2 static inline void Store(uint8_t *out, type v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), v);
+  }
+
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm256_add_epi8(a, b);
+  }
+  DALI_TARGET_AVX2 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm256_sub_epi8(a, b);
+  }
+};
+
+template <typename Result>
+struct VecAVX512;
+
+template <>
+struct VecAVX512<float> {
+  using type = __m512;
+  static constexpr int lanes = 16;
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(const T *data, int64_t i) {
+    return LoadN(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(T value, int64_t) {
+    return _mm512_set1_ps(static_cast<float>(value));
+  }
+
+  DALI_TARGET_AVX512 static inline void Store(float *out, type v) {
+    _mm512_storeu_ps(out, v);
+  }
+
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm512_add_ps(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm512_sub_ps(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::mul>, type a, type b) {
+    return _mm512_mul_ps(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::div>, type a, type b) {
+    return _mm512_div_ps(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::fdiv>, type a,
+                                              type b) {
+    return _mm512_div_ps(a, b);
+  }
+
+ private:
+  DALI_TARGET_AVX512 static inline type LoadN(const float *in) {
+    return _mm512_loadu_ps(in);
+  }
+  DALI_TARGET_AVX512 static inline type LoadN(const int32_t *in) {
+    return _mm512_cvtepi32_ps(_mm512_loadu_si512(in));
+  }
+  DALI_TARGET_AVX512 static inline type LoadN(const int16_t *in) {
+    return _mm512_cvtepi32_ps(
+        _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in))));
+  }
+  DALI_TARGET_AVX512 static inline type LoadN(const uint8_t *in) {
+    return _mm512_cvtepi32_ps(
+        _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))));
+  }
+};
+
+template <>
+struct VecAVX512<int32_t> {
+  using type = __m512i;
+  static constexpr int lanes = 16;
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(const T *data, int64_t i) {
+    return LoadN(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(T value, int64_t) {
+    return _mm512_set1_epi32(static_cast<int32_t>(value));
+  }
+
+  DALI_TARGET_AVX512 static inline void Store(int32_t *out, type v) {
+    _mm512_storeu_si512(out, v);
+  }
+
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm512_add_epi32(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm512_sub_epi32(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::mul>, type a, type b) {
+    return _mm512_mullo_epi32(a, b);
+  }
+
+ private:
+  DALI_TARGET_AVX512 static inline type LoadN(const int32_t *in) {
+    return _mm512_loadu_si512(in);
+  }
+  DALI_TARGET_AVX512 static inline type LoadN(const int16_t *in) {
+    return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in)));
+  }
+  DALI_TARGET_AVX512 static inline type LoadN(const uint8_t *in) {
+    return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+  }
+};
+
+template <>
+struct VecAVX512<int16_t> {
+  using type = __m512i;
+  static constexpr int lanes = 32;
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(const T *data, int64_t i) {
+    return LoadN(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(T value, int64_t) {
+    return _mm512_set1_epi16(static_cast<int16_t>(value));
+  }
+
+  DALI_TARGET_AVX512 static inline void Store(int16_t *out, type v) {
+    _mm512_storeu_si512(out, v);
+  }
+
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm512_add_epi16(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm512_sub_epi16(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::mul>, type a, type b) {
+    return _mm512_mullo_epi16(a, b);
+  }
+
+ private:
+  DALI_TARGET_AVX512 static inline type LoadN(const int16_t *in) {
+    return _mm512_loadu_si512(in);
+  }
+  DALI_TARGET_AVX512 static inline type LoadN(const uint8_t *in) {
+    return _mm512_cvtepu8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in)));
+  }
+};
+
+template <>
+struct VecAVX512<uint8_t> {
+  using type = __m512i;
+  static constexpr int lanes = 64;
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(const T *data, int64_t i) {
+    return _mm512_loadu_si512(data + i);
+  }
+
+  template <typename T>
+  DALI_TARGET_AVX512 static inline type Load(T value, int64_t) {
+    return _mm512_set1_epi8(static_cast<char>(value));
+  }
+
+  DALI_TARGET_AVX512 static inline void Store(uint8_t *out, type v) {
+    _mm512_storeu_si512(out, v);
+  }
+
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::add>, type a, type b) {
+    return _mm512_add_epi8(a, b);
+  }
+  DALI_TARGET_AVX512 static inline type Apply(arithm_op_tag<ArithmeticOp::sub>, type a, type b) {
+    return _mm512_sub_epi8(a, b);
+  }
+};
+
+template <ArithmeticOp op, typename Result, typename L, typename R>
+DALI_TARGET_AVX2 void ExecuteAVX2(Result *result, L l, R r, int64_t extent) {
+  using V = VecAVX2<Result>;
+  int64_t i = 0;
+  for (; i + V::lanes <= extent; i += V::lanes) {
+    V::Store(result + i, V::Apply(arithm_op_tag<op>(), V::Load(l, i), V::Load(r, i)));
+  }
+  ExecuteScalar<op>(result, l, r, i, extent);
+}
+
+template <ArithmeticOp op, typename Result, typename L, typename R>
+DALI_TARGET_AVX512 void ExecuteAVX512(Result *result, L l, R r, int64_t extent) {
+  using V = VecAVX512<Result>;
+  int64_t i = 0;
+  for (; i + V::lanes <= extent; i += V::lanes) {
+    V::Store(result + i, V::Apply(arithm_op_tag<op>(), V::Load(l, i), V::Load(r, i)));
+  }
+  ExecuteScalar<op>(result, l, r, i, extent);
+}
+
+#endif  // DALI_CPU_X86
+
+template <ArithmeticOp op, typename Result, typename L, typename R>
+bool ExecuteArithmSIMDImpl(std::true_type, Result *result, L l, R r, int64_t extent) {
+#if DALI_CPU_X86
+  switch (CurrentArithmSIMD().load(std::memory_order_relaxed)) {
+    case ArithmSIMD::AVX512:
+      ExecuteAVX512<op>(result, l, r, extent);
+      return true;
+    case ArithmSIMD::AVX2:
+      ExecuteAVX2<op>(result, l, r, extent);
+      return true;
+    default:
+      break;
+  }
+#endif
+  return false;
+}
+
+template <ArithmeticOp op, typename Result, typename L, typename R>
+bool ExecuteArithmSIMDImpl(std::false_type, Result *, L, R, int64_t) {
+  return false;
+}
+
+template <ArithmeticOp op, typename Left, typename Right>
+using arithm_simd_support =
+    std::integral_constant<bool, has_arithm_simd<op, Left, Right>::value>;
+
+}  // namespace
+
+ArithmSIMD GetArithmSIMD() {
+  return CurrentArithmSIMD();
+}
+
+void SetArithmSIMD(ArithmSIMD simd) {
+  if (simd > SupportedArithmSIMD())
+    simd = SupportedArithmSIMD();
+  CurrentArithmSIMD() = simd;
+}
+
+template <ArithmeticOp op, typename Left, typename Right>
+bool ExecuteArithmSIMD(arithm_simd_result_t<op, Left, Right> *result,
+                       const Left *l, const Right *r, int64_t extent) {
+  return ExecuteArithmSIMDImpl<op>(arithm_simd_support<op, Left, Right>(), result, l, r, extent);
+}
+
+template <ArithmeticOp op, typename Left, typename Right>
+bool ExecuteArithmSIMD(arithm_simd_result_t<op, Left, Right> *result,
+                       Left l, const Right *r, int64_t extent) {
+  return ExecuteArithmSIMDImpl<op>(arithm_simd_support<op, Left, Right>(), result, l, r, extent);
+}
+
+template <ArithmeticOp op, typename Left, typename Right>
+bool ExecuteArithmSIMD(arithm_simd_result_t<op, Left, Right> *result,
+                       const Left *l, Right r, int64_t extent) {
+  return ExecuteArithmSIMDImpl<op>(arithm_simd_support<op, Left, Right>(), result, l, r, extent);
+}
+
+#define INSTANTIATE_ARITHM_SIMD(OP, Left, Right)                                                \
+  template bool ExecuteArithmSIMD<OP, Left, Right>(arithm_simd_result_t<OP, Left, Right> *,     \
+                                                   const Left *, const Right *, int64_t);       \
+  template bool ExecuteArithmSIMD<OP, Left, Right>(arithm_simd_result_t<OP, Left, Right> *,     \
+                                                   Left, const Right *, int64_t);               \
+  template bool ExecuteArithmSIMD<OP, Left, Right>(arithm_simd_result_t<OP, Left, Right> *,     \
+                                                   const Left *, Right, int64_t);
+
+#define INSTANTIATE_ARITHM_SIMD_RIGHT(OP, Left)   \
+  INSTANTIATE_ARITHM_SIMD(OP, Left, uint8_t)      \
+  INSTANTIATE_ARITHM_SIMD(OP, Left, int16_t)      \
+  INSTANTIATE_ARITHM_SIMD(OP, Left, int32_t)      \
+  INSTANTIATE_ARITHM_SIMD(OP, Left, float)
+
+#define INSTANTIATE_ARITHM_SIMD_OP(OP)            \
+  INSTANTIATE_ARITHM_SIMD_RIGHT(OP, uint8_t)      \
+  INSTANTIATE_ARITHM_SIMD_RIGHT(OP, int16_t)      \
+  INSTANTIATE_ARITHM_SIMD_RIGHT(OP, int32_t)      \
+  INSTANTIATE_ARITHM_SIMD_RIGHT(OP, float)
+
+INSTANTIATE_ARITHM_SIMD_OP(ArithmeticOp::add)
+INSTANTIATE_ARITHM_SIMD_OP(ArithmeticOp::sub)
+INSTANTIATE_ARITHM_SIMD_OP(ArithmeticOp::mul)
+INSTANTIATE_ARITHM_SIMD_OP(ArithmeticOp::div)
+INSTANTIATE_ARITHM_SIMD_OP(ArithmeticOp::fdiv)
+
+}  // namespace dali
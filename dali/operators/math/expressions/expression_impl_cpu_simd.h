@@ -0,0 +1,138 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_H_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "dali/core/api_helper.h"
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+
+namespace dali {
+
+/**
+ * @brief Instruction set used by the vectorized arithmetic expression kernels;
+ *        the best one is detected at run time
+ */
+enum class ArithmSIMD {
+  None = 0,
+  AVX2,
+  AVX512
+};
+
+DLL_PUBLIC ArithmSIMD GetArithmSIMD();
+
+/**
+ * @brief Limits the instruction set used by the arithmetic expression kernels;
+ *        for testing and benchmarks
+ *
+ * The level is clamped to what is supported by the CPU.
+ */
+DLL_PUBLIC void SetArithmSIMD(ArithmSIMD simd);
+
+template <typename T>
+struct is_arithm_simd_type
+    : std::integral_constant<bool, std::is_same<T, uint8_t>::value ||
+                                   std::is_same<T, int16_t>::value ||
+                                   std::is_same<T, int32_t>::value ||
+                                   std::is_same<T, float>::value> {};
+
+/**
+ * @brief Tells, whether there is a vectorized implementation of binary `op` for given
+ *        input types.
+ *
+ * The inputs are converted to the result type and the operation is computed in that type:
+ * - float: add, sub, mul, div, fdiv,
+ * - int32 and int16: add, sub, mul,
+ * - uint8: add, sub.
+ */
+template <ArithmeticOp op, typename Left, typename Right>
+struct has_arithm_simd {
+  using Result = typename arithm_meta<op, CPUBackend>::template result_t<Left, Right>;
+  static constexpr bool is_float_op =
+      op == ArithmeticOp::add || op == ArithmeticOp::sub || op == ArithmeticOp::mul ||
+      op == ArithmeticOp::div || op == ArithmeticOp::fdiv;
+  static constexpr bool is_int_op =
+      op == ArithmeticOp::add || op == ArithmeticOp::sub || op == ArithmeticOp::mul;
+  static constexpr bool is_uint8_op = op == ArithmeticOp::add || op == ArithmeticOp::sub;
+
+  static constexpr bool value =
+      is_arithm_simd_type<Left>::value && is_arithm_simd_type<Right>::value &&
+      ((std::is_same<Result, float>::value && is_float_op) ||
+       (std::is_same<Result, int32_t>::value && is_int_op) ||
+       (std::is_same<Result, int16_t>::value && is_int_op) ||
+       (std::is_same<Result, uint8_t>::value && is_uint8_op));
+};
+
+template <ArithmeticOp op, typename Left, typename Right>
+using arithm_simd_result_t = typename arithm_meta<op, CPUBackend>::template result_t<Left, Right>;
+
+/**
+ * @brief Vectorized binary arithmetic operation over a tile: tensor-tensor, constant-tensor
+ *        and tensor-constant variants.
+ *
+ * The results are identical to those of the scalar implementation.
+ * Instantiated for the types supported by `has_arithm_simd`.
+ *
+ * @return false, if no vectorized implementation can be used on this CPU
+ */
+template <ArithmeticOp op, typename Left, typename Right>
+DLL_PUBLIC bool ExecuteArithmSIMD(arithm_simd_result_t<op, Left, Right> *result,
+                                  const Left *l, const Right *r, int64_t extent);
+
+template <ArithmeticOp op, typename Left, typename Right>
+DLL_PUBLIC bool ExecuteArithmSIMD(arithm_simd_result_t<op, Left, Right> *result,
+                                  Left l, const Right *r, int64_t extent);
+
+template <ArithmeticOp op, typename Left, typename Right>
+DLL_PUBLIC bool ExecuteArithmSIMD(arithm_simd_result_t<op, Left, Right> *result,
+                                  const Left *l, Right r, int64_t extent);
+
+namespace detail {
+
+template <ArithmeticOp op, typename Left, typename Right, typename Result, typename L,
+          typename R>
+inline bool TryExecuteArithmSIMD(std::true_type, Result *result, L l, R r, int64_t extent) {
+  return ExecuteArithmSIMD<op, Left, Right>(result, l, r, extent);
+}
+
+template <ArithmeticOp op, typename Left, typename Right, typename Result, typename L,
+          typename R>
+inline bool TryExecuteArithmSIMD(std::false_type, Result *, L, R, int64_t) {
+  return false;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Runs the vectorized implementation, if there is one for given operation, types
+ *        and CPU.
+ *
+ * `l` and `r` are either pointers to tensor data or constant values.
+ *
+ * @return false, if the caller should use the scalar implementation
+ */
+template <ArithmeticOp op, typename Result, typename L, typename R>
+inline bool TryExecuteArithmSIMD(Result *result, L l, R r, int64_t extent) {
+  using Left = std::remove_cv_t<std::remove_pointer_t<L>>;
+  using Right = std::remove_cv_t<std::remove_pointer_t<R>>;
+  using supported = std::integral_constant<bool, has_arithm_simd<op, Left, Right>::value>;
+  return detail::TryExecuteArithmSIMD<op, Left, Right>(supported(), result, l, r, extent);
+}
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_SIMD_H_
@@ -0,0 +1,141 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_impl_cpu_simd.h"
+
+namespace dali {
+
+namespace {
+
+template <typename T>
+std::vector<T> RandomData(std::mt19937 &rng, int64_t n) {
+  // positive values, so that they can be divisors
+  std::uniform_int_distribution<int> dist(1, std::is_same<T, uint8_t>::value ? 255 : 30000);
+  std::vector<T> result(n);
+  for (auto &x : result)
+    x = static_cast<T>(dist(rng)) / (std::is_floating_point<T>::value ? 7 : 1);
+  return result;
+}
+
+class ArithmSIMDGuard {
+ public:
+  ArithmSIMDGuard() : simd_(GetArithmSIMD()) {}
+  ~ArithmSIMDGuard() { SetArithmSIMD(simd_); }
+
+ private:
+  ArithmSIMD simd_;
+};
+
+/**
+ * @brief Compares the vectorized implementations at all the supported levels with
+ *        the scalar reference, for all the variants of operands.
+ */
+template <ArithmeticOp op, typename Left, typename Right>
+void TestArithmSIMD() {
+  static_assert(has_arithm_simd<op, Left, Right>::value, "Expected a vectorized implementation");
+  using Result = arithm_simd_result_t<op, Left, Right>;
+  using meta = arithm_meta<op, CPUBackend>;
+  ArithmSIMDGuard guard;
+  std::mt19937 rng(42);
+  // not a multiple of any vector length, so the remainder is processed too
+  const int64_t n = 1000 + 37;
+  auto l = RandomData<Left>(rng, n);
+  auto r = RandomData<Right>(rng, n);
+  Left l_const = l[1];
+  Right r_const = r[2];
+  std::vector<Result> ref_tt(n), ref_ct(n), ref_tc(n);
+  for (int64_t i = 0; i < n; i++) {
+    ref_tt[i] = meta::impl(l[i], r[i]);
+    ref_ct[i] = meta::impl(l_const, r[i]);
+    ref_tc[i] = meta::impl(l[i], r_const);
+  }
+
+  for (auto simd : { ArithmSIMD::AVX2, ArithmSIMD::AVX512 }) {
+    SetArithmSIMD(simd);
+    if (GetArithmSIMD() != simd)
+      continue;  // not supported by this CPU
+    std::vector<Result> out(n);
+    ASSERT_TRUE((ExecuteArithmSIMD<op, Left, Right>(out.data(), l.data(), r.data(), n)));
+    for (int64_t i = 0; i < n; i++)
+      ASSERT_EQ(out[i], ref_tt[i]) << "tensor-tensor, SIMD level " << static_cast<int>(simd)
+                                   << ", element " << i;
+    ASSERT_TRUE((ExecuteArithmSIMD<op, Left, Right>(out.data(), l_const, r.data(), n)));
+    for (int64_t i = 0; i < n; i++)
+      ASSERT_EQ(out[i], ref_ct[i]) << "constant-tensor, SIMD level " << static_cast<int>(simd)
+                                   << ", element " << i;
+    ASSERT_TRUE((ExecuteArithmSIMD<op, Left, Right>(out.data(), l.data(), r_const, n)));
+    for (int64_t i = 0; i < n; i++)
+      ASSERT_EQ(out[i], ref_tc[i]) << "tensor-constant, SIMD level " << static_cast<int>(simd)
+                                   << ", element " << i;
+  }
+
+  SetArithmSIMD(ArithmSIMD::None);
+  std::vector<Result> out(n);
+  EXPECT_FALSE((ExecuteArithmSIMD<op, Left, Right>(out.data(), l.data(), r.data(), n)));
+}
+
+}  // namespace
+
+TEST(ArithmSIMDTest, Float) {
+  TestArithmSIMD<ArithmeticOp::add, float, float>();
+  TestArithmSIMD<ArithmeticOp::sub, float, float>();
+  TestArithmSIMD<ArithmeticOp::mul, float, float>();
+  TestArithmSIMD<ArithmeticOp::div, float, float>();
+  TestArithmSIMD<ArithmeticOp::fdiv, float, float>();
+}
+
+TEST(ArithmSIMDTest, Int32) {
+  TestArithmSIMD<ArithmeticOp::add, int32_t, int32_t>();
+  TestArithmSIMD<ArithmeticOp::sub, int32_t, int32_t>();
+  TestArithmSIMD<ArithmeticOp::mul, int32_t, int32_t>();
+}
+
+TEST(ArithmSIMDTest, Int16) {
+  TestArithmSIMD<ArithmeticOp::add, int16_t, int16_t>();
+  TestArithmSIMD<ArithmeticOp::sub, int16_t, int16_t>();
+  TestArithmSIMD<ArithmeticOp::mul, int16_t, int16_t>();
+}
+
+TEST(ArithmSIMDTest, Uint8) {
+  TestArithmSIMD<ArithmeticOp::add, uint8_t, uint8_t>();
+  TestArithmSIMD<ArithmeticOp::sub, uint8_t, uint8_t>();
+}
+
+TEST(ArithmSIMDTest, MixedTypes) {
+  TestArithmSIMD<ArithmeticOp::add, uint8_t, float>();
+  TestArithmSIMD<ArithmeticOp::mul, float, int16_t>();
+  TestArithmSIMD<ArithmeticOp::sub, int32_t, float>();
+  TestArithmSIMD<ArithmeticOp::add, uint8_t, int16_t>();
+  TestArithmSIMD<ArithmeticOp::mul, int16_t, int32_t>();
+  TestArithmSIMD<ArithmeticOp::sub, uint8_t, int32_t>();
+  TestArithmSIMD<ArithmeticOp::fdiv, uint8_t, uint8_t>();
+  TestArithmSIMD<ArithmeticOp::fdiv, int32_t, int16_t>();
+}
+
+TEST(ArithmSIMDTest, Unsupported) {
+  static_assert(!has_arithm_simd<ArithmeticOp::mul, uint8_t, uint8_t>::value, "");
+  static_assert(!has_arithm_simd<ArithmeticOp::div, int32_t, int32_t>::value, "");
+  static_assert(!has_arithm_simd<ArithmeticOp::add, double, float>::value, "");
+  static_assert(!has_arithm_simd<ArithmeticOp::mod, float, float>::value, "");
+  int32_t out[4], l[4] = {1, 2, 3, 4};
+  EXPECT_FALSE((TryExecuteArithmSIMD<ArithmeticOp::div>(out, l, l, 4)));
+}
+
+}  // namespace dali
@@ -71,16 +71,22 @@ inline OutputSamplePtr GetOutput(const ExprFunc &func, workspace_t<Backend> &ws,
 
 /**
  * @brief Type erased obtaining pointers to inputs
+ *
+ * The inputs broadcast to the `result_shape` get no pointer - the operator, which keeps
+ * their BroadcastDesc, fills it in.
  */
 template <typename Backend>
 inline ArgPack GetArgPack(const ExprFunc &func, workspace_t<Backend> &ws,
-                          const ConstantStorage<Backend> &st, const OpSpec &spec, TileDesc tile) {
+                          const ConstantStorage<Backend> &st, const OpSpec &spec,
+                          const TensorListShape<> &result_shape, TileDesc tile) {
   ArgPack result;
   result.resize(func.GetSubexpressionCount());
   for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-    DALI_ENFORCE(func[i].GetNodeType() != NodeType::Function,
-                 "Function nodes are not supported as subexpressions");
-    if (IsScalarLike(func[i])) {
+    if (func[i].GetNodeType() == NodeType::Function) {
+      // Intermediate results are kept in the tile buffers of the thread evaluating the
+      // expression, which fills in the pointer
+      result[i] = nullptr;
+    } else if (IsScalarLike(func[i])) {
       if (func[i].GetNodeType() == NodeType::Constant) {
         const auto &constant = dynamic_cast<const ExprConstant &>(func[i]);
         result[i] = st.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
@@ -92,6 +98,11 @@ inline ArgPack GetArgPack(const ExprFunc &func, workspace_t<Backend> &ws,
       }
     } else if (func[i].GetNodeType() == NodeType::Tensor) {
       const auto &tensor = dynamic_cast<const ExprTensor &>(func[i]);
+      if (tensor.GetShape().tensor_size(tile.sample_idx) !=
+          result_shape.tensor_size(tile.sample_idx)) {
+        result[i] = nullptr;
+        continue;
+      }
       auto input_idx = tensor.GetInputIndex();
       const auto *ptr =
           reinterpret_cast<const char *>(GetInputSamplePointer(ws, input_idx, tile.sample_idx));
@@ -108,17 +119,31 @@ inline ArgPack GetArgPack(const ExprFunc &func, workspace_t<Backend> &ws,
  * based on the ExprFunc by extracting the input and output pointers to data
  * from workspace and constant storage.
  *
+ * Only the root of the expression writes to the output, the output pointers of the intermediate
+ * nodes are left empty. A scalar-like intermediate node covers just one element in every tile.
+ *
  * @param extended_tiles Output vector of ExtendedTiles for given task
  */
 template <typename Backend>
 void TransformDescs(std::vector<ExtendedTileDesc> &extended_tiles,
                            const std::vector<TileDesc> &tiles, const ExprFunc &func,
-                           workspace_t<Backend> &ws, const ConstantStorage<Backend> &st,
-                           const OpSpec &spec) {
+                           bool is_root, workspace_t<Backend> &ws,
+                           const ConstantStorage<Backend> &st, const OpSpec &spec,
+                           const TensorListShape<> &result_shape) {
   extended_tiles.reserve(tiles.size());
   for (auto &tile : tiles) {
-    extended_tiles.emplace_back(tile, GetOutput<Backend>(func, ws, tile),
-                                GetArgPack(func, ws, st, spec, tile));
+    if (is_root) {
+      extended_tiles.emplace_back(tile, GetOutput<Backend>(func, ws, tile),
+                                  GetArgPack(func, ws, st, spec, result_shape, tile));
+    } else {
+      auto desc = tile;
+      if (IsScalarLike(func)) {
+        desc.extent_idx = 0;
+        desc.extent_size = 1;
+      }
+      extended_tiles.emplace_back(desc, nullptr,
+                                  GetArgPack(func, ws, st, spec, result_shape, desc));
+    }
   }
 }
 
@@ -127,18 +152,23 @@ void TransformDescs(std::vector<ExtendedTileDesc> &extended_tiles,
  * the pointers to data.
  *
  * @param tiles_per_task  Output vectors of ExtendedTiles per every task to execute
+ * @param result_shape    Shape of the result of the whole expression
  */
 template <typename Backend>
 void PrepareTilesForTasks(std::vector<std::vector<ExtendedTileDesc>> &tiles_per_task,
                           const std::vector<ExprImplTask> &task_exec_order,
                           const std::vector<TileDesc> &tiles, workspace_t<Backend> &ws,
-                          const ConstantStorage<Backend> &constant_storage, const OpSpec &spec) {
+                          const ConstantStorage<Backend> &constant_storage, const OpSpec &spec,
+                          const TensorListShape<> &result_shape) {
   tiles_per_task.resize(task_exec_order.size());
   for (size_t i = 0; i < task_exec_order.size(); i++) {
     const auto &expr_task = task_exec_order[i];
     const auto &expr_func = dynamic_cast<const ExprFunc &>(*expr_task.ctx.node);
     tiles_per_task[i].resize(0);
-    TransformDescs<Backend>(tiles_per_task[i], tiles, expr_func, ws, constant_storage, spec);
+    // the execution order is post-order, so the root goes last
+    bool is_root = i + 1 == task_exec_order.size();
+    TransformDescs<Backend>(tiles_per_task[i], tiles, expr_func, is_root, ws, constant_storage,
+                            spec, result_shape);
   }
 }
 
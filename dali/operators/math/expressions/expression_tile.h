@@ -58,6 +58,9 @@ using OutputSamplePtr = void *;
 using InputSamplePtr = const void *;
 using ArgPack = SmallVector<InputSamplePtr, kMaxArity>;
 
+struct BroadcastDesc;
+using BroadcastPack = SmallVector<const BroadcastDesc *, kMaxArity>;
+
 /**
  * @brief Describe tile with pointers to output and input data for that tile.
  *
@@ -66,14 +69,21 @@ using ArgPack = SmallVector<InputSamplePtr, kMaxArity>;
  * As we obtain pointers to Tensor/TensorList data, we cast them to `void *`
  * and the ExprImpl is later aware to what type should it be casted back.
  * This reduces the amount of types and compilation time significantly.
+ *
+ * An argument broadcast to the shape of the result (CPU only) has a BroadcastDesc; its pointer
+ * is then the beginning of the sample and the argument is read through the strides
+ * of the descriptor. The other arguments have no descriptor and are read as is.
  */
 struct ExtendedTileDesc {
   ExtendedTileDesc() = default;
   ExtendedTileDesc(const TileDesc &desc, const OutputSamplePtr &output, const ArgPack &args)
-      : desc(desc), output(output), args(args) {}
+      : desc(desc), output(output), args(args) {
+    broadcast.resize(args.size(), nullptr);
+  }
   TileDesc desc;
   OutputSamplePtr output;
   ArgPack args;
+  BroadcastPack broadcast;
 };
 
 }  // namespace dali
@@ -96,11 +96,22 @@ void FileLabelLoader::PrepareEmpty(ImageLabelWrapper &image_label) {
 }
 
 void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
+  PrepareReadSample(image_label)();
+}
+
+std::function<void()> FileLabelLoader::PrepareReadSample(ImageLabelWrapper &image_label) {
   auto image_pair = image_label_pairs_[current_index_++];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
 
+  return [this, &image_label, image_pair]() {
+    ReadImage(image_label, image_pair);
+  };
+}
+
+void FileLabelLoader::ReadImage(ImageLabelWrapper &image_label,
+                                const std::pair<string, int> &image_pair) {
   // copy the label
   image_label.label = image_pair.second;
   DALIMeta meta;
@@ -118,7 +129,7 @@ void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
   }
 
   auto current_image = FileStream::Open(file_root_ + "/" + image_pair.first,
-                                        read_ahead_, !copy_read_data_);
+                                        read_ahead_, !copy_read_data_, GetAsyncReader());
   Index image_size = current_image->Size();
 
   if (copy_read_data_) {
@@ -126,20 +137,18 @@ void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
       image_label.image.Reset();
     }
     image_label.image.Resize({image_size});
-    // copy the image
-    Index ret = current_image->Read(image_label.image.mutable_data<uint8_t>(), image_size);
-    DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", image_pair.first));
+    // copy the image; with asynchronous I/O the data is ready after ReadSamples completes
+    ReadFileData(std::move(current_image), image_label.image.mutable_data<uint8_t>(), image_size);
   } else {
     auto p = current_image->Get(image_size);
     DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", image_pair.first));
     // Wrap the raw data in the Tensor object.
     image_label.image.ShareData(p, image_size, {image_size});
     image_label.image.set_type(TypeInfo::Create<uint8_t>());
+    // close the file handle
+    current_image->Close();
   }
 
-  // close the file handle
-  current_image->Close();
-
   // copy the label
   image_label.label = image_pair.second;
   image_label.image.SetMeta(meta);
@@ -20,6 +20,7 @@
 #include <errno.h>
 
 #include <fstream>
+#include <functional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -86,9 +87,18 @@ class FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper> {
   void PrepareEmpty(ImageLabelWrapper &tensor) override;
   void ReadSample(ImageLabelWrapper &tensor) override;
 
+  bool CanReadInParallel() const override {
+    return true;
+  }
+
+  std::function<void()> PrepareReadSample(ImageLabelWrapper &tensor) override;
+
  protected:
   Index SizeImpl() override;
 
+  // Reads the sample without modifying the state of the loader
+  void ReadImage(ImageLabelWrapper &image_label, const std::pair<string, int> &image_pair);
+
   void PrepareMetadataImpl() override {
     if (image_label_pairs_.empty()) {
       if (file_list_ == "") {
@@ -121,11 +121,21 @@ void FileLoader::PrepareEmpty(ImageFileWrapper &image_file) {
 }
 
 void FileLoader::ReadSample(ImageFileWrapper& imfile) {
+  PrepareReadSample(imfile)();
+}
+
+std::function<void()> FileLoader::PrepareReadSample(ImageFileWrapper& imfile) {
   auto image_file = images_[current_index_++];
 
   // handle wrap-around
   MoveToNextShard(current_index_);
 
+  return [this, &imfile, image_file]() {
+    ReadImage(imfile, image_file);
+  };
+}
+
+void FileLoader::ReadImage(ImageFileWrapper& imfile, const std::string &image_file) {
   // metadata info
   DALIMeta meta;
   meta.SetSourceInfo(image_file);
@@ -143,7 +153,7 @@ void FileLoader::ReadSample(ImageFileWrapper& imfile) {
   }
 
   auto current_image = FileStream::Open(file_root_ + "/" + image_file, read_ahead_,
-                                        !copy_read_data_);
+                                        !copy_read_data_, GetAsyncReader());
   Index image_size = current_image->Size();
 
   if (copy_read_data_) {
@@ -151,20 +161,18 @@ void FileLoader::ReadSample(ImageFileWrapper& imfile) {
       imfile.image.Reset();
     }
     imfile.image.Resize({image_size});
-    // copy the image
-    Index ret = current_image->Read(imfile.image.mutable_data<uint8_t>(), image_size);
-    DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", image_file));
+    // copy the image; with asynchronous I/O the data is ready after ReadSamples completes
+    ReadFileData(std::move(current_image), imfile.image.mutable_data<uint8_t>(), image_size);
   } else {
     auto p = current_image->Get(image_size);
     DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", image_file));
     // Wrap the raw data in the Tensor object.
     imfile.image.ShareData(p, image_size, {image_size});
     imfile.image.set_type(TypeInfo::Create<uint8_t>());
+    // close the file handle
+    current_image->Close();
   }
 
-  // close the file handle
-  current_image->Close();
-
   // set metadata
   imfile.image.SetMeta(meta);
 
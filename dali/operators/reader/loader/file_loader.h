@@ -20,6 +20,7 @@
 #include <errno.h>
 
 #include <fstream>
+#include <functional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -86,9 +87,18 @@ class FileLoader : public Loader< CPUBackend, ImageFileWrapper > {
   void PrepareEmpty(ImageFileWrapper &tensor) override;
   void ReadSample(ImageFileWrapper& tensor) override;
 
+  bool CanReadInParallel() const override {
+    return true;
+  }
+
+  std::function<void()> PrepareReadSample(ImageFileWrapper& tensor) override;
+
  protected:
   Index SizeImpl() override;
 
+  // Reads the sample without modifying the state of the loader
+  virtual void ReadImage(ImageFileWrapper& imfile, const std::string &image_file);
+
   void PrepareMetadataImpl() override {
     if (images_.empty()) {
       images_ = filesystem::traverse_directories(file_root_, file_filter_);
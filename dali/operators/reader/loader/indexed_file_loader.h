@@ -19,10 +19,13 @@
 #include <string>
 #include <tuple>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <utility>
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/record_index.h"
 #include "dali/util/file.h"
 
 namespace dali {
@@ -41,7 +44,7 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
 
     int64 seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    std::tie(seek_pos, size, file_index) = GetIndexEntry(current_index_);
     ++current_index_;
 
     std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
@@ -50,8 +53,9 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     meta.SetSkipSample(false);
 
     if (file_index != current_file_index_) {
-      current_file_->Close();
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+      CloseFile(std::move(current_file_));
+      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
+                                       GetAsyncReader());
       current_file_index_ = file_index;
     }
 
@@ -85,32 +89,95 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
       tensor.set_type(TypeInfo::Create<uint8_t>());
       tensor.Resize({size});
 
-      int64 n_read = current_file_->Read(reinterpret_cast<uint8_t*>(tensor.raw_mutable_data()),
-                          size);
-      DALI_ENFORCE(n_read == size, "Error reading from a file " + uris_[current_file_index_]);
+      // with asynchronous I/O the data is ready after ReadSamples completes
+      current_file_->ReadAsync(reinterpret_cast<uint8_t*>(tensor.raw_mutable_data()), size);
     }
 
     tensor.SetMeta(meta);
     return;
   }
 
+  bool CanReadInParallel() const override {
+    return true;
+  }
+
+  std::function<void()> PrepareReadSample(Tensor<CPUBackend>& tensor) override {
+    MoveToNextShard(current_index_);
+    auto index = GetIndexEntry(current_index_);
+    ++current_index_;
+    // the position of current_file_ is no longer known
+    should_seek_ = true;
+
+    return [this, &tensor, index]() {
+      int64 seek_pos, size;
+      size_t file_index;
+      std::tie(seek_pos, size, file_index) = index;
+
+      std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
+      DALIMeta meta;
+      meta.SetSourceInfo(image_key);
+      meta.SetSkipSample(false);
+
+      if (ShouldSkipImage(image_key)) {
+        meta.SetSkipSample(true);
+        tensor.Reset();
+        tensor.SetMeta(meta);
+        tensor.set_type(TypeInfo::Create<uint8_t>());
+        tensor.Resize({0});
+        return;
+      }
+
+      // the samples may be read concurrently, so each of them gets its own stream
+      auto file = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+      file->Seek(seek_pos);
+      if (!copy_read_data_) {
+        auto p = file->Get(size);
+        DALI_ENFORCE(p != nullptr, "Error reading from a file " + uris_[file_index]);
+        tensor.ShareData(p, size, {size});
+        tensor.set_type(TypeInfo::Create<uint8_t>());
+      } else {
+        if (tensor.shares_data()) {
+          tensor.Reset();
+        }
+        tensor.set_type(TypeInfo::Create<uint8_t>());
+        tensor.Resize({size});
+        int64 n_read = file->Read(reinterpret_cast<uint8_t*>(tensor.raw_mutable_data()), size);
+        DALI_ENFORCE(n_read == size, "Error reading from a file " + uris_[file_index]);
+      }
+      file->Close();
+      tensor.SetMeta(meta);
+    };
+  }
+
   ~IndexedFileLoader() override {
     if (current_file_ != nullptr) {
       current_file_->Close();
     }
   }
 
+  /**
+   * @brief Reads the index files - either one per data file or a single binary index file
+   *        describing all the data files
+   */
   virtual void ReadIndexFile(const std::vector<std::string>& index_uris) {
-    DALI_ENFORCE(index_uris.size() == uris_.size(),
+    bool combined_index = index_uris.size() == 1 && uris_.size() > 1 &&
+                          RecordIndex::IsBinaryIndexFile(index_uris[0]);
+    DALI_ENFORCE(combined_index || index_uris.size() == uris_.size(),
         "Number of index files needs to match the number of data files");
     for (size_t i = 0; i < index_uris.size(); ++i) {
+      if (RecordIndex::IsBinaryIndexFile(index_uris[i])) {
+        indices_.AddBinaryIndexFile(index_uris[i], i);
+        continue;
+      }
       std::ifstream fin(index_uris[i]);
       DALI_ENFORCE(fin.good(), "Failed to open file " + index_uris[i]);
+      std::vector<BinaryIndexRecord> records;
       int64 pos, size;
       while (fin >> pos >> size) {
-        indices_.push_back(std::make_tuple(pos, size, i));
+        records.push_back({pos, size, 0});
       }
       fin.close();
+      indices_.AddRecords(std::move(records), i);
     }
   }
 
@@ -119,6 +186,13 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     return indices_.size();
   }
 
+  RecordIndex::Entry GetIndexEntry(size_t index) const {
+    auto entry = indices_[index];
+    DALI_ENFORCE(std::get<2>(entry) < uris_.size(), make_string("Index refers to data file ",
+                 std::get<2>(entry), ", but only ", uris_.size(), " files were given"));
+    return entry;
+  }
+
   void PrepareMetadataImpl() override {
     if (!dont_use_mmap_) {
       mmap_reserver = FileStream::FileStreamMappinReserver(
@@ -141,12 +215,13 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     } else {
       current_index_ = 0;
     }
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    std::tie(seek_pos, size, file_index) = GetIndexEntry(current_index_);
     if (file_index != current_file_index_) {
       if (current_file_index_ != static_cast<size_t>(INVALID_INDEX)) {
-        current_file_->Close();
+        CloseFile(std::move(current_file_));
       }
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
+                                       GetAsyncReader());
       current_file_index_ = file_index;
     }
     current_file_->Seek(seek_pos);
@@ -154,7 +229,7 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
 
   std::vector<std::string> uris_;
   std::vector<std::string> index_uris_;
-  std::vector<std::tuple<int64, int64, size_t>> indices_;
+  RecordIndex indices_;
   size_t current_index_;
   size_t current_file_index_;
   std::unique_ptr<FileStream> current_file_;
@@ -55,7 +55,26 @@ not equally divisible by the batch size. In the end, the shard size will be equa
 .AddOptionalArg("dont_use_mmap",
       R"code(If set to true, the Loader will not attempt to map the file in memory and will use plain
 file I/O instead. Mapping provides a small performance benefit when accessing a local file system,
-but most of the network ones, due to their nature, don't provide optimum performance)code", false);
+but most of the network ones, due to their nature, don't provide optimum performance)code", false)
+  .AddOptionalArg("io_backend",
+      R"code(Method of reading the files. Possible values are:
+
+* ``"sync"`` - blocking reads, one sample at a time,
+* ``"io_uring"`` - asynchronous reads with Linux io_uring,
+* ``"threads"`` - asynchronous reads issued by a pool of `io_queue_depth` threads,
+* ``"auto"`` - ``"io_uring"``, if supported by the system, ``"threads"`` otherwise.
+
+With asynchronous reads, all samples of a batch are requested at once and up to `io_queue_depth`
+reads are kept in flight, which helps on network file systems and fast SSDs.
+Asynchronous reading implies `dont_use_mmap`. It is supported by the file and TFRecord readers;
+the other readers read synchronously.)code", "sync")
+  .AddOptionalArg("io_queue_depth",
+      R"code(Maximum number of reads in flight when `io_backend` is asynchronous.)code", 16)
+  .AddOptionalArg("num_read_threads",
+      R"code(Number of threads used by the Loader to read the samples of a batch.
+The order of the samples is decided by a single thread, so the output is the same as with one thread
+and the same `seed`. Only the file, COCO, Numpy and TFRecord readers read in parallel.
+Values greater than 1 cannot be combined with an asynchronous `io_backend`.)code", 1);
 
 size_t start_index(const size_t shard_id,
                    const size_t shard_num,
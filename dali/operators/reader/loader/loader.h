@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_READER_LOADER_LOADER_H_
 #define DALI_OPERATORS_READER_LOADER_LOADER_H_
 
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -28,9 +29,12 @@
 
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/span.h"
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/data/tensor.h"
+#include "dali/pipeline/util/thread_pool.h"
 #include "dali/operators/decoder/cache/image_cache_factory.h"
+#include "dali/util/async_file.h"
 
 namespace dali {
 
@@ -71,8 +75,18 @@ class Loader {
       read_sample_counter_(0),
       returned_sample_counter_(0),
       pad_last_batch_(options.GetArgument<bool>("pad_last_batch")),
-      dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")) {
+      dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")),
+      io_backend_(ParseAsyncIOBackend(options.GetArgument<std::string>("io_backend"))),
+      io_queue_depth_(options.GetArgument<int>("io_queue_depth")),
+      num_read_threads_(options.GetArgument<int>("num_read_threads")) {
     DALI_ENFORCE(initial_empty_size_ > 0, "Batch size needs to be greater than 0");
+    DALI_ENFORCE(io_queue_depth_ > 0, "io_queue_depth needs to be greater than 0");
+    DALI_ENFORCE(num_read_threads_ > 0, "num_read_threads needs to be greater than 0");
+    DALI_ENFORCE(num_read_threads_ == 1 || io_backend_ == AsyncIOBackend::Sync,
+                 "num_read_threads greater than 1 cannot be used with asynchronous io_backend");
+    // asynchronous reads go to memory - mapping the files would bypass them
+    if (io_backend_ != AsyncIOBackend::Sync)
+      dont_use_mmap_ = true;
     DALI_ENFORCE(num_shards_ > shard_id_, "num_shards needs to be greater than shard_id");
     // initialize a random distribution -- this will be
     // used to pick from our sample buffer
@@ -82,6 +96,9 @@ class Loader {
   }
 
   virtual ~Loader() {
+    // make sure that no read is in flight when the buffers are freed
+    async_reader_.reset();
+    read_thread_pool_.reset();
     sample_buffer_.clear();
     empty_tensors_.clear();
   }
@@ -117,6 +134,121 @@ class Loader {
 
   // Get a random read sample
   LoadTargetSharedPtr ReadOne(bool is_new_batch) {
+    auto sample = SelectOne(is_new_batch);
+    ReadPending();
+    return sample;
+  }
+
+  /**
+   * @brief Gets `batch_size` samples, as if by `batch_size` calls to ReadOne
+   *
+   * The samples are selected first and their data is read afterwards, with a single call to
+   * ReadSamples, so that the loader can have multiple reads in flight.
+   * The order of the samples and their content are the same as with ReadOne.
+   */
+  void ReadBatch(std::vector<LoadTargetSharedPtr> &batch, int batch_size) {
+    for (int i = 0; i < batch_size; ++i)
+      batch.push_back(SelectOne(i == 0));
+    ReadPending();
+  }
+
+  // return a tensor to the empty pile
+  // called by multiple consumer threads
+  void RecycleTensor(LoadTargetUniquePtr&& tensor_ptr) {
+    std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
+    empty_tensors_.push_back(std::move(tensor_ptr));
+  }
+
+  // Read an actual sample from the FileStore,
+  // used to populate the sample buffer for "shuffled"
+  // reads.
+  virtual void ReadSample(LoadTarget& tensor) = 0;
+
+  /**
+   * @brief Tells whether the loader implements PrepareReadSample
+   */
+  virtual bool CanReadInParallel() const {
+    return false;
+  }
+
+  /**
+   * @brief Advances the loader to the next sample, as ReadSample does, but instead of reading
+   *        the sample, returns a function which reads it into `tensor`
+   *
+   * The returned functions for different samples may be called concurrently, so they must not
+   * modify the state of the loader.
+   */
+  virtual std::function<void()> PrepareReadSample(LoadTarget& tensor) {
+    DALI_FAIL("This loader cannot read samples in parallel");
+  }
+
+  /**
+   * @brief Reads the samples, in order
+   *
+   * The default implementation calls ReadSample for each sample and then waits for the
+   * asynchronous reads submitted with ReadFileData (if any).
+   * If `num_read_threads` is greater than 1 and the loader supports it, the samples are selected
+   * serially with PrepareReadSample and then read by a thread pool.
+   */
+  virtual void ReadSamples(span<LoadTarget *> samples) {
+    if (num_read_threads_ > 1 && samples.size() > 1 && CanReadInParallel()) {
+      ReadSamplesParallel(samples);
+      return;
+    }
+    try {
+      for (auto *sample : samples)
+        ReadSample(*sample);
+    } catch (...) {
+      DiscardAsyncReads();
+      throw;
+    }
+    WaitForAsyncReads();
+  }
+
+  void PrepareMetadata() {
+    std::lock_guard<std::mutex> l(prepare_metadata_mutex_);
+    if (!loading_flag_) {
+      loading_flag_ = true;
+      PrepareMetadataImpl();
+    }
+  }
+
+  // Give the size of the data accessed through the Loader
+  Index Size(bool consider_padding = false) {
+    if (!loading_flag_) {
+      PrepareMetadata();
+    }
+    if (pad_last_batch_ && consider_padding) {
+      return num_samples(num_shards_, SizeImpl()) * num_shards_;
+    } else {
+      return SizeImpl();
+    }
+  }
+
+  int GetNumShards() {
+    return num_shards_;
+  }
+
+  int GetShardId() {
+    return shard_id_;
+  }
+
+  int PadLastBatch() {
+    return pad_last_batch_;
+  }
+
+  int StickToShard() {
+    return stick_to_shard_;
+  }
+
+ protected:
+  /**
+   * @brief Selects the next sample; the reading of new samples into the buffer is deferred
+   *        until ReadPending is called
+   *
+   * The returned sample may be one of the pending ones.
+   */
+  LoadTargetSharedPtr SelectOne(bool is_new_batch) {
     if (!loading_flag_) {
       PrepareMetadata();
     }
@@ -131,7 +263,7 @@ class Loader {
       for (int i = 0; i < initial_buffer_fill_; ++i) {
         auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
         PrepareEmpty(*tensor_ptr);
-        ReadSample(*tensor_ptr);
+        pending_reads_.push_back(tensor_ptr.get());
         IncreaseReadSampleCounter();
         sample_buffer_.push_back(std::move(tensor_ptr));
         ++shards_.back().end;
@@ -190,7 +322,7 @@ class Loader {
       tensor_ptr = std::move(empty_tensors_.back());
       empty_tensors_.pop_back();
     }
-    ReadSample(*tensor_ptr);
+    pending_reads_.push_back(tensor_ptr.get());
     IncreaseReadSampleCounter();
     std::swap(sample_buffer_[shards_.back().end % sample_buffer_.size()], tensor_ptr);
     ++shards_.back().end;
@@ -201,55 +333,100 @@ class Loader {
     return sample_ptr;
   }
 
-  // return a tensor to the empty pile
-  // called by multiple consumer threads
-  void RecycleTensor(LoadTargetUniquePtr&& tensor_ptr) {
-    std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-    empty_tensors_.push_back(std::move(tensor_ptr));
+  /**
+   * @brief Reads the samples selected since the last call
+   */
+  void ReadPending() {
+    if (pending_reads_.empty())
+      return;
+    TimeRange tr("[Loader] ReadSamples", TimeRange::kGreen1);
+    try {
+      ReadSamples(make_span(pending_reads_));
+    } catch (...) {
+      pending_reads_.clear();
+      throw;
+    }
+    pending_reads_.clear();
   }
 
-  // Read an actual sample from the FileStore,
-  // used to populate the sample buffer for "shuffled"
-  // reads.
-  virtual void ReadSample(LoadTarget& tensor) = 0;
+  void ReadSamplesParallel(span<LoadTarget *> samples) {
+    // The state of the loader (current index, shard, epoch) is only advanced here, in order,
+    // so the result doesn't depend on the order in which the reads complete
+    read_tasks_.clear();
+    for (auto *sample : samples)
+      read_tasks_.push_back(PrepareReadSample(*sample));
 
-  void PrepareMetadata() {
-    std::lock_guard<std::mutex> l(prepare_metadata_mutex_);
-    if (!loading_flag_) {
-      loading_flag_ = true;
-      PrepareMetadataImpl();
+    if (!read_thread_pool_) {
+      // the threads only do file I/O - no need to bind them to a device
+      read_thread_pool_.reset(new ThreadPool(num_read_threads_, -1, false));
     }
-  }
-
-  // Give the size of the data accessed through the Loader
-  Index Size(bool consider_padding = false) {
-    if (!loading_flag_) {
-      PrepareMetadata();
+    for (int64_t i = 0; i < static_cast<int64_t>(read_tasks_.size()); ++i) {
+      // earlier samples go first
+      read_thread_pool_->AddWork([this, i](int) { read_tasks_[i](); }, -i);
     }
-    if (pad_last_batch_ && consider_padding) {
-      return num_samples(num_shards_, SizeImpl()) * num_shards_;
-    } else {
-      return SizeImpl();
+    try {
+      read_thread_pool_->RunAll();
+    } catch (...) {
+      read_tasks_.clear();
+      throw;
     }
+    read_tasks_.clear();
   }
 
-  int GetNumShards() {
-    return num_shards_;
+  /**
+   * @brief Returns the reader used for asynchronous file I/O or nullptr, if I/O is synchronous
+   */
+  AsyncFileReader *GetAsyncReader() {
+    if (!async_reader_ && io_backend_ != AsyncIOBackend::Sync)
+      async_reader_ = AsyncFileReader::Create(io_backend_, io_queue_depth_);
+    return async_reader_.get();
   }
 
-  int GetShardId() {
-    return shard_id_;
+  /**
+   * @brief Reads `n_bytes` from the current position in `file` into `buffer`
+   *
+   * With asynchronous I/O, the read is only submitted and the data is ready after ReadSamples
+   * completes. The stream is kept open until then.
+   * Otherwise, the data is read immediately and the stream is closed.
+   */
+  void ReadFileData(std::unique_ptr<FileStream> file, uint8_t *buffer, Index n_bytes) {
+    file->ReadAsync(buffer, n_bytes);
+    if (async_reader_)
+      async_files_.push_back(std::move(file));
+    else
+      file->Close();
   }
 
-  int PadLastBatch() {
-    return pad_last_batch_;
+  /**
+   * @brief Closes a file, which may still have asynchronous reads in flight
+   */
+  void CloseFile(std::unique_ptr<FileStream> file) {
+    if (async_reader_)
+      async_files_.push_back(std::move(file));
+    else
+      file->Close();
   }
 
-  int StickToShard() {
-    return stick_to_shard_;
+  void WaitForAsyncReads() {
+    if (!async_reader_)
+      return;
+    try {
+      async_reader_->Wait();
+    } catch (...) {
+      async_files_.clear();
+      throw;
+    }
+    async_files_.clear();
+  }
+
+  void DiscardAsyncReads() {
+    try {
+      WaitForAsyncReads();
+    } catch (...) {
+      // the reads were discarded anyway
+    }
   }
 
- protected:
   virtual Index SizeImpl() = 0;
 
   virtual void PrepareMetadataImpl() {}
@@ -304,6 +481,9 @@ class Loader {
       auto &image_cache_factory = ImageCacheFactory::Instance();
       if (image_cache_factory.IsInitialized(device_id_))
         cache_ = image_cache_factory.Get(device_id_);
+      DALI_ENFORCE(!cache_ || !cache_->EvictsImages(),
+                   "`skip_cached_images` can't be used with a decoder cache policy that evicts "
+                   "images");
     });
     return cache_ && cache_->IsCached(key);
   }
@@ -370,6 +550,20 @@ class Loader {
   int virtual_shard_id_;
   // Keeps pointer to the last returned sample just in case it needs to be cloned
   LoadTargetSharedPtr last_sample_ptr_tmp;
+  // Samples selected, but not read yet (see SelectOne and ReadPending)
+  std::vector<LoadTarget *> pending_reads_;
+
+  // Asynchronous I/O configuration
+  AsyncIOBackend io_backend_;
+  int io_queue_depth_;
+  // Files with asynchronous reads in flight; kept open until the reads complete
+  std::vector<std::unique_ptr<FileStream>> async_files_;
+  std::unique_ptr<AsyncFileReader> async_reader_;
+
+  // Parallel reading of the samples of a batch (see ReadSamplesParallel)
+  int num_read_threads_;
+  std::vector<std::function<void()>> read_tasks_;
+  std::unique_ptr<ThreadPool> read_thread_pool_;
 
   struct ShardBoundaries {
     Index start;
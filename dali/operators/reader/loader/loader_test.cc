@@ -13,7 +13,13 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/backend.h"
@@ -26,6 +32,7 @@
 #include "dali/operators/reader/loader/indexed_file_loader.h"
 #include "dali/operators/reader/loader/coco_loader.h"
 #include "dali/operators/reader/loader/lmdb.h"
+#include "dali/operators/reader/loader/record_index.h"
 
 namespace dali {
 
@@ -159,6 +166,188 @@ TYPED_TEST(DataLoadStoreTest, LoaderTest) {
   }
 }
 
+namespace {
+
+template <typename Sample>
+const Tensor<CPUBackend> &SampleData(const Sample &sample) {
+  return sample.image;
+}
+
+const Tensor<CPUBackend> &SampleData(const Tensor<CPUBackend> &sample) {
+  return sample;
+}
+
+/**
+ * @brief Checks that batches read with ReadBatch by a loader created from `spec` are the same
+ *        as those read one by one, with ReadOne, by a loader created from `ref_spec`
+ */
+template <typename LoaderType, typename... LoaderArgs>
+void CompareWithReadOne(const OpSpec &ref_spec, const OpSpec &spec, const std::string &config,
+                        bool expect_copy, const LoaderArgs &...loader_args) {
+  constexpr int kBatchSize = 7, kNumBatches = 5;
+  auto ref = InitLoader<LoaderType>(ref_spec, loader_args...);
+  auto loader = InitLoader<LoaderType>(spec, loader_args...);
+  for (int b = 0; b < kNumBatches; b++) {
+    std::vector<typename LoaderType::LoadTargetSharedPtr> batch;
+    loader->ReadBatch(batch, kBatchSize);
+    ASSERT_EQ(batch.size(), static_cast<size_t>(kBatchSize));
+    for (int i = 0; i < kBatchSize; i++) {
+      auto ref_sample = ref->ReadOne(i == 0);
+      auto &ref_data = SampleData(*ref_sample);
+      auto &data = SampleData(*batch[i]);
+      if (expect_copy)
+        EXPECT_FALSE(data.shares_data());
+      ASSERT_EQ(data.shape(), ref_data.shape());
+      EXPECT_EQ(data.GetSourceInfo(), ref_data.GetSourceInfo());
+      EXPECT_EQ(std::memcmp(data.raw_data(), ref_data.raw_data(), data.nbytes()), 0)
+        << "Sample " << i << " of batch " << b << " differs (" << config << ")";
+    }
+  }
+}
+
+/**
+ * @brief Checks that batches read with asynchronous I/O are the same as those read one by one
+ */
+template <typename LoaderType>
+void TestAsyncIO(const OpSpec &spec) {
+  for (const char *backend : { "threads", "auto" }) {
+    CompareWithReadOne<LoaderType>(spec,
+                                   OpSpec(spec)
+                                   .AddArg("io_backend", std::string(backend))
+                                   .AddArg("io_queue_depth", 4),
+                                   make_string("io_backend = ", backend), true);
+  }
+}
+
+/**
+ * @brief Checks that batches read by multiple threads are the same as those read one by one
+ */
+template <typename LoaderType, typename... LoaderArgs>
+void TestParallelRead(const OpSpec &spec, const LoaderArgs &...loader_args) {
+  for (int num_threads : { 2, 5 }) {
+    CompareWithReadOne<LoaderType>(spec,
+                                   OpSpec(spec).AddArg("num_read_threads", num_threads),
+                                   make_string("num_read_threads = ", num_threads), false,
+                                   loader_args...);
+  }
+}
+
+}  // namespace
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderAsyncIO) {
+  for (bool shuffle : { false, true }) {
+    TestAsyncIO<FileLabelLoader>(
+        OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("batch_size", 7)
+        .AddArg("device_id", 0)
+        .AddArg("random_shuffle", shuffle)
+        .AddArg("initial_fill", 10));
+  }
+}
+
+TYPED_TEST(DataLoadStoreTest, TFRecordLoaderAsyncIO) {
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+  TestAsyncIO<IndexedFileLoader>(
+      OpSpec("TFRecordReader")
+      .AddArg("path", path)
+      .AddArg("index_path", index_path)
+      .AddArg("batch_size", 7)
+      .AddArg("device_id", 0)
+      .AddArg("dont_use_mmap", true));
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderParallelRead) {
+  for (bool shuffle : { false, true }) {
+    for (bool dont_use_mmap : { false, true }) {
+      TestParallelRead<FileLabelLoader>(
+          OpSpec("FileReader")
+          .AddArg("file_root", loader_test_image_folder)
+          .AddArg("batch_size", 7)
+          .AddArg("device_id", 0)
+          .AddArg("random_shuffle", shuffle)
+          .AddArg("initial_fill", 10)
+          .AddArg("dont_use_mmap", dont_use_mmap));
+    }
+  }
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderParallelReadShuffleAfterEpoch) {
+  // a small data set, so that the files are reshuffled a few times
+  auto image_label_pairs = filesystem::traverse_directories(loader_test_image_folder);
+  ASSERT_GE(image_label_pairs.size(), 10u);
+  image_label_pairs.resize(10);
+  TestParallelRead<FileLabelLoader>(
+      OpSpec("FileReader")
+      .AddArg("file_root", loader_test_image_folder)
+      .AddArg("batch_size", 7)
+      .AddArg("device_id", 0),
+      image_label_pairs, true);
+}
+
+TYPED_TEST(DataLoadStoreTest, TFRecordLoaderParallelRead) {
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+  for (bool dont_use_mmap : { false, true }) {
+    TestParallelRead<IndexedFileLoader>(
+        OpSpec("TFRecordReader")
+        .AddArg("path", path)
+        .AddArg("index_path", index_path)
+        .AddArg("batch_size", 7)
+        .AddArg("device_id", 0)
+        .AddArg("dont_use_mmap", dont_use_mmap));
+  }
+}
+
+TYPED_TEST(DataLoadStoreTest, ParallelReadWithAsyncIO) {
+  EXPECT_THROW(FileLabelLoader(OpSpec("FileReader")
+                               .AddArg("file_root", loader_test_image_folder)
+                               .AddArg("batch_size", 7)
+                               .AddArg("device_id", 0)
+                               .AddArg("io_backend", std::string("threads"))
+                               .AddArg("num_read_threads", 4)),
+               DALIException);
+}
+
+TYPED_TEST(DataLoadStoreTest, TFRecordLoaderBinaryIndex) {
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+
+  // convert the text index
+  std::ifstream text_index(index_path[0]);
+  ASSERT_TRUE(text_index.good());
+  std::vector<BinaryIndexRecord> records;
+  int64 pos, size;
+  while (text_index >> pos >> size)
+    records.push_back({pos, size, 0});
+  ASSERT_FALSE(records.empty());
+  char binary_index_path[] = "/tmp/dali_tfrecord_index_XXXXXX";
+  int fd = mkstemp(binary_index_path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  WriteBinaryIndexFile(binary_index_path, make_cspan(records));
+
+  OpSpec spec = OpSpec("TFRecordReader")
+                .AddArg("path", path)
+                .AddArg("batch_size", 7)
+                .AddArg("device_id", 0)
+                .AddArg("dont_use_mmap", true);
+  auto ref = InitLoader<IndexedFileLoader>(OpSpec(spec).AddArg("index_path", index_path));
+  auto loader = InitLoader<IndexedFileLoader>(
+      OpSpec(spec).AddArg("index_path", std::vector<std::string>{binary_index_path}));
+  std::remove(binary_index_path);
+  ASSERT_EQ(loader->Size(), ref->Size());
+  for (Index i = 0; i < ref->Size() + 3; i++) {
+    auto ref_sample = ref->ReadOne(i == 0);
+    auto sample = loader->ReadOne(i == 0);
+    ASSERT_EQ(sample->shape(), ref_sample->shape());
+    EXPECT_EQ(sample->GetSourceInfo(), ref_sample->GetSourceInfo());
+    EXPECT_EQ(std::memcmp(sample->raw_data(), ref_sample->raw_data(), sample->nbytes()), 0)
+      << "Sample " << i << " differs";
+  }
+}
+
 TYPED_TEST(DataLoadStoreTest, LoaderTestFail) {
   shared_ptr<dali::FileLabelLoader> reader(
       new FileLabelLoader(OpSpec("FileReader")
@@ -14,9 +14,16 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "dali/core/common.h"
+#include "dali/core/small_vector.h"
 #include "dali/operators/reader/loader/numpy_loader.h"
 #include "dali/util/file.h"
 #include "dali/operators/reader/loader/utils.h"
@@ -38,52 +45,123 @@ TypeInfo TypeFromNumpyStr(const std::string &format) {
   DALI_FAIL("Unknown Numpy type string");
 }
 
-std::unique_ptr<FileStream> NumpyLoader::ParseHeader(std::unique_ptr<FileStream> file,
-                                                     NumpyParseTarget& target) {
-  // check if the file is actually a numpy file
-  std::vector<uint8_t> token(11);
-  int64_t nread = file->Read(token.data(), 10);
-  DALI_ENFORCE(nread == 10, "Can not read header.");
-  token[nread] = '\0';
+namespace detail {
 
-  // check if heqder is too short
-  std::string header = std::string(reinterpret_cast<char*>(token.data()));
-  DALI_ENFORCE(header.find_first_of("NUMPY") != std::string::npos,
-               "File is not a numpy file.");
+namespace {
 
-  // extract header length
-  uint16_t header_len = 0;
-  memcpy(&header_len, &token[8], 2);
-  DALI_ENFORCE((header_len + 10) % 16 == 0,
-               "Error extracting header length.");
+class HeaderParser {
+ public:
+  explicit HeaderParser(const std::string &header) : s_(header), pos_(0) {}
 
-  // read header: the offset is a magic number
-  int64 offset = (6+1+1+2);
-  // the header_len can be 4GiB according to the NPYv2 file format
-  // specification: https://numpy.org/neps/nep-0001-npy-format.html
-  // while this allocation could be sizable, it is performed on the host.
-  token.resize(header_len+1);
-  file->Seek(offset);
-  nread = file->Read(token.data(), header_len);
-  DALI_ENFORCE(nread == header_len, "Can not read header.");
-  token[header_len] = '\0';
-  header = std::string(reinterpret_cast<char*>(token.data()));
-  DALI_ENFORCE(header.find_first_of("{") != std::string::npos, "Header is corrupted.");
-  offset += header_len;
+  void SkipSpaces() {
+    while (pos_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[pos_])))
+      pos_++;
+  }
 
-  // prepare file for later reads
-  file->Seek(offset);
+  bool TrySkip(char c) {
+    SkipSpaces();
+    if (pos_ < s_.size() && s_[pos_] == c) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
 
-  // extract dictionary info from header
-  std::smatch header_match;
-  DALI_ENFORCE(std::regex_search(header, header_match, header_regex_),
-               "Can not parse header.");
+  void Skip(char c) {
+    DALI_ENFORCE(TrySkip(c), make_string("Can not parse header: expected '", c,
+                                         "' at position ", pos_, " in: ", s_));
+  }
 
-  // now extract header information
-  // type
-  std::string typestring = header_match[1].str();
+  std::string ParseString() {
+    SkipSpaces();
+    DALI_ENFORCE(pos_ < s_.size() && (s_[pos_] == '\'' || s_[pos_] == '"'),
+                 make_string("Can not parse header: expected a string in: ", s_));
+    char quote = s_[pos_++];
+    size_t end = s_.find(quote, pos_);
+    DALI_ENFORCE(end != std::string::npos,
+                 make_string("Can not parse header: unterminated string in: ", s_));
+    std::string result = s_.substr(pos_, end - pos_);
+    pos_ = end + 1;
+    return result;
+  }
+
+  bool ParseBool() {
+    SkipSpaces();
+    if (s_.compare(pos_, 4, "True") == 0) {
+      pos_ += 4;
+      return true;
+    }
+    if (s_.compare(pos_, 5, "False") == 0) {
+      pos_ += 5;
+      return false;
+    }
+    DALI_FAIL(make_string("Can not parse header: expected True or False in: ", s_));
+  }
+
+  int64_t ParseInt() {
+    SkipSpaces();
+    int64_t value = 0;
+    size_t start = pos_;
+    while (pos_ < s_.size() && std::isdigit(static_cast<unsigned char>(s_[pos_])))
+      value = value * 10 + (s_[pos_++] - '0');
+    // NumPy may append L to the extents in the headers written by Python 2
+    if (pos_ < s_.size() && s_[pos_] == 'L')
+      pos_++;
+    DALI_ENFORCE(pos_ > start, make_string("Can not parse header: expected an integer in: ", s_));
+    return value;
+  }
+
+  std::vector<int64_t> ParseTuple() {
+    std::vector<int64_t> result;
+    Skip('(');
+    while (!TrySkip(')')) {
+      result.push_back(ParseInt());
+      if (!TrySkip(',')) {
+        Skip(')');
+        break;
+      }
+    }
+    return result;
+  }
+
+ private:
+  const std::string &s_;
+  size_t pos_;
+};
+
+}  // namespace
+
+void ParseHeaderMetadata(NumpyParseTarget& target, const std::string &header) {
+  HeaderParser parser(header);
+  std::string typestring;
+  std::vector<int64_t> shape;
+  bool has_descr = false, has_order = false, has_shape = false;
+  parser.Skip('{');
+  while (!parser.TrySkip('}')) {
+    auto key = parser.ParseString();
+    parser.Skip(':');
+    if (key == "descr") {
+      typestring = parser.ParseString();
+      has_descr = true;
+    } else if (key == "fortran_order") {
+      target.fortran_order = parser.ParseBool();
+      has_order = true;
+    } else if (key == "shape") {
+      shape = parser.ParseTuple();
+      has_shape = true;
+    } else {
+      DALI_FAIL(make_string("Can not parse header: unexpected key '", key, "' in: ", header));
+    }
+    if (!parser.TrySkip(',')) {
+      parser.Skip('}');
+      break;
+    }
+  }
+  DALI_ENFORCE(has_descr && has_order && has_shape,
+               make_string("Can not parse header: missing keys in: ", header));
 
   // < means LE, | means N/A, = means native. In all those cases, we can read
+  DALI_ENFORCE(!typestring.empty(), "Can not parse header: empty type string.");
   bool little_endian =
     (typestring[0] == '<' || typestring[0] == '|' || typestring[0] == '=');
   DALI_ENFORCE(little_endian,
@@ -93,45 +171,155 @@ std::unique_ptr<FileStream> NumpyLoader::ParseHeader(std::unique_ptr<FileStream>
   // get type in a safe way
   target.type_info = TypeFromNumpyStr(tid);
 
-  // check for data order
-  if (header_match[2].str() == "False")
-    target.fortran_order = false;
-  else
-    target.fortran_order = true;
-
-  // set sizes
-  std::string shapestring = header_match[3].str();
-  std::regex shape_regex{R"(,+)"};  // split on comma
-  std::sregex_token_iterator it{shapestring.begin(), shapestring.end(), shape_regex, -1};
-  std::vector<std::string> shapevec{it, {}};
-
-  // if shapevec size is 1 and shapevec[0] is the empty string,
   // the array is actually a scalar/singleton (denoted as ())
   // and thus the size needs to be set to one:
-  if ( (shapevec.size() == 1) && (shapevec[0] == "") ) shapevec[0] = "1";
+  if (shape.empty())
+    shape.push_back(1);
 
-  // determine shapes
-  size_t shapesize = shapevec.size();
-  target.shape.resize(shapesize);
   // cheapest thing to do is to define the tensor in an reversed way
-  if (target.fortran_order) {
-    for (size_t i = 0; i < shapesize; ++i)
-      target.shape[i] = static_cast<int64_t>(stoi(shapevec[shapesize-i-1]));
+  if (target.fortran_order)
+    std::reverse(shape.begin(), shape.end());
+  target.shape = std::move(shape);
+}
+
+}  // namespace detail
+
+std::unique_ptr<FileStream> NumpyLoader::ParseHeader(std::unique_ptr<FileStream> file,
+                                                     NumpyParseTarget& target) {
+  // check if the file is actually a numpy file
+  uint8_t token[12];
+  int64_t nread = file->Read(token, 10);
+  DALI_ENFORCE(nread == 10, "Can not read header.");
+  DALI_ENFORCE(std::memcmp(token, "\x93NUMPY", 6) == 0, "File is not a numpy file.");
+
+  // extract header length: 2 bytes in version 1.0, 4 bytes in versions 2.0 and 3.0
+  // specification: https://numpy.org/neps/nep-0001-npy-format.html
+  int major_version = token[6];
+  int64_t offset;
+  uint32_t header_len = 0;
+  if (major_version == 1) {
+    uint16_t header_len16 = 0;
+    memcpy(&header_len16, &token[8], 2);
+    header_len = header_len16;
+    offset = 10;
   } else {
-    for (size_t i = 0; i < shapesize; ++i)
-      target.shape[i] = static_cast<int64_t>(stoi(shapevec[i]));
+    nread = file->Read(token + 10, 2);
+    DALI_ENFORCE(nread == 2, "Can not read header.");
+    memcpy(&header_len, &token[8], 4);
+    offset = 12;
   }
+  DALI_ENFORCE((header_len + offset) % 16 == 0,
+               "Error extracting header length.");
+
+  // while this allocation could be sizable, it is performed on the host.
+  std::string header(header_len, '\0');
+  nread = file->Read(reinterpret_cast<uint8_t*>(&header[0]), header_len);
+  DALI_ENFORCE(nread == header_len, "Can not read header.");
+  offset += header_len;
+  target.data_offset = offset;
 
+  detail::ParseHeaderMetadata(target, header);
   return file;
 }
 
+std::unique_ptr<FileStream> NumpyLoader::GetHeader(std::unique_ptr<FileStream> file,
+                                                   const std::string &path,
+                                                   NumpyParseTarget& target) {
+  {
+    std::lock_guard<std::mutex> lock(header_cache_mutex_);
+    auto it = header_cache_.find(path);
+    if (it != header_cache_.end()) {
+      target = it->second;
+      // prepare file for later reads; there's nothing to read from an empty array
+      if (target.nbytes() > 0)
+        file->Seek(target.data_offset);
+      return file;
+    }
+  }
+  file = ParseHeader(std::move(file), target);
+  std::lock_guard<std::mutex> lock(header_cache_mutex_);
+  header_cache_.emplace(path, target);
+  return file;
+}
 
-void NumpyLoader::ReadSample(ImageFileWrapper& imfile) {
-  auto image_file = images_[current_index_++];
+bool NumpyLoader::GetStorageROI(const NumpyParseTarget& target, TensorShape<> &start,
+                                TensorShape<> &shape) const {
+  if (roi_start_.empty() && roi_shape_.empty())
+    return false;
+  int ndim = target.shape.size();
+  DALI_ENFORCE(roi_start_.empty() || static_cast<int>(roi_start_.size()) == ndim,
+               make_string("`roi_start` has ", roi_start_.size(), " elements, while the array has ",
+                           ndim, " dimensions."));
+  DALI_ENFORCE(roi_shape_.empty() || static_cast<int>(roi_shape_.size()) == ndim,
+               make_string("`roi_shape` has ", roi_shape_.size(), " elements, while the array has ",
+                           ndim, " dimensions."));
+  start.resize(ndim);
+  shape.resize(ndim);
+  bool whole = true;
+  for (int d = 0; d < ndim; d++) {
+    // the shape of Fortran-order arrays is stored reversed
+    int storage_d = target.fortran_order ? ndim - 1 - d : d;
+    int64_t extent = target.shape[storage_d];
+    int64_t lo = roi_start_.empty() ? 0 : roi_start_[d];
+    int64_t size = roi_shape_.empty() || roi_shape_[d] < 0 ? extent - lo : roi_shape_[d];
+    DALI_ENFORCE(lo >= 0 && size >= 0 && lo + size <= extent,
+                 make_string("The region of interest is out of bounds in dimension ", d,
+                             ": start ", lo, ", shape ", size, ", array extent ", extent));
+    start[storage_d] = lo;
+    shape[storage_d] = size;
+    whole = whole && lo == 0 && size == extent;
+  }
+  return !whole;
+}
 
-  // handle wrap-around
-  MoveToNextShard(current_index_);
+void NumpyLoader::ReadROI(FileStream *file, const NumpyParseTarget& target,
+                          const TensorShape<> &start, const TensorShape<> &shape, uint8_t *out) {
+  int ndim = shape.size();
+  int64_t element_size = target.type_info.size();
+  if (volume(shape) == 0)
+    return;
+  // the innermost dimensions, which are read in full, form a single contiguous run together
+  // with the first dimension which is cropped
+  int64_t run = element_size;
+  int outer = ndim;
+  while (outer > 0) {
+    outer--;
+    run *= shape[outer];
+    if (shape[outer] != target.shape[outer])
+      break;
+  }
+  TensorShape<> strides;
+  strides.resize(ndim);
+  int64_t stride = element_size;
+  for (int d = ndim - 1; d >= 0; d--) {
+    strides[d] = stride;
+    stride *= target.shape[d];
+  }
 
+  // iterate over the outer dimensions, like an odometer
+  SmallVector<int64_t, 6> idx;
+  idx.resize(outer, 0);
+  int64_t num_runs = 1;
+  for (int d = 0; d < outer; d++)
+    num_runs *= shape[d];
+  for (int64_t r = 0; r < num_runs; r++) {
+    int64_t offset = target.data_offset + start[outer] * strides[outer];
+    for (int d = 0; d < outer; d++)
+      offset += (start[d] + idx[d]) * strides[d];
+    file->Seek(offset);
+    int64_t nread = file->Read(out, run);
+    DALI_ENFORCE(nread == run, "Failed to read the region of interest.");
+    out += run;
+    for (int d = outer - 1; d >= 0; d--) {
+      if (++idx[d] < shape[d])
+        break;
+      idx[d] = 0;
+    }
+  }
+}
+
+
+void NumpyLoader::ReadImage(ImageFileWrapper& imfile, const std::string &image_file) {
   // metadata info
   DALIMeta meta;
   meta.SetSourceInfo(image_file);
@@ -148,15 +336,25 @@ void NumpyLoader::ReadSample(ImageFileWrapper& imfile) {
     return;
   }
 
-  auto current_image = FileStream::Open(file_root_ + "/" + image_file, read_ahead_,
-                                        !copy_read_data_);
+  auto path = file_root_ + "/" + image_file;
+  auto current_image = FileStream::Open(path, read_ahead_, !copy_read_data_);
 
   // read the header
   NumpyParseTarget target;
-  current_image = ParseHeader(std::move(current_image), target);
+  current_image = GetHeader(std::move(current_image), path, target);
   Index image_bytes = target.nbytes();
 
-  if (copy_read_data_) {
+  TensorShape<> roi_start, roi_shape;
+  if (GetStorageROI(target, roi_start, roi_shape)) {
+    // only the region of interest is read; it can't be shared with a mapped file, because
+    // it's not contiguous in general
+    if (imfile.image.shares_data()) {
+      imfile.image.Reset();
+    }
+    imfile.image.Resize(roi_shape, target.type_info);
+    ReadROI(current_image.get(), target, roi_start, roi_shape,
+            static_cast<uint8_t*>(imfile.image.raw_mutable_data()));
+  } else if (copy_read_data_) {
     if (imfile.image.shares_data()) {
       imfile.image.Reset();
     }
@@ -180,7 +378,7 @@ void NumpyLoader::ReadSample(ImageFileWrapper& imfile) {
   imfile.image.SetMeta(meta);
 
   // set file path
-  imfile.filename = file_root_ + "/" + image_file;
+  imfile.filename = path;
 
   // set meta
   imfile.meta = (target.fortran_order ? "transpose:true" : "transpose:false");
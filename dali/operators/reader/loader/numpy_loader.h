@@ -25,8 +25,9 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
-#include <regex>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/types.h"
@@ -42,6 +43,8 @@ class NumpyParseTarget{
   std::vector<int64_t> shape;
   TypeInfo type_info;
   bool fortran_order;
+  // offset of the array data in the file
+  int64_t data_offset = 0;
 
   size_t size() {
     return volume(shape);
@@ -52,25 +55,66 @@ class NumpyParseTarget{
   }
 };
 
+namespace detail {
+
+/**
+ * @brief Parses the dictionary stored in the header of a .npy file, e.g.
+ *        `{'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), }`
+ *
+ * Fills the type, the order and the shape of `target`; the shape of Fortran-order arrays
+ * is reversed.
+ */
+DLL_PUBLIC void ParseHeaderMetadata(NumpyParseTarget& target, const std::string &header);
+
+}  // namespace detail
+
 class NumpyLoader : public FileLoader {
  public:
   explicit inline NumpyLoader(
     const OpSpec& spec,
     vector<std::string> images = std::vector<std::string>(),
     bool shuffle_after_epoch = false)
-    : FileLoader(spec, images, shuffle_after_epoch),
-    header_regex_(R"###(^\{'descr': \'(.*?)\', 'fortran_order': (.*?), 'shape': \((.*?)\), \})###") {}
-
-  // we want to make it possible to override this function as well
-  void ReadSample(ImageFileWrapper& tensor) override;
+    : FileLoader(spec, images, shuffle_after_epoch) {
+    if (spec.HasArgument("roi_start"))
+      roi_start_ = spec.GetRepeatedArgument<int>("roi_start");
+    if (spec.HasArgument("roi_shape"))
+      roi_shape_ = spec.GetRepeatedArgument<int>("roi_shape");
+  }
 
  protected:
+  // reads the header and the data of a .npy file
+  void ReadImage(ImageFileWrapper& imfile, const std::string &image_file) override;
+
   // parser function, only for internal use
   std::unique_ptr<FileStream> ParseHeader(std::unique_ptr<FileStream> file,
                                           NumpyParseTarget& target);
 
-  // regex search string
-  const std::regex header_regex_;
+  /**
+   * @brief Returns the parsed header of the file, reading it only on the first access
+   *
+   * The stream is left at the beginning of the array data.
+   */
+  std::unique_ptr<FileStream> GetHeader(std::unique_ptr<FileStream> file,
+                                        const std::string &path, NumpyParseTarget& target);
+
+  /**
+   * @brief Computes the region of interest in the order in which the data is stored
+   *
+   * @return false, if the whole array should be read
+   */
+  bool GetStorageROI(const NumpyParseTarget& target, TensorShape<> &start,
+                     TensorShape<> &shape) const;
+
+  // reads the region of interest of a C-order array, one contiguous run at a time
+  void ReadROI(FileStream *file, const NumpyParseTarget& target, const TensorShape<> &start,
+               const TensorShape<> &shape, uint8_t *out);
+
+  // the headers of the files read so far, by path
+  std::unordered_map<std::string, NumpyParseTarget> header_cache_;
+  std::mutex header_cache_mutex_;
+
+  // region of interest in the array coordinates; empty, if not used
+  std::vector<int> roi_start_, roi_shape_;
 };
 
 }  // namespace dali
@@ -0,0 +1,74 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/numpy_loader.h"
+
+namespace dali {
+
+TEST(NumpyHeaderTest, Parse) {
+  NumpyParseTarget target;
+  detail::ParseHeaderMetadata(
+      target, "{'descr': '<f4', 'fortran_order': False, 'shape': (3, 4, 5), }          \n");
+  EXPECT_EQ(target.type_info.id(), DALI_FLOAT);
+  EXPECT_FALSE(target.fortran_order);
+  EXPECT_EQ(target.shape, (std::vector<int64_t>{3, 4, 5}));
+
+  // the shape of Fortran-order arrays is reversed
+  detail::ParseHeaderMetadata(
+      target, "{'descr': '|u1', 'fortran_order': True, 'shape': (3, 4, 5), }");
+  EXPECT_EQ(target.type_info.id(), DALI_UINT8);
+  EXPECT_TRUE(target.fortran_order);
+  EXPECT_EQ(target.shape, (std::vector<int64_t>{5, 4, 3}));
+}
+
+TEST(NumpyHeaderTest, ParseVariants) {
+  NumpyParseTarget target;
+  // 1D arrays have a trailing comma in the shape
+  detail::ParseHeaderMetadata(target, "{'descr': '<i2', 'fortran_order': False, 'shape': (7,), }");
+  EXPECT_EQ(target.type_info.id(), DALI_INT16);
+  EXPECT_EQ(target.shape, (std::vector<int64_t>{7}));
+
+  // scalars have an empty shape
+  detail::ParseHeaderMetadata(target, "{'descr': '<f8', 'fortran_order': False, 'shape': ()}");
+  EXPECT_EQ(target.type_info.id(), DALI_FLOAT64);
+  EXPECT_EQ(target.shape, (std::vector<int64_t>{1}));
+
+  // any order of keys, no trailing comma, Python 2 long integers
+  detail::ParseHeaderMetadata(target,
+                              "{\"shape\":(2L,3L),\"fortran_order\":False,\"descr\":\"<u2\"}");
+  EXPECT_EQ(target.type_info.id(), DALI_UINT16);
+  EXPECT_EQ(target.shape, (std::vector<int64_t>{2, 3}));
+}
+
+TEST(NumpyHeaderTest, ParseErrors) {
+  NumpyParseTarget target;
+  EXPECT_THROW(detail::ParseHeaderMetadata(target, "{'descr': '<f4', 'shape': (3, 4), }"),
+               std::runtime_error);
+  EXPECT_THROW(detail::ParseHeaderMetadata(
+      target, "{'descr': '>f4', 'fortran_order': False, 'shape': (3, 4), }"), std::runtime_error);
+  EXPECT_THROW(detail::ParseHeaderMetadata(
+      target, "{'descr': '<f4', 'fortran_order': Maybe, 'shape': (3, 4), }"), std::runtime_error);
+  EXPECT_THROW(detail::ParseHeaderMetadata(
+      target, "{'descr': '<f4', 'fortran_order': False, 'shape': (3, 4, }"), std::runtime_error);
+  EXPECT_THROW(detail::ParseHeaderMetadata(
+      target, "{'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), 'x': 1}"),
+      std::runtime_error);
+}
+
+}  // namespace dali
@@ -0,0 +1,120 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/record_index.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Binary index files are supported only on little endian platforms"
+#endif
+
+namespace dali {
+
+namespace {
+
+constexpr char kBinaryIndexMagic[8] = { 'D', 'A', 'L', 'I', 'I', 'D', 'X', '1' };
+
+struct BinaryIndexHeader {
+  char magic[8];
+  int64 num_records;
+};
+
+static_assert(sizeof(BinaryIndexHeader) == 16, "The binary index header must be 16 bytes");
+
+}  // namespace
+
+bool RecordIndex::IsBinaryIndexFile(const std::string &path) {
+  std::ifstream f(path, std::ios::binary);
+  DALI_ENFORCE(f.good(), make_string("Failed to open index file \"", path, "\""));
+  char magic[sizeof(kBinaryIndexMagic)];
+  if (!f.read(magic, sizeof(magic)))
+    return false;
+  return !std::memcmp(magic, kBinaryIndexMagic, sizeof(magic));
+}
+
+void RecordIndex::AddBinaryIndexFile(const std::string &path, size_t file_index_offset) {
+  int fd = open(path.c_str(), O_RDONLY);
+  DALI_ENFORCE(fd >= 0, make_string("Failed to open index file \"", path, "\": ",
+                                    std::strerror(errno)));
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int err = errno;
+    close(fd);
+    DALI_FAIL(make_string("Failed to stat index file \"", path, "\": ", std::strerror(err)));
+  }
+  size_t file_size = st.st_size;
+  if (file_size < sizeof(BinaryIndexHeader)) {
+    close(fd);
+    DALI_FAIL(make_string("Index file \"", path, "\" is too short"));
+  }
+
+  // the mapping is read-only and shared, so all the processes using the index share the pages
+  void *p = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  int err = errno;
+  close(fd);
+  DALI_ENFORCE(p != MAP_FAILED, make_string("Failed to map index file \"", path, "\": ",
+                                            std::strerror(err)));
+  std::shared_ptr<const void> mapping(p, [file_size](const void *ptr) {
+    munmap(const_cast<void *>(ptr), file_size);
+  });
+
+  auto *header = static_cast<const BinaryIndexHeader *>(p);
+  DALI_ENFORCE(!std::memcmp(header->magic, kBinaryIndexMagic, sizeof(kBinaryIndexMagic)),
+               make_string("\"", path, "\" is not a binary index file"));
+  DALI_ENFORCE(header->num_records >= 0 &&
+               file_size == sizeof(BinaryIndexHeader) +
+                            header->num_records * sizeof(BinaryIndexRecord),
+               make_string("Index file \"", path, "\" is corrupted: the size of the file doesn't "
+                           "match the number of records (", header->num_records, ")"));
+
+  auto *records = reinterpret_cast<const BinaryIndexRecord *>(header + 1);
+  AddSegment(records, header->num_records, file_index_offset, std::move(mapping));
+}
+
+void RecordIndex::AddRecords(std::vector<BinaryIndexRecord> &&records, size_t file_index_offset) {
+  auto storage = std::make_shared<std::vector<BinaryIndexRecord>>(std::move(records));
+  AddSegment(storage->data(), storage->size(), file_index_offset, storage);
+}
+
+void RecordIndex::AddSegment(const BinaryIndexRecord *records, size_t count,
+                             size_t file_index_offset, std::shared_ptr<const void> storage) {
+  if (count == 0)
+    return;
+  size_t start = size();
+  segments_.push_back({ records, start, file_index_offset, std::move(storage) });
+  segment_ends_.push_back(start + count);
+}
+
+void WriteBinaryIndexFile(const std::string &path, span<const BinaryIndexRecord> records) {
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  DALI_ENFORCE(f.good(), make_string("Failed to create index file \"", path, "\""));
+  BinaryIndexHeader header;
+  std::memcpy(header.magic, kBinaryIndexMagic, sizeof(kBinaryIndexMagic));
+  header.num_records = records.size();
+  f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  f.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(records[0]));
+  DALI_ENFORCE(f.good(), make_string("Failed to write index file \"", path, "\""));
+}
+
+}  // namespace dali
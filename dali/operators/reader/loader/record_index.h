@@ -0,0 +1,120 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_RECORD_INDEX_H_
+#define DALI_OPERATORS_READER_LOADER_RECORD_INDEX_H_
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/span.h"
+
+namespace dali {
+
+/**
+ * @brief A record of a binary index file
+ *
+ * The binary index file consists of a 16-byte header - the magic string "DALIIDX1" followed by
+ * the number of records as a 64-bit integer - and the records. All values are little endian.
+ * `file_index` is the position of the data file in the reader's `path` argument.
+ */
+struct BinaryIndexRecord {
+  int64 offset;
+  int64 size;
+  int64 file_index;
+};
+
+static_assert(sizeof(BinaryIndexRecord) == 24, "The binary index record must be 24 bytes");
+
+/**
+ * @brief Locations of the records in a set of data files
+ *
+ * The index is assembled from segments, which either own their records (parsed from text index
+ * files) or are views over memory-mapped binary index files. The mapped files are shared, via
+ * the page cache, between all the processes reading the same data set, so loading a binary
+ * index takes constant time and memory.
+ */
+class RecordIndex {
+ public:
+  /// offset, size and file index of a record
+  using Entry = std::tuple<int64, int64, size_t>;
+
+  /**
+   * @brief Tells whether the file starts with the binary index magic string
+   */
+  static bool IsBinaryIndexFile(const std::string &path);
+
+  /**
+   * @brief Maps a binary index file and appends its records
+   *
+   * @param file_index_offset  value added to the file indices stored in the index file
+   */
+  void AddBinaryIndexFile(const std::string &path, size_t file_index_offset);
+
+  /**
+   * @brief Appends the records, taking the ownership of them
+   */
+  void AddRecords(std::vector<BinaryIndexRecord> &&records, size_t file_index_offset);
+
+  Entry operator[](size_t index) const {
+    DALI_ENFORCE(index < size(), make_string("Record index ", index, " out of range [0, ",
+                 size(), ")"));
+    const Segment *segment = &segments_[0];
+    if (segments_.size() > 1) {
+      auto it = std::upper_bound(segment_ends_.begin(), segment_ends_.end(), index);
+      segment = &segments_[it - segment_ends_.begin()];
+    }
+    const BinaryIndexRecord &record = segment->records[index - segment->start];
+    return Entry(record.offset, record.size,
+                 static_cast<size_t>(record.file_index) + segment->file_index_offset);
+  }
+
+  size_t size() const {
+    return segment_ends_.empty() ? 0 : segment_ends_.back();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+ private:
+  struct Segment {
+    const BinaryIndexRecord *records;
+    size_t start;
+    size_t file_index_offset;
+    // keeps the records (or the mapping) alive
+    std::shared_ptr<const void> storage;
+  };
+
+  void AddSegment(const BinaryIndexRecord *records, size_t count, size_t file_index_offset,
+                  std::shared_ptr<const void> storage);
+
+  std::vector<Segment> segments_;
+  std::vector<size_t> segment_ends_;
+};
+
+/**
+ * @brief Writes a binary index file
+ */
+void WriteBinaryIndexFile(const std::string &path, span<const BinaryIndexRecord> records);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_RECORD_INDEX_H_
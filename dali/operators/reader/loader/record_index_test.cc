@@ -0,0 +1,128 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/record_index.h"
+
+namespace dali {
+
+namespace {
+
+std::string TempFileName() {
+  char name[] = "/tmp/dali_record_index_XXXXXX";
+  int fd = mkstemp(name);
+  EXPECT_GE(fd, 0);
+  close(fd);
+  return name;
+}
+
+std::vector<BinaryIndexRecord> MakeRecords(int n, int64 file_index) {
+  std::vector<BinaryIndexRecord> records;
+  int64 offset = 0;
+  for (int i = 0; i < n; i++) {
+    int64 size = 100 + i * 7;
+    records.push_back({ offset, size, file_index });
+    offset += size;
+  }
+  return records;
+}
+
+void ExpectEntry(const RecordIndex &index, size_t i, const BinaryIndexRecord &record,
+                 size_t file_index) {
+  int64 offset, size;
+  size_t file;
+  std::tie(offset, size, file) = index[i];
+  EXPECT_EQ(offset, record.offset) << "entry " << i;
+  EXPECT_EQ(size, record.size) << "entry " << i;
+  EXPECT_EQ(file, file_index) << "entry " << i;
+}
+
+}  // namespace
+
+TEST(RecordIndex, BinaryRoundTrip) {
+  auto path = TempFileName();
+  auto records = MakeRecords(1000, 3);
+  WriteBinaryIndexFile(path, make_cspan(records));
+  EXPECT_TRUE(RecordIndex::IsBinaryIndexFile(path));
+
+  RecordIndex index;
+  index.AddBinaryIndexFile(path, 0);
+  std::remove(path.c_str());  // the mapping stays valid
+  ASSERT_EQ(index.size(), records.size());
+  for (size_t i = 0; i < records.size(); i++)
+    ExpectEntry(index, i, records[i], 3);
+}
+
+TEST(RecordIndex, Segments) {
+  auto path = TempFileName();
+  auto binary_records = MakeRecords(50, 0);
+  WriteBinaryIndexFile(path, make_cspan(binary_records));
+
+  auto records0 = MakeRecords(10, 0);
+  auto records2 = MakeRecords(20, 0);
+  RecordIndex index;
+  EXPECT_TRUE(index.empty());
+  index.AddRecords(std::vector<BinaryIndexRecord>(records0), 0);
+  index.AddBinaryIndexFile(path, 1);
+  index.AddRecords({}, 2);  // empty segments are skipped
+  index.AddRecords(std::vector<BinaryIndexRecord>(records2), 2);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(index.size(), 80u);
+  for (size_t i = 0; i < 10; i++)
+    ExpectEntry(index, i, records0[i], 0);
+  for (size_t i = 0; i < 50; i++)
+    ExpectEntry(index, 10 + i, binary_records[i], 1);
+  for (size_t i = 0; i < 20; i++)
+    ExpectEntry(index, 60 + i, records2[i], 2);
+}
+
+TEST(RecordIndex, OutOfRange) {
+  RecordIndex index;
+  EXPECT_THROW(index[0], DALIException);
+  index.AddRecords(MakeRecords(3, 0), 0);
+  index.AddRecords(MakeRecords(2, 0), 1);
+  ExpectEntry(index, 4, MakeRecords(2, 0)[1], 1);
+  EXPECT_THROW(index[5], DALIException);
+}
+
+TEST(RecordIndex, TextFileIsNotBinary) {
+  auto path = TempFileName();
+  {
+    std::ofstream f(path);
+    f << "0 100\n100 200\n";
+  }
+  EXPECT_FALSE(RecordIndex::IsBinaryIndexFile(path));
+  EXPECT_THROW(RecordIndex().AddBinaryIndexFile(path, 0), DALIException);
+  std::remove(path.c_str());
+}
+
+TEST(RecordIndex, Truncated) {
+  auto path = TempFileName();
+  auto records = MakeRecords(10, 0);
+  WriteBinaryIndexFile(path, make_cspan(records));
+  ASSERT_EQ(truncate(path.c_str(), 16 + 9 * sizeof(BinaryIndexRecord) + 5), 0);
+  EXPECT_THROW(RecordIndex().AddBinaryIndexFile(path, 0), DALIException);
+  std::remove(path.c_str());
+}
+
+}  // namespace dali
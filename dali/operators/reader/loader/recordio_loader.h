@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "dali/operators/reader/loader/indexed_file_loader.h"
@@ -34,6 +35,15 @@ class RecordIOLoader : public IndexedFileLoader {
   ~RecordIOLoader() override {}
 
   void ReadIndexFile(const std::vector<std::string>& index_uris) override {
+    DALI_ENFORCE(index_uris.size() == 1,
+        "RecordIOReader supports only a single index file");
+    const std::string& path = index_uris[0];
+    // binary index files store the offsets within the data files - no need to compute them
+    if (RecordIndex::IsBinaryIndexFile(path)) {
+      indices_.AddBinaryIndexFile(path, 0);
+      return;
+    }
+
     std::vector<size_t> file_offsets;
     file_offsets.push_back(0);
     for (std::string& path : uris_) {
@@ -41,9 +51,6 @@ class RecordIOLoader : public IndexedFileLoader {
       file_offsets.push_back(tmp->Size() + file_offsets.back());
       tmp->Close();
     }
-    DALI_ENFORCE(index_uris.size() == 1,
-        "RecordIOReader supports only a single index file");
-    const std::string& path = index_uris[0];
     std::ifstream index_file(path);
     DALI_ENFORCE(index_file.good(),
         "Could not open RecordIO index file. Provided path: \"" + path + "\"");
@@ -57,6 +64,7 @@ class RecordIOLoader : public IndexedFileLoader {
                   path, "\""));
 
     std::sort(temp.begin(), temp.end());
+    std::vector<BinaryIndexRecord> records;
     size_t file_offset_index = 0;
     for (size_t i = 0; i < temp.size() - 1; ++i) {
       if (temp[i] >= file_offsets[file_offset_index + 1]) {
@@ -65,17 +73,23 @@ class RecordIOLoader : public IndexedFileLoader {
       int64 size = temp[i + 1] - temp[i];
       // skip 0 sized images
       if (size) {
-        indices_.push_back(std::make_tuple(temp[i] - file_offsets[file_offset_index],
-                                          size, file_offset_index));
+        records.push_back({static_cast<int64>(temp[i] - file_offsets[file_offset_index]),
+                           size, static_cast<int64>(file_offset_index)});
       }
     }
     int64 size = file_offsets.back() - temp.back();
     // skip 0 sized images
     if (size) {
-      indices_.push_back(std::make_tuple(temp.back() - file_offsets[file_offset_index],
-                                        size, file_offset_index));
+      records.push_back({static_cast<int64>(temp.back() - file_offsets[file_offset_index]),
+                         size, static_cast<int64>(file_offset_index)});
     }
     index_file.close();
+    indices_.AddRecords(std::move(records), 0);
+  }
+
+  bool CanReadInParallel() const override {
+    // records may span multiple files
+    return false;
   }
 
   void ReadSample(Tensor<CPUBackend>& tensor) override {
@@ -84,7 +98,7 @@ class RecordIOLoader : public IndexedFileLoader {
 
     int64 seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    std::tie(seek_pos, size, file_index) = GetIndexEntry(current_index_);
 
     ++current_index_;
 
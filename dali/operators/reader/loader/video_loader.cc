@@ -22,6 +22,7 @@
 #include <utility>
 #include <fstream>
 #include <limits>
+#include <cmath>
 #include <sstream>
 
 
@@ -258,7 +259,27 @@ static int64_t seek_file(void *opaque, int64_t offset, int whence) {
   }
 }
 
-VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
+VideoLoaderBase::VideoLoaderBase(const OpSpec& spec, const std::vector<std::string>& filenames)
+    : file_root_(spec.GetArgument<std::string>("file_root")),
+      file_list_(spec.GetArgument<std::string>("file_list")),
+      count_(spec.GetArgument<int>("sequence_length")),
+      step_(spec.GetArgument<int>("step")),
+      stride_(spec.GetArgument<int>("stride")),
+      max_height_(0),
+      max_width_(0),
+      filenames_(filenames),
+      codec_id_(0),
+      skip_vfr_check_(spec.GetArgument<bool>("skip_vfr_check")),
+      file_list_frame_num_(spec.GetArgument<bool>("file_list_frame_num")),
+      stats_({0, 0, 0, 0, 0}) {
+  if (step_ < 0)
+    step_ = count_ * stride_;
+
+  file_info_ = filesystem::get_file_label_pair(file_root_, filenames_, file_list_);
+  DALI_ENFORCE(!file_info_.empty(), "No files were read.");
+}
+
+VideoFile& VideoLoaderBase::get_or_open_file(const std::string &filename) {
   auto& file = open_files_[filename];
 
   if (file.empty()) {
@@ -331,7 +352,7 @@ VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
       DALI_ENFORCE(codec_id_ == codec_id, "File " + filename +
                    " is not the same codec as previous files");
 
-      if (NVCUVID_API_EXISTS(cuvidReconfigureDecoder)) {
+      if (can_change_resolution()) {
         if (max_width_ < width) max_width_ = width;
         if (max_height_ < height) max_height_ = height;
 
@@ -451,7 +472,7 @@ VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
   return file;
 }
 
-void VideoLoader::seek(VideoFile& file, int frame) {
+void VideoLoaderBase::seek(VideoFile& file, int frame) {
     auto seek_time = av_rescale_q(frame, file.frame_base_, file.stream_base_) + file.start_time_;
     LOG_LINE << "Seeking to frame " << frame << " timestamp " << seek_time << std::endl;
 
@@ -469,191 +490,270 @@ void VideoLoader::seek(VideoFile& file, int frame) {
     // starting.
 }
 
-void VideoLoader::read_file() {
+void VideoLoaderBase::read_sequence_packets(VideoFile& file, const FrameReq& req,
+                                            const std::function<bool(AVPacket*)>& send_packet) {
   // av_packet_unref is unlike the other libav free functions
   using pkt_ptr = std::unique_ptr<AVPacket, decltype(&av_packet_unref)>;
   AVPacket raw_pkt = {};
-  int seek_hack = 1;
 
-  while (!stop_) {
-    if (stop_) {
-      break;
-    }
+  // we want to seek each time because even if we ended on the
+  // correct key frame, we've flushed the decoder, so it needs
+  // another key frame to start decoding again
+  seek(file, req.frame);
 
-    auto req = send_queue_.pop();
+  auto nonkey_frame_count = 0;
+  int frames_left = req.count;
+  std::vector<bool> frames_read(frames_left, false);
 
-    LOG_LINE << "Got a request for " << req.filename << " frame " << req.frame
-             << " count " << req.count << " send_queue_ has " << send_queue_.size()
-             << " frames left" << std::endl;
+  bool is_first_frame = true;
+  bool key = false;
+  bool seek_must_succeed = false;
+  bool stop = false;
+  int seek_hack = 1;
 
-    if (stop_) {
-      break;
-    }
+  while (av_read_frame(file.fmt_ctx_.get(), &raw_pkt) >= 0) {
+    auto pkt = pkt_ptr(&raw_pkt, av_packet_unref);
 
-    auto& file = get_or_open_file(req.filename);
-    auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
-    req.frame_base = file.frame_base_;
+    stats_.bytes_read += pkt->size;
+    stats_.packets_read++;
 
-    if (vid_decoder_) {
-        vid_decoder_->push_req(req);
-    } else {
-        DALI_FAIL("No video decoder even after opening a file");
+    if (pkt->stream_index != file.vid_stream_idx_) {
+        continue;
     }
 
-    // we want to seek each time because even if we ended on the
-    // correct key frame, we've flushed the decoder, so it needs
-    // another key frame to start decoding again
-    seek(file, req.frame);
-
-    auto nonkey_frame_count = 0;
-    int frames_left = req.count;
-    std::vector<bool> frames_read(frames_left, false);
-
-    bool is_first_frame = true;
-    bool key = false;
-    bool seek_must_succeed = false;
-
-    while (av_read_frame(file.fmt_ctx_.get(), &raw_pkt) >= 0) {
-      auto pkt = pkt_ptr(&raw_pkt, av_packet_unref);
-
-      stats_.bytes_read += pkt->size;
-      stats_.packets_read++;
-
-      if (pkt->stream_index != file.vid_stream_idx_) {
-          continue;
-      }
-
-      auto frame = av_rescale_q(pkt->pts - file.start_time_,
-                                file.stream_base_,
-                                file.frame_base_);
-      LOG_LINE << "Frame candidate " << frame << " (for " << req.frame  <<" )...\n";
-
-      file.last_frame_ = frame;
-      key = (pkt->flags & AV_PKT_FLAG_KEY) != 0;
-      int pkt_frames = 1;
-      if (pkt->duration) {
-        pkt_frames = av_rescale_q(pkt->duration, file.stream_base_, file.frame_base_);
-        LOG_LINE << "Duration: " << pkt->duration
-                 << "\nPacket contains " << pkt_frames << " frames\n";
-      }
+    auto frame = av_rescale_q(pkt->pts - file.start_time_,
+                              file.stream_base_,
+                              file.frame_base_);
+    LOG_LINE << "Frame candidate " << frame << " (for " << req.frame  <<" )...\n";
+
+    file.last_frame_ = frame;
+    key = (pkt->flags & AV_PKT_FLAG_KEY) != 0;
+    int pkt_frames = 1;
+    if (pkt->duration) {
+      pkt_frames = av_rescale_q(pkt->duration, file.stream_base_, file.frame_base_);
+      LOG_LINE << "Duration: " << pkt->duration
+               << "\nPacket contains " << pkt_frames << " frames\n";
+    }
 
-      if (frame > req.frame) {
-        if (key) {
-          if (frames_left <= 0)
-            break;
-          if (is_first_frame) {
-            LOG_LINE << device_id_ << ": We got ahead of ourselves! "
-                          << frame << " > " << req.frame << " + "
-                          << nonkey_frame_count
-                          << " seek_hack = " << seek_hack << std::endl;
-            if (seek_must_succeed) {
-              std::stringstream ss;
-              ss << device_id_ << ": failed to seek frame "
-                  << req.frame;
-              DALI_FAIL(ss.str());
-            }
-            if (req.frame > seek_hack) {
-              seek(file, req.frame - seek_hack);
-              seek_hack *= 2;
-            } else {
-              seek_must_succeed = true;
-              seek(file, 0);
-            }
-            continue;
+    if (frame > req.frame) {
+      if (key) {
+        if (frames_left <= 0)
+          break;
+        if (is_first_frame) {
+          LOG_LINE << file.file_desc.filename << ": We got ahead of ourselves! "
+                        << frame << " > " << req.frame << " + "
+                        << nonkey_frame_count
+                        << " seek_hack = " << seek_hack << std::endl;
+          if (seek_must_succeed) {
+            std::stringstream ss;
+            ss << file.file_desc.filename << ": failed to seek frame "
+                << req.frame;
+            DALI_FAIL(ss.str());
+          }
+          if (req.frame > seek_hack) {
+            seek(file, req.frame - seek_hack);
+            seek_hack *= 2;
           } else {
-            nonkey_frame_count = 0;
+            seek_must_succeed = true;
+            seek(file, 0);
           }
-          seek_must_succeed = false;
+          continue;
         } else {
-          nonkey_frame_count += pkt_frames;
-          // A heuristic so we don't go way over... what should "20" be?
-          if (frames_left <= 0 && frame > req.frame + req.count + 20) {
-            break;
-          }
+          nonkey_frame_count = 0;
+        }
+        seek_must_succeed = false;
+      } else {
+        nonkey_frame_count += pkt_frames;
+        // A heuristic so we don't go way over... what should "20" be?
+        if (frames_left <= 0 && frame > req.frame + req.count + 20) {
+          break;
         }
       }
+    }
 
-      if (frame >= req.frame && frame < req.frame + req.count) {
-        if (frames_read[frame - req.frame]) {
-          ERROR_LOG << "Frame " << frame << " appeared twice\n";
-        } else {
-          frames_read[frame - req.frame] = true;
-          frames_left--;
-          LOG_LINE << "Frames left: " << frames_left << "\n";
-        }
+    if (frame >= req.frame && frame < req.frame + req.count) {
+      if (frames_read[frame - req.frame]) {
+        ERROR_LOG << "Frame " << frame << " appeared twice\n";
       } else {
-        LOG_LINE << "Frame " << frame << " not in the interesting range.\n";
+        frames_read[frame - req.frame] = true;
+        frames_left--;
+        LOG_LINE << "Frames left: " << frames_left << "\n";
       }
+    } else {
+      LOG_LINE << "Frame " << frame << " not in the interesting range.\n";
+    }
 
-      LOG_LINE << device_id_ << ": Sending " << (key ? "  key " : "nonkey")
-                  << " frame " << frame << " to the decoder."
-                  << " size = " << pkt->size
-                  << " req.frame = " << req.frame
-                  << " req.count = " << req.count
-                  << " nonkey_frame_count = " << nonkey_frame_count
-                  << std::endl;
+    LOG_LINE << "Sending " << (key ? "  key " : "nonkey")
+                << " frame " << frame << " to the decoder."
+                << " size = " << pkt->size
+                << " req.frame = " << req.frame
+                << " req.count = " << req.count
+                << " nonkey_frame_count = " << nonkey_frame_count
+                << std::endl;
 
-      stats_.bytes_decoded += pkt->size;
-      stats_.packets_decoded++;
+    stats_.bytes_decoded += pkt->size;
+    stats_.packets_decoded++;
 
-      if (file.bsf_ctx_ && pkt->size > 0) {
-        int ret;
+    if (file.bsf_ctx_ && pkt->size > 0) {
+      int ret;
 #if HAVE_AVBSFCONTEXT
-        auto raw_filtered_pkt = AVPacket{};
+      auto raw_filtered_pkt = AVPacket{};
 
-        if ((ret = av_bsf_send_packet(file.bsf_ctx_.get(), pkt.release())) < 0) {
-          DALI_FAIL(std::string("BSF send packet failed:") + av_err2str(ret));
-        }
-        while ((ret = av_bsf_receive_packet(file.bsf_ctx_.get(), &raw_filtered_pkt)) == 0) {
-          auto fpkt = pkt_ptr(&raw_filtered_pkt, av_packet_unref);
-          vid_decoder_->decode_packet(fpkt.get(), file.start_time_, file.stream_base_,
-                                      codecpar(stream));
-        }
-        if (ret != AVERROR(EAGAIN)) {
-          DALI_FAIL(std::string("BSF receive packet failed:") + av_err2str(ret));
-        }
+      if ((ret = av_bsf_send_packet(file.bsf_ctx_.get(), pkt.release())) < 0) {
+        DALI_FAIL(std::string("BSF send packet failed:") + av_err2str(ret));
+      }
+      while ((ret = av_bsf_receive_packet(file.bsf_ctx_.get(), &raw_filtered_pkt)) == 0) {
+        auto fpkt = pkt_ptr(&raw_filtered_pkt, av_packet_unref);
+        // the filter is drained even when stopping, so that it can take the next sequence
+        if (!stop)
+          stop = !send_packet(fpkt.get());
+      }
+      if (ret != AVERROR(EAGAIN)) {
+        DALI_FAIL(std::string("BSF receive packet failed:") + av_err2str(ret));
+      }
 #else
-        AVPacket fpkt;
-        for (auto bsf = file.bsf_ctx_.get(); bsf; bsf = bsf->next) {
-          fpkt = *pkt.get();
-          ret = av_bitstream_filter_filter(bsf, file.codec, nullptr,
-                                            &fpkt.data, &fpkt.size,
-                                            pkt->data, pkt->size,
-                                            !!(pkt->flags & AV_PKT_FLAG_KEY));
-          if (ret < 0) {
-              DALI_FAIL(std::string("BSF error:") + av_err2str(ret));
+      AVPacket fpkt;
+      for (auto bsf = file.bsf_ctx_.get(); bsf; bsf = bsf->next) {
+        fpkt = *pkt.get();
+        ret = av_bitstream_filter_filter(bsf, file.codec, nullptr,
+                                          &fpkt.data, &fpkt.size,
+                                          pkt->data, pkt->size,
+                                          !!(pkt->flags & AV_PKT_FLAG_KEY));
+        if (ret < 0) {
+            DALI_FAIL(std::string("BSF error:") + av_err2str(ret));
+        }
+        if (ret == 0 && fpkt.data != pkt->data) {
+          // fpkt is an offset into pkt, copy the smaller portion to the start
+          if ((ret = av_copy_packet(&fpkt, pkt.get())) < 0) {
+            av_free(fpkt.data);
+            DALI_FAIL(std::string("av_copy_packet error:") + av_err2str(ret));
           }
-          if (ret == 0 && fpkt.data != pkt->data) {
-            // fpkt is an offset into pkt, copy the smaller portion to the start
-            if ((ret = av_copy_packet(&fpkt, pkt.get())) < 0) {
+          ret = 1;
+        }
+        if (ret > 0) {
+          /* free the buffer in pkt and replace it with the newly
+          created buffer in fpkt */
+          av_free_packet(pkt.get());
+          fpkt.buf = av_buffer_create(fpkt.data, fpkt.size, av_buffer_default_free,
+                                      nullptr, 0);
+          if (!fpkt.buf) {
               av_free(fpkt.data);
-              DALI_FAIL(std::string("av_copy_packet error:") + av_err2str(ret));
-            }
-            ret = 1;
+              DALI_FAIL(std::string("Unable to create buffer during bsf"));
           }
-          if (ret > 0) {
-            /* free the buffer in pkt and replace it with the newly
-            created buffer in fpkt */
-            av_free_packet(pkt.get());
-            fpkt.buf = av_buffer_create(fpkt.data, fpkt.size, av_buffer_default_free,
-                                        nullptr, 0);
-            if (!fpkt.buf) {
-                av_free(fpkt.data);
-                DALI_FAIL(std::string("Unable to create buffer during bsf"));
-            }
-          }
-          *pkt.get() = fpkt;
         }
-        vid_decoder_->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
-                                    codecpar(stream));
+        *pkt.get() = fpkt;
+      }
+      stop = !send_packet(pkt.get());
 #endif
+    } else {
+      stop = !send_packet(pkt.get());
+    }
+    is_first_frame = false;
+    if (stop)
+      break;
+  }
+}
+
+void VideoLoaderBase::prepare_sequences(bool shuffle) {
+  int total_count = 1 + (count_ - 1) * stride_;
+
+  for (size_t i = 0; i < file_info_.size(); ++i) {
+    const auto& file = get_or_open_file(file_info_[i].video_file);
+    const auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
+
+    int start_frame = 0;
+    int end_frame = file.frame_count_;
+    float start = file_info_[i].start_time;
+    float end = file_info_[i].end_time;
+    if (start != -1 && end != -1) {
+      if (file_list_frame_num_) {
+        start_frame = start;
+        end_frame = end;
+        DALI_ENFORCE(end_frame <= file.frame_count_, "End frame number is greater than "
+            "total number of frames for file " + file_info_[i].video_file);
       } else {
-        vid_decoder_->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
-                                    codecpar(stream));
+        auto frame_rate = av_inv_q(file.frame_base_);
+        start_frame = static_cast<int>(std::ceil(start * av_q2d(frame_rate)));
+        end_frame = static_cast<int>(std::floor(end * av_q2d(frame_rate)));
+
+        DALI_ENFORCE(end_frame <= file.frame_count_, "End time is greater than video duration "
+                     "for file " + file_info_[i].video_file);
       }
-      is_first_frame = false;
     }
 
+    for (int s = start_frame; s < end_frame && s + total_count <= end_frame; s += step_) {
+      frame_starts_.emplace_back(sequence_meta{i, s, file_info_[i].label,
+                                 codecpar(stream)->height, codecpar(stream)->width});
+    }
+  }
+  DALI_ENFORCE(!frame_starts_.empty(), "There are no valid sequences in the provided "
+               "dataset, check the length of the available videos and the requested sequence "
+               "length.");
+
+  if (shuffle) {
+    // TODO(spanev) decide of a policy for multi-gpu here and SequenceLoader
+    // seeded with hardcoded value to get
+    // the same sequence on every shard
+    std::mt19937 g(kDaliDataloaderSeed);
+    std::shuffle(std::begin(frame_starts_), std::end(frame_starts_), g);
+  }
+}
+
+FrameReq VideoLoaderBase::sequence_request(std::string filename, int frame, int count) const {
+  int total_count = 1 + (count - 1) * stride_;
+  return FrameReq{std::move(filename), frame, total_count, stride_, {0, 0}};
+}
+
+void VideoLoaderBase::count_frames_used(int count) {
+  stats_.frames_used += count;
+
+  static auto frames_since_warn = 0;
+  static auto frames_used_warned = false;
+  frames_since_warn += count;
+  auto ratio_used = static_cast<float>(stats_.packets_decoded) / stats_.frames_used;
+  if (ratio_used > frames_used_warning_ratio &&
+      frames_since_warn > (frames_used_warned ? frames_used_warning_interval :
+                            frames_used_warning_minimum)) {
+    frames_since_warn = 0;
+    frames_used_warned = true;
+    LOG_LINE << "\e[1mThe video loader is performing suboptimally due to reading "
+                << std::setprecision(2) << ratio_used << "x as many packets as "
+                << "frames being used.\e[0m  Consider reencoding the video with a "
+                << "smaller key frame interval (GOP length).";
+  }
+}
+
+void VideoLoader::read_file() {
+  while (!stop_) {
+    if (stop_) {
+      break;
+    }
+
+    auto req = send_queue_.pop();
+
+    LOG_LINE << "Got a request for " << req.filename << " frame " << req.frame
+             << " count " << req.count << " send_queue_ has " << send_queue_.size()
+             << " frames left" << std::endl;
+
+    if (stop_) {
+      break;
+    }
+
+    auto& file = get_or_open_file(req.filename);
+    auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
+    req.frame_base = file.frame_base_;
+
+    if (vid_decoder_) {
+        vid_decoder_->push_req(req);
+    } else {
+        DALI_FAIL("No video decoder even after opening a file");
+    }
+
+    read_sequence_packets(file, req, [&](AVPacket* pkt) {
+      vid_decoder_->decode_packet(pkt, file.start_time_, file.stream_base_, codecpar(stream));
+      return true;
+    });
+
     // flush the decoder
     vid_decoder_->decode_packet(nullptr, 0, {0}, 0);
   }  // while not done
@@ -666,8 +766,7 @@ void VideoLoader::read_file() {
 }
 
 void VideoLoader::push_sequence_to_read(std::string filename, int frame, int count) {
-    int total_count = 1 + (count - 1) * stride_;
-    auto req = FrameReq{std::move(filename), frame, total_count, stride_, {0, 0}};
+    auto req = sequence_request(std::move(filename), frame, count);
     // give both reader thread and decoder a copy of what is coming
     send_queue_.push(req);
 }
@@ -682,23 +781,7 @@ void VideoLoader::receive_frames(SequenceWrapper& sequence) {
   }
   vid_decoder_->receive_frames(sequence);
 
-  // Stats code
-  stats_.frames_used += sequence.count;
-
-  static auto frames_since_warn = 0;
-  static auto frames_used_warned = false;
-  frames_since_warn += sequence.count;
-  auto ratio_used = static_cast<float>(stats_.packets_decoded) / stats_.frames_used;
-  if (ratio_used > frames_used_warning_ratio &&
-      frames_since_warn > (frames_used_warned ? frames_used_warning_interval :
-                            frames_used_warning_minimum)) {
-    frames_since_warn = 0;
-    frames_used_warned = true;
-    LOG_LINE << "\e[1mThe video loader is performing suboptimally due to reading "
-                << std::setprecision(2) << ratio_used << "x as many packets as "
-                << "frames being used.\e[0m  Consider reencoding the video with a "
-                << "smaller key frame interval (GOP length).";
-  }
+  count_frames_used(sequence.count);
   // We have to wait for all kernel recorded in sequence's event are completed
   LOG_LINE << "Waiting for sequence..";
   sequence.wait();
@@ -24,6 +24,7 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <random>
 #include <string>
@@ -144,36 +145,93 @@ struct sequence_meta {
 };
 
 
-class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
+/**
+ * @brief Demuxing, seeking and sequence bookkeeping shared by the video loaders
+ *
+ * It opens the files, splits them into the sequences to read and, for each sequence,
+ * reads the packets needed to decode its frames. The decoding itself is left to the loaders.
+ */
+class VideoLoaderBase {
+ public:
+  VideoLoaderBase(const OpSpec& spec, const std::vector<std::string>& filenames);
+
+  virtual ~VideoLoaderBase() = default;
+
+  VideoFile& get_or_open_file(const std::string &filename);
+  void seek(VideoFile& file, int frame);
+
+  /**
+   * @brief Describes the frames of the sequence of `count` frames starting at `frame`,
+   *        `stride_` frames apart
+   */
+  FrameReq sequence_request(std::string filename, int frame, int count) const;
+
+ protected:
+  /**
+   * @brief Whether the files can have different resolutions
+   *
+   * If they can't, opening a file with a different resolution than the previous ones fails.
+   */
+  virtual bool can_change_resolution() const = 0;
+
+  /**
+   * @brief Seeks to the key frame preceding `req.frame` and passes the (filtered) packets
+   *        to `send_packet`, until all the frames of the request are read
+   *
+   * Reading stops early when `send_packet` returns false.
+   */
+  void read_sequence_packets(VideoFile& file, const FrameReq& req,
+                             const std::function<bool(AVPacket*)>& send_packet);
+
+  /**
+   * @brief Splits the files into sequences of `count_` frames, `step_` frames apart
+   */
+  void prepare_sequences(bool shuffle);
+
+  /**
+   * @brief Updates the statistics with the frames of a decoded sequence, warning when
+   *        many more packets are decoded than frames used
+   */
+  void count_frames_used(int count);
+
+  // Params
+  std::string file_root_;
+  std::string file_list_;
+  int count_;
+  int step_;
+  int stride_;
+  int max_height_;
+  int max_width_;
+  static constexpr int channels_ = 3;
+
+  std::vector<std::string> filenames_;
+
+  int codec_id_;
+  bool skip_vfr_check_;
+  bool file_list_frame_num_;
+  VideoLoaderStats stats_;
+
+  std::unordered_map<std::string, VideoFile> open_files_;
+  std::string last_opened_;
+
+  std::vector<struct sequence_meta> frame_starts_;
+
+  std::vector<file_meta> file_info_;
+};
+
+class VideoLoader : public Loader<GPUBackend, SequenceWrapper>, public VideoLoaderBase {
  public:
   explicit inline VideoLoader(const OpSpec& spec,
     const std::vector<std::string>& filenames)
     : Loader<GPUBackend, SequenceWrapper>(spec),
-      file_root_(spec.GetArgument<std::string>("file_root")),
-      file_list_(spec.GetArgument<std::string>("file_list")),
-      count_(spec.GetArgument<int>("sequence_length")),
-      step_(spec.GetArgument<int>("step")),
-      stride_(spec.GetArgument<int>("stride")),
-      max_height_(0),
-      max_width_(0),
+      VideoLoaderBase(spec, filenames),
       additional_decode_surfaces_(spec.GetArgument<int>("additional_decode_surfaces")),
       image_type_(spec.GetArgument<DALIImageType>("image_type")),
       dtype_(spec.GetArgument<DALIDataType>("dtype")),
       normalized_(spec.GetArgument<bool>("normalized")),
-      filenames_(filenames),
       device_id_(spec.GetArgument<int>("device_id")),
-      codec_id_(0),
-      skip_vfr_check_(spec.GetArgument<bool>("skip_vfr_check")),
-      file_list_frame_num_(spec.GetArgument<bool>("file_list_frame_num")),
-      stats_({0, 0, 0, 0, 0}),
       current_frame_idx_(-1),
       stop_(false) {
-    if (step_ < 0)
-      step_ = count_ * stride_;
-
-    file_info_ = filesystem::get_file_label_pair(file_root_, filenames_, file_list_);
-    DALI_ENFORCE(!file_info_.empty(), "No files were read.");
-
     lib_handle_ = nvdecDriverHandle(cuvidInitChecked(0), cuvidDeinit);
 
     DALI_ENFORCE(lib_handle_,
@@ -200,8 +258,6 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   void PrepareEmpty(SequenceWrapper &tensor) override;
   void ReadSample(SequenceWrapper &tensor) override;
 
-  VideoFile& get_or_open_file(const std::string &filename);
-  void seek(VideoFile& file, int frame);
   void read_file();
   void push_sequence_to_read(std::string filename, int frame, int count);
   void receive_frames(SequenceWrapper& sequence);
@@ -209,43 +265,12 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
  protected:
   Index SizeImpl() override;
 
-  void PrepareMetadataImpl() override {
-    int total_count = 1 + (count_ - 1) * stride_;
-
-    for (size_t i = 0; i < file_info_.size(); ++i) {
-      const auto& file = get_or_open_file(file_info_[i].video_file);
-      const auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
-      int frame_count = file.frame_count_;
-
-      int start_frame = 0;
-      int end_frame = file.frame_count_;
-      float start = file_info_[i].start_time;
-      float end = file_info_[i].end_time;
-      if (start != -1 && end != -1) {
-        if (file_list_frame_num_) {
-          start_frame = start;
-          end_frame = end;
-          DALI_ENFORCE(end_frame <= file.frame_count_, "End frame number is greater than "
-              "total number of frames for file " + file_info_[i].video_file);
-        } else {
-          auto frame_rate = av_inv_q(file.frame_base_);
-          start_frame = static_cast<int>(std::ceil(start * av_q2d(frame_rate)));
-          end_frame = static_cast<int>(std::floor(end * av_q2d(frame_rate)));
-
-          DALI_ENFORCE(end_frame <= file.frame_count_, "End time is greater than video duration "
-                       "for file " + file_info_[i].video_file);
-        }
-      }
-
-      for (int s = start_frame; s < end_frame && s + total_count <= end_frame; s += step_) {
-        frame_starts_.emplace_back(sequence_meta{i, s, file_info_[i].label,
-                                   codecpar(stream)->height, codecpar(stream)->width});
-      }
-    }
-    DALI_ENFORCE(!frame_starts_.empty(), "There are no valid sequences in the provided "
-                 "dataset, check the length of the available videos and the requested sequence "
-                 "length.");
+  bool can_change_resolution() const override {
+    return NVCUVID_API_EXISTS(cuvidReconfigureDecoder);
+  }
 
+  void PrepareMetadataImpl() override {
+    prepare_sequences(shuffle_);
 
     const auto& file = get_or_open_file(file_info_[0].video_file);
     auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
@@ -259,14 +284,6 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
                                                ALIGN16(max_width_),
                                                additional_decode_surfaces_);
 
-    if (shuffle_) {
-      // TODO(spanev) decide of a policy for multi-gpu here and SequenceLoader
-      // seeded with hardcoded value to get
-      // the same sequence on every shard
-      std::mt19937 g(kDaliDataloaderSeed);
-      std::shuffle(std::begin(frame_starts_), std::end(frame_starts_), g);
-    }
-
     Reset(true);
 
     thread_file_reader_ = std::thread{&VideoLoader::read_file, this};
@@ -281,29 +298,13 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
     }
   }
   // Params
-  std::string file_root_;
-  std::string file_list_;
-  int count_;
-  int step_;
-  int stride_;
-  int max_height_;
-  int max_width_;
   int additional_decode_surfaces_;
-  static constexpr int channels_ = 3;
   DALIImageType image_type_;
   DALIDataType dtype_;
   bool normalized_;
 
-  std::vector<std::string> filenames_;
-
   int device_id_;
-  int codec_id_;
-  bool skip_vfr_check_;
-  bool file_list_frame_num_;
-  VideoLoaderStats stats_;
 
-  std::unordered_map<std::string, VideoFile> open_files_;
-  std::string last_opened_;
   nvdecDriverHandle lib_handle_;
   std::unique_ptr<NvDecoder> vid_decoder_;
 
@@ -311,11 +312,9 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
 
   std::thread thread_file_reader_;
 
-  std::vector<struct sequence_meta> frame_starts_;
   Index current_frame_idx_;
 
   volatile bool stop_;
-  std::vector<file_meta> file_info_;
 };
 
 }  // namespace dali
@@ -0,0 +1,180 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/video_loader_cpu.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dali {
+
+namespace {
+#undef av_err2str
+std::string av_err2str(int errnum) {
+  char errbuf[AV_ERROR_MAX_STRING_SIZE];
+  av_strerror(errnum, errbuf, AV_ERROR_MAX_STRING_SIZE);
+  return std::string{errbuf};
+}
+}  // namespace
+
+VideoLoaderCPU::VideoLoaderCPU(const OpSpec& spec, const std::vector<std::string>& filenames)
+    : Loader<CPUBackend, SequenceWrapperCPU>(spec),
+      VideoLoaderBase(spec, filenames),
+      num_threads_(spec.GetArgument<int>("num_threads")),
+      frame_(make_unique_av<AVFrame>(av_frame_alloc(), av_frame_free)),
+      sws_ctx_(nullptr, sws_freeContext),
+      current_frame_idx_(-1) {
+  DALI_ENFORCE(frame_, "Failed to allocate the frame for decoding");
+}
+
+void VideoLoaderCPU::open_decoder(VideoFile& file) {
+  if (codec_ctx_ && decoder_file_ == file.file_desc.filename) {
+    // drop whatever was left from the previous sequence
+    avcodec_flush_buffers(codec_ctx_.get());
+    return;
+  }
+  auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
+  auto codec = avcodec_find_decoder(codecpar(stream)->codec_id);
+  DALI_ENFORCE(codec, make_string("No software decoder for ", avcodec_get_name(
+               codecpar(stream)->codec_id), " in ", file.file_desc.filename));
+
+  auto codec_ctx = make_unique_av<AVCodecContext>(avcodec_alloc_context3(codec),
+                                                  avcodec_free_context);
+  DALI_ENFORCE(codec_ctx, "Failed to allocate the decoder context");
+  int ret = avcodec_parameters_to_context(codec_ctx.get(), codecpar(stream));
+  DALI_ENFORCE(ret >= 0, "Failed to set the decoder parameters: " + av_err2str(ret));
+  codec_ctx->thread_count = num_threads_;
+  codec_ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  codec_ctx->pkt_timebase = file.stream_base_;
+  ret = avcodec_open2(codec_ctx.get(), codec, nullptr);
+  DALI_ENFORCE(ret >= 0, "Failed to open the decoder: " + av_err2str(ret));
+
+  codec_ctx_ = std::move(codec_ctx);
+  decoder_file_ = file.file_desc.filename;
+}
+
+int VideoLoaderCPU::receive_frames(const VideoFile& file, const FrameReq& req,
+                                   SequenceWrapperCPU& sequence,
+                                   std::vector<bool>& frames_decoded, int frames_left) {
+  int ret;
+  while ((ret = avcodec_receive_frame(codec_ctx_.get(), frame_.get())) == 0) {
+    auto frame = frame_.get();
+    int64_t pts = frame->best_effort_timestamp;
+    if (pts == AV_NOPTS_VALUE)
+      pts = frame->pts;
+    auto frame_num = av_rescale_q(pts - file.start_time_, file.stream_base_, req.frame_base);
+
+    int idx = (frame_num - req.frame) / req.stride;
+    if (frame_num < req.frame || frame_num >= req.frame + req.count ||
+        (frame_num - req.frame) % req.stride != 0 || frames_decoded[idx]) {
+      LOG_LINE << "Ditching frame " << frame_num << " (for " << req.frame << ")\n";
+      av_frame_unref(frame);
+      continue;
+    }
+
+    const auto &shape = sequence.sequence.shape();
+    int height = shape[1], width = shape[2];
+    DALI_ENFORCE(frame->height == height && frame->width == width, make_string(
+        "The frame ", frame_num, " of ", req.filename, " has a different size (", frame->width,
+        "x", frame->height, ") than the stream (", width, "x", height, ")"));
+
+    prepare_color_conversion(width, height, static_cast<AVPixelFormat>(frame->format));
+    uint8_t *dst[4] = {sequence.sequence.mutable_data<uint8_t>() +
+                       static_cast<int64_t>(idx) * height * width * channels_};
+    int dst_linesize[4] = {width * channels_};
+    sws_scale(sws_ctx_.get(), frame->data, frame->linesize, 0, height, dst, dst_linesize);
+    sequence.timestamps[idx] = (pts - file.start_time_) * av_q2d(file.stream_base_);
+
+    frames_decoded[idx] = true;
+    frames_left--;
+    av_frame_unref(frame);
+  }
+  DALI_ENFORCE(ret == AVERROR(EAGAIN) || ret == AVERROR_EOF,
+               "Failed to decode a frame: " + av_err2str(ret));
+  return frames_left;
+}
+
+void VideoLoaderCPU::prepare_color_conversion(int width, int height, AVPixelFormat format) {
+  if (sws_ctx_ && width == sws_width_ && height == sws_height_ && format == sws_format_)
+    return;
+  sws_ctx_.reset(sws_getContext(width, height, format, width, height, AV_PIX_FMT_RGB24,
+                                SWS_BILINEAR, nullptr, nullptr, nullptr));
+  DALI_ENFORCE(sws_ctx_, "Failed to create the color conversion context");
+
+  // Use the limited range BT.601 matrix, as the GPU reader does, whatever the stream signals
+  int *inv_table, *table;
+  int src_range, dst_range, brightness, contrast, saturation;
+  if (sws_getColorspaceDetails(sws_ctx_.get(), &inv_table, &src_range, &table, &dst_range,
+                               &brightness, &contrast, &saturation) >= 0) {
+    sws_setColorspaceDetails(sws_ctx_.get(), sws_getCoefficients(SWS_CS_ITU601), 0,
+                             table, dst_range, brightness, contrast, saturation);
+  }
+  sws_width_ = width;
+  sws_height_ = height;
+  sws_format_ = format;
+}
+
+void VideoLoaderCPU::decode_sequence(VideoFile& file, const FrameReq& req,
+                                     SequenceWrapperCPU& sequence) {
+  open_decoder(file);
+
+  std::vector<bool> frames_decoded(count_, false);
+  int frames_left = count_;
+  read_sequence_packets(file, req, [&](AVPacket* pkt) {
+    int ret = avcodec_send_packet(codec_ctx_.get(), pkt);
+    DALI_ENFORCE(ret >= 0, "Failed to send a packet to the decoder: " + av_err2str(ret));
+    frames_left = receive_frames(file, req, sequence, frames_decoded, frames_left);
+    return frames_left > 0;
+  });
+
+  if (frames_left > 0) {
+    // the last frames of the sequence can still be in the decoder
+    int ret = avcodec_send_packet(codec_ctx_.get(), nullptr);
+    DALI_ENFORCE(ret >= 0, "Failed to flush the decoder: " + av_err2str(ret));
+    frames_left = receive_frames(file, req, sequence, frames_decoded, frames_left);
+  }
+  DALI_ENFORCE(frames_left == 0, make_string("Could not decode ", frames_left, " of the ",
+               count_, " frames of the sequence starting at frame ", req.frame, " of ",
+               req.filename));
+}
+
+void VideoLoaderCPU::PrepareEmpty(SequenceWrapperCPU &sequence) {
+  PrepareEmptyTensor(sequence.sequence);
+}
+
+void VideoLoaderCPU::ReadSample(SequenceWrapperCPU& sequence) {
+  auto& seq_meta = frame_starts_[current_frame_idx_];
+  auto req = sequence_request(file_info_[seq_meta.filename_idx].video_file,
+                              seq_meta.frame_idx, count_);
+  auto& file = get_or_open_file(req.filename);
+  req.frame_base = file.frame_base_;
+
+  sequence.sequence.set_type(TypeInfo::Create<uint8_t>());
+  sequence.sequence.Resize({count_, seq_meta.height, seq_meta.width, channels_});
+  sequence.timestamps.assign(count_, 0);
+  decode_sequence(file, req, sequence);
+  count_frames_used(count_);
+  ++current_frame_idx_;
+
+  sequence.label = seq_meta.label;
+  sequence.first_frame_idx = seq_meta.frame_idx;
+  MoveToNextShard(current_frame_idx_);
+}
+
+Index VideoLoaderCPU::SizeImpl() {
+  return static_cast<Index>(frame_starts_.size());
+}
+
+}  // namespace dali
@@ -0,0 +1,120 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_LOADER_CPU_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_LOADER_CPU_H_
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+#include <libswscale/swscale.h>
+}
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/video_loader.h"
+#include "dali/pipeline/data/tensor.h"
+
+namespace dali {
+
+/**
+ * @brief A sequence of frames decoded on the host
+ */
+struct SequenceWrapperCPU {
+  /// uint8 frames, laid out as FHWC
+  Tensor<CPUBackend> sequence;
+  int label = -1;
+  int first_frame_idx = -1;
+  std::vector<double> timestamps;
+};
+
+/**
+ * @brief Reads the sequences as VideoLoader does, but decodes them on the host
+ *        with the software decoders of libavcodec
+ *
+ * The sequences are decoded synchronously, in ReadSample, by a decoder using `num_threads`
+ * threads. The decoder is reused as long as the consecutive sequences come from the same file.
+ */
+class VideoLoaderCPU : public Loader<CPUBackend, SequenceWrapperCPU>, public VideoLoaderBase {
+ public:
+  VideoLoaderCPU(const OpSpec& spec, const std::vector<std::string>& filenames);
+
+  void PrepareEmpty(SequenceWrapperCPU &sequence) override;
+  void ReadSample(SequenceWrapperCPU &sequence) override;
+
+ protected:
+  Index SizeImpl() override;
+
+  bool can_change_resolution() const override {
+    return true;
+  }
+
+  void PrepareMetadataImpl() override {
+    prepare_sequences(shuffle_);
+    Reset(true);
+  }
+
+ private:
+  void Reset(bool wrap_to_shard) override {
+    if (wrap_to_shard) {
+      current_frame_idx_ = start_index(shard_id_, num_shards_, Size());
+    } else {
+      current_frame_idx_ = 0;
+    }
+  }
+
+  /**
+   * @brief Opens the decoder for the stream of `file`, unless it's already open
+   */
+  void open_decoder(VideoFile& file);
+
+  /**
+   * @brief Decodes the frames of `req` into `sequence`
+   */
+  void decode_sequence(VideoFile& file, const FrameReq& req, SequenceWrapperCPU& sequence);
+
+  /**
+   * @brief Takes the frames available in the decoder, keeping the ones belonging to `req`
+   *
+   * @return the number of frames of `req` still missing
+   */
+  int receive_frames(const VideoFile& file, const FrameReq& req, SequenceWrapperCPU& sequence,
+                     std::vector<bool>& frames_decoded, int frames_left);
+
+  /**
+   * @brief Creates the context converting the decoded frames to RGB, unless the current one
+   *        already converts frames of that size and format
+   */
+  void prepare_color_conversion(int width, int height, AVPixelFormat format);
+
+  int num_threads_;
+
+  av_unique_ptr<AVCodecContext> codec_ctx_;
+  /// the file which the stream parameters of `codec_ctx_` come from
+  std::string decoder_file_;
+  av_unique_ptr<AVFrame> frame_;
+  std::unique_ptr<SwsContext, void(*)(SwsContext*)> sws_ctx_;
+  int sws_width_ = 0, sws_height_ = 0;
+  AVPixelFormat sws_format_ = AV_PIX_FMT_NONE;
+
+  Index current_frame_idx_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_LOADER_CPU_H_
@@ -30,7 +30,9 @@ DALI_SCHEMA(MXNetReader)
       R"code(List (of length 1) containing a path to index (.idx) file.
 It is generated by the MXNet's `im2rec.py` script
 together with RecordIO file. It can also be
-generated using `rec2idx` script distributed with DALI.)code",
+generated using `rec2idx` script distributed with DALI.
+The index file can be converted with the `idx2bin` script into a binary index file,
+which is memory-mapped instead of parsed, so it loads much faster for large data sets.)code",
       DALI_STRING_VEC)
   .AddParent("LoaderBase");
 
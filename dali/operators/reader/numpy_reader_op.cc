@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "dali/kernels/transpose/transpose.h"
 #include "dali/core/static_switch.h"
@@ -24,25 +27,77 @@ namespace dali {
   (bool, uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float, float16, \
   double)
 
-void NumpyReader::TransposeHelper(Tensor<CPUBackend>& output, const Tensor<CPUBackend>& input) {
-  auto& in_shape = input.shape();
-  auto& type = input.type();
-  int n_dims = in_shape.size();
+namespace {
+
+// the transposition of an array is split between threads in chunks of at least that many bytes
+constexpr int64_t kMinTransposeTaskBytes = 1 << 20;
+
+}  // namespace
+
+void NumpyReader::TransposeHelper(Tensor<CPUBackend>& output, const Tensor<CPUBackend>& input,
+                                  int64_t begin, int64_t end) {
+  auto& in_ts = input.shape();
+  auto& out_ts = output.shape();
+  int n_dims = in_ts.size();
   std::vector<int> perm(n_dims);
-  std::vector<int64_t> out_shape(n_dims);
-  for (int i = 0; i < n_dims; ++i) {
+  for (int i = 0; i < n_dims; ++i)
     perm[i] = n_dims - i - 1;
-    out_shape[i] = in_shape[perm[i]];
-  }
-  output.Resize(out_shape, type);
-  auto input_type = type.id();
-  TensorShape<> in_ts(in_shape.begin(), in_shape.end());
-  TensorShape<> out_ts(out_shape.begin(), out_shape.end());
+  auto input_type = input.type().id();
   TYPE_SWITCH(input_type, type2id, InputType, NUMPY_ALLOWED_TYPES, (
-    kernels::Transpose(
+    kernels::TransposeTiled(
       TensorView<StorageCPU, InputType>{output.mutable_data<InputType>(), out_ts},
       TensorView<StorageCPU, const InputType>{input.data<InputType>(), in_ts},
-      make_cspan(perm));), DALI_FAIL("Input type not supported."));
+      make_cspan(perm), begin, end);), DALI_FAIL("Input type not supported."));
+}
+
+void NumpyReader::RunImpl(HostWorkspace &ws) {
+  auto &output = ws.OutputRef<CPUBackend>(0);
+  auto &tp = ws.GetThreadPool();
+
+  int64_t total_bytes = 0;
+  for (int i = 0; i < batch_size_; i++)
+    total_bytes += GetSample(i).image.nbytes();
+  // Large arrays, which would take more than their fair share of the thread pool,
+  // are transposed by multiple threads.
+  int64_t max_task_bytes = std::max(total_bytes / tp.size(), kMinTransposeTaskBytes);
+
+  for (int i = 0; i < batch_size_; i++) {
+    const auto& imfile = GetSample(i);
+    auto &image_output = output[i];
+    const auto &image = imfile.image;
+    Index image_bytes = image.nbytes();
+    bool transpose = transpose_fortran_order_ && imfile.meta == "transpose:true" &&
+                     image.shape().size() > 1;
+
+    if (!transpose) {
+      // just copy the tensor over
+      image_output.Resize(image.shape(), image.type());
+      tp.AddWork([&, i, image_bytes](int) {
+        std::memcpy(output[i].raw_mutable_data(), GetSample(i).image.raw_data(), image_bytes);
+      }, image_bytes);
+    } else {
+      // here we need to transpose the data
+      const auto &in_shape = image.shape();
+      int n_dims = in_shape.size();
+      TensorShape<> out_shape;
+      out_shape.resize(n_dims);
+      for (int d = 0; d < n_dims; d++)
+        out_shape[d] = in_shape[n_dims - 1 - d];
+      image_output.Resize(out_shape, image.type());
+
+      int64_t extent = out_shape[0];
+      int64_t num_tasks = std::min(extent, std::max<int64_t>(1, image_bytes / max_task_bytes));
+      for (int64_t t = 0; t < num_tasks; t++) {
+        int64_t begin = extent * t / num_tasks;
+        int64_t end = extent * (t + 1) / num_tasks;
+        tp.AddWork([&, i, begin, end](int) {
+          TransposeHelper(output[i], GetSample(i).image, begin, end);
+        }, image_bytes / num_tasks);
+      }
+    }
+    image_output.SetSourceInfo(image.GetSourceInfo());
+  }
+  tp.RunAll();
 }
 
 DALI_REGISTER_OPERATOR(NumpyReader, NumpyReader, CPU);
@@ -59,10 +114,30 @@ directories with numpy files in them.)code",
   .AddOptionalArg("file_filter",
       R"code(If specified, the string will be interpreted as glob string to filter
 the list of files in the sub-directories of `file_root`.)code", "*.npy")
+  .AddOptionalArg("transpose_fortran_order",
+      R"code(If true, the arrays stored in Fortran order are transposed, so that the output has
+the shape of the array as seen by NumPy.
+
+If false, such arrays are returned in their storage order, without copying them through a transpose:
+the dimensions of the output are reversed with respect to the shape of the array.)code",
+      true)
   .AddOptionalArg("shuffle_after_epoch",
       R"code(If true, reader shuffles whole dataset after each epoch. It is exclusive with
 ``stick_to_shard`` and ``random_shuffle``.)code",
       false)
+  .AddOptionalArg<std::vector<int>>("roi_start",
+      R"code(Start of the region of interest, in array coordinates (one value per dimension).
+
+If `roi_start` or `roi_shape` is specified, only the region of interest is read from the files,
+which is much faster than reading whole arrays and cropping them afterwards.
+Defaults to the beginning of the array.)code",
+      nullptr)
+  .AddOptionalArg<std::vector<int>>("roi_shape",
+      R"code(Shape of the region of interest (one value per dimension).
+
+A negative value means that the region of interest extends to the end of the array in
+that dimension. Defaults to the remainder of the array, starting at `roi_start`.)code",
+      nullptr)
   .AddParent("LoaderBase");
 
 }  // namespace dali
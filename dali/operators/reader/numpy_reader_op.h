@@ -27,39 +27,23 @@ namespace dali {
 class NumpyReader : public DataReader<CPUBackend, ImageFileWrapper > {
  public:
   explicit NumpyReader(const OpSpec& spec)
-    : DataReader< CPUBackend, ImageFileWrapper >(spec) {
+    : DataReader< CPUBackend, ImageFileWrapper >(spec),
+      transpose_fortran_order_(spec.GetArgument<bool>("transpose_fortran_order")) {
     bool shuffle_after_epoch = spec.GetArgument<bool>("shuffle_after_epoch");
     loader_ = InitLoader<NumpyLoader>(spec, std::vector<string>(),
                                       shuffle_after_epoch);
   }
 
-  void RunImpl(SampleWorkspace &ws) override {
-    const int idx = ws.data_idx();
-
-    const auto& imfile = GetSample(idx);
-
-    // copy from raw_data -> outputs directly
-    auto &image_output = ws.Output<CPUBackend>(0);
-
-    // image
-    Index image_bytes = imfile.image.nbytes();
-
-    if (imfile.meta == "transpose:false") {
-      // just copy the tensor over
-      image_output.Resize(imfile.image.shape(), imfile.image.type());
-      std::memcpy(image_output.raw_mutable_data(),
-                  imfile.image.raw_data(),
-                  image_bytes);
-    } else {
-      // here we need to transpose the data
-      TransposeHelper(image_output, imfile.image);
-    }
-    image_output.SetSourceInfo(imfile.image.GetSourceInfo());
-  }
+  void RunImpl(HostWorkspace &ws) override;
 
  protected:
-  void TransposeHelper(Tensor<CPUBackend>& output, const Tensor<CPUBackend>& input);
+  // transposes the range [begin, end) of the outermost dimension of the output
+  void TransposeHelper(Tensor<CPUBackend>& output, const Tensor<CPUBackend>& input,
+                       int64_t begin, int64_t end);
   USE_READER_OPERATOR_MEMBERS(CPUBackend, ImageFileWrapper);
+
+  // if false, Fortran-order arrays are returned in their storage order (reversed shape)
+  bool transpose_fortran_order_;
 };
 
 }  // namespace dali
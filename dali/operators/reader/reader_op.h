@@ -80,17 +80,16 @@ class DataReader : public Operator<Backend> {
   // perform the prefetching operation
   virtual void Prefetch() {
     // We actually prepare the next batch
-    TimeRange tr("DataReader::Prefetch #" + to_string(curr_batch_producer_), TimeRange::kRed);
+    TimeRange tr("DataReader::Prefetch", TimeRange::kRed, batches_produced_);
     auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
     curr_batch.reserve(Operator<Backend>::batch_size_);
     curr_batch.clear();
-    for (int i = 0; i < Operator<Backend>::batch_size_; ++i) {
-      curr_batch.push_back(loader_->ReadOne(i == 0));
-    }
+    loader_->ReadBatch(curr_batch, Operator<Backend>::batch_size_);
   }
 
   // Main prefetch work loop
   void PrefetchWorker() {
+    tracing::SetThreadName("DataReader prefetch");
     DeviceGuard g(device_id_);
     ProducerWait();
     while (!finished_) {
@@ -135,7 +134,7 @@ class DataReader : public Operator<Backend> {
     ConsumerWait();
 
     // consume batch
-    TimeRange tr("DataReader::Run #" + to_string(curr_batch_consumer_), TimeRange::kViolet);
+    TimeRange tr("DataReader::Run", TimeRange::kViolet, batches_consumed_);
 
     // This is synchronous call for CPU Backend
     Operator<Backend>::Run(ws);
@@ -248,6 +247,7 @@ class DataReader : public Operator<Backend> {
     {
       std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
       AdvanceIndex(curr_batch_producer_, producer_cycle_);
+      batches_produced_++;
     }
     consumer_.notify_all();
   }
@@ -258,8 +258,7 @@ class DataReader : public Operator<Backend> {
   }
 
   void ConsumerWait() {
-    TimeRange tr("DataReader::ConsumerWait #" + to_string(curr_batch_consumer_),
-                 TimeRange::kMagenta);
+    TimeRange tr("DataReader::ConsumerWait", TimeRange::kMagenta, batches_consumed_);
     std::unique_lock<std::mutex> prefetch_lock(prefetch_access_mutex_);
     consumer_.wait(prefetch_lock, [this]() { return finished_ || !IsPrefetchQueueEmpty(); });
     if (prefetch_error_) std::rethrow_exception(prefetch_error_);
@@ -269,6 +268,7 @@ class DataReader : public Operator<Backend> {
     {
       std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
       AdvanceIndex(curr_batch_consumer_, consumer_cycle_);
+      batches_consumed_++;
     }
     producer_.notify_one();
   }
@@ -308,6 +308,9 @@ class DataReader : public Operator<Backend> {
   int curr_batch_producer_;
   bool consumer_cycle_;
   bool producer_cycle_;
+  // number of batches prefetched and consumed so far - shown in the traces
+  int64_t batches_produced_ = 0;
+  int64_t batches_consumed_ = 0;
   int device_id_;
 
   // keep track of how many samples have been processed over all threads.
@@ -32,7 +32,10 @@ DALI_SCHEMA(_TFRecordReaderBase)
   .AddArg("index_path",
       R"code(List of paths to index files (1 index file for every TFRecord file).
 Index files may be obtained from TFRecord files using
-`tfrecord2idx` script distributed with DALI.)code",
+`tfrecord2idx` script distributed with DALI.
+The index files can be converted with the `idx2bin` script into a single binary index file,
+which is memory-mapped instead of parsed, so it loads much faster for large data sets. In this case
+the list should contain just the binary index file.)code",
       DALI_STRING_VEC);
 
 DALI_SCHEMA(_TFRecordReader)
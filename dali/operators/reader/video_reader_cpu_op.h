@@ -0,0 +1,110 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_VIDEO_READER_CPU_OP_H_
+#define DALI_OPERATORS_READER_VIDEO_READER_CPU_OP_H_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dali/operators/reader/reader_op.h"
+#include "dali/operators/reader/loader/video_loader_cpu.h"
+
+namespace dali {
+
+class VideoReaderCPU : public DataReader<CPUBackend, SequenceWrapperCPU> {
+ public:
+  explicit VideoReaderCPU(const OpSpec &spec)
+  : DataReader<CPUBackend, SequenceWrapperCPU>(spec),
+    filenames_(spec.GetRepeatedArgument<std::string>("filenames")),
+    file_root_(spec.GetArgument<std::string>("file_root")),
+    file_list_(spec.GetArgument<std::string>("file_list")),
+    enable_frame_num_(spec.GetArgument<bool>("enable_frame_num")),
+    enable_timestamps_(spec.GetArgument<bool>("enable_timestamps")) {
+    int arg_count = !filenames_.empty() + !file_root_.empty() + !file_list_.empty();
+
+    DALI_ENFORCE(arg_count == 1,
+                 "Only one of `filenames`, `file_root` or `file_list` argument "
+                 "must be specified at once");
+
+    DALI_ENFORCE(spec.GetArgument<DALIImageType>("image_type") == DALI_RGB,
+                 "Image type must be RGB for the CPU backend.");
+
+    DALI_ENFORCE(spec.GetArgument<DALIDataType>("dtype") == DALI_UINT8,
+                 "Data type must be UINT8 for the CPU backend.");
+
+    DALI_ENFORCE(!spec.GetArgument<bool>("normalized"),
+                 "Normalized output is not supported by the CPU backend.");
+
+    enable_label_output_ = !file_root_.empty() || !file_list_.empty();
+    DALI_ENFORCE(enable_label_output_ || !enable_frame_num_,
+                "frame numbers can be enabled only when "
+                "`file_list` or `file_root` argument is passed");
+    DALI_ENFORCE(enable_label_output_ || !enable_timestamps_,
+                "timestamps can be enabled only when "
+                "`file_list` or `file_root` argument is passed");
+
+    loader_ = InitLoader<VideoLoaderCPU>(spec, filenames_);
+  }
+
+  void RunImpl(SampleWorkspace &ws) override {
+    const auto &prefetched_video = GetSample(ws.data_idx());
+
+    auto &video_output = ws.Output<CPUBackend>(0);
+    video_output.set_type(TypeInfo::Create<uint8_t>());
+    video_output.Resize(prefetched_video.sequence.shape());
+    video_output.SetLayout("FHWC");
+    std::memcpy(video_output.raw_mutable_data(),
+                prefetched_video.sequence.raw_data(),
+                prefetched_video.sequence.nbytes());
+
+    if (enable_label_output_) {
+      int output_index = 1;
+      auto &label_output = ws.Output<CPUBackend>(output_index++);
+      label_output.Resize({1});
+      label_output.mutable_data<int>()[0] = prefetched_video.label;
+
+      if (enable_frame_num_) {
+        auto &frame_num_output = ws.Output<CPUBackend>(output_index++);
+        frame_num_output.Resize({1});
+        frame_num_output.mutable_data<int>()[0] = prefetched_video.first_frame_idx;
+      }
+
+      if (enable_timestamps_) {
+        auto &timestamp_output = ws.Output<CPUBackend>(output_index++);
+        const auto &timestamps = prefetched_video.timestamps;
+        timestamp_output.Resize({static_cast<int64_t>(timestamps.size())});
+        std::memcpy(timestamp_output.mutable_data<double>(),
+                    timestamps.data(),
+                    timestamps.size() * sizeof(double));
+      }
+    }
+  }
+
+ protected:
+  USE_READER_OPERATOR_MEMBERS(CPUBackend, SequenceWrapperCPU);
+
+ private:
+  std::vector<std::string> filenames_;
+  std::string file_root_;
+  std::string file_list_;
+  bool enable_frame_num_;
+  bool enable_timestamps_;
+  bool enable_label_output_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_VIDEO_READER_CPU_OP_H_
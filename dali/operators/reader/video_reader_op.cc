@@ -30,7 +30,10 @@ DALI_SCHEMA(VideoReader)
 Load and decode H264 video codec with FFmpeg and NVDECODE, NVIDIA GPU's hardware-accelerated video decoding.
 The video codecs can be contained in most of container file formats. FFmpeg is used to parse video containers.
 Returns a batch of sequences of `sequence_length` frames of shape [N, F, H, W, C] (N being the batch size and F the
-number of frames). Supports only constant frame rate videos.)code")
+number of frames). Supports only constant frame rate videos.
+
+The CPU backend decodes the videos with the software decoders of libavcodec, using `num_threads` threads,
+and supports only RGB, uint8 output.)code")
   .NumInput(0)
   .OutputFn(detail::VideoReaderOutputFn)
   .AddOptionalArg("filenames",
@@ -64,16 +67,19 @@ This option is mutually exclusive with `filenames` and `file_root`.)code",
       R"code(Additional decode surfaces to use beyond minimum required.
 This is ignored when decoder is not able to determine minimum
 number of decode surfaces, which may happen when using an older driver.
-This parameter can be used trade off memory usage with performance.)code",
+This parameter can be used trade off memory usage with performance.
+Used only by the GPU backend.)code",
       2)
   .AddOptionalArg("normalized",
-      R"code(Get output as normalized data.)code",
+      R"code(Get output as normalized data. Not supported by the CPU backend.)code",
       false)
   .AddOptionalArg("image_type",
-      R"code(The color space of the output frames (supports RGB and YCbCr).)code",
+      R"code(The color space of the output frames (supports RGB and YCbCr).
+The CPU backend supports only RGB.)code",
       DALI_RGB)
   .AddOptionalArg("dtype",
-      R"code(The data type of the output frames (supports FLOAT and UINT8).)code",
+      R"code(The data type of the output frames (supports FLOAT and UINT8).
+The CPU backend supports only UINT8.)code",
       DALI_UINT8)
   .AddOptionalArg("stride",
       R"code(Distance between consecutive frames in sequence.)code", 1u, false)
@@ -15,7 +15,9 @@
 #ifndef DALI_PIPELINE_DATA_ALLOCATOR_H_
 #define DALI_PIPELINE_DATA_ALLOCATOR_H_
 
+#include <new>
 #include "dali/core/cuda_utils.h"
+#include "dali/core/host_memory_pool.h"
 #include "dali/pipeline/operator/operator_factory.h"
 
 namespace dali {
@@ -78,6 +80,9 @@ DALI_DECLARE_OPTYPE_REGISTRY(GPUAllocator, GPUAllocator);
 
 /**
  * @brief Default CPU memory allocator.
+ *
+ * The memory comes from HostMemoryPool, so the buffers freed by one iteration of the pipeline
+ * are reused by the next one.
  */
 class CPUAllocator : public AllocatorBase {
  public:
@@ -85,11 +90,13 @@ class CPUAllocator : public AllocatorBase {
   ~CPUAllocator() override = default;
 
   void New(void **ptr, size_t bytes) override {
-    *ptr = ::operator new(bytes);
+    *ptr = HostMemoryPool::instance().Allocate(bytes);
+    if (!*ptr)
+      throw std::bad_alloc();
   }
 
   void Delete(void *ptr, size_t /* unused */) override {
-    ::operator delete(ptr);
+    HostMemoryPool::instance().Deallocate(ptr);
   }
 };
 
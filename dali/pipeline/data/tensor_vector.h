@@ -300,6 +300,21 @@ class TensorVector {
     return state_ == State::contiguous && static_cast<size_t>(views_count_) == size();
   }
 
+  /**
+   * @brief If the TensorVector uses memory that it doesn't own, either as the contiguous buffer
+   *        or in any of the samples
+   */
+  bool shares_data() const {
+    if (tl_->shares_data())
+      return true;
+    for (auto &t : tensors_) {
+      // views of the contiguous buffer are not considered
+      if (t && t->shares_data() && !std::get_deleter<ViewRefDeleter>(t->data_))
+        return true;
+    }
+    return false;
+  }
+
   /**
    * @brief Set the current state if further calls like Resize() or set_type
    *        should use TensorList or std::vector<Tensor> as backing memory
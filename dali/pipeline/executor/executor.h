@@ -15,7 +15,10 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 
+#include <shared_mutex>
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <queue>
@@ -29,6 +32,7 @@
 #include "dali/core/error_handling.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/executor/queue_policy.h"
+#include "dali/pipeline/executor/timing_stats.h"
 #include "dali/pipeline/executor/workspace_policy.h"
 #include "dali/pipeline/graph/op_graph.h"
 #include "dali/pipeline/graph/op_graph_storage.h"
@@ -51,7 +55,15 @@ struct DLL_PUBLIC ExecutorMeta {
   size_t reserved;
   size_t max_reserved;
 };
-using ExecutorMetaMap = std::unordered_map<std::string, std::vector<ExecutorMeta>>;
+
+struct DLL_PUBLIC OperatorMeta {
+  /// memory statistics of the outputs; filled only when the memory statistics are enabled
+  std::vector<ExecutorMeta> outputs;
+  OperatorTimingStats timing;
+};
+
+/// Statistics of the operators, keyed by the stage prefix ("CPU_", "MIXED_", "GPU_") and the name
+using ExecutorMetaMap = std::unordered_map<std::string, OperatorMeta>;
 
 namespace detail {
 // This is stream callback used on GPU stream to indicate that GPU work for this
@@ -78,6 +90,8 @@ class DLL_PUBLIC ExecutorBase {
   DLL_PUBLIC virtual void SetCompletionCallback(ExecutorCallback cb) = 0;
   DLL_PUBLIC virtual void EnableMemoryStats(bool enable_memory_stats = false) = 0;
   DLL_PUBLIC virtual ExecutorMetaMap GetExecutorMeta() = 0;
+  DLL_PUBLIC virtual void SetCPUOpConcurrency(int max_concurrent_ops) = 0;
+  DLL_PUBLIC virtual StageTimingStats GetStageTimingStats(OpType stage) = 0;
 
  protected:
   // virtual to allow the TestPruneWholeGraph test in gcc
@@ -113,7 +127,8 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
         gpu_op_stream_(0),
         enable_memory_stats_(false) {
     DALI_ENFORCE(batch_size_ > 0, "Batch size must be greater than 0.");
-    DALI_ENFORCE(device_id >= 0, "Device id must be non-negative.");
+    DALI_ENFORCE(device_id >= 0 || device_id == CPU_ONLY_DEVICE_ID,
+                 "Device id must be non-negative or CPU_ONLY_DEVICE_ID.");
 
     stage_queue_depths_ = QueuePolicy::GetQueueSizes(prefetch_queue_depth);
   }
@@ -132,10 +147,47 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   DLL_PUBLIC void SetCompletionCallback(ExecutorCallback cb) override;
   DLL_PUBLIC ExecutorMetaMap GetExecutorMeta() override;
 
+  /**
+   * @brief Sets how many CPU operators can run at the same time; must be called before Build
+   *
+   * With the default value of 1 the CPU operators run one after another, in topological order.
+   * Otherwise an operator is launched as soon as all the operators it consumes outputs of
+   * have finished, so independent branches of the graph run concurrently, sharing the thread
+   * pool. An operator which has to set the default layout on one of its inputs runs alone.
+   */
+  DLL_PUBLIC void SetCPUOpConcurrency(int max_concurrent_ops) override {
+    DALI_ENFORCE(max_concurrent_ops > 0,
+                 "The number of concurrent CPU operators must be positive.");
+    DALI_ENFORCE(graph_ == nullptr, "CPU operator concurrency must be set before Build.");
+    cpu_op_concurrency_ = max_concurrent_ops;
+  }
+
+  /**
+   * @brief Obtains the queue wait, run time and throughput of a stage, over the most recent
+   *        iterations; for the CPU stage, also the utilization of the thread pool and how much
+   *        the operators overlapped
+   */
+  DLL_PUBLIC StageTimingStats GetStageTimingStats(OpType stage) override {
+    auto &timing = stage_timing_[static_cast<int>(stage)];
+    std::lock_guard<std::mutex> lock(timing.mutex);
+    return timing.window.GetStats(batch_size_, stage == OpType::CPU ? thread_pool_.size() : 0);
+  }
+
   DLL_PUBLIC void ShutdownQueue() {
     QueuePolicy::SignalStop();
   }
 
+  /**
+   * @brief Whether the built graph runs without using CUDA
+   *
+   * This is the case when the graph has no GPU operators and no data on the GPU - either
+   * detected in Build, or requested with device_id = CPU_ONLY_DEVICE_ID. No streams nor events
+   * are created then and the mixed and GPU stages only pass the buffers along the queues.
+   */
+  DLL_PUBLIC bool IsCPUOnly() const {
+    return cpu_only_;
+  }
+
   DISABLE_COPY_MOVE_ASSIGN(Executor);
 
  protected:
@@ -181,7 +233,7 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
         size_t reserved_size = 0;
         size_t max_reserved_size = 0;
         std::lock_guard<std::mutex> lck(write_mutex);
-        auto &stats = memory_stats[op_name];
+        auto &stats = memory_stats[op_name].outputs;
         stats.resize(ws.NumOutput(), {0, 0});
 
         for (int i = 0; i < ws.NumOutput(); ++i) {
@@ -253,6 +305,22 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
 
   void SetupOutputQueuesForGraph();
 
+  static bool IsCPUOnlyGraph(const OpGraph &graph);
+
+  void SetupCPUOpScheduling();
+
+  // Bookkeeping of a single run of the CPU stage
+  struct CPUStageIteration {
+    int64_t index = 0;
+    std::atomic<int64_t> op_time_ns{0};
+    std::atomic<int> running_ops{0};
+    std::atomic<int> max_running_ops{0};
+  };
+
+  void RunCPUOp(QueueIdxs idxs, int cpu_op_id, CPUStageIteration &iteration);
+
+  void RunCPUOpsConcurrently(QueueIdxs idxs, CPUStageIteration &iteration);
+
   class EventList {
    public:
     inline EventList() {}
@@ -320,7 +388,7 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   ThreadPool thread_pool_;
   std::vector<std::string> errors_;
   std::mutex errors_mutex_;
-  bool exec_error_;
+  std::atomic<bool> exec_error_;
   QueueSizes queue_sizes_;
   std::vector<tensor_data_store_queue_t> tensor_to_store_queue_;
   cudaStream_t mixed_op_stream_, gpu_op_stream_;
@@ -332,26 +400,117 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
   // in some edge cases where there are no operators
   std::vector<cudaEvent_t> mixed_callback_events_;
 
+  // Set in Build when the graph can run without CUDA
+  bool cpu_only_ = false;
+
   std::atomic<bool> enable_memory_stats_;
   ExecutorMetaMap cpu_memory_stats_, mixed_memory_stats_, gpu_memory_stats_;
   std::mutex cpu_memory_stats_mutex_;
   std::mutex mixed_memory_stats_mutex_;
   std::mutex gpu_memory_stats_mutex_;
 
+  int cpu_op_concurrency_ = 1;
+  // Runs the CPU operators when they are scheduled by dependencies; null if they run in order
+  std::unique_ptr<ThreadPool> cpu_op_launcher_;
+  // CPU op id -> ids of the CPU operators consuming its outputs
+  std::vector<std::vector<int>> cpu_op_consumers_;
+  // CPU op id -> number of CPU operators producing its inputs
+  std::vector<int> cpu_op_num_producers_;
+  // Default layouts are set on the inputs, which can be shared with other operators,
+  // so the operators that need that take the lock exclusively
+  std::shared_timed_mutex cpu_input_layout_mutex_;
+
+  // Iterations run by each stage; each stage runs its iterations one after another.
+  // Shown in the traces.
+  int64_t cpu_iteration_ = 0, mixed_iteration_ = 0, gpu_iteration_ = 0;
+
+  // Each operator and each stage has its own lock, so the threads recording the timing
+  // only wait for the queries, not for each other
+  struct OpTiming {
+    std::mutex mutex;
+    TimingWindow run_time;
+  };
+  struct StageTiming {
+    std::mutex mutex;
+    StageTimingWindow window;
+  };
+  // Run times of the operators, indexed by the OpNodeId; allocated in Build
+  std::vector<OpTiming> op_timing_;
+  // Timing of the stages, indexed by OpType
+  StageTiming stage_timing_[static_cast<int>(OpType::COUNT)];
+
+  using timing_clock = std::chrono::steady_clock;
+
+  static double Seconds(timing_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  /**
+   * @param iteration the CPU stage iteration that ended; null for the other stages
+   * @param thread_pool_busy the time the thread pool was busy in this iteration (CPU stage only)
+   */
+  void RecordStageTiming(OpType stage, timing_clock::time_point acquire_start,
+                         timing_clock::time_point run_start,
+                         const CPUStageIteration *iteration = nullptr,
+                         double thread_pool_busy = 0) {
+    auto end = timing_clock::now();
+    auto &timing = stage_timing_[static_cast<int>(stage)];
+    std::lock_guard<std::mutex> lock(timing.mutex);
+    auto &window = timing.window;
+    window.queue_wait.Add(Seconds(run_start - acquire_start));
+    window.run_time.Add(Seconds(end - run_start));
+    window.end_time.Add(Seconds(end.time_since_epoch()));
+    if (iteration) {
+      window.thread_pool_busy.Add(thread_pool_busy);
+      window.op_time.Add(iteration->op_time_ns * 1e-9);
+      window.max_concurrent_ops = std::max<int>(window.max_concurrent_ops,
+                                                iteration->max_running_ops);
+    }
+  }
+
  private:
   template <typename InputRef>
-  static bool SetDefaultLayoutIfNeeded(InputRef &in, const OpSchema &schema, int in_idx) {
+  static TensorLayout DefaultLayoutIfNeeded(InputRef &in, const OpSchema &schema, int in_idx) {
     if (!in.GetLayout().empty())
-      return false;
-    auto default_layout = schema.GetInputLayout(in_idx, in.shape().sample_dim(), in.GetLayout());
+      return {};
+    return schema.GetInputLayout(in_idx, in.shape().sample_dim(), in.GetLayout());
+  }
+
+  template <typename InputRef>
+  static bool SetDefaultLayoutIfNeeded(InputRef &in, const OpSchema &schema, int in_idx) {
+    auto default_layout = DefaultLayoutIfNeeded(in, schema, in_idx);
     if (default_layout.empty())
       return false;
     in.SetLayout(default_layout);
     return true;
   }
 
+  template <typename Workspace>
+  static bool NeedsDefaultLayout(OpNode &op_node, Workspace &ws) {
+    const auto &spec = op_node.op->GetSpec();
+    const auto &schema = spec.GetSchema();
+    for (int i = 0; i < spec.NumRegularInput(); i++) {
+      bool needed = ws.template InputIsType<CPUBackend>(i)
+          ? !DefaultLayoutIfNeeded(ws.template InputRef<CPUBackend>(i), schema, i).empty()
+          : !DefaultLayoutIfNeeded(ws.template InputRef<GPUBackend>(i), schema, i).empty();
+      if (needed)
+        return true;
+    }
+    return false;
+  }
+
   template <typename Workspace>
   void RunHelper(OpNode &op_node, Workspace &ws) {
+    auto start = timing_clock::now();
+    RunHelperImpl(op_node, ws);
+    double run_time = Seconds(timing_clock::now() - start);
+    auto &timing = op_timing_[op_node.id];
+    std::lock_guard<std::mutex> lock(timing.mutex);
+    timing.run_time.Add(run_time);
+  }
+
+  template <typename Workspace>
+  void RunHelperImpl(OpNode &op_node, Workspace &ws) {
     auto &output_desc = op_node.output_desc;
     auto &op = *op_node.op;
     output_desc.clear();
@@ -410,8 +569,8 @@ class DLL_PUBLIC Executor : public ExecutorBase, public WorkspacePolicy, public
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::SetCompletionCallback(ExecutorCallback cb) {
   callback_ = cb;
-  // Create necessary events lazily
-  if (mixed_callback_events_.empty()) {
+  // Create necessary events lazily; without a device the callback is called directly
+  if (mixed_callback_events_.empty() && device_id_ != CPU_ONLY_DEVICE_ID) {
     mixed_callback_events_.resize(stage_queue_depths_[OpType::MIXED]);
     for (auto &event : mixed_callback_events_) {
       event = event_pool_.GetEvent();
@@ -425,6 +584,20 @@ ExecutorMetaMap Executor<WorkspacePolicy, QueuePolicy>::GetExecutorMeta() {
   detail::AppendToMap(ret, cpu_memory_stats_, cpu_memory_stats_mutex_);
   detail::AppendToMap(ret, mixed_memory_stats_, mixed_memory_stats_mutex_);
   detail::AppendToMap(ret, gpu_memory_stats_, gpu_memory_stats_mutex_);
+  if (graph_) {
+    for (OpType stage : {OpType::CPU, OpType::MIXED, OpType::GPU}) {
+      const char *prefix = stage == OpType::CPU   ? "CPU_"
+                         : stage == OpType::MIXED ? "MIXED_"
+                                                  : "GPU_";
+      for (int i = 0; i < graph_->NumOp(stage); i++) {
+        auto &op_node = graph_->Node(stage, i);
+        auto &timing = op_timing_[op_node.id];
+        std::lock_guard<std::mutex> lock(timing.mutex);
+        ret[prefix + op_node.instance_name].timing =
+            GetOperatorTimingStats(timing.run_time, batch_size_);
+      }
+    }
+  }
   return ret;
 }
 
@@ -442,9 +615,15 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
   // Remove any node from the graph whose output
   // will not be used as an output or by another node
   PruneUnusedGraphNodes();
+  op_timing_ = std::vector<OpTiming>(graph_->NumOp());
 
   // Check if graph is ok for execution
   CheckGraphConstraints(*graph_);
+
+  cpu_only_ = IsCPUOnlyGraph(*graph_);
+  DALI_ENFORCE(cpu_only_ || device_id_ != CPU_ONLY_DEVICE_ID,
+               "The graph contains GPU operators or produces data on the GPU, which is not "
+               "possible with device_id = CPU_ONLY_DEVICE_ID.");
   // Clear the old data
   tensor_to_store_queue_.clear();
 
@@ -456,7 +635,7 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
   // Create corresponding storage type for TensorNodes in graph
   tensor_to_store_queue_ = CreateBackingStorageForTensorNodes(*graph_, batch_size_, queue_sizes);
   // Setup stream and events that will be used for execution
-  {
+  if (!cpu_only_) {
     DeviceGuard g(device_id_);
     mixed_op_stream_ = stream_pool_.GetStream();
     gpu_op_stream_ = stream_pool_.GetStream();
@@ -485,6 +664,33 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
 
   // Producer-consumer queues info
   SetupOutputQueuesForGraph();
+
+  SetupCPUOpScheduling();
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupCPUOpScheduling() {
+  int num_cpu_ops = graph_->NumOp(OpType::CPU);
+  cpu_op_consumers_.assign(num_cpu_ops, {});
+  cpu_op_num_producers_.assign(num_cpu_ops, 0);
+  cpu_op_launcher_.reset();
+  if (cpu_op_concurrency_ <= 1 || num_cpu_ops <= 1)
+    return;
+
+  for (int cpu_op_id = 0; cpu_op_id < num_cpu_ops; cpu_op_id++) {
+    const OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
+    for (OpNodeId child : op_node.children) {
+      if (graph_->NodeType(child) != OpType::CPU)
+        continue;
+      int consumer = graph_->NodeIdx(child);
+      cpu_op_consumers_[cpu_op_id].push_back(consumer);
+      cpu_op_num_producers_[consumer]++;
+    }
+  }
+  // The operators' own work goes to thread_pool_ - this one only runs the operators
+  cpu_op_launcher_ = std::make_unique<ThreadPool>(std::min(cpu_op_concurrency_, num_cpu_ops),
+                                                  device_id_, false,
+                                                  ThreadPoolMode::PriorityQueue);
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
@@ -493,63 +699,145 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPU() {
 
   DeviceGuard g(device_id_);
 
+  auto acquire_start = timing_clock::now();
   auto cpu_idxs = QueuePolicy::AcquireIdxs(OpType::CPU);
   if (exec_error_ || QueuePolicy::IsStopSignaled() || !QueuePolicy::AreValid(cpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
     return;
   }
 
-  // Run the cpu-ops in the thread
-  // Process each CPU Op in batch
-  for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU); ++cpu_op_id) {
-    OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
-    typename WorkspacePolicy::template ws_t<OpType::CPU> ws =
-        WorkspacePolicy::template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
-    TimeRange tr("[Executor] Run CPU op " + op_node.instance_name, TimeRange::kBlue1);
-
-    try {
-      RunHelper(op_node, ws);
-      FillStats(cpu_memory_stats_, ws, "CPU_" + op_node.instance_name, cpu_memory_stats_mutex_);
-    } catch (std::exception &e) {
-      HandleError("CPU", op_node, e.what());
-    } catch (...) {
-      HandleError();
+  auto stage_start = std::chrono::steady_clock::now();
+  int64_t busy_start = thread_pool_.GetBusyTime();
+  CPUStageIteration iteration;
+  iteration.index = cpu_iteration_++;
+  if (cpu_op_launcher_) {
+    RunCPUOpsConcurrently(cpu_idxs, iteration);
+  } else {
+    // Run the cpu-ops in the thread
+    // Process each CPU Op in batch
+    for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU); ++cpu_op_id) {
+      RunCPUOp(cpu_idxs, cpu_op_id, iteration);
     }
   }
+  RecordStageTiming(OpType::CPU, acquire_start, stage_start, &iteration,
+                    (thread_pool_.GetBusyTime() - busy_start) * 1e-9);
 
   // Pass the work to the mixed stage
   QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUOp(QueueIdxs idxs, int cpu_op_id,
+                                                      CPUStageIteration &iteration) {
+  OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
+  typename WorkspacePolicy::template ws_t<OpType::CPU> ws =
+      WorkspacePolicy::template GetWorkspace<OpType::CPU>(idxs, *graph_, cpu_op_id);
+  TimeRange tr("[Executor] Run CPU op", op_node.instance_name, TimeRange::kBlue1,
+               iteration.index);
+
+  int running = ++iteration.running_ops;
+  int max_running = iteration.max_running_ops;
+  while (running > max_running &&
+         !iteration.max_running_ops.compare_exchange_weak(max_running, running)) {}
+  auto start = std::chrono::steady_clock::now();
+
+  try {
+    if (cpu_op_launcher_) {
+      bool exclusive;
+      {
+        std::shared_lock<std::shared_timed_mutex> lock(cpu_input_layout_mutex_);
+        exclusive = NeedsDefaultLayout(op_node, ws);
+      }
+      if (exclusive) {
+        std::unique_lock<std::shared_timed_mutex> lock(cpu_input_layout_mutex_);
+        RunHelper(op_node, ws);
+      } else {
+        std::shared_lock<std::shared_timed_mutex> lock(cpu_input_layout_mutex_);
+        RunHelper(op_node, ws);
+      }
+    } else {
+      RunHelper(op_node, ws);
+    }
+    FillStats(cpu_memory_stats_, ws, "CPU_" + op_node.instance_name, cpu_memory_stats_mutex_);
+  } catch (std::exception &e) {
+    HandleError("CPU", op_node, e.what());
+  } catch (...) {
+    HandleError();
+  }
+
+  iteration.op_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  --iteration.running_ops;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUOpsConcurrently(QueueIdxs idxs,
+                                                                   CPUStageIteration &iteration) {
+  int num_cpu_ops = cpu_op_num_producers_.size();
+  std::unique_ptr<std::atomic<int>[]> pending_producers(new std::atomic<int>[num_cpu_ops]);
+  for (int cpu_op_id = 0; cpu_op_id < num_cpu_ops; cpu_op_id++)
+    pending_producers[cpu_op_id] = cpu_op_num_producers_[cpu_op_id];
+
+  // Runs the operator and then launches the consumers for which it was the last producer.
+  // The work is added before the launching work finishes, so WaitForWork covers all of it.
+  std::function<void(int)> launch = [&](int cpu_op_id) {
+    cpu_op_launcher_->DoWorkWithID([&, cpu_op_id](int) {
+      RunCPUOp(idxs, cpu_op_id, iteration);
+      for (int consumer : cpu_op_consumers_[cpu_op_id]) {
+        if (--pending_producers[consumer] == 0)
+          launch(consumer);
+      }
+    }, -cpu_op_id);  // prefer the topological order
+  };
+
+  try {
+    for (int cpu_op_id = 0; cpu_op_id < num_cpu_ops; cpu_op_id++) {
+      if (cpu_op_num_producers_[cpu_op_id] == 0)
+        launch(cpu_op_id);
+    }
+    cpu_op_launcher_->WaitForWork();
+  } catch (std::exception &e) {
+    cpu_op_launcher_->WaitForWork(false);
+    HandleError(e.what());
+  }
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunMixed() {
   TimeRange tr("[Executor] RunMixed");
   DeviceGuard g(device_id_);
 
+  auto acquire_start = timing_clock::now();
   auto mixed_idxs = QueuePolicy::AcquireIdxs(OpType::MIXED);
   if (exec_error_ || QueuePolicy::IsStopSignaled() || !QueuePolicy::AreValid(mixed_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs);
     return;
   }
+  auto run_start = timing_clock::now();
 
   // Enforce our assumed dependency between consecutive
   // iterations of a stage of the pipeline.
-  CUDA_CALL(cudaEventSynchronize(mixed_stage_event_));
+  if (!cpu_only_) {
+    CUDA_CALL(cudaEventSynchronize(mixed_stage_event_));
+  }
+  int64_t iteration = mixed_iteration_++;
 
     for (int i = 0; i < graph_->NumOp(OpType::MIXED); ++i) {
       OpNode &op_node = graph_->Node(OpType::MIXED, i);
       try {
         typename WorkspacePolicy::template ws_t<OpType::MIXED> ws =
             WorkspacePolicy::template GetWorkspace<OpType::MIXED>(mixed_idxs, *graph_, i);
-        TimeRange tr("[Executor] Run Mixed op " + op_node.instance_name,
-            TimeRange::kOrange);
+        TimeRange tr("[Executor] Run Mixed op", op_node.instance_name, TimeRange::kOrange,
+                     iteration);
         RunHelper(op_node, ws);
         FillStats(mixed_memory_stats_, ws,  "MIXED_" + op_node.instance_name,
                   mixed_memory_stats_mutex_);
         if (ws.has_stream() && ws.has_event()) {
           CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
         }
-        CUDA_CALL(cudaGetLastError());
+        if (!cpu_only_) {
+          CUDA_CALL(cudaGetLastError());
+        }
       } catch (std::exception &e) {
         HandleError("Mixed", op_node, e.what());
       } catch (...) {
@@ -557,19 +845,23 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunMixed() {
       }
     }
 
-  if (callback_) {
-    // Record event that will allow to call the callback after whole run of this pipeline is
-    // finished.
-    CUDA_CALL(cudaEventRecord(mixed_callback_events_[mixed_idxs[OpType::MIXED]], mixed_op_stream_));
-  }
+  if (!cpu_only_) {
+    if (callback_) {
+      // Record event that will allow to call the callback after whole run of this pipeline is
+      // finished.
+      CUDA_CALL(cudaEventRecord(mixed_callback_events_[mixed_idxs[OpType::MIXED]],
+                                mixed_op_stream_));
+    }
 
-  if (!mixed_output_events_.empty()) {
-    int queue_id = mixed_idxs[OpType::MIXED];
-    CUDA_CALL(cudaEventRecord(mixed_output_events_.GetEvent(queue_id), mixed_op_stream_));
-  }
+    if (!mixed_output_events_.empty()) {
+      int queue_id = mixed_idxs[OpType::MIXED];
+      CUDA_CALL(cudaEventRecord(mixed_output_events_.GetEvent(queue_id), mixed_op_stream_));
+    }
 
-  // We know that this is the proper stream, we do not need to look it up in any workspace
-  CUDA_CALL(cudaEventRecord(mixed_stage_event_, mixed_op_stream_));
+    // We know that this is the proper stream, we do not need to look it up in any workspace
+    CUDA_CALL(cudaEventRecord(mixed_stage_event_, mixed_op_stream_));
+  }
+  RecordStageTiming(OpType::MIXED, acquire_start, run_start);
 
   // Pass the work to the gpu stage
   QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs, mixed_op_stream_);
@@ -579,16 +871,28 @@ template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunGPU() {
   TimeRange tr("[Executor] RunGPU");
 
+  auto acquire_start = timing_clock::now();
   auto gpu_idxs = QueuePolicy::AcquireIdxs(OpType::GPU);
   if (exec_error_ || QueuePolicy::IsStopSignaled() || !QueuePolicy::AreValid(gpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::GPU, gpu_idxs);
     return;
   }
+  auto run_start = timing_clock::now();
   DeviceGuard g(device_id_);
 
+  if (cpu_only_) {
+    // There is no GPU work - the outputs of the mixed stage are ready
+    if (callback_)
+      callback_();
+    RecordStageTiming(OpType::GPU, acquire_start, run_start);
+    QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
+    return;
+  }
+
   // Enforce our assumed dependency between consecutive
   // iterations of a stage of the pipeline.
   CUDA_CALL(cudaEventSynchronize(gpu_stage_event_));
+  int64_t iteration = gpu_iteration_++;
 
     for (int i = 0; i < graph_->NumOp(OpType::GPU); ++i) {
       OpNode &op_node = graph_->Node(OpType::GPU, i);
@@ -601,8 +905,8 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPU() {
           CUDA_CALL(cudaStreamWaitEvent(ws.stream(), event, 0));
         }
 
-        TimeRange tr("[Executor] Run GPU op " + op_node.instance_name,
-            TimeRange::knvGreen);
+        TimeRange tr("[Executor] Run GPU op", op_node.instance_name, TimeRange::knvGreen,
+                     iteration);
         RunHelper(op_node, ws);
         FillStats(gpu_memory_stats_, ws, "GPU_" + op_node.instance_name, gpu_memory_stats_mutex_);
         if (ws.has_event()) {
@@ -636,6 +940,7 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPU() {
 
   // We know that this is the proper stream, we do not need to look it up in any workspace
   CUDA_CALL(cudaEventRecord(gpu_stage_event_, gpu_op_stream_));
+  RecordStageTiming(OpType::GPU, acquire_start, run_start);
 
   // We do not release, but handle to used outputs
   QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
@@ -807,6 +1112,20 @@ std::vector<int> Executor<WorkspacePolicy, QueuePolicy>::GetTensorQueueSizes(con
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::PrepinData(
     std::vector<tensor_data_store_queue_t> &tensor_to_store_queue, const OpGraph &graph) {
+  if (cpu_only_) {
+    // The host outputs of the mixed stage are pinned by default, which requires a device
+    for (int i = 0; i < graph.NumOp(OpType::MIXED); i++) {
+      auto &node = graph.Node(OpType::MIXED, i);
+      for (auto tid : node.children_tensors) {
+        auto &queue = get_queue<OpType::MIXED, StorageDevice::CPU>(tensor_to_store_queue[tid]);
+        for (auto &tensor : queue) {
+          tensor->set_pinned(false);
+        }
+      }
+    }
+    return;
+  }
+
   // We only pin what we need
   for (int i = 0; i < graph.NumOp(OpType::MIXED); i++) {
     auto &node = graph.Node(OpType::MIXED, i);
@@ -886,6 +1205,18 @@ std::vector<int> Executor<WorkspacePolicy, QueuePolicy>::GetMemoryHints(const Op
   return hints;
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::IsCPUOnlyGraph(const OpGraph &graph) {
+  if (graph.NumOp(OpType::GPU) > 0)
+    return false;
+  // Mixed operators are allowed as long as they keep the data on the host (MakeContiguous)
+  for (int i = 0; i < graph.NumTensor(); i++) {
+    if (graph.Tensor(i).producer.storage_device != StorageDevice::CPU)
+      return false;
+  }
+  return true;
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::SetupOutputQueuesForGraph() {
   QueuePolicy::InitializeQueues(stage_queue_depths_);
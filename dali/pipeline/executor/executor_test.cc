@@ -14,8 +14,13 @@
 
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "dali/test/dali_test_decoder.h"
 #include "dali/pipeline/executor/executor.h"
@@ -499,6 +504,311 @@ TYPED_TEST(ExecutorTest, TestRunBasicGraphWithCB) {
   ASSERT_TRUE(ws.OutputIsType<CPUBackend>(0));
 }
 
+TYPED_TEST(ExecutorTest, TestRunCPUOnlyGraph) {
+  auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, CPU_ONLY_DEVICE_ID, 1);
+  exe->Init();
+
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddArg("device_id", CPU_ONLY_DEVICE_ID)
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ImageDecoder")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("images", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("images", "cpu")
+          .AddOutput("final_images", "cpu")), "");
+
+  vector<string> outputs = {"final_images_cpu"};
+  int cb_counter = 0;
+  exe->SetCompletionCallback([&cb_counter]() { ++cb_counter; });
+  exe->Build(&graph, outputs);
+  ASSERT_TRUE(exe->IsCPUOnly());
+
+  auto *src_op =
+      dynamic_cast<ExternalSource<CPUBackend> *>(graph.Node(OpType::CPU, 0).op.get());
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  tl.set_pinned(false);
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+
+  for (int iter = 0; iter < 3; iter++) {
+    src_op->SetDataSource(tl);
+    exe->RunCPU();
+    exe->RunMixed();
+    exe->RunGPU();
+
+    DeviceWorkspace ws;
+    exe->Outputs(&ws);
+    ASSERT_EQ(ws.NumOutput(), 1);
+    ASSERT_TRUE(ws.OutputIsType<CPUBackend>(0));
+    auto &res = ws.Output<CPUBackend>(0);
+    EXPECT_FALSE(res.is_pinned());
+    for (int i = 0; i < this->batch_size_; ++i) {
+      this->VerifyDecode(res.template tensor<uint8>(i), res.tensor_shape(i)[0],
+                         res.tensor_shape(i)[1], i);
+    }
+  }
+  // No GPU work, so the callback is called by the executor thread before the outputs are ready
+  EXPECT_EQ(cb_counter, 3);
+}
+
+TYPED_TEST(ExecutorTest, TestRunConcurrentCPUOps) {
+  auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, CPU_ONLY_DEVICE_ID, 1);
+  exe->Init();
+  exe->SetCPUOpConcurrency(2);
+
+  // two independent branches decoding the same data
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddArg("device_id", CPU_ONLY_DEVICE_ID)
+          .AddOutput("data", "cpu")), "");
+
+  for (const char *branch : { "a", "b" }) {
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ImageDecoder")
+            .AddArg("device", "cpu")
+            .AddInput("data", "cpu")
+            .AddOutput(make_string("images_", branch), "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("MakeContiguous")
+            .AddArg("device", "mixed")
+            .AddInput(make_string("images_", branch), "cpu")
+            .AddOutput(make_string("final_images_", branch), "cpu")), "");
+  }
+
+  vector<string> outputs = {"final_images_a_cpu", "final_images_b_cpu"};
+  exe->SetCompletionCallback([]() {});
+  exe->Build(&graph, outputs);
+  EXPECT_THROW(exe->SetCPUOpConcurrency(1), std::runtime_error);
+
+  auto *src_op =
+      dynamic_cast<ExternalSource<CPUBackend> *>(graph.Node(OpType::CPU, 0).op.get());
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  tl.set_pinned(false);
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+
+  const int kIters = 3;
+  for (int iter = 0; iter < kIters; iter++) {
+    src_op->SetDataSource(tl);
+    exe->RunCPU();
+    exe->RunMixed();
+    exe->RunGPU();
+
+    DeviceWorkspace ws;
+    exe->Outputs(&ws);
+    ASSERT_EQ(ws.NumOutput(), 2);
+    for (int out = 0; out < 2; out++) {
+      auto &res = ws.Output<CPUBackend>(out);
+      for (int i = 0; i < this->batch_size_; ++i) {
+        this->VerifyDecode(res.template tensor<uint8>(i), res.tensor_shape(i)[0],
+                           res.tensor_shape(i)[1], i);
+      }
+    }
+  }
+
+  auto stats = exe->GetStageTimingStats(OpType::CPU);
+  EXPECT_EQ(stats.iterations, kIters);
+  EXPECT_GT(stats.op_overlap, 0);
+  EXPECT_GT(stats.mean_run_time, 0);
+  // the decoders may or may not have overlapped, but the source always runs alone
+  EXPECT_GE(stats.max_concurrent_ops, 1);
+  EXPECT_LE(stats.max_concurrent_ops, 2);
+}
+
+TYPED_TEST(ExecutorTest, TestSequentialCPUOpsStats) {
+  auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, CPU_ONLY_DEVICE_ID, 1);
+  exe->Init();
+
+  OpGraph graph;
+  for (const char *branch : { "a", "b" }) {
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("DummyOp")
+            .AddArg("device", "cpu")
+            .AddArg("num_outputs", 1)
+            .AddOutput(make_string("data_", branch), "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("MakeContiguous")
+            .AddArg("device", "mixed")
+            .AddInput(make_string("data_", branch), "cpu")
+            .AddOutput(make_string("data_cont_", branch), "cpu")), "");
+  }
+
+  exe->SetCompletionCallback([]() {});
+  exe->Build(&graph, {"data_cont_a_cpu", "data_cont_b_cpu"});
+  EXPECT_EQ(exe->GetStageTimingStats(OpType::CPU).iterations, 0);
+  exe->RunCPU();
+  exe->RunMixed();
+  exe->RunGPU();
+  DeviceWorkspace ws;
+  exe->Outputs(&ws);
+
+  auto stats = exe->GetStageTimingStats(OpType::CPU);
+  EXPECT_EQ(stats.iterations, 1);
+  EXPECT_EQ(stats.max_concurrent_ops, 1);
+  EXPECT_LE(stats.op_overlap, 1);
+}
+
+namespace {
+
+// The events of TestConcurrentCPUOpsWaitForOwnWork, in the order they happened
+std::mutex branch_events_mutex;
+std::vector<std::string> branch_events;
+std::atomic<bool> slow_branch_started{false};
+
+void RecordBranchEvent(const std::string &event) {
+  std::lock_guard<std::mutex> lock(branch_events_mutex);
+  branch_events.push_back(event);
+}
+
+}  // namespace
+
+/**
+ * @brief Runs its per-sample work in the thread pool; the slow one adds a long task,
+ *        the fast one starts its work only once the long task is running.
+ */
+class ThreadPoolBranchOp : public Operator<CPUBackend> {
+ public:
+  explicit ThreadPoolBranchOp(const OpSpec &spec)
+      : Operator<CPUBackend>(spec), slow_(spec.GetArgument<bool>("slow")) {}
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    output_desc.resize(1);
+    output_desc[0] = {uniform_list_shape(batch_size_, {1}), TypeTable::GetTypeInfo(DALI_INT32)};
+    return true;
+  }
+
+  void RunImpl(HostWorkspace &ws) override {
+    auto &tp = ws.GetThreadPool();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    if (slow_) {
+      tp.AddWork([](int) {
+        slow_branch_started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        RecordBranchEvent("slow work done");
+      });
+    } else {
+      while (!slow_branch_started && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    }
+    auto &out = ws.OutputRef<CPUBackend>(0);
+    for (int i = 0; i < batch_size_; i++) {
+      tp.AddWork([&out, i](int) {
+        *out[i].mutable_data<int>() = i;
+      });
+    }
+    tp.RunAll();
+    RecordBranchEvent(slow_ ? "slow op done" : "fast op done");
+  }
+
+ private:
+  bool slow_;
+};
+
+DALI_REGISTER_OPERATOR(ThreadPoolBranchOp, ThreadPoolBranchOp, CPU);
+
+DALI_SCHEMA(ThreadPoolBranchOp)
+    .DocStr("ThreadPoolBranchOp")
+    .NumInput(0)
+    .NumOutput(1)
+    .AddOptionalArg("slow", "Whether the operator adds a long task", false);
+
+TYPED_TEST(ExecutorTest, TestConcurrentCPUOpsWaitForOwnWork) {
+  auto exe = this->GetExecutor(this->batch_size_, 2, CPU_ONLY_DEVICE_ID, 1);
+  exe->Init();
+  exe->SetCPUOpConcurrency(2);
+
+  OpGraph graph;
+  for (const char *branch : { "slow", "fast" }) {
+    graph.AddOp(OpSpec("ThreadPoolBranchOp")
+            .AddArg("batch_size", this->batch_size_)
+            .AddArg("num_threads", 2)
+            .AddArg("device", "cpu")
+            .AddArg("slow", branch == std::string("slow"))
+            .AddOutput(make_string("data_", branch), "cpu"), "");
+
+    graph.AddOp(OpSpec("MakeContiguous")
+            .AddArg("batch_size", this->batch_size_)
+            .AddArg("num_threads", 2)
+            .AddArg("device", "mixed")
+            .AddInput(make_string("data_", branch), "cpu")
+            .AddOutput(make_string("data_cont_", branch), "cpu"), "");
+  }
+
+  branch_events.clear();
+  slow_branch_started = false;
+  exe->SetCompletionCallback([]() {});
+  exe->Build(&graph, {"data_cont_slow_cpu", "data_cont_fast_cpu"});
+  exe->RunCPU();
+  exe->RunMixed();
+  exe->RunGPU();
+  DeviceWorkspace ws;
+  exe->Outputs(&ws);
+
+  // the fast operator doesn't wait for the work of the slow one
+  std::vector<std::string> expected = { "fast op done", "slow work done", "slow op done" };
+  EXPECT_EQ(branch_events, expected);
+  EXPECT_EQ(exe->GetStageTimingStats(OpType::CPU).max_concurrent_ops, 2);
+}
+
+TYPED_TEST(ExecutorTest, TestCPUOnlyDetected) {
+  auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, 0, 1);
+  exe->Init();
+
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("DummyOp")
+          .AddArg("device", "cpu")
+          .AddArg("num_outputs", 1)
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("data", "cpu")
+          .AddOutput("data_cont", "cpu")), "");
+
+  exe->Build(&graph, {"data_cont_cpu"});
+  EXPECT_TRUE(exe->IsCPUOnly());
+}
+
+TYPED_TEST(ExecutorTest, TestCPUOnlyWithGPUOps) {
+  auto exe = this->GetExecutor(this->batch_size_, this->num_threads_, CPU_ONLY_DEVICE_ID, 1);
+  exe->Init();
+
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("DummyOp")
+          .AddArg("device", "cpu")
+          .AddArg("num_outputs", 1)
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("data", "cpu")
+          .AddOutput("data", "gpu")), "");
+
+  EXPECT_THROW(exe->Build(&graph, {"data_gpu"}), std::runtime_error);
+}
+
 // This test does not work with Async Executors
 TYPED_TEST(ExecutorSyncTest, TestPrefetchedExecution) {
   int batch_size = this->batch_size_ / 2;
@@ -282,9 +282,14 @@ struct SeparateQueuePolicy {
     int current_stage = static_cast<int>(stage);
     // TODO(klecki) when we move to CUDA 10, we should move to cudaLaunchHostFunc
     if (stage == OpType::MIXED) {
-      auto &command = cpu_release_commands_[idxs[OpType::CPU]];
-      command = detail::ReleaseCommand{this, OpType::CPU, idxs[OpType::CPU]};
-      cudaStreamAddCallback(stage_stream, &detail::release_callback, &command, 0);
+      if (stage_stream) {
+        auto &command = cpu_release_commands_[idxs[OpType::CPU]];
+        command = detail::ReleaseCommand{this, OpType::CPU, idxs[OpType::CPU]};
+        cudaStreamAddCallback(stage_stream, &detail::release_callback, &command, 0);
+      } else {
+        // No stream - the mixed stage ran on the host and is done with the CPU buffers
+        ReleaseStageIdx(OpType::CPU, idxs[OpType::CPU]);
+      }
     }
     {
       std::lock_guard<std::mutex> ready_current_lock(stage_ready_mutex_[current_stage]);
@@ -0,0 +1,196 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_TIMING_STATS_H_
+#define DALI_PIPELINE_EXECUTOR_TIMING_STATS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+/**
+ * @brief Wall time of an operator, over the most recent iterations
+ */
+struct DLL_PUBLIC OperatorTimingStats {
+  /// number of iterations the operator has run
+  int64_t iterations = 0;
+  /// number of the most recent iterations the statistics below are calculated over
+  int window = 0;
+  /// wall time of a run, in seconds
+  double min_time = 0, mean_time = 0, p50_time = 0, p99_time = 0;
+  /// batch size divided by the mean run time
+  double samples_per_sec = 0;
+};
+
+/**
+ * @brief Timing of a stage of the executor (CPU, mixed or GPU), over the most recent iterations
+ */
+struct DLL_PUBLIC StageTimingStats {
+  /// number of iterations the stage has run
+  int64_t iterations = 0;
+  /// number of the most recent iterations the statistics below are calculated over
+  int window = 0;
+  /// time spent waiting for the outputs of the previous stage or for free buffers, in seconds
+  double mean_queue_wait = 0, max_queue_wait = 0;
+  /// wall time of the stage, excluding the waiting, in seconds
+  double mean_run_time = 0;
+  /// throughput of the stage, from the intervals between the ends of its iterations
+  double samples_per_sec = 0;
+  /// fraction of the run time of the stage in which the threads of the pool were busy;
+  /// CPU stage only
+  double thread_pool_utilization = 0;
+  /// average number of operators running at the same time: the sum of the run times of the
+  /// operators divided by the run time of the stage; close to 1 when the operators run one
+  /// after another; CPU stage only
+  double op_overlap = 0;
+  /// the largest number of operators that were running at the same time, over all the
+  /// iterations; CPU stage only
+  int max_concurrent_ops = 0;
+};
+
+/**
+ * @brief Keeps the most recent values (e.g. run times) and calculates their statistics
+ */
+class TimingWindow {
+ public:
+  static constexpr int kDefaultCapacity = 256;
+
+  explicit TimingWindow(int capacity = kDefaultCapacity) : values_(capacity) {
+    DALI_ENFORCE(capacity > 0, "The capacity of the window must be positive.");
+  }
+
+  void Add(double value) {
+    values_[count_ % values_.size()] = value;
+    count_++;
+  }
+
+  /// The number of values added so far
+  int64_t count() const {
+    return count_;
+  }
+
+  /// The number of values in the window
+  int size() const {
+    return std::min<int64_t>(count_, values_.size());
+  }
+
+  /// The most recently added value, 0 if none
+  double last() const {
+    return count_ ? values_[(count_ - 1) % values_.size()] : 0;
+  }
+
+  /// The value added `n` values before the last one; `n` must be less than size()
+  double recent(int n) const {
+    return values_[(count_ - 1 - n) % values_.size()];
+  }
+
+  double Min() const {
+    return size() ? *std::min_element(values_.begin(), values_.begin() + size()) : 0;
+  }
+
+  double Max() const {
+    return size() ? *std::max_element(values_.begin(), values_.begin() + size()) : 0;
+  }
+
+  double Mean() const {
+    int n = size();
+    double sum = 0;
+    for (int i = 0; i < n; i++)
+      sum += values_[i];
+    return n ? sum / n : 0;
+  }
+
+  /**
+   * @brief The smallest value that is not less than `p` percent of the values in the window
+   *        (nearest rank); 0 if the window is empty
+   */
+  double Percentile(double p) const {
+    int n = size();
+    if (n == 0)
+      return 0;
+    std::vector<double> tmp(values_.begin(), values_.begin() + n);
+    int rank = std::ceil(p / 100 * n);
+    int idx = std::min(std::max(rank - 1, 0), n - 1);
+    std::nth_element(tmp.begin(), tmp.begin() + idx, tmp.end());
+    return tmp[idx];
+  }
+
+ private:
+  std::vector<double> values_;
+  int64_t count_ = 0;
+};
+
+/**
+ * @brief Calculates the statistics of the run times (in seconds) of an operator
+ */
+inline OperatorTimingStats GetOperatorTimingStats(const TimingWindow &run_times, int batch_size) {
+  OperatorTimingStats stats;
+  stats.iterations = run_times.count();
+  stats.window = run_times.size();
+  stats.min_time = run_times.Min();
+  stats.mean_time = run_times.Mean();
+  stats.p50_time = run_times.Percentile(50);
+  stats.p99_time = run_times.Percentile(99);
+  stats.samples_per_sec = stats.mean_time > 0 ? batch_size / stats.mean_time : 0;
+  return stats;
+}
+
+/**
+ * @brief Timing of the iterations of a stage
+ */
+struct StageTimingWindow {
+  TimingWindow queue_wait, run_time;
+  /// the time (in seconds, from an arbitrary point) at which the iterations ended
+  TimingWindow end_time;
+  /// the time the threads of the pool were busy and the sum of the run times of the operators;
+  /// CPU stage only
+  TimingWindow thread_pool_busy, op_time;
+  int max_concurrent_ops = 0;
+
+  /**
+   * @param num_threads the number of threads of the pool the stage runs its operators in;
+   *                    0 if there is no such pool
+   */
+  StageTimingStats GetStats(int batch_size, int num_threads = 0) const {
+    StageTimingStats stats;
+    stats.iterations = run_time.count();
+    stats.window = run_time.size();
+    stats.mean_queue_wait = queue_wait.Mean();
+    stats.max_queue_wait = queue_wait.Max();
+    stats.mean_run_time = run_time.Mean();
+    int n = end_time.size();
+    if (n > 1) {
+      double interval = end_time.last() - end_time.recent(n - 1);
+      if (interval > 0)
+        stats.samples_per_sec = batch_size * (n - 1) / interval;
+    }
+    if (stats.mean_run_time > 0) {
+      if (num_threads > 0)
+        stats.thread_pool_utilization = thread_pool_busy.Mean() /
+                                        (stats.mean_run_time * num_threads);
+      stats.op_overlap = op_time.Mean() / stats.mean_run_time;
+    }
+    stats.max_concurrent_ops = max_concurrent_ops;
+    return stats;
+  }
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_TIMING_STATS_H_
@@ -0,0 +1,103 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include "dali/pipeline/executor/timing_stats.h"
+
+namespace dali {
+
+TEST(TimingWindowTest, Empty) {
+  TimingWindow w;
+  EXPECT_EQ(w.count(), 0);
+  EXPECT_EQ(w.size(), 0);
+  EXPECT_EQ(w.last(), 0);
+  EXPECT_EQ(w.Min(), 0);
+  EXPECT_EQ(w.Mean(), 0);
+  EXPECT_EQ(w.Percentile(99), 0);
+  auto stats = GetOperatorTimingStats(w, 16);
+  EXPECT_EQ(stats.iterations, 0);
+  EXPECT_EQ(stats.samples_per_sec, 0);
+}
+
+TEST(TimingWindowTest, Percentiles) {
+  TimingWindow w;
+  // 1..100 in a scrambled order
+  for (int i = 0; i < 100; i++)
+    w.Add((i * 37) % 100 + 1);
+  EXPECT_EQ(w.size(), 100);
+  EXPECT_EQ(w.Min(), 1);
+  EXPECT_EQ(w.Max(), 100);
+  EXPECT_DOUBLE_EQ(w.Mean(), 50.5);
+  EXPECT_EQ(w.Percentile(50), 50);
+  EXPECT_EQ(w.Percentile(99), 99);
+  EXPECT_EQ(w.Percentile(100), 100);
+  EXPECT_EQ(w.Percentile(0), 1);
+
+  auto stats = GetOperatorTimingStats(w, 101);
+  EXPECT_EQ(stats.iterations, 100);
+  EXPECT_EQ(stats.window, 100);
+  EXPECT_EQ(stats.p50_time, 50);
+  EXPECT_DOUBLE_EQ(stats.samples_per_sec, 2);
+}
+
+TEST(TimingWindowTest, Wraparound) {
+  TimingWindow w(4);
+  for (int i = 1; i <= 10; i++)
+    w.Add(i);
+  // only 7..10 are kept
+  EXPECT_EQ(w.count(), 10);
+  EXPECT_EQ(w.size(), 4);
+  EXPECT_EQ(w.last(), 10);
+  EXPECT_EQ(w.recent(3), 7);
+  EXPECT_EQ(w.Min(), 7);
+  EXPECT_EQ(w.Max(), 10);
+  EXPECT_DOUBLE_EQ(w.Mean(), 8.5);
+  EXPECT_EQ(w.Percentile(50), 8);
+}
+
+TEST(TimingWindowTest, StageThroughput) {
+  StageTimingWindow w;
+  // an iteration of 8 samples ends every 0.5 s
+  for (int i = 0; i < 5; i++) {
+    w.queue_wait.Add(i * 0.1);
+    w.run_time.Add(0.25);
+    w.end_time.Add(100 + i * 0.5);
+  }
+  auto stats = w.GetStats(8);
+  EXPECT_EQ(stats.iterations, 5);
+  EXPECT_DOUBLE_EQ(stats.mean_queue_wait, 0.2);
+  EXPECT_DOUBLE_EQ(stats.max_queue_wait, 0.4);
+  EXPECT_DOUBLE_EQ(stats.mean_run_time, 0.25);
+  EXPECT_DOUBLE_EQ(stats.samples_per_sec, 16);
+  EXPECT_EQ(stats.thread_pool_utilization, 0);
+  EXPECT_EQ(stats.op_overlap, 0);
+}
+
+TEST(TimingWindowTest, StageOverlapAndUtilization) {
+  StageTimingWindow w;
+  for (int i = 0; i < 4; i++) {
+    w.run_time.Add(1);
+    w.end_time.Add(i);
+    // 2 threads, busy for 1.5 s in total; operators running for 3 s in total
+    w.thread_pool_busy.Add(1.5);
+    w.op_time.Add(i % 2 ? 2 : 4);
+  }
+  w.max_concurrent_ops = 3;
+  auto stats = w.GetStats(8, 2);
+  EXPECT_DOUBLE_EQ(stats.thread_pool_utilization, 0.75);
+  EXPECT_DOUBLE_EQ(stats.op_overlap, 3);
+  EXPECT_EQ(stats.max_concurrent_ops, 3);
+}
+
+}  // namespace dali
@@ -172,6 +172,9 @@ inline void SetupStreamsAndEvents<OpType::MIXED>(
     const OpGraph &graph, const OpNode &node,
     cudaStream_t mixed_op_stream, cudaStream_t gpu_op_stream,
     const MixedOpEventMap &mixed_op_events, const QueueIdxs idxs) {
+  // No events are created when the graph runs without CUDA
+  if (mixed_op_events.empty())
+    return;
   // We assign unique stream to mixed ops.
   // This ensures that we won't have false dependencies
   // between mixed ops and the previous iterations
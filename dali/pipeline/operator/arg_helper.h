@@ -21,6 +21,7 @@
 #include <dali/pipeline/data/views.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace dali {
 
@@ -105,6 +106,91 @@ class ArgValue {
   std::unique_ptr<TensorList<GPUBackend>> gpu_;
 };
 
+/**
+ * @brief A scalar argument, which can be given per sample as an argument input, resolved
+ *        when the operator is constructed
+ *
+ * `OpSpec::GetArgument` looks the argument up by name and, for argument inputs, checks the
+ * shape of the whole batch on every call, which adds up when it's called for each sample.
+ * ScalarArg gets the value of a constant argument once, in the constructor, and looks up
+ * the argument input once per iteration, in `Acquire`; the value of a sample is then read
+ * directly from the argument input.
+ *
+ * Usage:
+ *  - construct it in the constructor of the operator,
+ *  - call `Acquire` once per iteration, before the samples are processed (e.g. in SetupImpl),
+ *  - get the values with `operator[]`, also from the per-sample `RunImpl`.
+ */
+template <typename T>
+class ScalarArg {
+ public:
+  ScalarArg() = default;
+
+  ScalarArg(const std::string &name, const OpSpec &spec)
+      : name_(name), batch_size_(spec.GetArgument<int>("batch_size")) {
+    if (spec.HasTensorArgument(name)) {
+      is_input_ = true;
+    } else {
+      has_value_ = spec.HasArgument(name) || spec.GetSchema().HasArgumentDefaultValue(name);
+      if (has_value_)
+        value_ = spec.GetArgument<T>(name);
+    }
+  }
+
+  /**
+   * @brief Gets the argument input for the current iteration from the workspace
+   *
+   * Does nothing if the argument is not an argument input.
+   */
+  void Acquire(const ArgumentWorkspace &ws) {
+    if (!is_input_)
+      return;
+    const auto &arg = ws.ArgumentInput(name_);
+    OpSpec::CheckArgumentShape(arg.shape(), batch_size_, name_, true);
+    DALI_ENFORCE(IsType<T>(arg.type()),
+        "Unexpected type of argument \"" + name_ + "\". Expected " +
+        TypeTable::GetTypeName<T>() + " and got " + arg.type().name());
+    sample_data_.resize(batch_size_);
+    if (arg.ntensor() == 1) {
+      // one tensor with a value for each sample
+      const T *data = arg[0].data<T>();
+      for (int i = 0; i < batch_size_; i++)
+        sample_data_[i] = data + i;
+    } else {
+      for (int i = 0; i < batch_size_; i++)
+        sample_data_[i] = arg[i].data<T>();
+    }
+  }
+
+  inline bool IsInput() const noexcept { return is_input_; }
+
+  /// True if the argument is an argument input, is specified or has a default value
+  inline bool IsDefined() const noexcept { return is_input_ || has_value_; }
+
+  inline const std::string &name() const noexcept { return name_; }
+
+  inline T operator[](int sample_index) const {
+    if (is_input_) {
+#if DALI_DEBUG
+      DALI_ENFORCE(sample_index >= 0 && sample_index < static_cast<int>(sample_data_.size()),
+                   "Argument input \"" + name_ + "\" has not been acquired for this sample.");
+#endif
+      return *sample_data_[sample_index];
+    }
+    if (!has_value_)
+      DALI_FAIL("Argument \"" + name_ + "\" is not specified and has no default value.");
+    return value_;
+  }
+
+ private:
+  std::string name_;
+  int batch_size_ = 0;
+  bool is_input_ = false;
+  bool has_value_ = false;
+  T value_{};
+  std::vector<const T *> sample_data_;
+};
+
 }  // namespace dali
 
 #endif  // DALI_PIPELINE_OPERATOR_ARG_HELPER_H_
@@ -0,0 +1,119 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "dali/pipeline/operator/arg_helper.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+DALI_SCHEMA(DummyOpForScalarArgTest)
+  .NumInput(0).NumOutput(0)
+  .AddArg("required", "required argument", DALIDataType::DALI_FLOAT, true)
+  .AddOptionalArg("default", "argument with default", 11, true)
+  .AddOptionalArg<int>("no_default", "argument without default", nullptr, true);
+
+namespace {
+
+constexpr int kBatchSize = 4;
+
+std::shared_ptr<TensorVector<CPUBackend>> MakeArgumentInput(const TensorListShape<> &shape,
+                                                            int first_value) {
+  auto tv = std::make_shared<TensorVector<CPUBackend>>(shape.num_samples());
+  tv->Resize(shape);
+  tv->set_type(TypeInfo::Create<int32_t>());
+  int value = first_value;
+  for (int i = 0; i < shape.num_samples(); i++) {
+    auto *data = tv->tensor_handle(i)->mutable_data<int32_t>();
+    for (int64_t j = 0; j < volume(shape[i]); j++)
+      data[j] = value++;
+  }
+  return tv;
+}
+
+}  // namespace
+
+TEST(ScalarArgTest, Constant) {
+  auto spec = OpSpec("DummyOpForScalarArgTest")
+      .AddArg("batch_size", kBatchSize)
+      .AddArg("required", 0.5f);
+  ArgumentWorkspace ws;
+
+  ScalarArg<float> required("required", spec);
+  ScalarArg<int> with_default("default", spec);
+  ScalarArg<int> no_default("no_default", spec);
+  EXPECT_FALSE(required.IsInput());
+  EXPECT_TRUE(required.IsDefined());
+  EXPECT_TRUE(with_default.IsDefined());
+  EXPECT_FALSE(no_default.IsDefined());
+
+  // no-op for constant arguments
+  required.Acquire(ws);
+  for (int i = 0; i < kBatchSize; i++) {
+    EXPECT_EQ(required[i], 0.5f);
+    EXPECT_EQ(with_default[i], 11);
+  }
+  EXPECT_THROW(no_default[0], std::runtime_error);
+
+  // the type is checked when the argument is resolved
+  EXPECT_THROW(ScalarArg<int>("required", spec), std::runtime_error);
+  EXPECT_THROW(ScalarArg<int>("not_in_schema", spec), std::runtime_error);
+}
+
+TEST(ScalarArgTest, ArgumentInput) {
+  for (auto &shape : {uniform_list_shape(kBatchSize, {1}), uniform_list_shape(1, {kBatchSize})}) {
+    auto spec = OpSpec("DummyOpForScalarArgTest")
+        .AddArg("batch_size", kBatchSize)
+        .AddArgumentInput("default", "<not_used>");
+    ArgumentWorkspace ws;
+    ws.AddArgumentInput("default", MakeArgumentInput(shape, 42));
+
+    ScalarArg<int> arg("default", spec);
+    EXPECT_TRUE(arg.IsInput());
+    arg.Acquire(ws);
+    for (int i = 0; i < kBatchSize; i++) {
+      EXPECT_EQ(arg[i], 42 + i);
+      if (shape.num_samples() == kBatchSize)
+        EXPECT_EQ(arg[i], spec.GetArgument<int>("default", &ws, i));
+    }
+
+    // the next iteration
+    ws.Clear();
+    ws.AddArgumentInput("default", MakeArgumentInput(shape, 100));
+    arg.Acquire(ws);
+    for (int i = 0; i < kBatchSize; i++)
+      EXPECT_EQ(arg[i], 100 + i);
+
+    ScalarArg<float> wrong_type("default", spec);
+    EXPECT_THROW(wrong_type.Acquire(ws), std::runtime_error);
+  }
+}
+
+TEST(ScalarArgTest, ArgumentInputShape) {
+  auto spec = OpSpec("DummyOpForScalarArgTest")
+      .AddArg("batch_size", kBatchSize)
+      .AddArgumentInput("default", "<not_used>");
+  ScalarArg<int> arg("default", spec);
+  for (auto &shape : {uniform_list_shape(kBatchSize, {2}),
+                      uniform_list_shape(kBatchSize - 1, {1}),
+                      uniform_list_shape(1, {kBatchSize + 1})}) {
+    ArgumentWorkspace ws;
+    ws.AddArgumentInput("default", MakeArgumentInput(shape, 0));
+    EXPECT_THROW(arg.Acquire(ws), std::runtime_error);
+  }
+}
+
+}  // namespace dali
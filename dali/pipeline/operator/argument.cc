@@ -32,6 +32,7 @@ inline Argument *DeserializeProtobufImpl<type>(const DaliProtoPriv& arg) { \
 
 DESERIALIZE_PROTOBUF(int64_t, ints);
 DESERIALIZE_PROTOBUF(float, floats);
+DESERIALIZE_PROTOBUF(double, doubles);
 DESERIALIZE_PROTOBUF(bool, bools);
 DESERIALIZE_PROTOBUF(string, strings);
 
@@ -57,6 +58,7 @@ Argument *DeserializeProtobuf(const DaliProtoPriv arg) {
   std::map<std::pair<string, bool>, std::function<Argument*(const DaliProtoPriv&)>> fn_map{
     ADD_SERIALIZABLE_ARG(int64)
     ADD_SERIALIZABLE_ARG(float)
+    {{serialize_type(double()), false}, DeserializeProtobufImpl<double>},
     ADD_SERIALIZABLE_ARG(string)
     ADD_SERIALIZABLE_ARG(bool)
 #ifdef DALI_BUILD_PROTO3
@@ -132,13 +132,19 @@ class ExternalSource : public Operator<Backend> {
 
   /**
    * @brief Sets the data that should be passed out of the op on the next iteration.
+   *
+   * If `no_copy` is true (or the operator was created with the `no_copy` argument), the data
+   * is shared instead of copied. The reference to the shared allocation is kept until
+   * the buffer is recycled, which happens after the iteration that used it has been consumed.
+   * The caller can pass the data with a custom deleter to be notified when that happens.
    */
   template<typename SrcBackend>
   inline void SetDataSource(const TensorList<SrcBackend> &tl, cudaStream_t stream = 0,
-                            bool sync = false, bool use_copy_kernel = false) {
+                            bool sync = false, bool use_copy_kernel = false,
+                            bool no_copy = false) {
     DeviceGuard g(device_id_);
     TimeRange tr("[ExternalSource] SetDataSource", TimeRange::kViolet);
-    SetDataSourceHelper(tl, stream, sync, use_copy_kernel);
+    SetDataSourceHelper(tl, stream, sync, use_copy_kernel, no_copy);
   }
 
   /**
@@ -147,14 +153,14 @@ class ExternalSource : public Operator<Backend> {
   template <typename SrcBackend>
   inline void SetDataSource(const vector<Tensor<SrcBackend>> &vect_of_tensors,
                             cudaStream_t stream = 0, bool sync = false,
-                            bool use_copy_kernel = false) {
+                            bool use_copy_kernel = false, bool no_copy = false) {
     DeviceGuard g(device_id_);
     TimeRange tr("[ExternalSource] SetDataSource", TimeRange::kViolet);
     TensorVector<SrcBackend> tv(vect_of_tensors.size());
     for (size_t i = 0; i < tv.size(); ++i) {
       tv[i].ShareData(const_cast<Tensor<SrcBackend>*>(&vect_of_tensors[i]));
     }
-    SetDataSourceHelper(tv, stream, sync, use_copy_kernel);
+    SetDataSourceHelper(tv, stream, sync, use_copy_kernel, no_copy);
   }
 
   /**
@@ -162,10 +168,11 @@ class ExternalSource : public Operator<Backend> {
    */
   template<typename SrcBackend>
   inline void SetDataSource(const TensorVector<SrcBackend> &tv, cudaStream_t stream = 0,
-                            bool sync = false, bool use_copy_kernel = false) {
+                            bool sync = false, bool use_copy_kernel = false,
+                            bool no_copy = false) {
     DeviceGuard g(device_id_);
     TimeRange tr("[ExternalSource] SetDataSource", TimeRange::kViolet);
-    SetDataSourceHelper(tv, stream, sync, use_copy_kernel);
+    SetDataSourceHelper(tv, stream, sync, use_copy_kernel, no_copy);
   }
 
   DISABLE_COPY_MOVE_ASSIGN(ExternalSource);
@@ -216,12 +223,24 @@ class ExternalSource : public Operator<Backend> {
     tv_data_.Recycle(data);
   }
 
+  /**
+   * @brief Drops the element's reference to the memory shared with the user, so that it's
+   *        released when the buffer is recycled rather than when the element is reused
+   */
+  template <typename T>
+  void ReleaseSharedData(std::list<std::unique_ptr<T>> &data) {
+    if (data.front()->shares_data())
+      data.front() = std::make_unique<T>();
+  }
+
   // pass cuda_event by pointer to allow default, nullptr value, with the
   // reference it is not that easy
   template<typename DataType>
   void RecycleBuffer(DataType &data,
                      std::list<uptr_cuda_event_type> *cuda_event = nullptr,
                      std::list<uptr_cuda_event_type> *copy_to_gpu = nullptr) {
+    // outside of the lock - it may call back into the user code
+    ReleaseSharedData(data);
     // No need to synchronize on copy_to_gpu - it was already synchronized before
     std::lock_guard<std::mutex> busy_lock(busy_m_);
     RecycleBufferHelper(data);
@@ -248,7 +267,7 @@ class ExternalSource : public Operator<Backend> {
   ShareUserData(const SourceDataType<SrcBackend> &batch, cudaStream_t /*stream = 0*/,
                 bool /*use_copy_kernel = false*/) {
     std::lock_guard<std::mutex> busy_lock(busy_m_);
-    state_.push_back({});
+    state_.push_back({false, true});
     auto tv_elm = tv_data_.GetEmpty();
     // set pinned if needed
     if (batch.is_pinned() !=  tv_elm.front()->is_pinned()) {
@@ -281,7 +300,7 @@ class ExternalSource : public Operator<Backend> {
     if (batch.IsContiguous()) {
       batch.ShareWith(const_cast<TensorList<Backend>*>(tl_elm.front().get()));
       zero_copy_noncontiguous_gpu_input_ = true;
-      state_.push_back({});
+      state_.push_back({false, true});
     } else {
       // it is not contiguous so we need to copy
       tl_elm.front()->Copy(batch, stream, use_copy_kernel);
@@ -296,7 +315,7 @@ class ExternalSource : public Operator<Backend> {
                   "In such a case the internal memory used to gather data in a contiguous chunk "
                   "of memory would be trashed.");
       }
-      state_.push_back({true});
+      state_.push_back({true, true});
     }
     tl_data_.PushBack(tl_elm);
   }
@@ -307,7 +326,7 @@ class ExternalSource : public Operator<Backend> {
   ShareUserData(const TensorList<SrcBackend> &batch, cudaStream_t /*stream = 0*/,
                 bool /* use_copy_kernel */) {
     std::lock_guard<std::mutex> busy_lock(busy_m_);
-    state_.push_back({});
+    state_.push_back({false, true});
     auto tl_elm = tl_data_.GetEmpty();
     tl_elm.front()->ShareData(const_cast<TensorList<Backend>*>(&batch));
     tl_data_.PushBack(tl_elm);
@@ -323,10 +342,11 @@ class ExternalSource : public Operator<Backend> {
       std::lock_guard<std::mutex> busy_lock(busy_m_);
       tv_elm = tv_data_.GetEmpty();
     }
-    // set pinned if needed
-    if (batch.is_pinned() !=  tv_elm.front()->is_pinned()) {
+    // set pinned if needed - pinned memory is not available without a device
+    bool pinned = batch.is_pinned() && device_id_ != CPU_ONLY_DEVICE_ID;
+    if (pinned != tv_elm.front()->is_pinned()) {
       tv_elm.front()->Reset();
-      tv_elm.front()->set_pinned(batch.is_pinned());
+      tv_elm.front()->set_pinned(pinned);
     }
     tv_elm.front()->Copy(batch, stream);
     // if copying from GPU to CPU always synchronize
@@ -377,7 +397,8 @@ class ExternalSource : public Operator<Backend> {
 
   template<typename SrcBackend, template<typename> class SourceDataType>
   inline void SetDataSourceHelper(const SourceDataType<SrcBackend> &batch, cudaStream_t stream = 0,
-                                  bool sync = false, bool use_copy_kernel = false) {
+                                  bool sync = false, bool use_copy_kernel = false,
+                                  bool no_copy = false) {
     bool is_gpu_src = std::is_same<SrcBackend, GPUBackend>::value;
     bool is_gpu_dst = std::is_same<Backend, GPUBackend>::value;
     if (is_gpu_src && !is_gpu_dst) {
@@ -393,7 +414,7 @@ class ExternalSource : public Operator<Backend> {
     // pass anything as it is ignored.
     std::list<uptr_tl_type> tl_elm;
     std::list<uptr_tl_type> tv_elm;
-    if (no_copy_) {
+    if (no_copy_ || no_copy) {
       ShareUserData(batch, stream, use_copy_kernel);
     } else {
       CopyUserData(batch, stream, sync, use_copy_kernel);
@@ -418,6 +439,7 @@ class ExternalSource : public Operator<Backend> {
    */
   struct ExternalSourceState {
     bool copied_shared_data = false;
+    bool no_copy = false;  // the data was passed with no_copy, not with CopyUserData
   };
 
   std::list<ExternalSourceState > state_;
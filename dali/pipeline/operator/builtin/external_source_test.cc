@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <list>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "dali/test/dali_test_decoder.h"
 #include "dali/pipeline/executor/async_pipelined_executor.h"
@@ -184,6 +188,29 @@ class ExternalSourceTest : public::testing::WithParamInterface<int>,
     src_op->SetDataSource(tl_gpu_);
   }
 
+  /**
+   * @brief Lends the operator a buffer without copying; `released` is incremented
+   *        when the operator drops the buffer
+   */
+  template<typename Backend>
+  void FeedWithCpuListNoCopy(ExternalSource<Backend> *src_op, std::atomic<int> *released) {
+    auto rand_shape = GetRandShape(this->RandInt(1, 4));
+    TensorListShape<> shape = uniform_list_shape(this->batch_size_, rand_shape);
+    no_copy_buffers_.emplace_back(shape.num_elements(), -1);
+    auto &buffer = no_copy_buffers_.back();
+    TensorList<CPUBackend> tensor_list;
+    tensor_list.set_pinned(false);
+    tensor_list.ShareData(std::shared_ptr<void>(buffer.data(), [released](void *) { ++*released; }),
+                          buffer.size() * sizeof(int), TensorListShape<>{});
+    tensor_list.Resize(shape, TypeInfo::Create<int>());
+    src_op->SetDataSource(tensor_list, 0, false, false, true);
+    // the buffer is filled after it was passed to the operator - it must not have been copied
+    for (auto &x : buffer) {
+      x = fill_counter_;
+      ++fill_counter_;
+    }
+  }
+
   void RunExe() {
     exe_->RunCPU();
     exe_->RunMixed();
@@ -217,6 +244,7 @@ class ExternalSourceTest : public::testing::WithParamInterface<int>,
   std::vector<Tensor<CPUBackend>> vt_cpu_;
   TensorList<GPUBackend> tl_gpu_;
   std::vector<Tensor<GPUBackend>> vt_gpu_;
+  std::list<std::vector<int>> no_copy_buffers_;
   int fill_counter_;
   int check_counter_;
 };
@@ -448,6 +476,37 @@ TYPED_TEST(ExternalSourceTest, ConsumeOneThenFeedsGPU) {
   }
 }
 
+TYPED_TEST(ExternalSourceTest, FeedNoCopyThenConsume) {
+  auto *src_op = this->CreateCPUExe();
+  ASSERT_NE(src_op, nullptr);
+  std::atomic<int> released{0};
+  for (int i = 0; i < TypeParam::loops; ++i) {
+    this->FeedWithCpuListNoCopy(src_op, &released);
+  }
+  EXPECT_EQ(released, 0);
+  for (int i = 0; i < TypeParam::loops; ++i) {
+    this->RunExe();
+    EXPECT_TRUE(this->RunOutputs());
+  }
+  // the last buffers are kept until the output buffers are reused or the operator is destroyed
+  this->exe_.reset();
+  EXPECT_EQ(released, TypeParam::loops);
+}
+
+TYPED_TEST(ExternalSourceTest, ConsumeOneThenFeedsNoCopy) {
+  auto *src_op = this->CreateCPUExe();
+  ASSERT_NE(src_op, nullptr);
+  std::atomic<int> released{0};
+  for (int i = 0; i < TypeParam::loops; ++i) {
+    this->FeedWithCpuListNoCopy(src_op, &released);
+    this->RunExe();
+    EXPECT_TRUE(this->RunOutputs());
+    EXPECT_LE(released, i + 1);
+  }
+  this->exe_.reset();
+  EXPECT_EQ(released, TypeParam::loops);
+}
+
 TEST(ExternalSourceTestNoInput, Throw) {
   OpGraph graph;
   int batch_size = 1;
@@ -17,6 +17,7 @@
 
 #include <vector>
 #include <string>
+#include <type_traits>
 
 #include "dali/core/error_handling.h"
 #include "dali/core/tensor_shape.h"
@@ -43,6 +44,22 @@ inline void GetSingleOrRepeatedArg(const OpSpec &spec, vector<T> &result,
       to_string(result.size()) + " given.");
 }
 
+namespace detail {
+
+/**
+ * @brief Reads an element of a per-sample argument input
+ *
+ * Double precision arguments also accept single precision inputs.
+ */
+template <typename T>
+T GetArgumentInputElement(const TensorVector<CPUBackend> &arg, int sample_idx, int elem_idx) {
+  if (std::is_same<T, double>::value && IsType<float>(arg.type()))
+    return arg[sample_idx].template data<float>()[elem_idx];
+  return arg[sample_idx].template data<T>()[elem_idx];
+}
+
+}  // namespace detail
+
 template <typename T>
 void GetPerSampleArgument(std::vector<T> &output,
                           const std::string &argument_name,
@@ -64,10 +81,8 @@ void GetPerSampleArgument(std::vector<T> &output,
                     ") tensor list. Got: ", shape));
 
       output.resize(batch_size);
-      auto *data = arg[0].template data<T>();
-
       for (int i = 0; i < batch_size; i++) {
-        output[i] = data[i];
+        output[i] = detail::GetArgumentInputElement<T>(arg, 0, i);
       }
     } else {
       bool is_valid_shape = N == batch_size &&
@@ -79,7 +94,7 @@ void GetPerSampleArgument(std::vector<T> &output,
 
       output.resize(batch_size);
       for (int i = 0; i < batch_size; i++) {
-        output[i] = arg[i].template data<T>()[0];
+        output[i] = detail::GetArgumentInputElement<T>(arg, i, 0);
       }
     }
   } else {
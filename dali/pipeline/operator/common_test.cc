@@ -20,7 +20,9 @@
 
 namespace dali {
 
-DALI_SCHEMA(PipelineCommonTest).AddOptionalArg("size", "size", std::vector<float>{}, true);
+DALI_SCHEMA(PipelineCommonTest)
+  .AddOptionalArg("size", "size", std::vector<float>{}, true)
+  .AddOptionalArg("offset", "offset", 0.0, true);
 
 TEST(PipelineCommon, GetShapeLikeArgumentScalar) {
   OpSpec spec("PipelineCommonTest");
@@ -126,4 +128,39 @@ TEST(PipelineCommon, GetShapeLikeArgumentInput) {
   }
 }
 
+TEST(PipelineCommon, GetPerSampleArgumentDouble) {
+  OpSpec spec("PipelineCommonTest");
+  ArgumentWorkspace ws;
+  const int N = 3;
+  const double offset = (1 << 24) + 1;  // not representable in single precision
+  vector<double> offsets;
+
+  GetPerSampleArgument<double>(offsets, "offset", spec, ws, N);
+  ASSERT_EQ(offsets.size(), N);
+  for (int i = 0; i < N; i++)
+    EXPECT_EQ(offsets[i], 0.0);
+
+  spec.AddArg("offset", offset);
+  GetPerSampleArgument<double>(offsets, "offset", spec, ws, N);
+  ASSERT_EQ(offsets.size(), N);
+  for (int i = 0; i < N; i++)
+    EXPECT_EQ(offsets[i], offset);
+
+  // single precision argument inputs are accepted, too
+  auto input = std::make_shared<TensorList<CPUBackend>>();
+  input->set_pinned(false);
+  input->Resize(uniform_list_shape<1>(N, {1}));
+  float *data = input->mutable_data<float>();
+  for (int i = 0; i < N; i++)
+    data[i] = i * 1.5f;
+
+  OpSpec input_spec("PipelineCommonTest");
+  input_spec.AddArgumentInput("offset", "offset");
+  ws.AddArgumentInput("offset", input);
+  GetPerSampleArgument<double>(offsets, "offset", input_spec, ws, N);
+  ASSERT_EQ(offsets.size(), N);
+  for (int i = 0; i < N; i++)
+    EXPECT_EQ(offsets[i], i * 1.5);
+}
+
 }  // namespace dali
@@ -385,10 +385,6 @@ class DLL_PUBLIC OpSpec {
     return ret;
   }
 
- private:
-  template <typename T, typename S>
-  inline T GetArgumentImpl(const string &name, const ArgumentWorkspace *ws, Index idx) const;
-
   /**
    * @brief Check if the ArgumentInput of given shape can be used with GetArgument(),
    *        representing a batch of scalars
@@ -396,8 +392,8 @@ class DLL_PUBLIC OpSpec {
    * @argument should_throw whether this function should throw an error if the shape doesn't match
    * @return true iff the shape is allowed to be used as Argument
    */
-  bool CheckArgumentShape(const TensorListShape<> &shape, int batch_size,
-                          const std::string &name, bool should_throw = false) const {
+  DLL_PUBLIC static bool CheckArgumentShape(const TensorListShape<> &shape, int batch_size,
+                                            const std::string &name, bool should_throw = false) {
     DALI_ENFORCE(is_uniform(shape),
                  "Arguments should be passed as uniform TensorLists. Argument \"" + name +
                      "\" is not uniform. To access non-uniform argument inputs use "
@@ -438,6 +434,10 @@ class DLL_PUBLIC OpSpec {
     return true;
   }
 
+ private:
+  template <typename T, typename S>
+  inline T GetArgumentImpl(const string &name, const ArgumentWorkspace *ws, Index idx) const;
+
   template <typename T, typename S>
   inline bool TryGetArgumentImpl(T &result,
                                  const string &name,
@@ -134,6 +134,15 @@ void Pipeline::Init(int batch_size, int num_threads, int device_id, int64_t seed
     this->prefetch_queue_depth_ = prefetch_queue_depth;
     DALI_ENFORCE(batch_size_ > 0, "Batch size must be greater than 0");
 
+    seed_.resize(MAX_SEEDS);
+    current_seed_ = 0;
+    std::seed_seq ss{this->original_seed_};
+    ss.generate(seed_.begin(), seed_.end());
+
+    // there are no streams to prioritize without a device
+    if (device_id == CPU_ONLY_DEVICE_ID)
+      return;
+
     int lowest_cuda_stream_priority, highest_cuda_stream_priority;
     CUDA_CALL(cudaDeviceGetStreamPriorityRange(&lowest_cuda_stream_priority,
                                                &highest_cuda_stream_priority));
@@ -149,11 +158,6 @@ void Pipeline::Init(int batch_size, int num_threads, int device_id, int64_t seed
         std::to_string(max_priority_value) + "], with lowest priority being `" +
         std::to_string(lowest_cuda_stream_priority) + "` and highest priority being `" +
         std::to_string(highest_cuda_stream_priority) + "`");
-
-    seed_.resize(MAX_SEEDS);
-    current_seed_ = 0;
-    std::seed_seq ss{this->original_seed_};
-    ss.generate(seed_.begin(), seed_.end());
   }
 
 static bool has_prefix(const std::string &operator_name, const std::string& prefix) {
@@ -202,6 +206,11 @@ int Pipeline::AddOperator(const OpSpec &const_spec, const std::string& inst_name
     spec.SetArg("device", "cpu");
   }
 
+  DALI_ENFORCE(device == "cpu" || device_id_ != CPU_ONLY_DEVICE_ID,
+    make_string("Cannot add a ", device, " operator ", spec.name(), " to a pipeline with "
+                "device_id = CPU_ONLY_DEVICE_ID. Only CPU operators can run without a CUDA "
+                "device."));
+
   // If necessary, split ImageDecoder operator in two separated stages (CPU and Mixed-GPU)
   auto operator_name = spec.name();
   bool split_stages = false;
@@ -432,6 +441,7 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
                           num_threads_, device_id_, bytes_per_sample_hint_, set_affinity_,
                           max_num_stream_, default_cuda_stream_priority_, prefetch_queue_depth_);
   executor_->EnableMemoryStats(enable_memory_stats_);
+  executor_->SetCPUOpConcurrency(cpu_op_concurrency_);
   executor_->Init();
 
   // Creating the graph
@@ -494,6 +504,8 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
       }
       outputs.push_back("contiguous_" + name + "_" + device);
     } else if (device == "gpu") {
+      DALI_ENFORCE(device_id_ != CPU_ONLY_DEVICE_ID, "Requested gpu output '" +
+          name + "' in a pipeline with device_id = CPU_ONLY_DEVICE_ID.");
       if (!it->second.has_gpu) {
         DALI_ENFORCE(it->second.has_cpu, "Output '" + name +
             "' exists on neither cpu or gpu, internal error");
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "dali/core/common.h"
+#include "dali/core/tracer.h"
 #include "dali/pipeline/executor/executor.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor.h"
@@ -67,7 +68,8 @@ class DLL_PUBLIC Pipeline {
    *
    * @param batch_size the size of the batch that should be produced.
    * @param num_threads the number of threads to use in the prefetch stage.
-   * @param device_id id of the GPU to operate on.
+   * @param device_id id of the GPU to operate on. CPU_ONLY_DEVICE_ID runs the pipeline
+   * without any CUDA device; such a pipeline can contain only CPU operators.
    * @param seed used for random number generation. Leaving the default value
    * for this parameter results in random seed
    * @param pipelined_execution whether to allocate the necessary buffers for pipeline execution
@@ -137,13 +139,13 @@ class DLL_PUBLIC Pipeline {
   template <typename T, typename OperatorBackend>
   void SetDataSourceHelper(const string &name, const T &tl, OperatorBase *op_ptr,
                            cudaStream_t stream = 0, bool sync = false,
-                           bool use_copy_kernel = false) {
+                           bool use_copy_kernel = false, bool no_copy = false) {
     // Note: we have 2 different Backends here - OperatorBackend and T's Backend (StorageBackend).
     // The StorageBackend is hidden under `T` type.
     auto *source = dynamic_cast<ExternalSource<OperatorBackend> *>(op_ptr);
     DALI_ENFORCE(source != nullptr,
                  "Input name '" + name + "' is not marked as an external input.");
-    source->SetDataSource(tl, stream, sync, use_copy_kernel);
+    source->SetDataSource(tl, stream, sync, use_copy_kernel, no_copy);
   }
 
   /**
@@ -155,10 +157,12 @@ class DLL_PUBLIC Pipeline {
    * @param stream CUDA stream to use in case of GPUBackend
    * @param sync If SetExternalInputHelper should be blocking - waits until provided data is copied
    *             to the internal buffer
+   * @param no_copy If true, the ExternalSource shares the data instead of copying it
    */
   template<typename TL>
   inline void SetExternalInputHelper(const string &name, const TL &tl, cudaStream_t stream = 0,
-                                     bool sync = false, bool use_copy_kernel = false) {
+                                     bool sync = false, bool use_copy_kernel = false,
+                                     bool no_copy = false) {
     bool is_cpu_node = true;
     OpNodeId node_id;
 
@@ -179,9 +183,11 @@ class DLL_PUBLIC Pipeline {
     OperatorBase *op_ptr = &node.InstantiateOperator();
 
     if (is_cpu_node) {
-      SetDataSourceHelper<TL, CPUBackend>(name, tl, op_ptr, stream, sync, use_copy_kernel);
+      SetDataSourceHelper<TL, CPUBackend>(name, tl, op_ptr, stream, sync, use_copy_kernel,
+                                          no_copy);
     } else {
-      SetDataSourceHelper<TL, GPUBackend>(name, tl, op_ptr, stream, sync, use_copy_kernel);
+      SetDataSourceHelper<TL, GPUBackend>(name, tl, op_ptr, stream, sync, use_copy_kernel,
+                                          no_copy);
     }
   }
 
@@ -194,12 +200,17 @@ class DLL_PUBLIC Pipeline {
    * @param stream CUDA stream to use in case of GPUBackend
    * @param sync If SetExternalInputHelper should be blocking - waits until provided data is copied
    *             to the internal buffer
+   * @param no_copy If true, the data is not copied, even if the operator was created without
+   *                the `no_copy` argument. The pipeline keeps a reference to the allocation
+   *                of the data and drops it when the buffer is reused, after the iteration that
+   *                used it has been consumed - a deleter of a shared allocation can be used
+   *                to learn when the memory is free.
    */
   template<typename Backend>
   DLL_PUBLIC inline void
   SetExternalInput(const string &name, const TensorList<Backend> &tl, cudaStream_t stream = 0,
-                   bool sync = false, bool use_copy_kernel = false) {
-    SetExternalInputHelper(name, tl, stream, sync, use_copy_kernel);
+                   bool sync = false, bool use_copy_kernel = false, bool no_copy = false) {
+    SetExternalInputHelper(name, tl, stream, sync, use_copy_kernel, no_copy);
   }
 
 
@@ -211,12 +222,17 @@ class DLL_PUBLIC Pipeline {
    * @param stream CUDA stream to use in case of GPUBackend
    * @param sync If SetExternalInputHelper should be blocking - waits until provided data is copied
    *             to the internal buffer
+   * @param no_copy If true, the data is not copied, even if the operator was created without
+   *                the `no_copy` argument. The pipeline keeps a reference to the allocation
+   *                of the data and drops it when the buffer is reused, after the iteration that
+   *                used it has been consumed - a deleter of a shared allocation can be used
+   *                to learn when the memory is free.
    */
   template<typename Backend>
   DLL_PUBLIC inline void
   SetExternalInput(const string &name, const TensorVector<Backend> &tv, cudaStream_t stream = 0,
-                   bool sync = false, bool use_copy_kernel = false) {
-    SetExternalInputHelper(name, tv, stream, sync, use_copy_kernel);
+                   bool sync = false, bool use_copy_kernel = false, bool no_copy = false) {
+    SetExternalInputHelper(name, tv, stream, sync, use_copy_kernel, no_copy);
   }
 
   /**
@@ -315,6 +331,55 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Sets how many CPU operators can run at the same time
+   *
+   * With a value greater than 1, the CPU operators are launched as soon as their inputs are
+   * ready, so independent branches of the graph run concurrently, sharing the thread pool.
+   * Must be called before Build.
+   */
+  DLL_PUBLIC void SetCPUOpConcurrency(int max_concurrent_ops) {
+    DALI_ENFORCE(!built_, "CPU operator concurrency must be set before the pipeline is built.");
+    DALI_ENFORCE(max_concurrent_ops > 0,
+                 "The number of concurrent CPU operators must be positive.");
+    cpu_op_concurrency_ = max_concurrent_ops;
+  }
+
+  /**
+   * @brief Obtains the queue wait, run time and throughput of a stage of the executor,
+   *        over the most recent iterations; for the CPU stage, also how much the CPU operators
+   *        overlapped
+   */
+  DLL_PUBLIC StageTimingStats GetStageTimingStats(OpType stage) {
+    if (executor_) {
+      return executor_->GetStageTimingStats(stage);
+    } else {
+      return {};
+    }
+  }
+
+  /**
+   * @brief Starts recording the host trace of the pipeline
+   *
+   * The tracer is shared by all the pipelines in the process; it records the ranges marked
+   * with TimeRange, e.g. the operators run by the executor, the reader prefetching and
+   * the work of the thread pools. Starting discards the events recorded so far.
+   *
+   * @param events_per_thread the number of most recent events kept for each thread
+   */
+  DLL_PUBLIC void StartTracing(int64_t events_per_thread = tracing::kDefaultEventsPerThread) {
+    tracing::StartTracing(events_per_thread);
+  }
+
+  /**
+   * @brief Stops recording the host trace and writes it to `filename` in the Chrome trace
+   *        event format (viewable in chrome://tracing or Perfetto)
+   */
+  DLL_PUBLIC void StopTracing(const std::string &filename) {
+    tracing::StopTracing();
+    tracing::WriteTrace(filename);
+  }
+
   /**
    * @brief Set queue sizes for Pipeline using Separated Queues
    *
@@ -507,6 +572,7 @@ class DLL_PUBLIC Pipeline {
   int next_internal_logical_id_ = -1;
   QueueSizes prefetch_queue_depth_;
   bool enable_memory_stats_ = false;
+  int cpu_op_concurrency_ = 1;
 
   std::vector<int64_t> seed_;
   int original_seed_;
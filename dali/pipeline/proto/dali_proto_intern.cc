@@ -50,6 +50,10 @@ namespace dali {
     intern_->add_floats(val);
   }
 
+  void DaliProtoPriv::add_doubles(const double &val) {
+    intern_->add_doubles(val);
+  }
+
   void DaliProtoPriv::add_bools(const bool &val) {
     intern_->add_bools(val);
   }
@@ -93,6 +97,15 @@ namespace dali {
     return intern_->floats(index);
   }
 
+  std::vector<double> DaliProtoPriv::doubles(void) const {
+    std::vector<double> tmp{intern_->doubles().begin(), intern_->doubles().end()};
+    return tmp;
+  }
+
+  double DaliProtoPriv::doubles(int index) const {
+    return intern_->doubles(index);
+  }
+
   std::vector<bool> DaliProtoPriv::bools(void) const {
     std::vector<bool> tmp{intern_->bools().begin(), intern_->bools().end()};
     return tmp;
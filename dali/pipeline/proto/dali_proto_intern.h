@@ -35,6 +35,7 @@ class DLL_PUBLIC DaliProtoPriv {
   DLL_PUBLIC void set_is_vector(const bool &);
   DLL_PUBLIC void add_ints(const int64 &);
   DLL_PUBLIC void add_floats(const float &);
+  DLL_PUBLIC void add_doubles(const double &);
   DLL_PUBLIC void add_bools(const bool &);
   DLL_PUBLIC void add_strings(const string &);
   DLL_PUBLIC DaliProtoPriv add_extra_args(void);
@@ -46,6 +47,8 @@ class DLL_PUBLIC DaliProtoPriv {
   DLL_PUBLIC int64 ints(int index) const;
   DLL_PUBLIC std::vector<float> floats(void) const;
   DLL_PUBLIC float floats(int index) const;
+  DLL_PUBLIC std::vector<double> doubles(void) const;
+  DLL_PUBLIC double doubles(int index) const;
   DLL_PUBLIC std::vector<bool> bools(void) const;
   DLL_PUBLIC bool bools(int index) const;
   DLL_PUBLIC std::vector<string> strings(void) const;
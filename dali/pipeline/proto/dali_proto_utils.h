@@ -38,6 +38,10 @@ inline std::string serialize_type(const float&) {
   return "float";
 }
 
+inline std::string serialize_type(const double&) {
+  return "double";
+}
+
 template<typename T>
 inline auto serialize_type(const T& t)
   -> decltype(t.SerializeType()) {
@@ -59,6 +63,7 @@ inline DaliProtoPriv * SerializeToProtobuf(const type& t, DaliProtoPriv *arg) {
 
 SERIALIZE_ARGUMENT(int64, ints);
 SERIALIZE_ARGUMENT(float, floats);
+SERIALIZE_ARGUMENT(double, doubles);
 SERIALIZE_ARGUMENT(bool, bools);
 SERIALIZE_ARGUMENT(string, strings);
 
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <utility>
 #include "dali/pipeline/util/thread_pool.h"
@@ -21,33 +23,61 @@
 #include "dali/core/format.h"
 #include "dali/core/cuda_utils.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/tracer.h"
 
 namespace dali {
 
-ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity)
-    : threads_(num_thread), running_(true), work_complete_(true), adding_work_(false)
-    , active_threads_(0) {
+namespace {
+
+ThreadPoolMode ResolveThreadPoolMode(ThreadPoolMode mode) {
+  if (mode != ThreadPoolMode::Default)
+    return mode;
+  if (const char *env_mode = std::getenv("DALI_THREAD_POOL_MODE")) {
+    string value = env_mode;
+    if (value == "work_stealing")
+      return ThreadPoolMode::WorkStealing;
+    if (value != "priority")
+      DALI_WARN(make_string("Unknown DALI_THREAD_POOL_MODE value: \"", value, "\". Valid values "
+                            "are \"priority\" and \"work_stealing\". Ignoring..."));
+  }
+  return ThreadPoolMode::PriorityQueue;
+}
+
+// Distinguishes the workers of different thread pools in the traces
+std::atomic<int> next_pool_id{0};
+
+// The pool whose worker is the current thread and the submitter of the work it is running
+thread_local const ThreadPool *tls_pool = nullptr;
+thread_local std::thread::id tls_submitter;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, ThreadPoolMode mode)
+    : threads_(num_thread), running_(true), device_id_(device_id)
+    , mode_(ResolveThreadPoolMode(mode)) {
   DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
 #if NVML_ENABLED
-  nvml::Init();
+  // without a device there is no GPU affinity to query
+  if (device_id_ >= 0)
+    nvml::Init();
 #endif
+  tl_errors_.resize(num_thread);
+  pool_id_ = next_pool_id++;
+  if (mode_ == ThreadPoolMode::WorkStealing) {
+    worker_queues_.resize(num_thread);
+    for (auto &q : worker_queues_)
+      q.reset(new WorkerQueue());
+  }
   // Start the threads in the main loop
   for (int i = 0; i < num_thread; ++i) {
     threads_[i] = std::thread(std::bind(&ThreadPool::ThreadMain, this, i, device_id, set_affinity));
   }
-  tl_errors_.resize(num_thread);
 }
 
 ThreadPool::~ThreadPool() {
-  // Wait for work to find errors
-  // terminate explicitly as we are finishing the program anyway
-  try {
-    WaitForWork(false);
-  } catch (...) {
-    std::terminate();
-  }
-
+  // Wait for the work of all the submitters
   std::unique_lock<std::mutex> lock(mutex_);
+  completed_.wait(lock, [this] { return this->pending_work_ == 0; });
   running_ = false;
   condition_.notify_all();
   lock.unlock();
@@ -56,35 +86,96 @@ ThreadPool::~ThreadPool() {
     thread.join();
   }
 #if NVML_ENABLED
-  nvml::Shutdown();
+  if (device_id_ >= 0)
+    nvml::Shutdown();
 #endif
 }
 
+std::thread::id ThreadPool::Submitter() const {
+  return tls_pool == this ? tls_submitter : std::this_thread::get_id();
+}
+
+ThreadPool::WorkGroup &ThreadPool::GetWorkGroup(std::thread::id submitter) {
+  auto &group = work_groups_[submitter];
+  if (!group)
+    group.reset(new WorkGroup());
+  return *group;
+}
+
+void ThreadPool::ReleaseStagedWork(WorkGroup &group) {
+  if (mode_ == ThreadPoolMode::WorkStealing) {
+    DistributeStagedWork(group.staged);
+    return;
+  }
+  if (group.staged.empty())
+    return;
+  for (auto &work : group.staged)
+    work_queue_.push(std::move(work));
+  group.staged.clear();
+  condition_.notify_one();  // other threads will be waken up if needed
+}
+
 void ThreadPool::AddWork(Work work, int64_t priority, bool finished_adding_work) {
+  auto submitter = Submitter();
   std::lock_guard<std::mutex> lock(mutex_);
-  work_queue_.push({priority, std::move(work)});
-  work_complete_ = false;
-  adding_work_ = !finished_adding_work;
+  WorkGroup &group = GetWorkGroup(submitter);
+  ++group.pending;
+  ++pending_work_;
+  group.staged.push_back({priority, std::move(work), submitter, &group});
+  if (finished_adding_work)
+    ReleaseStagedWork(group);
 }
 
 void ThreadPool::DoWorkWithID(Work work, int64_t priority) {
+  if (mode_ == ThreadPoolMode::WorkStealing) {
+    // Fast path: skip the staging area and go straight to a worker deque.
+    // The staged work of the submitter must be released as well, so in that case
+    // we go through AddWork.
+    auto submitter = Submitter();
+    WorkGroup *group;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      group = &GetWorkGroup(submitter);
+      if (group->staged.empty()) {
+        ++group->pending;
+        ++pending_work_;
+      } else {
+        group = nullptr;
+      }
+    }
+    if (group) {
+      PushToWorker(next_worker_++ % threads_.size(),
+                   {priority, std::move(work), submitter, group});
+      return;
+    }
+  }
   AddWork(std::move(work), priority, true);
-  // Signal a thread to complete the work
-  condition_.notify_one();
 }
 
-// Blocks until all work issued to the thread pool is complete
+// Blocks until all work issued to the thread pool by the calling thread is complete
 void ThreadPool::WaitForWork(bool checkForErrors) {
+  auto submitter = Submitter();
   std::unique_lock<std::mutex> lock(mutex_);
-  completed_.wait(lock, [this] { return this->work_complete_; });
+  auto it = work_groups_.find(submitter);
+  if (it != work_groups_.end()) {
+    WorkGroup *group = it->second.get();
+    completed_.wait(lock, [group] { return group->pending == 0; });
+    // the workers don't access the group after finishing its last task
+    work_groups_.erase(submitter);
+  }
 
   if (checkForErrors) {
-    // Check for errors
+    // Check for the errors of the work added by this thread
     for (size_t i = 0; i < threads_.size(); ++i) {
-      if (!tl_errors_[i].empty()) {
+      auto &errors = tl_errors_[i];
+      auto it = std::find_if(errors.begin(), errors.end(),
+                             [submitter](const std::pair<std::thread::id, string> &e) {
+                               return e.first == submitter || e.first == std::thread::id();
+                             });
+      if (it != errors.end()) {
         // Throw the first error that occurred
-        string error = make_string("Error in thread ", i, ": ", tl_errors_[i].front());
-        tl_errors_[i].pop();
+        string error = make_string("Error in thread ", i, ": ", it->second);
+        errors.erase(it);
         throw std::runtime_error(error);
       }
     }
@@ -93,10 +184,12 @@ void ThreadPool::WaitForWork(bool checkForErrors) {
 
 void ThreadPool::RunAll(bool wait) {
   {
+    auto submitter = Submitter();
     std::lock_guard<std::mutex> lock(mutex_);
-    adding_work_ = false;
+    auto it = work_groups_.find(submitter);
+    if (it != work_groups_.end())
+      ReleaseStagedWork(*it->second);
   }
-  condition_.notify_one();  // other threads will be waken up if needed
   if (wait) {
     WaitForWork();
   }
@@ -114,9 +207,7 @@ std::vector<std::thread::id> ThreadPool::GetThreadIds() const {
   return tids;
 }
 
-
-void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
-  DeviceGuard g(device_id);
+void ThreadPool::SetAffinity(int thread_id, bool set_affinity) {
   try {
 #if NVML_ENABLED
     if (set_affinity) {
@@ -136,24 +227,53 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
     }
 #endif
   } catch (std::exception &e) {
-    tl_errors_[thread_id].push(e.what());
+    tl_errors_[thread_id].emplace_back(std::thread::id(), e.what());
   } catch (...) {
-    tl_errors_[thread_id].push("Caught unknown exception");
+    tl_errors_[thread_id].emplace_back(std::thread::id(), "Caught unknown exception");
   }
+}
 
-  while (running_) {
+// If an error occurs, we save it in tl_errors_. When
+// WaitForWork is called by the thread which added the work,
+// it will return an error if one occured.
+void ThreadPool::RunWork(QueuedWork &work, int thread_id) {
+  auto start = std::chrono::steady_clock::now();
+  tls_submitter = work.submitter;
+  try {
+    work.work(thread_id);
+  } catch (std::exception &e) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tl_errors_[thread_id].emplace_back(work.submitter, e.what());
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tl_errors_[thread_id].emplace_back(work.submitter, "Caught unknown exception");
+  }
+  busy_time_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+}
+
+void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
+  tracing::SetThreadName(make_string("ThreadPool ", pool_id_, " worker ", thread_id));
+  tls_pool = this;
+  DeviceGuard g(device_id);
+  SetAffinity(thread_id, set_affinity && device_id >= 0);
+
+  if (mode_ == ThreadPoolMode::WorkStealing) {
+    WorkStealingLoop(thread_id);
+    return;
+  }
+
+  for (;;) {
     // Block on the condition to wait for work
     std::unique_lock<std::mutex> lock(mutex_);
-    condition_.wait(lock, [this] { return !running_ || (!work_queue_.empty() && !adding_work_); });
+    condition_.wait(lock, [this] { return !running_ || !work_queue_.empty(); });
     // If we're no longer running, exit the run loop
     if (!running_) break;
 
-    // Get work from the queue & mark
-    // this thread as active
-    Work work = std::move(work_queue_.top().second);
+    // Get work from the queue
+    QueuedWork work = work_queue_.top();
     work_queue_.pop();
     bool should_wake_next = !work_queue_.empty();
-    ++active_threads_;
 
     // Unlock the lock
     lock.unlock();
@@ -162,28 +282,114 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity) {
       condition_.notify_one();
     }
 
-    // If an error occurs, we save it in tl_errors_. When
-    // WaitForWork is called, we will check for any errors
-    // in the threads and return an error if one occured.
-    try {
-      work(thread_id);
-    } catch (std::exception &e) {
-      lock.lock();
-      tl_errors_[thread_id].push(e.what());
-      lock.unlock();
-    } catch (...) {
-      lock.lock();
-      tl_errors_[thread_id].push("Caught unknown exception");
-      lock.unlock();
+    RunWork(work, thread_id);
+    work.work = nullptr;
+    OnWorkDone(work.group);
+  }
+}
+
+void ThreadPool::DistributeStagedWork(std::vector<QueuedWork> &staged) {
+  if (staged.empty())
+    return;
+  // Highest priority (typically: most expensive) work goes first - dealing the sorted work
+  // round-robin gives every worker a similar mix of large and small tasks to start with.
+  std::stable_sort(staged.begin(), staged.end(),
+                   [](const QueuedWork &a, const QueuedWork &b) {
+                     return a.priority > b.priority;
+                   });
+  int nworkers = threads_.size();
+  for (int w = 0; w < nworkers; w++) {
+    WorkerQueue &q = *worker_queues_[w];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    for (size_t i = w; i < staged.size(); i += nworkers)
+      q.work.push_back(std::move(staged[i]));
+  }
+  queued_work_ += staged.size();
+  staged.clear();
+  condition_.notify_all();
+}
+
+void ThreadPool::PushToWorker(int worker, QueuedWork work) {
+  {
+    WorkerQueue &q = *worker_queues_[worker];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    // after the work of the same priority, to keep it in order of submission
+    auto pos = std::upper_bound(q.work.begin(), q.work.end(), work.priority,
+                                [](int64_t p, const QueuedWork &w) { return p > w.priority; });
+    q.work.insert(pos, std::move(work));
+  }
+  ++queued_work_;
+  // Paired with the increment in WorkStealingLoop - either we see the sleeping worker,
+  // or the worker sees the new work before going to sleep.
+  if (idle_threads_ > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_one();
+  }
+}
+
+bool ThreadPool::TryPop(int thread_id, QueuedWork &work) {
+  WorkerQueue &q = *worker_queues_[thread_id];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if (q.work.empty())
+    return false;
+  work = std::move(q.work.front());
+  q.work.pop_front();
+  --queued_work_;
+  return true;
+}
+
+bool ThreadPool::TrySteal(int thread_id, QueuedWork &work) {
+  int nworkers = threads_.size();
+  bool contended = false;
+  for (bool blocking : {false, true}) {
+    for (int i = 1; i < nworkers; i++) {
+      WorkerQueue &q = *worker_queues_[(thread_id + i) % nworkers];
+      std::unique_lock<std::mutex> lock(q.mutex, std::defer_lock);
+      if (blocking) {
+        lock.lock();
+      } else if (!lock.try_lock()) {
+        contended = true;
+        continue;
+      }
+      if (q.work.empty())
+        continue;
+      work = std::move(q.work.back());
+      q.work.pop_back();
+      --queued_work_;
+      return true;
     }
+    // all the deques were checked - there's nothing to steal
+    if (!contended)
+      break;
+  }
+  return false;
+}
+
+void ThreadPool::OnWorkDone(WorkGroup *group) {
+  // The group may be gone as soon as its last task is finished - don't touch it afterwards
+  bool group_done = --group->pending == 0;
+  bool all_done = --pending_work_ == 0;
+  if (group_done || all_done) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // there can be more waiters when the pool is shared by concurrently running operators
+    completed_.notify_all();
+  }
+}
 
-    // Mark this thread as idle & check for complete work
-    lock.lock();
-    --active_threads_;
-    if (work_queue_.empty() && active_threads_ == 0) {
-      work_complete_ = true;
-      completed_.notify_one();
+void ThreadPool::WorkStealingLoop(int thread_id) {
+  QueuedWork work;
+  for (;;) {
+    if (TryPop(thread_id, work) || TrySteal(thread_id, work)) {
+      RunWork(work, thread_id);
+      work.work = nullptr;
+      OnWorkDone(work.group);
+      continue;
     }
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++idle_threads_;
+    condition_.wait(lock, [this] { return !running_ || queued_work_ > 0; });
+    --idle_threads_;
+    if (!running_) break;
   }
 }
 
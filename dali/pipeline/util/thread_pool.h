@@ -15,13 +15,17 @@
 #ifndef DALI_PIPELINE_UTIL_THREAD_POOL_H_
 #define DALI_PIPELINE_UTIL_THREAD_POOL_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <utility>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include "dali/core/common.h"
@@ -29,12 +33,32 @@
 
 namespace dali {
 
+/**
+ * @brief Scheduling strategy used by the ThreadPool
+ */
+enum class ThreadPoolMode {
+  /**
+   * Resolved at construction from the DALI_THREAD_POOL_MODE environment variable
+   * ("priority" or "work_stealing"); PriorityQueue if not set.
+   */
+  Default,
+  /// Single priority queue guarded by one mutex; tasks run strictly by priority.
+  PriorityQueue,
+  /**
+   * Each worker owns a deque; queued tasks are sorted by priority and dealt round-robin
+   * to the workers, which then steal from each other when their own deque runs dry.
+   * Priority becomes a hint (e.g. cost-based seeding) rather than a strict order.
+   */
+  WorkStealing
+};
+
 class DLL_PUBLIC ThreadPool {
  public:
   // Basic unit of work that our threads do
   typedef std::function<void(int)> Work;
 
-  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity);
+  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity,
+                        ThreadPoolMode mode = ThreadPoolMode::Default);
 
   DLL_PUBLIC ~ThreadPool();
 
@@ -46,6 +70,8 @@ class DLL_PUBLIC ThreadPool {
    * @remarks if finished_adding_work == true, the thread pool will proceed picking
    *          tasks from its queue, otherwise it will hold execution until `RunAll`
    *          is invoked.
+   *          Only the work added by the calling thread is held - the threads using
+   *          the pool at the same time don't wait for each other.
    */
   DLL_PUBLIC void AddWork(Work work, int64_t priority = 0, bool finished_adding_work = false);
 
@@ -56,14 +82,18 @@ class DLL_PUBLIC ThreadPool {
   DLL_PUBLIC void DoWorkWithID(Work work, int64_t priority = 0);
 
   /**
-   * @brief Wakes up all the threads to complete all the queued work,
+   * @brief Wakes up all the threads to complete all the work queued by the calling thread,
    *        optionally not waiting for the work to be finished before return
    *        (the default wait=true is equivalent to invoking WaitForWork after RunAll).
    */
   DLL_PUBLIC void RunAll(bool wait = true);
 
   /**
-   * @brief Waits until all work issued to the thread pool is complete
+   * @brief Waits until all work issued to the thread pool by the calling thread is complete
+   *
+   * When the pool is used by several threads at once, each of them waits only for its own
+   * work and gets only the errors raised by it. The work added by the work running in
+   * the pool counts as added by the thread which added the outer work.
    */
   DLL_PUBLIC void WaitForWork(bool checkForErrors = true);
 
@@ -71,31 +101,148 @@ class DLL_PUBLIC ThreadPool {
 
   DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
 
+  DLL_PUBLIC ThreadPoolMode mode() const {
+    return mode_;
+  }
+
+  /**
+   * @brief Total time the threads spent running the work, in nanoseconds
+   *
+   * Comparing it with the wall time times the number of threads shows how well
+   * the pool is utilized.
+   */
+  DLL_PUBLIC int64_t GetBusyTime() const {
+    return busy_time_ns_.load(std::memory_order_relaxed);
+  }
+
   DISABLE_COPY_MOVE_ASSIGN(ThreadPool);
 
  private:
   DLL_PUBLIC void ThreadMain(int thread_id, int device_id, bool set_affinity);
 
+  void SetAffinity(int thread_id, bool set_affinity);
+
+  struct WorkGroup;
+
+  /**
+   * @brief Work waiting in a queue, along with the thread which gets its errors
+   */
+  struct QueuedWork {
+    int64_t priority;
+    Work work;
+    std::thread::id submitter;
+    WorkGroup *group;
+  };
+
+  /**
+   * @brief The work added by a single submitter
+   *
+   * The submitters (e.g. operators running at the same time) hold and wait for their own
+   * work only.
+   */
+  struct WorkGroup {
+    // Number of tasks added and not yet finished (staged, queued or running)
+    std::atomic<int64_t> pending{0};
+    // Work added with AddWork, held until RunAll
+    std::vector<QueuedWork> staged;
+  };
+
+  /**
+   * @brief The thread to which the errors of the work added now should be reported
+   */
+  std::thread::id Submitter() const;
+
+  /**
+   * @brief Returns the work group of the submitter, creating it if needed.
+   *        Must be called with mutex_ held.
+   */
+  WorkGroup &GetWorkGroup(std::thread::id submitter);
+
+  /**
+   * @brief Passes the staged work of the group to the workers.
+   *        Must be called with mutex_ held.
+   */
+  void ReleaseStagedWork(WorkGroup &group);
+
+  void RunWork(QueuedWork &work, int thread_id);
+
+  void WorkStealingLoop(int thread_id);
+
+  /**
+   * @brief Sorts the staged work by priority and deals it round-robin to the worker deques.
+   *        Must be called with mutex_ held.
+   */
+  void DistributeStagedWork(std::vector<QueuedWork> &staged);
+
+  /**
+   * @brief Puts the work in the worker's deque, ahead of the work with lower priority
+   */
+  void PushToWorker(int worker, QueuedWork work);
+
+  bool TryPop(int thread_id, QueuedWork &work);
+
+  /**
+   * @brief Takes the lowest priority work from another worker's deque
+   *
+   * The deques are first probed without waiting for their locks; if that fails only because
+   * some of them were locked, they are scanned again, this time waiting for the locks.
+   */
+  bool TrySteal(int thread_id, QueuedWork &work);
+
+  void OnWorkDone(WorkGroup *group);
+
   vector<std::thread> threads_;
 
-  using PrioritizedWork = std::pair<int64_t, Work>;
   struct SortByPriority {
-    bool operator() (const PrioritizedWork &a, const PrioritizedWork &b) {
-      return a.first < b.first;
+    bool operator() (const QueuedWork &a, const QueuedWork &b) {
+      return a.priority < b.priority;
     }
   };
-  std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority> work_queue_;
+  std::priority_queue<QueuedWork, std::vector<QueuedWork>, SortByPriority> work_queue_;
 
   bool running_;
-  bool work_complete_;
-  bool adding_work_;
-  int active_threads_;
+  int device_id_;
+  // identifies the pool in the names of the threads
+  int pool_id_ = 0;
+  std::atomic<int64_t> busy_time_ns_{0};
   std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable completed_;
 
-  //  Stored error strings for each thread
-  vector<std::queue<string>> tl_errors_;
+  /**
+   * @brief Stored error strings for each thread, along with the thread which added the work
+   *
+   * The errors raised outside of any work (when setting the affinity) have no submitter
+   * and are reported to any thread.
+   */
+  vector<std::deque<std::pair<std::thread::id, string>>> tl_errors_;
+
+  ThreadPoolMode mode_;
+
+  /**
+   * @brief Per-worker deque used in WorkStealing mode, sorted by descending priority.
+   *        The owner pops from the front, thieves take from the back.
+   */
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<QueuedWork> work;
+  };
+  // Allocated separately to keep the hot mutexes of different workers apart
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+
+  /**
+   * @brief Work groups of the submitters, by the submitting thread.
+   *        A group is removed when its submitter has waited for all its work.
+   */
+  std::unordered_map<std::thread::id, std::unique_ptr<WorkGroup>> work_groups_;
+  // Number of tasks present in worker queues
+  std::atomic<int64_t> queued_work_{0};
+  // Number of tasks added and not yet finished (staged, queued or running), in all groups
+  std::atomic<int64_t> pending_work_{0};
+  // Number of workers sleeping on condition_
+  std::atomic<int> idle_threads_{0};
+  // Round-robin counter for DoWorkWithID
+  std::atomic<unsigned> next_worker_{0};
 };
 
 }  // namespace dali
@@ -15,6 +15,9 @@
 #include "dali/pipeline/util/thread_pool.h"
 #include <gtest/gtest.h>
 #include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 namespace dali {
 
@@ -67,6 +70,181 @@ TEST(ThreadPool, AddWorkWithPriority) {
   ASSERT_EQ(((1+1) << 3) + 1, count);
 }
 
+TEST(ThreadPool, WorkStealingAddWork) {
+  ThreadPool tp(8, 0, false, ThreadPoolMode::WorkStealing);
+  ASSERT_EQ(tp.mode(), ThreadPoolMode::WorkStealing);
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int i = 0; i < 1000; i++) {
+    tp.AddWork(increase, i % 17);
+  }
+  ASSERT_EQ(count, 0);
+  tp.RunAll();
+  ASSERT_EQ(count, 1000);
+  // the pool must be reusable
+  for (int i = 0; i < 1000; i++) {
+    tp.AddWork(increase);
+  }
+  tp.RunAll();
+  ASSERT_EQ(count, 2000);
+}
+
+TEST(ThreadPool, WorkStealingDoWorkWithID) {
+  ThreadPool tp(8, 0, false, ThreadPoolMode::WorkStealing);
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int i = 0; i < 1000; i++) {
+    tp.DoWorkWithID(increase);
+  }
+  tp.WaitForWork();
+  ASSERT_EQ(count, 1000);
+}
+
+TEST(ThreadPool, WorkStealingPriorityHint) {
+  ThreadPool tp(1, 0, false, ThreadPoolMode::WorkStealing);  // a single worker follows the hint
+  std::atomic<int> count{0};
+  auto set_to_1 = [&count](int thread_id) {
+    count = 1;
+  };
+  auto increase_by_1 = [&count](int thread_id) {
+    count++;
+  };
+  auto mult_by_2 = [&count](int thread_id) {
+    int val = count.load();
+    while (!count.compare_exchange_weak(val, val * 2)) {}
+  };
+  tp.AddWork(increase_by_1, 2);
+  tp.AddWork(mult_by_2, 7);
+  tp.AddWork(mult_by_2, 9);
+  tp.AddWork(mult_by_2, 8);
+  tp.AddWork(increase_by_1, 100);
+  tp.AddWork(set_to_1, 1000);
+
+  tp.RunAll();
+  ASSERT_EQ(((1+1) << 3) + 1, count);
+}
+
+TEST(ThreadPool, WorkStealingDoWorkWithIDPriority) {
+  ThreadPool tp(1, 0, false, ThreadPoolMode::WorkStealing);
+  std::atomic<bool> release{false};
+  std::vector<int> order;
+  // keep the only worker busy until all the work is submitted
+  tp.DoWorkWithID([&release](int) {
+    while (!release) std::this_thread::yield();
+  }, 1000);
+  for (int priority : {1, 5, 3, 5, 2}) {
+    tp.DoWorkWithID([&order, priority](int) { order.push_back(priority); }, priority);
+  }
+  release = true;
+  tp.WaitForWork();
+  EXPECT_EQ(order, std::vector<int>({5, 5, 3, 2, 1}));
+}
+
+TEST(ThreadPool, WorkStealingErrors) {
+  ThreadPool tp(4, 0, false, ThreadPoolMode::WorkStealing);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 100; i++) {
+    tp.AddWork([&count, i](int thread_id) {
+      count++;
+      if (i == 42)
+        throw std::runtime_error("Test error");
+    });
+  }
+  EXPECT_THROW(tp.RunAll(), std::runtime_error);
+  EXPECT_EQ(count, 100);
+}
+
+namespace {
+
+/**
+ * Two threads share the pool; the work of only one of them fails, even when it is
+ * added by the work running in the pool.
+ */
+void TestErrorsReportedToSubmitter(ThreadPoolMode mode) {
+  ThreadPool tp(4, 0, false, mode);
+  std::atomic<bool> failed{false};
+  std::thread failing([&]() {
+    tp.DoWorkWithID([&tp, &failed](int) {
+      tp.DoWorkWithID([&failed](int) {
+        failed = true;
+        throw std::runtime_error("Test error");
+      });
+    });
+    EXPECT_THROW(tp.WaitForWork(), std::runtime_error);
+  });
+  while (!failed) std::this_thread::yield();
+  std::atomic<int> count{0};
+  for (int i = 0; i < 16; i++)
+    tp.AddWork([&count](int) { count++; });
+  EXPECT_NO_THROW(tp.RunAll());
+  EXPECT_EQ(count, 16);
+  failing.join();
+}
+
+/**
+ * Two threads share the pool; one waits for a long task, the other one only for its own work
+ * and isn't held by the work the first one is still adding.
+ */
+void TestSubmittersDontWaitForEachOther(ThreadPoolMode mode) {
+  ThreadPool tp(2, 0, false, mode);
+  std::atomic<bool> started{false}, release{false}, slow_done{false};
+  std::thread slow([&]() {
+    tp.AddWork([&](int) {
+      started = true;
+      // bounded, so that waiting for this task fails the test instead of hanging it
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (!release && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    });
+    tp.RunAll();
+    slow_done = true;
+  });
+  while (!started) std::this_thread::yield();
+
+  std::atomic<bool> staged{false}, staged_run{false};
+  std::atomic<bool> release_staged{false};
+  std::thread staging([&]() {
+    tp.AddWork([&](int) { staged_run = true; });
+    staged = true;
+    while (!release_staged) std::this_thread::yield();
+    tp.RunAll();
+  });
+  while (!staged) std::this_thread::yield();
+
+  std::atomic<int> count{0};
+  for (int i = 0; i < 16; i++)
+    tp.AddWork([&count](int) { count++; });
+  tp.RunAll();
+  EXPECT_EQ(count, 16);
+  EXPECT_FALSE(slow_done);
+  EXPECT_FALSE(staged_run);
+
+  release_staged = true;
+  staging.join();
+  EXPECT_TRUE(staged_run);
+  release = true;
+  slow.join();
+  EXPECT_TRUE(slow_done);
+}
+
+}  // namespace
+
+TEST(ThreadPool, SubmittersDontWaitForEachOther) {
+  TestSubmittersDontWaitForEachOther(ThreadPoolMode::PriorityQueue);
+}
+
+TEST(ThreadPool, WorkStealingSubmittersDontWaitForEachOther) {
+  TestSubmittersDontWaitForEachOther(ThreadPoolMode::WorkStealing);
+}
+
+TEST(ThreadPool, ErrorsReportedToSubmitter) {
+  TestErrorsReportedToSubmitter(ThreadPoolMode::PriorityQueue);
+}
+
+TEST(ThreadPool, WorkStealingErrorsReportedToSubmitter) {
+  TestErrorsReportedToSubmitter(ThreadPoolMode::WorkStealing);
+}
+
 }  // namespace test
 
 }  // namespace dali
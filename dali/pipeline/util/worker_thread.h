@@ -66,19 +66,24 @@ class WorkerThread {
  public:
   typedef std::function<void(void)> Work;
 
-  inline WorkerThread(int device_id, bool set_affinity) :
-    running_(true), work_complete_(true), barrier_(2) {
+  /**
+   * @param name the name of the thread in the traces; may be null
+   */
+  inline WorkerThread(int device_id, bool set_affinity, const char *name = nullptr) :
+    running_(true), work_complete_(true), device_id_(device_id), barrier_(2) {
 #if NVML_ENABLED
-    nvml::Init();
+    if (device_id_ >= 0)
+      nvml::Init();
 #endif
     thread_ = std::thread(&WorkerThread::ThreadMain,
-        this, device_id, set_affinity);
+        this, device_id, set_affinity, name);
   }
 
   inline ~WorkerThread() {
 #if NVML_ENABLED
     try {
-      nvml::Shutdown();
+      if (device_id_ >= 0)
+        nvml::Shutdown();
     } catch (const std::exception &) {
       // Something went terribly wrong while releasing resources. We'd better die right now.
       std::terminate();
@@ -163,10 +168,12 @@ class WorkerThread {
   }
 
  private:
-  void ThreadMain(int device_id, bool set_affinity) {
+  void ThreadMain(int device_id, bool set_affinity, const char *name) {
+    if (name)
+      tracing::SetThreadName(name);
     DeviceGuard g(device_id);
     try {
-      if (set_affinity) {
+      if (set_affinity && device_id >= 0) {
 #if NVML_ENABLED
         nvml::SetCPUAffinity();
 #endif
@@ -233,6 +240,7 @@ class WorkerThread {
 
   std::queue<string> errors_;
 
+  int device_id_;
   Barrier barrier_;
 };
 
@@ -1024,7 +1024,7 @@ py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
     py::list reserved_memory_size;
     py::list max_real_memory_size;
     py::list max_reserved_memory_size;
-    for (const auto &entry : stat.second) {
+    for (const auto &entry : stat.second.outputs) {
       real_memory_size.append(entry.real_size);
       max_real_memory_size.append(entry.max_real_size);
       reserved_memory_size.append(entry.reserved);
@@ -1034,11 +1034,32 @@ py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
     op_dict["max_real_memory_size"] = max_real_memory_size;
     op_dict["reserved_memory_size"] = reserved_memory_size;
     op_dict["max_reserved_memory_size"] = max_reserved_memory_size;
+    const auto &timing = stat.second.timing;
+    op_dict["iterations"] = timing.iterations;
+    op_dict["min_time"] = timing.min_time;
+    op_dict["mean_time"] = timing.mean_time;
+    op_dict["p50_time"] = timing.p50_time;
+    op_dict["p99_time"] = timing.p99_time;
+    op_dict["samples_per_sec"] = timing.samples_per_sec;
     d[stat.first.c_str()] = op_dict;
   }
   return d;
 }
 
+py::dict StageTimingStatsToDict(const StageTimingStats &stats) {
+  py::dict d;
+  d["iterations"] = stats.iterations;
+  d["window"] = stats.window;
+  d["mean_queue_wait"] = stats.mean_queue_wait;
+  d["max_queue_wait"] = stats.max_queue_wait;
+  d["mean_run_time"] = stats.mean_run_time;
+  d["samples_per_sec"] = stats.samples_per_sec;
+  d["thread_pool_utilization"] = stats.thread_pool_utilization;
+  d["op_overlap"] = stats.op_overlap;
+  d["max_concurrent_ops"] = stats.max_concurrent_ops;
+  return d;
+}
+
 template <typename Backend>
 void FeedPipeline(Pipeline *p, const string &name, py::list list, cudaStream_t stream,
                   bool sync = false, bool use_copy_kernel = false) {
@@ -1057,6 +1078,8 @@ PYBIND11_MODULE(backend_impl, m) {
   // DALI Init function
   m.def("Init", &DALIInit);
 
+  m.attr("CPU_ONLY_DEVICE_ID") = CPU_ONLY_DEVICE_ID;
+
   ExposeBufferPolicyFunctions(m);
 
   m.def("LoadLibrary", &PluginManager::LoadLibrary);
@@ -1212,6 +1235,29 @@ PYBIND11_MODULE(backend_impl, m) {
           auto ret = p->GetExecutorMeta();
           return ExecutorMetaToDict(ret);
         })
+    .def("SetCPUOpConcurrency",
+        [](Pipeline *p, int max_concurrent_ops) {
+          p->SetCPUOpConcurrency(max_concurrent_ops);
+        },
+        "max_concurrent_ops"_a)
+    .def("stage_timing_statistics",
+        [](Pipeline *p) {
+          py::dict d;
+          d["CPU"] = StageTimingStatsToDict(p->GetStageTimingStats(OpType::CPU));
+          d["MIXED"] = StageTimingStatsToDict(p->GetStageTimingStats(OpType::MIXED));
+          d["GPU"] = StageTimingStatsToDict(p->GetStageTimingStats(OpType::GPU));
+          return d;
+        })
+    .def("StartTracing",
+        [](Pipeline *p, int64_t events_per_thread) {
+          p->StartTracing(events_per_thread);
+        },
+        "events_per_thread"_a = tracing::kDefaultEventsPerThread)
+    .def("StopTracing",
+        [](Pipeline *p, const std::string &filename) {
+          p->StopTracing(filename);
+        },
+        "filename"_a, py::call_guard<py::gil_scoped_release>())
     .def("SetQueueSizes",
         [](Pipeline *p, int cpu_size, int gpu_size) {
           p->SetQueueSizes(cpu_size, gpu_size);
@@ -1362,7 +1408,23 @@ PYBIND11_MODULE(backend_impl, m) {
     DALI_OPSPEC_ADDARG(std::string)
     DALI_OPSPEC_ADDARG(bool)
     DALI_OPSPEC_ADDARG(int64)
-    DALI_OPSPEC_ADDARG(float)
+    // Python floats are double precision - keep it for the arguments declared as double
+    .def("AddArg",
+        [](OpSpec *spec, const string& name, double v) -> OpSpec& {
+        const OpSchema *schema = SchemaRegistry::TryGetSchema(spec->name());
+        if (schema && schema->HasArgument(name) &&
+            schema->GetArgumentType(name) == DALI_FLOAT64) {
+          spec->AddArg(name, v);
+        } else {
+          spec->AddArg(name, static_cast<float>(v));
+        }
+        return *spec;
+      }, py::return_value_policy::reference_internal)
+    .def("AddArg",
+        [](OpSpec *spec, const string& name, std::vector<float> v) -> OpSpec& {
+        spec->AddArg(name, v);
+        return *spec;
+      }, py::return_value_policy::reference_internal)
 #ifdef DALI_BUILD_PROTO3
     DALI_OPSPEC_ADDARG(TFFeature)
 #endif
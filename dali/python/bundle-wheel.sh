@@ -93,6 +93,7 @@ DEPS_LIST=(
     "/usr/local/lib/libavcodec.so.58"
     "/usr/local/lib/libavfilter.so.7"
     "/usr/local/lib/libavutil.so.56"
+    "/usr/local/lib/libswscale.so.5"
     "/usr/local/lib/libtiff.so.5"
     "/usr/local/lib/libsndfile.so.1"
     "/usr/local/lib/libFLAC.so.8"
@@ -107,6 +108,7 @@ DEPS_SONAME=(
     "libavcodec.so.58"
     "libavfilter.so.7"
     "libavutil.so.56"
+    "libswscale.so.5"
     "libtiff.so.5"
     "libsndfile.so.1"
     "libFLAC.so.8"
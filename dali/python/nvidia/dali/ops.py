@@ -926,13 +926,93 @@ def _generate_input_desc(categories_idx, integers, reals):
             input_desc += " "
     return input_desc
 
+# Maximum number of tensor inputs of ArithmeticGenericOp
+_arithm_op_max_inputs = 64
+
+# An expression computed by ArithmeticGenericOp - the function name and its inputs, which are
+# either nested expressions or the inputs accepted by `_group_inputs`.
+class _ArithmExpr(object):
+    def __init__(self, name, inputs):
+        self.name = name
+        self.inputs = inputs
+
+    # The inputs which are not expressions, in the order they appear in the expression
+    def leaves(self):
+        for input in self.inputs:
+            if isinstance(input, _ArithmExpr):
+                for leaf in input.leaves():
+                    yield leaf
+            else:
+                yield input
+
+# Creation order of the CPU arithmetic results - an expression only uses the results created
+# before it
+_arithm_result_ids = count()
+
+# Build the expression tree of `expr`, inlining the CPU arithmetic results it uses.
+# A result is inlined only if the tree uses it once - a result used more than once is read as
+# an input, so that its operator computes it once instead of duplicating the subexpression
+# for every use.
+def _inline_arithm_results(expr):
+    # The CPU arithmetic results reachable from `expr`, by id
+    results = {}
+    def collect(inputs):
+        for input in inputs:
+            if isinstance(input, _DataNode) and hasattr(input, "_arithm_expr") and \
+                    id(input) not in results:
+                results[id(input)] = input
+                collect(input._arithm_expr.inputs)
+    collect(expr.inputs)
+
+    # Count the uses in the tree - a result is used by the root and the results inlined into it.
+    # The results are visited in reverse creation order, so all uses of a result are counted
+    # before deciding whether it's inlined.
+    uses = {}
+    def count_uses(inputs):
+        for input in inputs:
+            if id(input) in results:
+                uses[id(input)] = uses.get(id(input), 0) + 1
+    count_uses(expr.inputs)
+    inlined = set()
+    for result in sorted(results.values(), key = lambda r: r._arithm_id, reverse = True):
+        if uses.get(id(result)) == 1:
+            inlined.add(id(result))
+            count_uses(result._arithm_expr.inputs)
+
+    def build(expr):
+        return _ArithmExpr(expr.name, [build(input._arithm_expr) if id(input) in inlined
+                                       else input for input in expr.inputs])
+    return build(expr)
+
+# Generate the <expr> as specified by grammar for ArithmeticGenericOp, taking the descriptions
+# of the leaves of the expression one by one from `leaf_descs`
+def _generate_expr_desc(expr, leaf_descs):
+    input_descs = []
+    for input in expr.inputs:
+        if isinstance(input, _ArithmExpr):
+            input_descs.append(_generate_expr_desc(input, leaf_descs))
+        else:
+            input_descs.append(next(leaf_descs))
+    return "{}({})".format(expr.name, " ".join(input_descs))
+
 # Create arguments for ArithmeticGenericOp and call it with supplied inputs.
 # Select the `gpu` device if at least one of the inputs is `gpu`, otherwise `cpu`.
+# The CPU operator evaluates whole expression trees, so the results of other CPU arithmetic
+# operations used once in the expression are replaced with the expressions computing them and
+# the whole tree runs as a single operator. The operators computing the inlined results are not
+# run unless their outputs are used elsewhere.
 def _arithm_op(name, *inputs):
-    categories_idxs, edges, integers, reals = _group_inputs(inputs)
+    dev = _choose_device(input for input in inputs if isinstance(input, _DataNode))
+    expr = _ArithmExpr(name, inputs)
+    merged = expr
+    if dev == "cpu":
+        merged = _inline_arithm_results(expr)
+        num_edges = sum(1 for leaf in merged.leaves() if isinstance(leaf, _DataNode))
+        if num_edges > _arithm_op_max_inputs:
+            merged = expr
+    categories_idxs, edges, integers, reals = _group_inputs(list(merged.leaves()))
     input_desc = _generate_input_desc(categories_idxs, integers, reals)
-    expression_desc = "{}({})".format(name, input_desc)
-    dev = _choose_device(edges)
+    expression_desc = _generate_expr_desc(merged, iter(input_desc.split(" ")))
     # Create "instance" of operator
     op = ArithmeticGenericOp(device = dev, expression_desc = expression_desc,
                              integer_constants = integers, real_constants = reals)
@@ -942,7 +1022,11 @@ def _arithm_op(name, *inputs):
     else:
         dev_inputs = edges
     # Call it immediately
-    return op(*dev_inputs)
+    result = op(*dev_inputs)
+    if dev == "cpu":
+        result._arithm_expr = expr
+        result._arithm_id = next(_arithm_result_ids)
+    return result
 
 def cpu_ops():
     return _cpu_ops
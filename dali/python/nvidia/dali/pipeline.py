@@ -60,11 +60,13 @@ Parameters
     Negative values for this parameter are invalid - the default
     value may only be used with serialized pipeline (the value
     stored in serialized pipeline is used instead).
-`device_id` : int, optional, default = -1
+`device_id` : int or None, optional, default = -1
     Id of GPU used by the pipeline.
     Negative values for this parameter are invalid - the default
     value may only be used with serialized pipeline (the value
     stored in serialized pipeline is used instead).
+    If None, the pipeline runs without any GPU - it can contain only CPU operators
+    and return only CPU outputs.
 `seed` : int, optional, default = -1
     Seed used for random number generation. Leaving the default value
     for this parameter results in random seed.
@@ -106,17 +108,22 @@ Parameters
 `enable_memory_stats`: bool, optional, default = False
     If DALI should print operator output buffer statistics.
     Usefull for `bytes_per_sample_hint` operator parameter.
+`cpu_op_concurrency`: int, optional, default = 1
+    Maximum number of CPU operators that can run at the same time. With values greater than 1
+    an operator starts as soon as its inputs are ready, so independent branches of the
+    pipeline run concurrently, sharing the `num_threads` worker threads.
+    See :meth:`stage_timing_statistics` for how much the operators overlap.
 """
     def __init__(self, batch_size = -1, num_threads = -1, device_id = -1, seed = -1,
                  exec_pipelined=True, prefetch_queue_depth=2,
                  exec_async=True, bytes_per_sample=0,
                  set_affinity=False, max_streams=-1, default_cuda_stream_priority = 0,
                  *,
-                 enable_memory_stats=False):
+                 enable_memory_stats=False, cpu_op_concurrency=1):
         self._sinks = []
         self._batch_size = batch_size
         self._num_threads = num_threads
-        self._device_id = device_id
+        self._device_id = _device_id_or_cpu_only(device_id)
         self._seed = seed
         self._exec_pipelined = exec_pipelined
         self._built = False
@@ -138,6 +145,7 @@ Parameters
         self._graph_out = None
         self._input_callbacks = None
         self._enable_memory_stats = enable_memory_stats
+        self._cpu_op_concurrency = cpu_op_concurrency
         if type(prefetch_queue_depth) is dict:
             self._exec_separated = True
             self._cpu_queue_size = prefetch_queue_depth["cpu_size"]
@@ -212,11 +220,83 @@ Parameters
 
         ``max_reserved_memory_size``: list of maximum memory sizes per tensor that is reserved for each of the operator outputs
                                   index in the list corresponds to the output index
+
+        The memory sizes are reported only when the memory statistics are enabled.
+        The timing keys are always present; the times are in seconds, over the most recent
+        256 iterations:
+
+        ``iterations``:           number of iterations the operator has run
+
+        ``min_time``, ``mean_time``, ``p50_time``, ``p99_time``: minimum, mean, median and
+                                  99th percentile of the wall time of a run of the operator
+
+        ``samples_per_sec``:      batch size divided by the mean run time
         """
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
         return self._pipe.executor_statistics()
 
+    def stage_timing_statistics(self):
+        """Returns the timing of the stages of the executor, over the most recent 256 iterations,
+        as a dictionary with the keys ``"CPU"``, ``"MIXED"`` and ``"GPU"``.
+
+        Available keys for each stage:
+
+        ``iterations``:              number of iterations the stage has run
+
+        ``window``:                  number of the iterations the statistics are calculated over
+
+        ``mean_queue_wait``, ``max_queue_wait``: time spent waiting for the outputs of
+                                     the previous stage or for free output buffers, in seconds
+
+        ``mean_run_time``:           wall time of an iteration, excluding the waiting, in seconds
+
+        ``samples_per_sec``:         throughput of the stage
+
+        ``thread_pool_utilization``: fraction of the run time of the CPU stage in which
+                                     the threads of the pool were busy; 0 for the other stages
+
+        ``op_overlap``:              sum of the run times of the CPU operators divided by the run
+                                     time of the CPU stage - average number of CPU operators
+                                     running at the same time; close to 1 when they run one
+                                     after another; 0 for the other stages
+
+        ``max_concurrent_ops``:      the largest number of CPU operators that were running at
+                                     once, over all the iterations; 0 for the other stages
+
+        CPU operators run concurrently when ``cpu_op_concurrency`` is greater than 1.
+
+        A stage which waits long for its queues is not the bottleneck of the pipeline.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.stage_timing_statistics()
+
+    def start_tracing(self, events_per_thread = 32768):
+        """Starts recording a host trace of the pipeline: the operators run by the executor,
+        the reader prefetching and other marked ranges, with the threads they run on and
+        the iteration numbers. The trace is written by :meth:`stop_tracing`.
+
+        The tracer is shared by all the pipelines in the process. Setting the ``DALI_TRACE_FILE``
+        environment variable records the trace of the whole process to that file.
+
+        Parameters
+        ----------
+        `events_per_thread` : int, optional, default = 32768
+                              Number of the most recent events kept for each thread.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.StartTracing(events_per_thread)
+
+    def stop_tracing(self, filename):
+        """Stops recording the host trace and writes it to `filename` in the Chrome trace
+        event format, which can be opened in ``chrome://tracing`` or Perfetto.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.StopTracing(filename)
+
     def reader_meta(self, name = None):
         """Returns provided reader metadata as a dictionary. If no name is provided if provides
         a dictionary with data for all readers as {reader_name : meta}
@@ -370,6 +450,7 @@ Parameters
         self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async)
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
+        self._pipe.SetCPUOpConcurrency(self._cpu_op_concurrency)
 
         if define_graph is not None:
             if self._graph_out is not None:
@@ -862,7 +943,7 @@ Parameters
             serialized_pipeline,
             kw.get("batch_size", -1),
             kw.get("num_threads", -1),
-            kw.get("device_id", -1),
+            _device_id_or_cpu_only(kw.get("device_id", -1)),
             kw.get("exec_pipelined", True),
             kw.get("prefetch_queue_depth", 2),
             kw.get("exec_async", True),
@@ -875,6 +956,7 @@ Parameters
                                          pipeline._exec_async)
         pipeline._pipe.SetQueueSizes(pipeline._cpu_queue_size, pipeline._gpu_queue_size)
         pipeline._pipe.EnableExecutorMemoryStats(pipeline._enable_memory_stats)
+        pipeline._pipe.SetCPUOpConcurrency(pipeline._cpu_op_concurrency)
         pipeline._prepared = True
         pipeline._pipe.Build()
         pipeline._built = True
@@ -902,6 +984,7 @@ Parameters
         self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async)
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
+        self._pipe.SetCPUOpConcurrency(self._cpu_op_concurrency)
         self._prepared = True
         self._pipe.Build()
         self._built = True
@@ -962,3 +1045,6 @@ Parameters
         For example, one can use this function to feed the input
         data from NumPy arrays."""
         pass
+
+def _device_id_or_cpu_only(device_id):
+    return b.CPU_ONLY_DEVICE_ID if device_id is None else device_id
@@ -44,6 +44,7 @@ _known_types = {
         DALIDataType.UINT32 : ("int", int),
         # DALIDataType.UINT64 : ("int", int), # everything else fits into the Python int
         DALIDataType.FLOAT : ("float", float),
+        DALIDataType.FLOAT64 : ("float", float),
         DALIDataType.BOOL : ("bool", bool),
         DALIDataType.STRING : ("str", str),
         DALIDataType._BOOL_VEC : ("bool", _to_list(bool)),
@@ -488,3 +488,65 @@ def test_bitwise_disallowed():
             for types_in in itertools.product(selected_input_types, selected_input_types):
                 if types_in[0] in float_types or types_in[1] in float_types:
                     yield check_raises, kinds, types_in, op, shape_small, op_desc
+
+
+def arithm_ops_in_pipeline(pipe):
+    return [op for op in pipe._ops if isinstance(op._op, ops.ArithmeticGenericOp)]
+
+def test_cpu_expression_fused():
+    shape = [(16, 8)] * batch_size
+    types_in = (np.int32, np.int32, np.int32)
+    kinds = ("cpu", "cpu", "cpu")
+    iterator = iter(ExternalInputIterator(batch_size, shape, types_in, kinds))
+    pipe = ExprOpPipeline(kinds, types_in, iterator, (lambda a, b, c: (a + b) * c),
+                          batch_size = batch_size, num_threads = 2, device_id = 0)
+    pipe.build()
+    arithm_ops = arithm_ops_in_pipeline(pipe)
+    assert_equals(len(arithm_ops), 1)
+    # the fused operator reads the external sources directly
+    assert_equals([inp.name for inp in arithm_ops[0].inputs],
+                  [source.name for source in pipe.source])
+    a, b, c, out = pipe.run()
+    for sample in range(batch_size):
+        expected = (as_cpu(a).at(sample) + as_cpu(b).at(sample)) * as_cpu(c).at(sample)
+        np.testing.assert_array_equal(as_cpu(out).at(sample), expected)
+
+def test_expression_on_gpu_not_fused():
+    shape = [(16, 8)] * batch_size
+    types_in = (np.int32, np.int32, np.int32)
+    kinds = ("cpu", "cpu", "gpu")
+    iterator = iter(ExternalInputIterator(batch_size, shape, types_in, kinds))
+    pipe = ExprOpPipeline(kinds, types_in, iterator, (lambda a, b, c: (a + b) * c),
+                          batch_size = batch_size, num_threads = 2, device_id = 0)
+    pipe.build()
+    # the GPU operator evaluates a single function, the sum is computed on the CPU
+    assert_equals(len(arithm_ops_in_pipeline(pipe)), 2)
+
+def check_shared_subexpression(op, num_arithm_ops):
+    shape = [(16, 8)] * batch_size
+    types_in = (np.float32, np.float32)
+    kinds = ("cpu", "cpu")
+    iterator = iter(ExternalInputIterator(batch_size, shape, types_in, kinds))
+    pipe = ExprOpPipeline(kinds, types_in, iterator, op,
+                          batch_size = batch_size, num_threads = 2, device_id = 0)
+    pipe.build()
+    # a result used more than once is computed by its own operator, not inlined for every use
+    assert_equals(len(arithm_ops_in_pipeline(pipe)), num_arithm_ops)
+    a, b, out = pipe.run()
+    for sample in range(batch_size):
+        expected = op(as_cpu(a).at(sample), as_cpu(b).at(sample))
+        np.testing.assert_allclose(as_cpu(out).at(sample), expected, rtol = 1e-6)
+
+def square(x):
+    return x * x
+
+def repeated_square(x, times):
+    for _ in range(times):
+        x = square(x)
+    return x
+
+def test_cpu_shared_subexpression_not_duplicated():
+    yield check_shared_subexpression, (lambda a, b: square(a + b)), 2
+    yield check_shared_subexpression, (lambda a, b: repeated_square(a - b, 4)), 5
+    # the sum is computed once, both products are inlined into the difference
+    yield check_shared_subexpression, (lambda a, b: (lambda x: x * 2 - x * 3)(a + b)), 2
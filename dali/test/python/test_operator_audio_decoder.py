@@ -136,3 +136,113 @@ def test_decoded_vs_generated():
       assert np.allclose(res_mix, rosa3, rtol = 0, atol=3e-3)
 
       idx = (idx + 1) % len(names)
+
+# windows, in input samples: (offset, duration); negative duration means "until the end"
+windows = [(0, 1000), (123, 4567), (5000, -1), (9000, 5000), (20000, 300)]
+
+class WindowDecoderPipeline(Pipeline):
+  def __init__(self, offset, duration, window_unit):
+    super(WindowDecoderPipeline, self).__init__(batch_size=len(names), num_threads=3,
+                                                device_id=0, exec_async=True, exec_pipelined=True)
+    self.file_source = ops.ExternalSource()
+    kwargs = dict(offset=float(offset), duration=float(duration), window_unit=window_unit, dtype=types.INT16)
+    self.plain_decoder = ops.AudioDecoder(dtype=types.INT16)
+    self.window_decoder = ops.AudioDecoder(**kwargs)
+    self.resampling_decoder = ops.AudioDecoder(sample_rate=rate1, dtype=types.FLOAT)
+    self.window_resampling_decoder = ops.AudioDecoder(sample_rate=rate1,
+                                                      **dict(kwargs, dtype=types.FLOAT))
+    self.window_resampling_downmixing_decoder = ops.AudioDecoder(sample_rate=rate2, downmix=True,
+                                                                 **dict(kwargs, dtype=types.FLOAT))
+    self.resampling_downmixing_decoder = ops.AudioDecoder(sample_rate=rate2, downmix=True,
+                                                          dtype=types.FLOAT)
+
+  def define_graph(self):
+    self.raw_file = self.file_source()
+    return [self.plain_decoder(self.raw_file)[0],
+            self.window_decoder(self.raw_file)[0],
+            self.resampling_decoder(self.raw_file)[0],
+            self.window_resampling_decoder(self.raw_file)[0],
+            self.resampling_downmixing_decoder(self.raw_file)[0],
+            self.window_resampling_downmixing_decoder(self.raw_file)[0]]
+
+  def iter_setup(self):
+    list = []
+    for name in names:
+      with open(name, mode = "rb") as f:
+        list.append(np.array(bytearray(f.read()), np.uint8))
+    self.feed_input(self.raw_file, list)
+
+def check_window(offset, duration, window_unit):
+  pipeline = WindowDecoderPipeline(offset, duration, window_unit)
+  pipeline.build()
+  out = pipeline.run()
+  for i in range(len(names)):
+    if window_unit == "seconds":
+      begin = int(round(offset * rates[i]))
+      end = lengths[i] if duration < 0 else begin + int(round(duration * rates[i]))
+    else:
+      begin = offset
+      end = lengths[i] if duration < 0 else begin + duration
+    begin = min(begin, lengths[i])
+    end = min(end, lengths[i])
+
+    plain = out[0].at(i)
+    assert np.array_equal(out[1].at(i), plain[begin:end])
+
+    for full, window, out_rate in [(out[2].at(i), out[3].at(i), rate1),
+                                   (out[4].at(i), out[5].at(i), rate2)]:
+      out_begin = int(math.ceil(begin * out_rate / rates[i]))
+      out_end = int(math.ceil(end * out_rate / rates[i]))
+      assert window.shape[0] == out_end - out_begin
+      # the window is resampled as a part of the whole recording
+      assert np.allclose(window, full[out_begin:out_end], rtol=0, atol=4e-3)
+
+def test_decode_window():
+  for offset, duration in windows:
+    yield check_window, offset, duration, "samples"
+  for offset, duration in [(0.1, 0.2), (0.5, -1.0), (2.5, 1.0)]:
+    yield check_window, offset, duration, "seconds"
+
+# offsets above 2^24 samples are not representable in single precision
+long_name = "/tmp/dali_test_long.wav"
+long_rate = 8000
+long_length = (1 << 24) + 10000
+
+def create_long_test_file():
+  np.random.seed(1234)
+  wave = np.random.randint(-32768, 32768, size=long_length).astype(np.int16)
+  scipy.io.wavfile.write(long_name, long_rate, wave)
+
+class LongWindowDecoderPipeline(Pipeline):
+  def __init__(self, offset, duration, window_unit):
+    super(LongWindowDecoderPipeline, self).__init__(batch_size=1, num_threads=1, device_id=0)
+    self.file_source = ops.ExternalSource()
+    self.plain_decoder = ops.AudioDecoder(dtype=types.INT16)
+    self.window_decoder = ops.AudioDecoder(offset=offset, duration=duration,
+                                           window_unit=window_unit, dtype=types.INT16)
+
+  def define_graph(self):
+    self.raw_file = self.file_source()
+    return [self.plain_decoder(self.raw_file)[0],
+            self.window_decoder(self.raw_file)[0]]
+
+  def iter_setup(self):
+    with open(long_name, mode = "rb") as f:
+      self.feed_input(self.raw_file, [np.array(bytearray(f.read()), np.uint8)])
+
+def check_long_window(begin, length, window_unit):
+  if window_unit == "seconds":
+    pipeline = LongWindowDecoderPipeline(begin / long_rate, length / long_rate, window_unit)
+  else:
+    pipeline = LongWindowDecoderPipeline(begin, length, window_unit)
+  pipeline.build()
+  plain, window = pipeline.run()
+  plain = plain.at(0)
+  assert plain.shape[0] == long_length
+  assert np.array_equal(window.at(0), plain[begin:begin + length])
+
+def test_decode_window_large_offset():
+  create_long_test_file()
+  for begin, length in [((1 << 24) + 1, 1000), ((1 << 24) + 3, 777), (long_length - 5, 5)]:
+    yield check_long_window, begin, length, "samples"
+  yield check_long_window, (1 << 24) + 1, 1000, "seconds"
@@ -23,7 +23,8 @@ import tempfile
 import nose.tools
 
 class NumpyReaderPipeline(Pipeline):
-    def __init__(self, path, batch_size, path_filter="*.npy", num_threads=1, device_id=0, num_gpus=1):
+    def __init__(self, path, batch_size, path_filter="*.npy", num_threads=1, device_id=0, num_gpus=1,
+                 **kwargs):
         super(NumpyReaderPipeline, self).__init__(batch_size,
                                                   num_threads,
                                                   device_id)
@@ -31,7 +32,8 @@ class NumpyReaderPipeline(Pipeline):
         self.input = ops.NumpyReader(file_root = path,
                                      file_filter = path_filter,
                                      shard_id = device_id,
-                                     num_shards = num_gpus)
+                                     num_shards = num_gpus,
+                                     **kwargs)
 
     def define_graph(self):
         inputs = self.input(name="Reader")
@@ -105,7 +107,70 @@ def test_batch():
                 # compare
                 assert_array_equal(arr_rd, arr_np)
             
-                    
+
+# test reading only the region of interest
+def test_roi():
+    with tempfile.TemporaryDirectory() as test_data_root:
+        shape = (6, 8, 10)
+        rois = [((0, 0, 0), (6, 8, 10)),
+                ((1, 2, 3), (2, 3, 4)),
+                ((0, 0, 5), (6, 8, 5)),
+                ((2, 0, 0), (1, 8, 10)),
+                ((3, 4, 0), None),
+                (None, (2, 2, 2)),
+                ((1, 1, 1), (-1, 3, -1))]
+        for fortran_order in [False, True]:
+            filename = os.path.join(test_data_root, "test_roi.npy")
+            create_numpy_file(filename, shape, np.float32, fortran_order)
+            arr_np = np.load(filename)
+            for roi_start, roi_shape in rois:
+                yield check_roi, filename, arr_np, roi_start, roi_shape
+
+def check_roi(filename, arr_np, roi_start, roi_shape):
+    kwargs = {}
+    if roi_start is not None:
+        kwargs["roi_start"] = roi_start
+    if roi_shape is not None:
+        kwargs["roi_shape"] = roi_shape
+    pipe = NumpyReaderPipeline(path = os.path.dirname(filename),
+                               path_filter = os.path.basename(filename),
+                               batch_size = 1,
+                               num_threads = 1,
+                               device_id = 0,
+                               **kwargs)
+    pipe.build()
+    # the second run reads the header from the cache
+    for _ in range(2):
+        pipe_out = pipe.run()
+        arr_rd = np.squeeze(pipe_out[0].as_array(), axis=0)
+        start = roi_start or (0,) * arr_np.ndim
+        roi = tuple(slice(s, None if roi_shape is None or roi_shape[i] < 0 else s + roi_shape[i])
+                    for i, s in enumerate(start))
+        assert_array_equal(arr_rd, arr_np[roi])
+
+# test returning Fortran-order arrays in their storage order
+def test_fortran_order_storage():
+    with tempfile.TemporaryDirectory() as test_data_root:
+        for shape in [(11,), (4, 7), (6, 2, 5)]:
+            filename = os.path.join(test_data_root, "test_fortran.npy")
+            create_numpy_file(filename, shape, np.float32, True)
+            pipe = NumpyReaderPipeline(path = test_data_root,
+                                       path_filter = "test_fortran.npy",
+                                       batch_size = 1,
+                                       num_threads = 2,
+                                       device_id = 0,
+                                       transpose_fortran_order = False)
+            pipe.build()
+            arr_rd = np.squeeze(pipe.run()[0].as_array(), axis=0)
+            assert_array_equal(arr_rd, np.load(filename).T)
+
+def test_roi_out_of_bounds():
+    with tempfile.TemporaryDirectory() as test_data_root:
+        filename = os.path.join(test_data_root, "test_roi.npy")
+        create_numpy_file(filename, (6, 8), np.float32, False)
+        arr_np = np.load(filename)
+        nose.tools.assert_raises(RuntimeError, check_roi, filename, arr_np, (4, 0), (3, 8))
+
 def create_numpy_file(filename, shape, typ, fortran_order):
     # generate random array
     arr = rng.random_sample(shape) * 10.
@@ -141,3 +206,44 @@ def check_array(filename, shape, typ, fortran_order=False):
 
     # delete temp files
     delete_numpy_file(filename)
+
+class NumpyReaderResizePipeline(Pipeline):
+    def __init__(self, path, batch_size, path_filter, scale, num_threads=1, device_id=0):
+        super(NumpyReaderResizePipeline, self).__init__(batch_size, num_threads, device_id)
+        self.input = ops.NumpyReader(file_root = path, file_filter = path_filter)
+        self.layout = ops.Reshape(layout = "DHWC")
+        self.resize = ops.Resize(device = "cpu", interp_type = types.INTERP_NN,
+                                 resize_z = scale[0], resize_y = scale[1], resize_x = scale[2])
+
+    def define_graph(self):
+        volume = self.layout(self.input(name="Reader"))
+        return volume, self.resize(volume)
+
+# test resizing DHWC volumes loaded with the reader, on the CPU
+def test_dhwc_volume_resize_cpu():
+    with tempfile.TemporaryDirectory() as test_data_root:
+        num_samples = 4
+        shape = (6, 8, 10, 3)
+        filenames = []
+        for index in range(num_samples):
+            filename = os.path.join(test_data_root, "volume_{:02d}.npy".format(index))
+            filenames.append(filename)
+            np.save(filename, rng.randint(0, 256, shape).astype(np.uint8))
+
+        out_size = [2 * extent for extent in shape[:3]]
+        for num_threads in [1, 4]:
+            pipe = NumpyReaderResizePipeline(path = test_data_root,
+                                             path_filter = "volume_*.npy",
+                                             batch_size = num_samples,
+                                             scale = out_size,
+                                             num_threads = num_threads)
+            pipe.build()
+            volumes, resized = pipe.run()
+            assert volumes.layout() == "DHWC"
+            assert resized.layout() == "DHWC"
+            for i in range(num_samples):
+                volume = np.load(filenames[i])
+                assert_array_equal(volumes.at(i), volume)
+                # nearest neighbor upscaling by 2 repeats each voxel twice along each axis
+                expected = volume.repeat(2, axis=0).repeat(2, axis=1).repeat(2, axis=2)
+                assert_array_equal(resized.at(i), expected)
@@ -998,8 +998,10 @@ def test_pipeline_default_cuda_stream_priority():
             assert(np.sum(np.abs(out1_data.at(i)-out2_data.at(i)))==0)
 
 class CachedPipeline(Pipeline):
-    def __init__(self, reader_type, batch_size, is_cached=False, is_cached_batch_copy=True,  seed=123456, skip_cached_images=False, num_shards=100000):
-        super(CachedPipeline, self).__init__(batch_size, num_threads=1, device_id=0, prefetch_queue_depth=1, seed=seed)
+    def __init__(self, reader_type, batch_size, is_cached=False, is_cached_batch_copy=True,  seed=123456, skip_cached_images=False, num_shards=100000,
+                 decoder_device="mixed", cache_type="threshold"):
+        device_id = 0 if decoder_device == "mixed" else None
+        super(CachedPipeline, self).__init__(batch_size, num_threads=1, device_id=device_id, prefetch_queue_depth=1, seed=seed)
         self.reader_type = reader_type
         if reader_type == "MXNetReader":
             self.input = ops.MXNetReader(path = os.path.join(recordio_db_folder, "train.rec"),
@@ -1044,14 +1046,14 @@ class CachedPipeline(Pipeline):
                                                         "image/class/label": tfrec.FixedLenFeature([1], tfrec.int64,  -1)})
 
         if is_cached:
-            self.decode = ops.ImageDecoder(device = "mixed", output_type = types.RGB,
+            self.decode = ops.ImageDecoder(device = decoder_device, output_type = types.RGB,
                                             cache_size=2000,
                                             cache_threshold=0,
-                                            cache_type='threshold',
+                                            cache_type=cache_type,
                                             cache_debug=False,
                                             cache_batch_copy=is_cached_batch_copy)
         else:
-           self.decode = ops.ImageDecoder(device = "mixed", output_type = types.RGB)
+           self.decode = ops.ImageDecoder(device = decoder_device, output_type = types.RGB)
 
     def define_graph(self):
         if self.reader_type == "TFRecordReader":
@@ -1085,6 +1087,31 @@ def test_skip_cached_images():
                           CachedPipeline(reader_type, batch_size, is_cached=True, skip_cached_images=True),
                           batch_size=batch_size, N_iterations=100)
 
+def test_host_decoder_cached_pipelines():
+    batch_size = 26
+    for cache_type in ["threshold", "largest", "lru"]:
+        for reader_type in {"MXNetReader", "CaffeReader", "Caffe2Reader", "FileReader", "TFRecordReader"}:
+            compare_pipelines(CachedPipeline(reader_type, batch_size, is_cached=False, decoder_device="cpu"),
+                              CachedPipeline(reader_type, batch_size, is_cached=True, decoder_device="cpu",
+                                             cache_type=cache_type),
+                              batch_size=batch_size, N_iterations=20)
+
+def test_host_decoder_skip_cached_images():
+    batch_size = 1
+    for cache_type in ["threshold", "largest"]:
+        for reader_type in {"MXNetReader", "CaffeReader", "Caffe2Reader", "FileReader"}:
+            compare_pipelines(CachedPipeline(reader_type, batch_size, is_cached=False, decoder_device="cpu"),
+                              CachedPipeline(reader_type, batch_size, is_cached=True, skip_cached_images=True,
+                                             decoder_device="cpu", cache_type=cache_type),
+                              batch_size=batch_size, N_iterations=100)
+
+@raises(RuntimeError)
+def test_host_decoder_skip_cached_images_lru():
+    pipe = CachedPipeline("FileReader", 1, is_cached=True, skip_cached_images=True,
+                          decoder_device="cpu", cache_type="lru")
+    pipe.build()
+    pipe.run()
+
 def test_caffe_no_label():
     class CaffePipeline(Pipeline):
         def __init__(self, batch_size, path_to_data, labels, seed=123456, skip_cached_images=False, num_shards=1):
@@ -1693,3 +1720,101 @@ def test_epoch_size():
     assert(pipe.epoch_size("caffe2_reader") != 0)
     assert(pipe.epoch_size("file_reader") != 0)
     assert(len(pipe.epoch_size()) == 4)
+
+def test_cpu_only_pipeline():
+    batch_size = 4
+    data = [np.arange(15, dtype=np.int32).reshape(3, 5, 1) + i for i in range(batch_size)]
+    pipe = Pipeline(batch_size, 2, device_id=None)
+    with pipe:
+        inp = fn.external_source(source=lambda: data, layout="HWC")
+        pipe.set_outputs(inp, fn.flip(inp, horizontal=1))
+    pipe.build()
+    for _ in range(3):
+        out, flipped = pipe.run()
+        for i in range(batch_size):
+            assert_array_equal(out.at(i), data[i])
+            assert_array_equal(flipped.at(i), data[i][:, ::-1, :])
+
+@raises(RuntimeError)
+def test_cpu_only_pipeline_gpu_op():
+    pipe = Pipeline(1, 2, device_id=None)
+    with pipe:
+        pipe.set_outputs(fn.external_source(source=lambda: [np.zeros(3)], device="gpu"))
+    pipe.build()
+
+def test_concurrent_cpu_ops():
+    batch_size = 4
+    data = [np.arange(15, dtype=np.int32).reshape(3, 5, 1) + i for i in range(batch_size)]
+    pipe = Pipeline(batch_size, 2, device_id=None, cpu_op_concurrency=4)
+    with pipe:
+        inp = fn.external_source(source=lambda: data, layout="HWC")
+        h = fn.flip(inp, horizontal=1)
+        v = fn.flip(inp, horizontal=0, vertical=1)
+        hv = fn.flip(h, horizontal=0, vertical=1)
+        pipe.set_outputs(h, v, hv)
+    pipe.build()
+    iters = 3
+    for _ in range(iters):
+        h, v, hv = pipe.run()
+        for i in range(batch_size):
+            assert_array_equal(h.at(i), data[i][:, ::-1, :])
+            assert_array_equal(v.at(i), data[i][::-1, :, :])
+            assert_array_equal(hv.at(i), data[i][::-1, ::-1, :])
+    stats = pipe.stage_timing_statistics()["CPU"]
+    assert stats["iterations"] >= iters
+    assert 1 <= stats["max_concurrent_ops"] <= 4
+    assert stats["op_overlap"] > 0
+
+def test_tracing():
+    import json
+    import tempfile
+    batch_size = 4
+    data = [np.full((3, 5, 1), i, dtype=np.uint8) for i in range(batch_size)]
+    pipe = Pipeline(batch_size, 2, device_id=None)
+    with pipe:
+        inp = fn.external_source(source=lambda: data, layout="HWC", name="trace_input")
+        pipe.set_outputs(fn.flip(inp, horizontal=1, name="trace_flip"))
+    pipe.build()
+    iters = 3
+    with tempfile.NamedTemporaryFile(suffix=".json") as f:
+        pipe.start_tracing()
+        for _ in range(iters):
+            pipe.run()
+        pipe.stop_tracing(f.name)
+        trace = json.load(open(f.name))
+    events = trace["traceEvents"]
+    flip_events = [e for e in events if e["name"] == "[Executor] Run CPU op trace_flip"]
+    assert len(flip_events) >= iters
+    iterations = [e["args"]["iteration"] for e in flip_events]
+    assert iterations == sorted(iterations)
+    for e in flip_events:
+        assert e["ph"] == "X" and e["dur"] >= 0
+    thread_names = [e["args"]["name"] for e in events if e["name"] == "thread_name"]
+    assert any(name.startswith("ThreadPool") for name in thread_names)
+
+def test_timing_statistics():
+    batch_size = 4
+    data = [np.full((3, 5, 1), i, dtype=np.uint8) for i in range(batch_size)]
+    pipe = Pipeline(batch_size, 2, device_id=None)
+    with pipe:
+        inp = fn.external_source(source=lambda: data, layout="HWC")
+        pipe.set_outputs(fn.flip(inp, horizontal=1, name="timed_flip"))
+    pipe.build()
+    iters = 5
+    for _ in range(iters):
+        pipe.run()
+    flip_stats = pipe.executor_statistics()["CPU_timed_flip"]
+    assert flip_stats["iterations"] >= iters
+    assert 0 < flip_stats["min_time"] <= flip_stats["p50_time"] <= flip_stats["p99_time"]
+    assert flip_stats["samples_per_sec"] > 0
+    stages = pipe.stage_timing_statistics()
+    assert set(stages.keys()) == {"CPU", "MIXED", "GPU"}
+    for stats in stages.values():
+        assert stats["iterations"] >= iters
+        assert stats["window"] == min(stats["iterations"], 256)
+        assert stats["max_queue_wait"] >= stats["mean_queue_wait"] >= 0
+        assert stats["samples_per_sec"] > 0
+    assert 0 <= stages["CPU"]["thread_pool_utilization"] <= 1
+    assert stages["CPU"]["max_concurrent_ops"] == 1
+    for stage in ("MIXED", "GPU"):
+        assert stages[stage]["op_overlap"] == 0 and stages[stage]["max_concurrent_ops"] == 0
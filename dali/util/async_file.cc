@@ -0,0 +1,541 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/util/async_file.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define DALI_HAS_IO_URING 1
+#endif
+#endif
+
+namespace dali {
+
+AsyncIOBackend ParseAsyncIOBackend(const std::string &name) {
+  if (name == "sync")
+    return AsyncIOBackend::Sync;
+  if (name == "auto")
+    return AsyncIOBackend::Auto;
+  if (name == "io_uring")
+    return AsyncIOBackend::IOUring;
+  if (name == "threads")
+    return AsyncIOBackend::Threads;
+  DALI_FAIL(make_string("Unknown I/O backend: \"", name,
+                        "\". Valid values are: \"sync\", \"auto\", \"io_uring\" and \"threads\"."));
+}
+
+namespace {
+
+/**
+ * @brief Reads exactly n_bytes at given offset, unless end of file or an error is encountered.
+ *
+ * @return number of bytes read
+ */
+size_t PReadFull(int fd, void *buffer, size_t n_bytes, int64 offset) {
+  size_t total = 0;
+  char *dst = static_cast<char *>(buffer);
+  while (total < n_bytes) {
+    ssize_t n = pread(fd, dst + total, n_bytes - total, offset + total);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      DALI_FAIL(make_string("Read operation did not succeed: ", std::strerror(errno)));
+    }
+    if (n == 0)
+      break;
+    total += n;
+  }
+  return total;
+}
+
+std::string ShortReadError(const std::string &name, size_t expected, size_t actual) {
+  return make_string("Failed to read file ", name, ": expected ", expected,
+                     " bytes, got ", actual);
+}
+
+class ThreadedFileReader : public AsyncFileReader {
+ public:
+  explicit ThreadedFileReader(int queue_depth) : AsyncFileReader(queue_depth) {
+    threads_.reserve(queue_depth);
+    for (int i = 0; i < queue_depth; i++)
+      threads_.emplace_back([this]() { WorkerLoop(); });
+  }
+
+  ~ThreadedFileReader() override {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      stop_ = true;
+    }
+    work_cv_.notify_all();
+    // the workers drain the queue before exiting, so no buffer is touched after this point
+    for (auto &t : threads_)
+      t.join();
+  }
+
+  void Submit(int fd, void *buffer, size_t n_bytes, int64 offset,
+              const std::string &name) override {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      done_cv_.wait(lock, [&]() { return in_flight_ < queue_depth_; });
+      queue_.push_back({ fd, buffer, n_bytes, offset, name });
+      in_flight_++;
+    }
+    work_cv_.notify_one();
+  }
+
+  void Wait() override {
+    std::unique_lock<std::mutex> lock(mtx_);
+    done_cv_.wait(lock, [&]() { return in_flight_ == 0; });
+    if (!error_.empty()) {
+      std::string error = std::move(error_);
+      error_.clear();
+      DALI_FAIL(error);
+    }
+  }
+
+  AsyncIOBackend Backend() const override {
+    return AsyncIOBackend::Threads;
+  }
+
+ private:
+  struct Request {
+    int fd;
+    void *buffer;
+    size_t n_bytes;
+    int64 offset;
+    std::string name;
+  };
+
+  void WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    for (;;) {
+      work_cv_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty())
+        return;  // stop_ is set and there's no more work
+      Request req = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+
+      std::string error;
+      try {
+        size_t n = PReadFull(req.fd, req.buffer, req.n_bytes, req.offset);
+        if (n != req.n_bytes)
+          error = ShortReadError(req.name, req.n_bytes, n);
+      } catch (const std::exception &e) {
+        error = make_string("Failed to read file ", req.name, ": ", e.what());
+      }
+
+      lock.lock();
+      if (!error.empty() && error_.empty())
+        error_ = std::move(error);
+      in_flight_--;
+      done_cv_.notify_all();
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable work_cv_, done_cv_;
+  std::deque<Request> queue_;
+  int in_flight_ = 0;
+  bool stop_ = false;
+  std::string error_;
+  std::vector<std::thread> threads_;
+};
+
+#if DALI_HAS_IO_URING
+
+int IOUringSetup(unsigned entries, io_uring_params *params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int IOUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+/**
+ * @brief io_uring-based reader
+ *
+ * The rings are managed directly through the system calls, so there's no dependency on liburing.
+ * Each request occupies one of `queue_depth` slots, which hold the state of the read
+ * (the read is resubmitted after a short read).
+ */
+class IOUringFileReader : public AsyncFileReader {
+ public:
+  explicit IOUringFileReader(int queue_depth)
+  : AsyncFileReader(queue_depth), slots_(queue_depth) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = IOUringSetup(queue_depth, &params);
+    DALI_ENFORCE(ring_fd_ >= 0, make_string("io_uring setup failed: ", std::strerror(errno)));
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+#endif
+    if (single_mmap)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = MapRing(sq_ring_size_, IORING_OFF_SQ_RING);
+    cq_ring_ = single_mmap ? sq_ring_ : MapRing(cq_ring_size_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe *>(MapRing(sqes_size_, IORING_OFF_SQES));
+
+    char *sq = static_cast<char *>(sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+    char *cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    free_slots_.reserve(queue_depth);
+    for (int i = queue_depth - 1; i >= 0; i--)
+      free_slots_.push_back(i);
+  }
+
+  ~IOUringFileReader() override {
+    try {
+      // the kernel may still write to the buffers - wait for the reads to complete
+      while (InFlight() > 0)
+        Reap(true);
+    } catch (...) {
+      // nothing we can do about it here
+    }
+    UnmapRings();
+    close(ring_fd_);
+  }
+
+  void Submit(int fd, void *buffer, size_t n_bytes, int64 offset,
+              const std::string &name) override {
+    if (n_bytes == 0)
+      return;
+    while (free_slots_.empty())
+      Reap(true);
+    int slot_idx = free_slots_.back();
+    free_slots_.pop_back();
+    Slot &slot = slots_[slot_idx];
+    slot.fd = fd;
+    slot.dst = static_cast<char *>(buffer);
+    slot.remaining = n_bytes;
+    slot.total = n_bytes;
+    slot.offset = offset;
+    slot.name = name;
+    Push(slot_idx);
+    SubmitPushed();
+  }
+
+  void Wait() override {
+    while (InFlight() > 0)
+      Reap(true);
+    if (!error_.empty()) {
+      std::string error = std::move(error_);
+      error_.clear();
+      DALI_FAIL(error);
+    }
+  }
+
+  AsyncIOBackend Backend() const override {
+    return AsyncIOBackend::IOUring;
+  }
+
+ private:
+  struct Slot {
+    int fd;
+    char *dst;
+    size_t remaining, total;
+    int64 offset;
+    iovec iov;
+    std::string name;
+  };
+
+  /**
+   * @brief Maps one of the rings; on failure, releases the rings mapped so far and the ring
+   *        file descriptor, as the destructor won't run for the partially constructed reader
+   */
+  void *MapRing(size_t size, off_t offset) {
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ring_fd_, offset);
+    if (ptr == MAP_FAILED) {
+      int err = errno;
+      UnmapRings();
+      close(ring_fd_);
+      DALI_FAIL(make_string("Cannot map io_uring buffers: ", std::strerror(err)));
+    }
+    return ptr;
+  }
+
+  void UnmapRings() {
+    if (sqes_)
+      munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_)
+      munmap(sq_ring_, sq_ring_size_);
+    sqes_ = nullptr;
+    sq_ring_ = cq_ring_ = nullptr;
+  }
+
+  int InFlight() const {
+    return queue_depth_ - static_cast<int>(free_slots_.size());
+  }
+
+  /**
+   * @brief Places a read request for given slot in the submission queue
+   *
+   * There's no need to check for free space - there are at most queue_depth requests and
+   * the submission queue is at least that large.
+   */
+  void Push(int slot_idx) {
+    Slot &slot = slots_[slot_idx];
+    slot.iov.iov_base = slot.dst;
+    slot.iov.iov_len = slot.remaining;
+
+    unsigned tail = *sq_tail_;  // only this thread writes the tail
+    unsigned idx = tail & sq_mask_;
+    io_uring_sqe *sqe = &sqes_[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = slot.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.iov);
+    sqe->len = 1;
+    sqe->off = slot.offset;
+    sqe->user_data = slot_idx;
+    sq_array_[idx] = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    to_submit_++;
+  }
+
+  void SubmitPushed() {
+    int backoff_us = kMinSubmitBackoffUs;
+    while (to_submit_ > 0) {
+      int ret = IOUringEnter(ring_fd_, to_submit_, 0, 0);
+      if (ret < 0) {
+        if (errno == EINTR)
+          continue;
+        if (errno == EAGAIN || errno == EBUSY) {
+          // The kernel is short of resources or the completion queue is full - wait until
+          // a request completes and make some room. When the kernel holds no requests,
+          // nothing will complete, so back off for a while instead.
+          if (InFlight() > static_cast<int>(to_submit_)) {
+            WaitForCompletion();
+          } else {
+            DALI_ENFORCE(backoff_us <= kMaxSubmitBackoffUs, make_string(
+                "io_uring submission failed: ", std::strerror(errno)));
+            std::this_thread::sleep_for(std::chrono::microseconds(backoff_us));
+            backoff_us *= 2;
+          }
+          ReapAvailable();
+          continue;
+        }
+        DALI_FAIL(make_string("io_uring submission failed: ", std::strerror(errno)));
+      }
+      to_submit_ -= ret;
+      backoff_us = kMinSubmitBackoffUs;
+    }
+  }
+
+  /**
+   * @brief Processes the completed requests; if `wait` is true, waits for at least one
+   */
+  void Reap(bool wait) {
+    if (wait)
+      WaitForCompletion();
+    ReapAvailable();
+    SubmitPushed();
+  }
+
+  /**
+   * @brief Blocks until the completion queue is not empty
+   */
+  void WaitForCompletion() {
+    if (__atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) == *cq_head_) {
+      int ret = IOUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+      if (ret < 0 && errno != EINTR && errno != EAGAIN)
+        DALI_FAIL(make_string("Waiting for io_uring completion failed: ", std::strerror(errno)));
+    }
+  }
+
+  void ReapAvailable() {
+    unsigned head = *cq_head_;  // only this thread writes the head
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+      Complete(static_cast<int>(cqe.user_data), cqe.res);
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+  void Complete(int slot_idx, int result) {
+    Slot &slot = slots_[slot_idx];
+    if (result < 0) {
+      if (result == -EINTR || result == -EAGAIN) {
+        Push(slot_idx);
+        return;
+      }
+      SetError(make_string("Failed to read file ", slot.name, ": ", std::strerror(-result)));
+    } else if (result == 0) {
+      SetError(ShortReadError(slot.name, slot.total, slot.total - slot.remaining));
+    } else if (static_cast<size_t>(result) < slot.remaining) {
+      // short read - continue from where it stopped
+      slot.dst += result;
+      slot.offset += result;
+      slot.remaining -= result;
+      Push(slot_idx);
+      return;
+    }
+    free_slots_.push_back(slot_idx);
+  }
+
+  void SetError(std::string error) {
+    if (error_.empty())
+      error_ = std::move(error);
+  }
+
+  /// How long to wait before retrying a submission the kernel refused while holding no requests;
+  /// doubled on each retry, up to the maximum (about 100 ms in total)
+  static constexpr int kMinSubmitBackoffUs = 50;
+  static constexpr int kMaxSubmitBackoffUs = 51200;
+
+  int ring_fd_ = -1;
+  void *sq_ring_ = nullptr, *cq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0, cq_ring_size_ = 0, sqes_size_ = 0;
+  io_uring_sqe *sqes_ = nullptr;
+  unsigned *sq_tail_ = nullptr, *sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe *cqes_ = nullptr;
+  unsigned to_submit_ = 0;
+
+  std::vector<Slot> slots_;
+  std::vector<int> free_slots_;
+  std::string error_;
+};
+
+#endif  // DALI_HAS_IO_URING
+
+}  // namespace
+
+bool AsyncFileReader::IOUringSupported() {
+#if DALI_HAS_IO_URING
+  static const bool supported = []() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = IOUringSetup(1, &params);
+    if (fd < 0)
+      return false;  // e.g. ENOSYS on old kernels or EPERM when blocked by seccomp
+    close(fd);
+    return true;
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+std::unique_ptr<AsyncFileReader> AsyncFileReader::Create(AsyncIOBackend backend,
+                                                         int queue_depth) {
+  DALI_ENFORCE(queue_depth > 0, make_string("I/O queue depth must be positive. Got: ",
+                                            queue_depth));
+  if (backend == AsyncIOBackend::Auto)
+    backend = IOUringSupported() ? AsyncIOBackend::IOUring : AsyncIOBackend::Threads;
+
+  switch (backend) {
+    case AsyncIOBackend::IOUring:
+      DALI_ENFORCE(IOUringSupported(), "io_uring is not supported on this system");
+#if DALI_HAS_IO_URING
+      return std::unique_ptr<AsyncFileReader>(new IOUringFileReader(queue_depth));
+#else
+      return nullptr;
+#endif
+    case AsyncIOBackend::Threads:
+      return std::unique_ptr<AsyncFileReader>(new ThreadedFileReader(queue_depth));
+    default:
+      return nullptr;
+  }
+}
+
+AsyncFileStream::AsyncFileStream(const std::string &path, AsyncFileReader *reader)
+: FileStream(path), reader_(reader) {
+  fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  DALI_ENFORCE(fd_ >= 0, "Could not open file " + path + ": " + std::strerror(errno));
+}
+
+void AsyncFileStream::Close() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+shared_ptr<void> AsyncFileStream::Get(size_t /*n_bytes*/) {
+  // the data is not mapped - there's nothing to share
+  return {};
+}
+
+size_t AsyncFileStream::Read(uint8_t *buffer, size_t n_bytes) {
+  size_t n_read = PReadFull(fd_, buffer, n_bytes, pos_);
+  pos_ += n_read;
+  return n_read;
+}
+
+void AsyncFileStream::ReadAsync(uint8_t *buffer, size_t n_bytes) {
+  if (!reader_) {
+    FileStream::ReadAsync(buffer, n_bytes);
+    return;
+  }
+  reader_->Submit(fd_, buffer, n_bytes, pos_, path_);
+  pos_ += n_bytes;
+}
+
+void AsyncFileStream::Seek(int64 pos) {
+  DALI_ENFORCE(pos >= 0, make_string("Invalid seek position: ", pos));
+  pos_ = pos;
+}
+
+size_t AsyncFileStream::Size() const {
+  struct stat sb;
+  if (fstat(fd_, &sb) == -1) {
+    DALI_FAIL("Unable to stat file " + path_ + ": " + std::strerror(errno));
+  }
+  return sb.st_size;
+}
+
+}  // namespace dali
@@ -0,0 +1,119 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_ASYNC_FILE_H_
+#define DALI_UTIL_ASYNC_FILE_H_
+
+#include <memory>
+#include <string>
+
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+enum class AsyncIOBackend {
+  Sync,     ///< no asynchronous I/O - blocking reads
+  Auto,     ///< io_uring, if supported by the kernel, otherwise Threads
+  IOUring,  ///< Linux io_uring
+  Threads,  ///< a pool of threads issuing blocking positional reads
+};
+
+/**
+ * @brief Parses the name of an I/O backend: "sync", "auto", "io_uring" or "threads"
+ */
+DLL_PUBLIC AsyncIOBackend ParseAsyncIOBackend(const std::string &name);
+
+/**
+ * @brief Reads file fragments with multiple requests in flight
+ *
+ * The reads are submitted with Submit and are guaranteed to be complete only after a call
+ * to Wait. The buffers and file descriptors must stay valid until then.
+ * The object is not thread-safe - it is meant to be used by one producer thread.
+ */
+class DLL_PUBLIC AsyncFileReader {
+ public:
+  /**
+   * @brief Creates a reader with given backend and maximum number of reads in flight
+   *
+   * @remarks Auto selects IOUring if it's supported, otherwise Threads.
+   *          Requesting IOUring explicitly fails if it's not supported.
+   */
+  static std::unique_ptr<AsyncFileReader> Create(AsyncIOBackend backend, int queue_depth);
+
+  /**
+   * @brief Tells whether the kernel supports io_uring (and the process is allowed to use it)
+   */
+  static bool IOUringSupported();
+
+  /**
+   * @brief Submits a read of `n_bytes` at `offset` in file `fd` into `buffer`
+   *
+   * If the queue is full, the call blocks until one of the pending reads completes.
+   * @param name  file name, used in error messages
+   */
+  virtual void Submit(int fd, void *buffer, size_t n_bytes, int64 offset,
+                      const std::string &name) = 0;
+
+  /**
+   * @brief Waits for all submitted reads to complete
+   *
+   * If any of the reads failed or the file was shorter than expected, an exception is thrown
+   * after all reads have completed.
+   */
+  virtual void Wait() = 0;
+
+  virtual AsyncIOBackend Backend() const = 0;
+
+  int QueueDepth() const {
+    return queue_depth_;
+  }
+
+  virtual ~AsyncFileReader() = default;
+
+ protected:
+  explicit AsyncFileReader(int queue_depth) : queue_depth_(queue_depth) {}
+  int queue_depth_;
+};
+
+/**
+ * @brief File stream which reads through a file descriptor with positional reads
+ *
+ * ReadAsync submits the reads to an AsyncFileReader, so the stream must not be closed before
+ * the reader is waited for.
+ */
+class DLL_PUBLIC AsyncFileStream : public FileStream {
+ public:
+  AsyncFileStream(const std::string &path, AsyncFileReader *reader);
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(uint8_t *buffer, size_t n_bytes) override;
+  void ReadAsync(uint8_t *buffer, size_t n_bytes) override;
+  void Seek(int64 pos) override;
+  size_t Size() const override;
+
+  ~AsyncFileStream() override {
+    Close();
+  }
+
+ private:
+  int fd_ = -1;
+  int64 pos_ = 0;
+  AsyncFileReader *reader_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_ASYNC_FILE_H_
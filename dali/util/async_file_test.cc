@@ -0,0 +1,152 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/util/async_file.h"
+
+namespace dali {
+
+namespace {
+
+class TempFile {
+ public:
+  explicit TempFile(const std::vector<uint8_t> &contents) {
+    char name[] = "/tmp/dali_async_file_XXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_GE(fd, 0);
+    path_ = name;
+    EXPECT_EQ(write(fd, contents.data(), contents.size()),
+              static_cast<ssize_t>(contents.size()));
+    close(fd);
+  }
+  ~TempFile() {
+    std::remove(path_.c_str());
+  }
+  const std::string &path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+std::vector<uint8_t> RandomData(size_t size) {
+  std::vector<uint8_t> data(size);
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto &x : data)
+    x = dist(rng);
+  return data;
+}
+
+std::vector<AsyncIOBackend> AvailableBackends() {
+  std::vector<AsyncIOBackend> backends = { AsyncIOBackend::Threads };
+  if (AsyncFileReader::IOUringSupported())
+    backends.push_back(AsyncIOBackend::IOUring);
+  return backends;
+}
+
+}  // namespace
+
+TEST(AsyncFileReader, ParseBackend) {
+  EXPECT_EQ(ParseAsyncIOBackend("sync"), AsyncIOBackend::Sync);
+  EXPECT_EQ(ParseAsyncIOBackend("auto"), AsyncIOBackend::Auto);
+  EXPECT_EQ(ParseAsyncIOBackend("io_uring"), AsyncIOBackend::IOUring);
+  EXPECT_EQ(ParseAsyncIOBackend("threads"), AsyncIOBackend::Threads);
+  EXPECT_THROW(ParseAsyncIOBackend("aio"), DALIException);
+}
+
+TEST(AsyncFileReader, Create) {
+  EXPECT_EQ(AsyncFileReader::Create(AsyncIOBackend::Sync, 4), nullptr);
+  auto reader = AsyncFileReader::Create(AsyncIOBackend::Auto, 4);
+  ASSERT_NE(reader, nullptr);
+  EXPECT_EQ(reader->Backend(), AsyncFileReader::IOUringSupported() ? AsyncIOBackend::IOUring
+                                                                     : AsyncIOBackend::Threads);
+  EXPECT_EQ(reader->QueueDepth(), 4);
+}
+
+TEST(AsyncFileReader, ReadFragments) {
+  auto data = RandomData(1 << 20);
+  TempFile file(data);
+  for (auto backend : AvailableBackends()) {
+    for (int queue_depth : { 1, 3, 16 }) {
+      auto reader = AsyncFileReader::Create(backend, queue_depth);
+      AsyncFileStream stream(file.path(), reader.get());
+      ASSERT_EQ(stream.Size(), data.size());
+
+      // read the file in fragments of random size, out of order
+      std::mt19937 rng(queue_depth);
+      std::vector<std::pair<size_t, size_t>> fragments;
+      for (size_t pos = 0; pos < data.size(); ) {
+        size_t size = std::min<size_t>(data.size() - pos, rng() % 10000 + 1);
+        fragments.emplace_back(pos, size);
+        pos += size;
+      }
+      std::shuffle(fragments.begin(), fragments.end(), rng);
+
+      std::vector<uint8_t> out(data.size());
+      for (auto &f : fragments) {
+        stream.Seek(f.first);
+        stream.ReadAsync(out.data() + f.first, f.second);
+      }
+      reader->Wait();
+      EXPECT_EQ(out, data) << "backend " << static_cast<int>(backend)
+                           << ", queue depth " << queue_depth;
+    }
+  }
+}
+
+TEST(AsyncFileReader, ShortRead) {
+  auto data = RandomData(1000);
+  TempFile file(data);
+  for (auto backend : AvailableBackends()) {
+    auto reader = AsyncFileReader::Create(backend, 2);
+    AsyncFileStream stream(file.path(), reader.get());
+    std::vector<uint8_t> out(2000);
+    stream.ReadAsync(out.data(), 500);
+    stream.ReadAsync(out.data() + 500, 1500);  // goes past the end of the file
+    EXPECT_THROW(reader->Wait(), DALIException);
+    // the reader is usable after an error
+    stream.Seek(0);
+    stream.ReadAsync(out.data(), 1000);
+    EXPECT_NO_THROW(reader->Wait());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), out.begin()));
+  }
+}
+
+TEST(AsyncFileStream, SyncRead) {
+  auto data = RandomData(5000);
+  TempFile file(data);
+  auto stream = FileStream::Open(file.path(), false, false, nullptr);
+  std::vector<uint8_t> out(data.size());
+  stream->Seek(1000);
+  EXPECT_EQ(stream->Read(out.data(), 4000), 4000u);
+  stream->Seek(0);
+  stream->ReadAsync(out.data() + 4000, 1000);
+  EXPECT_TRUE(std::equal(out.begin(), out.begin() + 4000, data.begin() + 1000));
+  EXPECT_TRUE(std::equal(out.begin() + 4000, out.end(), data.begin()));
+
+  AsyncFileStream async_stream(file.path(), nullptr);  // no reader - synchronous reads
+  async_stream.Seek(4990);
+  EXPECT_EQ(async_stream.Read(out.data(), 100), 10u);
+}
+
+}  // namespace dali
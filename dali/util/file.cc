@@ -15,6 +15,9 @@
 
 #include <string>
 
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/util/async_file.h"
 #include "dali/util/file.h"
 #include "dali/util/mmaped_file.h"
 #include "dali/util/std_file.h"
@@ -23,7 +26,7 @@
 namespace dali {
 
 std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, bool read_ahead,
-                                             bool use_mmap) {
+                                             bool use_mmap, AsyncFileReader *async_reader) {
   std::string processed_uri;
 
   if (uri.find("file://") == 0) {
@@ -34,11 +37,19 @@ std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, bool read_a
 
   if (use_mmap) {
     return std::unique_ptr<FileStream>(new MmapedFileStream(processed_uri, read_ahead));
+  } else if (async_reader) {
+    return std::unique_ptr<FileStream>(new AsyncFileStream(processed_uri, async_reader));
   } else {
     return std::unique_ptr<FileStream>(new StdFileStream(processed_uri));
   }
 }
 
+void FileStream::ReadAsync(uint8_t * buffer, size_t n_bytes) {
+  size_t n_read = Read(buffer, n_bytes);
+  DALI_ENFORCE(n_read == n_bytes, make_string("Failed to read file ", path_, ": expected ",
+                                              n_bytes, " bytes, got ", n_read));
+}
+
 bool FileStream::ReserveFileMappings(unsigned int num) {
   return MmapedFileStream::ReserveFileMappings(num);
 }
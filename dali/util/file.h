@@ -24,6 +24,8 @@
 
 namespace dali {
 
+class AsyncFileReader;
+
 class DLL_PUBLIC FileStream {
  public:
   class FileStreamMappinReserver {
@@ -75,11 +77,25 @@ class DLL_PUBLIC FileStream {
    private:
      unsigned int reserved;
   };
+  /**
+   * @brief Opens a file stream
+   *
+   * If `async_reader` is provided and the file is not mapped, the stream submits ReadAsync
+   * requests to `async_reader`.
+   */
   static std::unique_ptr<FileStream> Open(const std::string& uri, bool read_ahead,
-                                          bool use_mmap);
+                                          bool use_mmap,
+                                          AsyncFileReader *async_reader = nullptr);
 
   virtual void Close() = 0;
   virtual size_t Read(uint8_t * buffer, size_t n_bytes) = 0;
+  /**
+   * @brief Reads exactly n_bytes from the current position, possibly asynchronously
+   *
+   * The data is only guaranteed to be in the buffer after the AsyncFileReader the stream was
+   * opened with is waited for. The default implementation reads synchronously.
+   */
+  virtual void ReadAsync(uint8_t * buffer, size_t n_bytes);
   virtual shared_ptr<void>  Get(size_t n_bytes) = 0;
   virtual void Seek(int64 pos) = 0;
   virtual size_t Size() const = 0;
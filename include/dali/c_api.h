@@ -81,8 +81,35 @@ typedef struct {
   size_t *max_real_size;       // the biggest size of the tensor in the batch
   size_t *reserved;            // reserved size of the operator output, user need to free the memory
   size_t *max_reserved;        // the biggest reserved memory size for the tensor in the batch
+  // run time of the operator in seconds, over the most recent iterations
+  size_t iterations;           // number of iterations the operator has run
+  double min_time;             // shortest run time
+  double mean_time;            // mean run time
+  double p50_time;             // median run time
+  double p99_time;             // 99th percentile of the run time
+  double samples_per_sec;      // batch size divided by the mean run time
 } daliExecutorMetadata;
 
+typedef enum {
+  DALI_STAGE_CPU   = 0,
+  DALI_STAGE_MIXED = 1,
+  DALI_STAGE_GPU   = 2
+} dali_executor_stage_t;
+
+/*
+ * Need to keep that in sync with StageTimingStats from timing_stats.h
+ */
+typedef struct {
+  size_t iterations;               // number of iterations the stage has run
+  double mean_queue_wait;          // mean time spent waiting for the buffers, in seconds
+  double max_queue_wait;           // longest time spent waiting for the buffers, in seconds
+  double mean_run_time;            // mean wall time of the stage, excluding the waiting
+  double samples_per_sec;          // throughput of the stage
+  double thread_pool_utilization;  // fraction of the time the thread pool was busy (CPU only)
+  double op_overlap;               // average number of operators running at once (CPU only)
+  int max_concurrent_ops;          // most operators that ran at once (CPU only)
+} daliExecutorStageMetadata;
+
 /**
  * @brief DALI initialization
  *
@@ -231,6 +258,52 @@ daliSetExternalInputTensors(daliPipelineHandle *pipe_handle, const char *name,
                             int64_t sample_dim, const char *layout_str, unsigned int flags);
 ///@}
 
+/**
+ * @brief Called when the memory lent to the pipeline with daliSetExternalInputNoCopy or
+ *        daliSetExternalInputTensorsNoCopy is no longer used.
+ *
+ * It may be called from any thread, including the one calling the DALI functions
+ * (e.g. daliRun or daliDeletePipeline), so it must not call back into the pipeline.
+ *
+ * @param release_arg The value passed together with the callback.
+ */
+typedef void (*daliExternalInputReleaseCallback)(void *release_arg);
+
+///@{
+/**
+ * @brief Feed the data to ExternalSource without copying it.
+ *
+ * Works like daliSetExternalInputAsync and daliSetExternalInputTensorsAsync, but the
+ * ExternalSource uses the provided memory directly, as if it was created with `no_copy=True`.
+ * The memory must stay valid and unmodified until `release` is called with `release_arg`,
+ * which happens once, after the iteration that used the data has been consumed and its buffers
+ * are reused, or when the pipeline is deleted. It is also called if the function fails.
+ *
+ * The memory must match the device of the ExternalSource. For GPU operators, separate samples
+ * (daliSetExternalInputTensorsNoCopy) are copied to a contiguous buffer on the provided stream
+ * and `release` may be called before that copy completes - synchronize the stream before
+ * reusing the memory.
+ *
+ * @param release Callback invoked when the memory is no longer used. Can be NULL.
+ * @param release_arg Argument passed to `release`.
+ */
+DLL_PUBLIC void
+daliSetExternalInputNoCopy(daliPipelineHandle *pipe_handle, const char *name,
+                           device_type_t device, const void *data_ptr,
+                           dali_data_type_t data_type, const int64_t *shapes,
+                           int sample_dim, const char *layout_str,
+                           cudaStream_t stream, unsigned int flags,
+                           daliExternalInputReleaseCallback release, void *release_arg);
+
+DLL_PUBLIC void
+daliSetExternalInputTensorsNoCopy(daliPipelineHandle *pipe_handle, const char *name,
+                                  device_type_t device, const void *const *data_ptr,
+                                  dali_data_type_t data_type, const int64_t *shapes,
+                                  int64_t sample_dim, const char *layout_str,
+                                  cudaStream_t stream, unsigned int flags,
+                                  daliExternalInputReleaseCallback release, void *release_arg);
+///@}
+
 /**
  * @brief Start the execution of the pipeline.
  */
@@ -406,6 +479,15 @@ DLL_PUBLIC void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle,
 DLL_PUBLIC void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta,
                                          size_t operator_meta_num);
 
+/**
+ * @brief Obtains the timing of a stage of the executor, over the most recent iterations
+ *  @param stage The stage of the executor
+ *  @param stage_meta Pointer to the structure to be filled
+ */
+DLL_PUBLIC void daliGetExecutorStageMetadata(daliPipelineHandle* pipe_handle,
+                                             dali_executor_stage_t stage,
+                                             daliExecutorStageMetadata *stage_meta);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,7 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -36,6 +37,7 @@
 #include <vector>
 
 #include "dali/core/api_helper.h"
+#include "dali/core/tracer.h"
 
 namespace dali {
 
@@ -64,6 +66,13 @@ using uint32 = uint32_t;
 // Basic data type for our indices and dimension sizes
 typedef int64_t Index;
 
+/**
+ * @brief Device id which makes the pipeline run without any CUDA device
+ *
+ * Such a pipeline can contain only CPU operators and produce only CPU outputs.
+ */
+constexpr int CPU_ONLY_DEVICE_ID = -99999;
+
 enum class OpType {
   GPU = 0,
   CPU = 1,
@@ -148,6 +157,8 @@ inline int NumberOfChannels(DALIImageType type) {
 #define ANONYMIZE_VARIABLE(name) CONCAT_2(name, __LINE__)
 
 // Basic timerange for profiling
+// Marks an NVTX range and records the range to the host tracer (see dali/core/tracer.h),
+// when it's active.
 struct TimeRange {
   static const uint32_t kRed = 0xFF0000;
   static const uint32_t kGreen = 0x00FF00;
@@ -162,20 +173,26 @@ struct TimeRange {
   static const uint32_t kGreen1 = 0x859900;
   static const uint32_t knvGreen = 0x76B900;
 
-  TimeRange(std::string name, const uint32_t rgb = kBlue) {  // NOLINT
-#if NVTX_ENABLED
-    nvtxEventAttributes_t att;
-    att.version = NVTX_VERSION;
-    att.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
-    att.colorType = NVTX_COLOR_ARGB;
-    att.color = rgb | 0xff000000;
-    att.messageType = NVTX_MESSAGE_TYPE_ASCII;
-    att.message.ascii = name.c_str();
+  /**
+   * @param name      name of the range; must be a string with static storage duration
+   * @param iteration iteration number, or -1 if not applicable
+   */
+  TimeRange(const char *name, const uint32_t rgb = kBlue, int64_t iteration = -1) {  // NOLINT
+    start(name, nullptr, rgb, iteration);
+  }
 
-    nvtxRangePushEx(&att);
-    started = true;
+  /**
+   * @param name      name of the range; must be a string with static storage duration
+   * @param detail    appended to the name, e.g. the name of an operator instance
+   * @param iteration iteration number, or -1 if not applicable
+   */
+  TimeRange(const char *name, const std::string &detail, const uint32_t rgb = kBlue,
+            int64_t iteration = -1) {
+    start(name, detail.c_str(), rgb, iteration);
+  }
 
-#endif
+  TimeRange(const std::string &name, const uint32_t rgb = kBlue) {  // NOLINT
+    start(nullptr, name.c_str(), rgb, -1);
   }
 
   ~TimeRange() { stop(); }
@@ -187,13 +204,52 @@ struct TimeRange {
       nvtxRangePop();
     }
 #endif
+    if (begin_) {
+      tracing::RecordEvent(name_, detail_, iteration_, begin_, tracing::Now());
+      begin_ = 0;
+    }
   }
 
+ private:
+  void start(const char *name, const char *detail, const uint32_t rgb, int64_t iteration) {
 #if NVTX_ENABLED
+    std::string message = name ? name : "";
+    if (detail && *detail)
+      message += name ? std::string(" ") + detail : std::string(detail);
+    if (iteration >= 0)
+      message += " #" + std::to_string(iteration);
+    nvtxEventAttributes_t att;
+    att.version = NVTX_VERSION;
+    att.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    att.colorType = NVTX_COLOR_ARGB;
+    att.color = rgb | 0xff000000;
+    att.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    att.message.ascii = message.c_str();
 
- private:
+    nvtxRangePushEx(&att);
+    started = true;
+#endif
+    if (tracing::IsTracingEnabled()) {
+      name_ = name;
+      iteration_ = iteration;
+      // the detail may be a temporary - it's copied
+      if (detail) {
+        strncpy(detail_, detail, tracing::kMaxDetailLength - 1);
+        detail_[tracing::kMaxDetailLength - 1] = '\0';
+      } else {
+        detail_[0] = '\0';
+      }
+      begin_ = tracing::Now();
+    }
+  }
+
+#if NVTX_ENABLED
   bool started = false;
 #endif
+  const char *name_ = nullptr;
+  char detail_[tracing::kMaxDetailLength];
+  int64_t iteration_ = -1;
+  int64_t begin_ = 0;
 };
 
 using std::to_string;
@@ -0,0 +1,76 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_CPU_FEATURES_H_
+#define DALI_CORE_CPU_FEATURES_H_
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DALI_CPU_X86 1
+// The AVX-512 conversions start from an undefined register, which some GCC versions
+// falsely report as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+/**
+ * Function attributes which allow the use of the given instruction set in a function,
+ * regardless of the target of the translation unit. Such a function can only be called
+ * after checking GetCPUFeatures().
+ */
+#define DALI_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DALI_TARGET_AVX2 __attribute__((target("avx2")))
+#define DALI_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#define DALI_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define DALI_CPU_X86 0
+#endif
+
+namespace dali {
+
+/**
+ * @brief Instruction set extensions supported by the CPU the process runs on
+ */
+struct CPUFeatures {
+  bool sse41 = false;
+  bool avx2 = false;
+  bool fma = false;
+  bool avx512f = false;
+  bool avx512bw = false;
+};
+
+inline CPUFeatures DetectCPUFeatures() {
+  CPUFeatures features;
+#if DALI_CPU_X86
+  __builtin_cpu_init();
+  features.sse41 = __builtin_cpu_supports("sse4.1");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.fma = __builtin_cpu_supports("fma");
+  features.avx512f = __builtin_cpu_supports("avx512f");
+  features.avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+  return features;
+}
+
+/**
+ * @brief Returns the features of the CPU, detected on the first call
+ */
+inline const CPUFeatures &GetCPUFeatures() {
+  static const CPUFeatures features = DetectCPUFeatures();
+  return features;
+}
+
+}  // namespace dali
+
+#endif  // DALI_CORE_CPU_FEATURES_H_
@@ -0,0 +1,142 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_HOST_MEMORY_POOL_H_
+#define DALI_CORE_HOST_MEMORY_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+
+struct HostMemoryPoolStats {
+  int64_t allocations = 0;
+  int64_t deallocations = 0;
+  /// allocations served from the cache of the calling thread
+  int64_t thread_cache_hits = 0;
+  /// allocations served from the shared cache
+  int64_t pool_hits = 0;
+  /// allocations which had to go to the system allocator
+  int64_t system_allocations = 0;
+  /// blocks returned to the system (not cached)
+  int64_t system_deallocations = 0;
+  /// size of the blocks currently allocated by the users of the pool
+  int64_t bytes_in_use = 0;
+  int64_t peak_bytes_in_use = 0;
+  /// size of the free blocks kept by the pool
+  int64_t bytes_cached = 0;
+};
+
+/**
+ * @brief Caching allocator for pageable host memory
+ *
+ * The requests are rounded up to size classes (4 per power of 2, so at most 25% is wasted) and
+ * freed blocks are kept for reuse, so a pipeline which keeps allocating buffers of similar
+ * sizes stops calling the system allocator after a few iterations.
+ * Small blocks are first cached per thread, without locking; larger blocks, or those which
+ * don't fit in the thread cache, go to the shared cache.
+ *
+ * The total size of the cached blocks is limited by the capacity - the blocks that would
+ * exceed it are freed. The default capacity is 1 GiB and can be changed with the
+ * DALI_HOST_POOL_CAPACITY_MB environment variable or with SetCapacity; 0 disables caching.
+ *
+ * The blocks are 64-byte aligned. Allocate and Deallocate can be called from any thread.
+ */
+class DLL_PUBLIC HostMemoryPool {
+ public:
+  static HostMemoryPool &instance();
+
+  /**
+   * @brief Allocates a block of at least `bytes` bytes; returns nullptr on failure
+   */
+  void *Allocate(size_t bytes) noexcept;
+
+  /**
+   * @brief Returns a block obtained from Allocate to the pool
+   */
+  void Deallocate(void *ptr) noexcept;
+
+  /**
+   * @brief Sets the maximum total size of the cached blocks
+   *
+   * If the cache currently holds more, the shared cache is trimmed.
+   */
+  void SetCapacity(size_t bytes);
+
+  size_t Capacity() const {
+    return capacity_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Frees the blocks kept in the shared cache and in the cache of the calling thread
+   *
+   * The caches of other threads are returned to the shared cache when the threads exit.
+   */
+  void ReleaseCached();
+
+  HostMemoryPoolStats GetStats() const;
+
+  /// Alignment of the blocks
+  static constexpr size_t kAlignment = 64;
+
+  /// Blocks larger than that are not cached
+  static constexpr size_t kMaxCachedSize = size_t(1) << 31;
+
+  /// Size of the block which is allocated for a request of `bytes` bytes
+  static size_t BlockSize(size_t bytes);
+
+  struct ThreadCache;
+
+ private:
+  HostMemoryPool();
+
+  void *SystemAllocate(int size_class, size_t block_size) noexcept;
+  void SystemDeallocate(void *block) noexcept;
+  bool ReserveCache(size_t bytes) noexcept;
+  void PushShared(int size_class, void *block) noexcept;
+  void TrimShared(size_t target_bytes);
+  void FlushThreadCache(ThreadCache &cache) noexcept;
+  void AddInUse(int64_t bytes) noexcept;
+
+  struct SharedBin {
+    std::mutex mutex;
+    std::vector<void *> blocks;
+  };
+
+  std::unique_ptr<SharedBin[]> shared_;
+  std::atomic<size_t> capacity_;
+  std::atomic<int64_t> bytes_cached_{0};
+
+  struct Counters {
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> deallocations{0};
+    std::atomic<int64_t> thread_cache_hits{0};
+    std::atomic<int64_t> pool_hits{0};
+    std::atomic<int64_t> system_allocations{0};
+    std::atomic<int64_t> system_deallocations{0};
+    std::atomic<int64_t> bytes_in_use{0};
+    std::atomic<int64_t> peak_bytes_in_use{0};
+  } counters_;
+
+  friend struct ThreadCache;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_HOST_MEMORY_POOL_H_
@@ -0,0 +1,115 @@
+// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_TRACER_H_
+#define DALI_CORE_TRACER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "dali/core/api_helper.h"
+
+/**
+ * @file
+ *
+ * In-process tracer, which records the ranges marked with `TimeRange` on the host.
+ *
+ * Each thread records its events to its own ring buffer, so recording doesn't take any locks;
+ * when the buffer is full, the oldest events are overwritten. The trace is written
+ * in the Chrome trace event format, which can be opened in chrome://tracing or Perfetto.
+ *
+ * Setting the environment variable `DALI_TRACE_FILE` to a file name starts the tracing
+ * when DALI is loaded and writes the trace to that file when the process exits.
+ */
+
+namespace dali {
+namespace tracing {
+
+/// Maximum length of the detail string of an event, including the terminating null
+constexpr int kMaxDetailLength = 48;
+/// Default capacity of the per-thread ring buffers
+constexpr int64_t kDefaultEventsPerThread = 1 << 15;
+
+struct TraceEvent {
+  /// Name of the range; must be a string with static storage duration, e.g. a literal
+  const char *name;
+  /// Additional description, e.g. the name of an operator instance; may be empty
+  char detail[kMaxDetailLength];
+  /// Iteration number, or -1 if not applicable
+  int64_t iteration;
+  /// Start and end time, in nanoseconds since the tracing was started
+  int64_t begin_ns, end_ns;
+};
+
+namespace detail {
+DLL_PUBLIC extern std::atomic<bool> tracing_enabled;
+}  // namespace detail
+
+/**
+ * @brief Checks whether the tracing is active; this is the only cost paid by `TimeRange`
+ *        when the tracer is not used.
+ */
+inline bool IsTracingEnabled() {
+  return detail::tracing_enabled.load(std::memory_order_relaxed);
+}
+
+inline int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Starts recording the events, discarding the ones recorded before
+ *
+ * @param events_per_thread capacity of the ring buffer of each thread
+ */
+DLL_PUBLIC void StartTracing(int64_t events_per_thread = kDefaultEventsPerThread);
+
+/**
+ * @brief Stops recording the events; returns after the events being recorded are complete
+ */
+DLL_PUBLIC void StopTracing();
+
+/**
+ * @brief Records a range which started at `begin` and ended at `end`, as returned by `Now()`
+ *
+ * The event is dropped if the tracing is not active.
+ */
+DLL_PUBLIC void RecordEvent(const char *name, const char *detail, int64_t iteration,
+                            int64_t begin, int64_t end);
+
+/**
+ * @brief Sets the name under which the calling thread appears in the trace
+ */
+DLL_PUBLIC void SetThreadName(const std::string &name);
+
+/**
+ * @brief Returns the events recorded since the last `StartTracing` as Chrome trace JSON
+ *
+ * The tracing must be stopped.
+ */
+DLL_PUBLIC std::string GetTraceJSON();
+
+/**
+ * @brief Writes the events recorded since the last `StartTracing` as Chrome trace JSON
+ *
+ * The tracing must be stopped.
+ */
+DLL_PUBLIC void WriteTrace(const std::string &filename);
+
+}  // namespace tracing
+}  // namespace dali
+
+#endif  // DALI_CORE_TRACER_H_